@@ -70,12 +70,26 @@ class PythonDataset(Dataset, wrap=link.VAPoR.PythonDataMgr):
         if not link.VAPoR.XmlNode.IsValidXMLElement(name):
             raise Exception(f"The variable name '{name}' must be a valid XML tag, i.e. [a-Z0-9_-]+")
 
-    def AddNumpyData(self, name:str, arr:np.ndarray):
+    def AddNumpyData(self, name:str, arr:np.ndarray, copy:bool=True):
+        """
+        Add a variable sampled on a regular grid from a numpy array.
+        If copy is False and arr is a C-contiguous float32 array, the data
+        are used in place rather than copied. The array must not be modified
+        afterwards; it is kept alive until the variable is replaced.
+        """
         self.__checkNameValid(name)
-        # assert arr.dtype == np.float32
-        if arr.__array_interface__['strides']:
-            arr = arr.copy() # Flatten data
-        self._wrappedInstance.AddRegularData(name, np.float32(arr), arr.shape)
+        if copy:
+            # assert arr.dtype == np.float32
+            if arr.__array_interface__['strides']:
+                arr = arr.copy() # Flatten data
+            self._wrappedInstance.AddRegularData(name, np.float32(arr), arr.shape)
+            self.ses._pinnedArrays.pop((self.GetName(), name), None)
+        else:
+            arr = np.ascontiguousarray(arr, dtype=np.float32)
+            self._wrappedInstance.AddRegularData(name, arr, arr.shape, False)
+            # Holding a buffer export keeps the memory alive, and prevents
+            # the array from being resized, while VAPOR references it
+            self.ses._pinnedArrays[(self.GetName(), name)] = memoryview(arr)
         # TODO: Only clear necessary renderers
         self.ses.ce.ClearAllRenderCaches()
 
@@ -14,6 +14,8 @@ class Session(link.Session):
     def __init__(self):
         super().__init__()
         self.ce = super()._controlExec
+        # Numpy arrays whose memory is referenced by python datasets
+        self._pinnedArrays = {}
 
     def NewRenderer(self, Class:Renderer, datasetName:str) -> Renderer:
         id = super().NewRenderer(Class.VaporName, datasetName)
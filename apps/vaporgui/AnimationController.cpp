@@ -1,7 +1,12 @@
 #include "AnimationController.h"
+#include <algorithm>
 #include <vapor/ControlExecutive.h>
 #include <vapor/AnimationParams.h>
 #include <vapor/NavigationUtils.h>
+#include <vapor/DataStatus.h>
+#include <vapor/ParamsMgr.h>
+#include <vapor/RenderParams.h>
+#include <vapor/DataMgr.h>
 
 using namespace VAPoR;
 
@@ -58,6 +63,7 @@ void AnimationController::AnimationPause()
 {
     _animationOn = false;
     setPlay(0);
+    cancelPrefetch();
 }
 
 void AnimationController::AnimationPlayReverse()
@@ -136,6 +142,64 @@ void AnimationController::setPlay(int direction)
     }
 }
 
+// While playing forward, read the variables of the enabled renderers
+// for the next frame in the background
+//
+void AnimationController::prefetchFrames(size_t ts, size_t k) const
+{
+    DataStatus *dataStatus = _controlExec->GetDataStatus();
+    ParamsMgr * paramsMgr = _controlExec->GetParamsMgr();
+
+    vector<string> winNames = paramsMgr->GetVisualizerNames();
+    vector<string> dataSetNames = dataStatus->GetDataMgrNames();
+    for (const auto &dataSetName : dataSetNames) {
+        DataMgr *dataMgr = dataStatus->GetDataMgr(dataSetName);
+        if (!dataMgr) continue;
+
+        size_t local_ts = dataStatus->MapGlobalToLocalTimeStep(dataSetName, ts);
+
+        // One request per data set, so use the varnames, region, and
+        // resolution of the first enabled renderer
+        //
+        vector<string> varnames;
+        int            level = 0, lod = 0;
+        CoordType      minExt, maxExt;
+        for (const auto &winName : winNames) {
+            vector<RenderParams *> rParams;
+            paramsMgr->GetRenderParams(winName, dataSetName, rParams);
+            for (auto rp : rParams) {
+                if (!rp->IsEnabled()) continue;
+
+                vector<string> names = rp->GetFieldVariableNames();
+                names.push_back(rp->GetVariableName());
+                names.push_back(rp->GetColorMapVariableName());
+                if (varnames.empty()) {
+                    level = rp->GetRefinementLevel();
+                    lod = rp->GetCompressionLevel();
+                    rp->GetBox()->GetExtents(minExt, maxExt);
+                }
+                for (const auto &name : names) {
+                    if (!name.empty() && std::find(varnames.begin(), varnames.end(), name) == varnames.end()) varnames.push_back(name);
+                }
+            }
+        }
+
+        if (varnames.empty()) continue;
+        dataMgr->PrefetchTimeSteps(local_ts, k, varnames, level, lod, minExt, maxExt);
+    }
+}
+
+void AnimationController::cancelPrefetch() const
+{
+    DataStatus *dataStatus = _controlExec->GetDataStatus();
+
+    vector<string> dataSetNames = dataStatus->GetDataMgrNames();
+    for (const auto &dataSetName : dataSetNames) {
+        DataMgr *dataMgr = dataStatus->GetDataMgr(dataSetName);
+        if (dataMgr) dataMgr->CancelPrefetch();
+    }
+}
+
 void AnimationController::playNextFrame()
 {
     VAssert(_direction == -1 || _direction == 1);
@@ -164,6 +228,8 @@ void AnimationController::playNextFrame()
 
     setCurrentTimestep(currentFrame);
 
+    if (_direction > 0) prefetchFrames(currentFrame, frameStepSize);
+
     // playNextFrame() is called via a timer and bypasses main event
     // loop. So we need to call updateTab ourselves
     //
@@ -45,6 +45,8 @@ signals:
 private:
     void             setCurrentTimestep(size_t ts) const;
     void             setPlay(int direction);
+    void             prefetchFrames(size_t ts, size_t k) const;
+    void             cancelPrefetch() const;
     AnimationParams *GetActiveParams() const;
     void             _updateTab();
 
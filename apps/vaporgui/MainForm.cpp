@@ -1602,6 +1602,10 @@ void MainForm::closeDataHelper(string dataSetName)
 
     p->RemoveOpenDateSet(dataSetName);
 
+    // Statistics may be reading from the data set in the background
+    //
+    if (_stats) _stats->StopUpdate();
+
     _controlExec->CloseData(dataSetName);
 
     // Close data can't be undone
@@ -1617,6 +1621,11 @@ bool MainForm::openDataHelper(string dataSetName, string format, const vector<st
     GUIStateParams *p = GetStateParams();
     vector<string>  dataSetNames = p->GetOpenDataSetNames();
 
+    // OpenData() closes any data set already open under this name, and
+    // statistics may be reading from it in the background
+    //
+    if (_stats) _stats->StopUpdate();
+
     // Open the data set
     //
     int rc = _controlExec->OpenData(files, options, dataSetName, format);
@@ -26,6 +26,7 @@
 
 #include <QFileDialog>
 #include <QMouseEvent>
+#include <QTimer>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -63,6 +64,16 @@ Statistics::Statistics(QWidget *parent) : QDialog(parent), Ui_StatsWindow()
     verticalLayout_2->insertWidget(1, cr);
     _pw.push_back(cr);
 
+    auto bg = new PCheckbox(StatisticsParams::BackgroundTag, "Compute in background");
+    verticalLayout_2->insertWidget(2, bg);
+    _pw.push_back(bg);
+
+    // With an interval of zero the timer fires whenever the event loop
+    // is idle, so one grid is read between handling user events
+    _jobTimer = new QTimer(this);
+    _jobTimer->setInterval(0);
+    connect(_jobTimer, &QTimer::timeout, this, &Statistics::_jobStep);
+
     VPushButton *close = new VPushButton("Close Window");
     connect(close, &VPushButton::ButtonClicked, this, &QDialog::accept);
     layout()->addWidget(close);
@@ -70,6 +81,8 @@ Statistics::Statistics(QWidget *parent) : QDialog(parent), Ui_StatsWindow()
 
 Statistics::~Statistics()
 {
+    StopUpdate();
+
     if (_errMsg) {
         delete _errMsg;
         _errMsg = NULL;
@@ -435,32 +448,80 @@ void Statistics::_updateButtonClicked()
     GUIStateParams *  guiParams = dynamic_cast<GUIStateParams *>(_controlExec->GetParamsMgr()->GetParams(GUIStateParams::GetClassType()));
     std::string       dsName = guiParams->GetStatsDatasetName();
     StatisticsParams *statsParams = dynamic_cast<StatisticsParams *>(_controlExec->GetParamsMgr()->GetAppRenderParams(dsName, StatisticsParams::GetClassType()));
+    VAPoR::DataMgr *  currentDmgr = _controlExec->GetDataStatus()->GetDataMgr(dsName);
+
+    // A computation already under way may be for outdated parameters
+    StopUpdate();
 
+    // All statistics of a variable are computed together, so a variable
+    // is recomputed if any of its enabled statistics is invalid
+    std::vector<std::string> varnames;
     for (int i = 0; i < _validStats.GetVariableCount(); i++) {
         std::string varname = _validStats.GetVariableName(i);
         long        count = 0;
+        float       m3[3]{0.0f, 0.0f, 0.0f}, median = 0.0f, stddev = 0.0f;
         _validStats.GetCount(varname, &count);
-        if (count == -1) {
-            _calc3M(varname);
-            _updateStatsTable();
-        }
-        float m3[3]{0.0f, 0.0f, 0.0f}, median = 0.0f, stddev = 0.0f;
         _validStats.Get3MStats(varname, m3);
         _validStats.GetMedian(varname, &median);
         _validStats.GetStddev(varname, &stddev);
-        if ((statsParams->GetMinEnabled() || statsParams->GetMaxEnabled() || statsParams->GetMeanEnabled()) && std::isnan(m3[2])) {
-            _calc3M(varname);
-            _updateStatsTable();
-        }
-        if (statsParams->GetMedianEnabled() && std::isnan(median)) {
-            _calcMedian(varname);
-            _updateStatsTable();
-        }
-        if (statsParams->GetStdDevEnabled() && std::isnan(stddev)) {
-            _calcStddev(varname);
-            _updateStatsTable();
-        }
+        if (count == -1 || ((statsParams->GetMinEnabled() || statsParams->GetMaxEnabled() || statsParams->GetMeanEnabled()) && std::isnan(m3[2]))
+            || (statsParams->GetMedianEnabled() && std::isnan(median)) || (statsParams->GetStdDevEnabled() && std::isnan(stddev)))
+            varnames.push_back(varname);
+    }
+    if (varnames.empty()) return;
+
+    std::unique_ptr<StatsJob> job(new StatsJob(currentDmgr, dsName, varnames, statsParams));
+    if (!statsParams->GetBackgroundEnabled()) {
+        job->Run();
+        _storeStats(*job);
+        _updateStatsTable();
+        return;
+    }
+
+    // Read one grid per timer tick, so that the GUI stays responsive in
+    // the meantime. DataMgr and MyBase error reporting are not thread
+    // safe, so the grids are read on the GUI thread rather than in a
+    // worker thread.
+    _job = std::move(job);
+    UpdateButton->setText(QString("Updating %1/%2").arg(_job->progress).arg(_job->total));
+    _jobTimer->start();
+}
+
+void Statistics::_jobStep()
+{
+    if (!_job) {
+        _jobTimer->stop();
+        return;
+    }
+
+    if (_job->Step()) {
+        UpdateButton->setText(QString("Updating %1/%2").arg(_job->progress).arg(_job->total));
+        if (!_job->Done()) return;
     }
+
+    _jobTimer->stop();
+    UpdateButton->setText("Update Statistics");
+
+    // Initialize pointers
+    GUIStateParams *  guiParams = dynamic_cast<GUIStateParams *>(_controlExec->GetParamsMgr()->GetParams(GUIStateParams::GetClassType()));
+    std::string       dsName = guiParams->GetStatsDatasetName();
+    StatisticsParams *statsParams = dynamic_cast<StatisticsParams *>(_controlExec->GetParamsMgr()->GetAppRenderParams(dsName, StatisticsParams::GetClassType()));
+
+    // Discard the results if the parameters changed while computing them
+    if (statsParams && _job->HaveSameParams(dsName, statsParams)) _storeStats(*_job);
+    _job.reset();
+
+    _updateStatsTable();
+}
+
+void Statistics::StopUpdate()
+{
+    if (!_job) return;
+
+    _job.reset();
+
+    _jobTimer->stop();
+    UpdateButton->setText("Update Statistics");
 }
 
 void Statistics::_minTSChanged(int val)
@@ -629,159 +690,88 @@ void Statistics::_removeVarChanged(int index)
     _validStats.RemoveVariable(varName);
 }
 
-bool Statistics::_calc3M(std::string varname)
+void Statistics::_storeStats(const StatsJob &job)
 {
-    // Initialize pointers
-    GUIStateParams *  guiParams = dynamic_cast<GUIStateParams *>(_controlExec->GetParamsMgr()->GetParams(GUIStateParams::GetClassType()));
-    std::string       dsName = guiParams->GetStatsDatasetName();
-    StatisticsParams *statsParams = dynamic_cast<StatisticsParams *>(_controlExec->GetParamsMgr()->GetAppRenderParams(dsName, StatisticsParams::GetClassType()));
-    VAPoR::DataMgr *  currentDmgr = _controlExec->GetDataStatus()->GetDataMgr(dsName);
-
-    int minTS = statsParams->GetCurrentTimestep();
-    int maxTS = statsParams->GetCurrentMaxTS();
-    if (!currentDmgr->IsTimeVarying(varname)) maxTS = minTS;
-
-    CoordType minExtent = {0.0, 0.0, 0.0};
-    CoordType maxExtent = {0.0, 0.0, 0.0};
-    statsParams->GetBox()->GetExtents(minExtent, maxExtent);
-
-    float c = 0.0;
-    float sum = 0.0;
-    float min = std::numeric_limits<float>::max();
-    float max = -min;
-    long  count = 0;
-
-    for (int ts = minTS; ts <= maxTS; ts++) {
-        VAPoR::Grid *grid = currentDmgr->GetVariable(ts, varname, statsParams->GetRefinementLevel(), statsParams->GetCompressionLevel(), minExtent, maxExtent);
-        if (grid) {
-            Grid::ConstIterator endItr = grid->cend();
-            float               missingVal = grid->GetMissingValue();
-
-            for (Grid::ConstIterator it = grid->cbegin(minExtent, maxExtent); it != endItr; ++it) {
-                if (*it != missingVal) {
-                    float val = *it;
-                    min = min < val ? min : val;
-                    max = max > val ? max : val;
-                    float y = val - c;
-                    float t = sum + y;
-                    c = t - sum - y;
-                    sum = t;
-                    count++;
-                }
-            }
-
-            delete grid;    // delete the grid after using it!
+    for (int i = 0; i < job.varnames.size(); i++) {
+        std::string                  varname = job.varnames[i];
+        const VAPoR::GridStatistics &stats = job.results[i];
+
+        if (stats.GetCount() > 0) {
+            float m3[3] = {stats.GetMin(), stats.GetMax(), (float)stats.GetMean()};
+            _validStats.Add3MStats(varname, m3);
+            _validStats.AddMedian(varname, stats.GetQuantile(0.5));
+            _validStats.AddStddev(varname, (float)stats.GetStddev());
         }
+        _validStats.AddCount(varname, stats.GetCount());
     }
-
-    if (count > 0) {
-        float m3[3] = {min, max, sum / (float)count};
-        _validStats.Add3MStats(varname, m3);
-    } else    // count == 0
-    {
-        // std::cerr << "Error: Zero value got selected!!" << std::endl;
-    }
-
-    _validStats.AddCount(varname, count);
-
-    return true;
 }
 
-bool Statistics::_calcMedian(std::string varname)
+// StatsJob class
+//
+Statistics::StatsJob::StatsJob(VAPoR::DataMgr *dmgr, const std::string &dsName, const std::vector<std::string> &vars, const VAPoR::StatisticsParams *params)
+: dataMgr(dmgr), dataSetName(dsName), varnames(vars), results(vars.size()), progress(0), _varIdx(0), _ts(0)
 {
-    // Initialize pointers
-    GUIStateParams *  guiParams = dynamic_cast<GUIStateParams *>(_controlExec->GetParamsMgr()->GetParams(GUIStateParams::GetClassType()));
-    std::string       dsName = guiParams->GetStatsDatasetName();
-    StatisticsParams *statsParams = dynamic_cast<StatisticsParams *>(_controlExec->GetParamsMgr()->GetAppRenderParams(dsName, StatisticsParams::GetClassType()));
-    VAPoR::DataMgr *  currentDmgr = _controlExec->GetDataStatus()->GetDataMgr(dsName);
+    minTS = params->GetCurrentTimestep();
+    maxTS = params->GetCurrentMaxTS();
+    refLevel = params->GetRefinementLevel();
+    lod = params->GetCompressionLevel();
 
-    int minTS = statsParams->GetCurrentTimestep();
-    int maxTS = statsParams->GetCurrentMaxTS();
-    if (!currentDmgr->IsTimeVarying(varname)) maxTS = minTS;
+    minExtent = {0.0, 0.0, 0.0};
+    maxExtent = {0.0, 0.0, 0.0};
+    params->GetBox()->GetExtents(minExtent, maxExtent);
 
-    CoordType minExtent = {0.0, 0.0, 0.0};
-    CoordType maxExtent = {0.0, 0.0, 0.0};
-    statsParams->GetBox()->GetExtents(minExtent, maxExtent);
+    total = 0;
+    for (int i = 0; i < varnames.size(); i++) total += _lastTS(i) - minTS + 1;
 
-    std::vector<float> buffer;
-    for (int ts = minTS; ts <= maxTS; ts++) {
-        VAPoR::Grid *grid = currentDmgr->GetVariable(ts, varname, statsParams->GetRefinementLevel(), statsParams->GetCompressionLevel(), minExtent, maxExtent);
-        if (grid) {
-            Grid::ConstIterator endItr = grid->cend();
-            float               missingVal = grid->GetMissingValue();
+    _ts = minTS;
+    _skipEmpty();
+}
 
-            for (Grid::ConstIterator it = grid->cbegin(minExtent, maxExtent); it != endItr; ++it) {
-                if (*it != missingVal) buffer.push_back(*it);
-            }
-        }
-    }
+int Statistics::StatsJob::_lastTS(int varIdx) const
+{
+    // A time range may be empty
+    return (dataMgr->IsTimeVarying(varnames[varIdx]) ? std::max(maxTS, minTS - 1) : minTS);
+}
 
-    if (buffer.size() > 0) {
-        std::sort(buffer.begin(), buffer.end());
-        float median = buffer.at(buffer.size() / 2);
-        _validStats.AddMedian(varname, median);
-    } else {
-        // std::cerr << "Error: Zero value got selected!!" << std::endl;
+void Statistics::StatsJob::_skipEmpty()
+{
+    while (_varIdx < varnames.size() && _ts > _lastTS(_varIdx)) {
+        _varIdx++;
+        _ts = minTS;
     }
-
-    _validStats.AddCount(varname, buffer.size());
-
-    return true;
 }
 
-bool Statistics::_calcStddev(std::string varname)
+bool Statistics::StatsJob::Step()
 {
-    // Initialize pointers
-    GUIStateParams *  guiParams = dynamic_cast<GUIStateParams *>(_controlExec->GetParamsMgr()->GetParams(GUIStateParams::GetClassType()));
-    std::string       dsName = guiParams->GetStatsDatasetName();
-    StatisticsParams *statsParams = dynamic_cast<StatisticsParams *>(_controlExec->GetParamsMgr()->GetAppRenderParams(dsName, StatisticsParams::GetClassType()));
-    VAPoR::DataMgr *  currentDmgr = _controlExec->GetDataStatus()->GetDataMgr(dsName);
+    if (Done()) return (false);
 
-    int minTS = statsParams->GetCurrentTimestep();
-    int maxTS = statsParams->GetCurrentMaxTS();
-    if (!currentDmgr->IsTimeVarying(varname)) maxTS = minTS;
-
-    CoordType minExtent = {0.0, 0.0, 0.0};
-    CoordType maxExtent = {0.0, 0.0, 0.0};
-    statsParams->GetBox()->GetExtents(minExtent, maxExtent);
-
-    float c = 0.0;
-    float sum = 0.0;
-    long  count = 0;
-    float m3[3];
-    _validStats.Get3MStats(varname, m3);
-    if (std::isnan(m3[2])) {
-        this->_calc3M(varname);
-        _validStats.Get3MStats(varname, m3);
+    VAPoR::Grid *grid = dataMgr->GetVariable(_ts, varnames[_varIdx], refLevel, lod, minExtent, maxExtent);
+    if (grid) {
+        results[_varIdx].Add(grid, minExtent, maxExtent);
+        delete grid;    // delete the grid after using it!
     }
+    progress++;
 
-    for (int ts = minTS; ts <= maxTS; ts++) {
-        VAPoR::Grid *grid = currentDmgr->GetVariable(ts, varname, statsParams->GetRefinementLevel(), statsParams->GetCompressionLevel(), minExtent, maxExtent);
-        if (grid) {
-            Grid::ConstIterator endItr = grid->cend();
-            float               missingVal = grid->GetMissingValue();
-            for (Grid::ConstIterator it = grid->cbegin(minExtent, maxExtent); it != endItr; ++it) {
-                if (*it != missingVal) {
-                    float val = *it;
-                    float y = (val - m3[2]) * (val - m3[2]) - c;
-                    float t = sum + y;
-                    c = t - sum - y;
-                    sum = t;
-                    count++;
-                }
-            }
-        }
-    }
+    // Advance to the next time step, or the next variable
+    _ts++;
+    _skipEmpty();
+    return (true);
+}
 
-    if (count > 0) {
-        _validStats.AddStddev(varname, std::sqrt(sum / (float)count));
-    } else {
-        // std::cerr << "Error: Zero value got selected!!" << std::endl;
-    }
+void Statistics::StatsJob::Run()
+{
+    while (Step())
+        ;
+}
 
-    _validStats.AddCount(varname, count);
+bool Statistics::StatsJob::HaveSameParams(const std::string &dsName, const VAPoR::StatisticsParams *params) const
+{
+    CoordType myMin = {0.0, 0.0, 0.0};
+    CoordType myMax = {0.0, 0.0, 0.0};
+    params->GetBox()->GetExtents(myMin, myMax);
 
-    return true;
+    return (dsName == dataSetName && minTS == params->GetCurrentTimestep() && maxTS == params->GetCurrentMaxTS() && refLevel == params->GetRefinementLevel() && lod == params->GetCompressionLevel()
+            && myMin == minExtent && myMax == maxExtent);
 }
 
 // ValidStats class
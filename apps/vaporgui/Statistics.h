@@ -23,10 +23,12 @@
 #ifndef STATISTICS_H
     #define STATISTICS_H
 
+    #include <memory>
     #include <qdialog.h>
     #include <qwidget.h>
     #include <vapor/DataMgr.h>
     #include <vapor/Grid.h>
+    #include <vapor/GridStatistics.h>
     #include <vapor/ControlExecutive.h>
     #include "ui_statsWindow.h"
     #include "ui_errMsg.h"
@@ -39,6 +41,8 @@ class ParamsMgr;
 class DataMgr;
 }    // namespace VAPoR
 
+class QTimer;
+
 class sErrMsg : public QDialog, public Ui_ErrMsg {
     Q_OBJECT
 
@@ -56,6 +60,11 @@ public:
     void showMe();
     bool Update();
 
+    // Cancel a computation running in the background, if any. Must be
+    // called before closing the data set it reads from.
+    //
+    void StopUpdate();
+
 protected:
     // Keeps the current variables shown and their statistical values.
     // Invalid values are stored as std::nan("1");
@@ -104,6 +113,40 @@ protected:
                                           // >=0: a valid index
     };                                    // finish class ValidStats
 
+    // The statistics of a set of variables, computed together with a
+    // single pass over each grid. The grids may be read all at once with
+    // Run(), or one at a time with Step(). Both must be called from the
+    // GUI thread, as DataMgr and MyBase error reporting are not thread
+    // safe.
+    //
+    class StatsJob {
+    public:
+        VAPoR::DataMgr *                   dataMgr;
+        std::string                        dataSetName;
+        std::vector<std::string>           varnames;
+        int                                minTS, maxTS, refLevel, lod;
+        VAPoR::CoordType                   minExtent, maxExtent;
+        std::vector<VAPoR::GridStatistics> results;
+        int                                progress;    // number of grids read
+        int                                total;       // number of grids to read
+
+        StatsJob(VAPoR::DataMgr *dmgr, const std::string &dsName, const std::vector<std::string> &vars, const VAPoR::StatisticsParams *params);
+
+        // Read the next grid and add it to the results. Returns false,
+        // and does nothing, once every grid has been read
+        //
+        bool Step();
+        void Run();
+        bool Done() const { return (_varIdx >= varnames.size()); }
+        bool HaveSameParams(const std::string &dsName, const VAPoR::StatisticsParams *params) const;
+
+    private:
+        int _varIdx, _ts;    // next grid to read
+
+        int  _lastTS(int varIdx) const;
+        void _skipEmpty();    // advance past variables with no time steps left
+    };
+
     bool Connect();    // connect slots
 
 private slots:
@@ -118,6 +161,7 @@ private slots:
     void _dataSourceChanged(int);
     void _autoUpdateClicked(int);
     void _exportTextClicked();
+    void _jobStep();
 
 private:
     ValidStats             _validStats;
@@ -125,11 +169,13 @@ private:
     VAPoR::ControlExec *   _controlExec;
     std::vector<PWidget *> _pw;
 
+    std::unique_ptr<StatsJob> _job;    // computation running in the background
+    QTimer *                  _jobTimer;
+
     void _updateStatsTable();
 
-    // calculations should put results in _validStats directly.
-    bool _calc3M(std::string);    // min, max, mean
-    bool _calcMedian(std::string);
-    bool _calcStddev(std::string);
+    // Put the results of a finished job in _validStats
+    //
+    void _storeStats(const StatsJob &job);
 };
 #endif
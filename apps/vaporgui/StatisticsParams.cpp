@@ -28,6 +28,7 @@ using namespace VAPoR;
 
 const string StatisticsParams::_maxTSTag = "MaxTS";
 const string StatisticsParams::_autoUpdateTag = "AutoUpdate";
+const string StatisticsParams::BackgroundTag = "Background";
 const string StatisticsParams::_minEnabledTag = "MinEnabled";
 const string StatisticsParams::_maxEnabledTag = "MaxEnabled";
 const string StatisticsParams::_meanEnabledTag = "MeanEnabled";
@@ -54,6 +55,10 @@ bool StatisticsParams::GetAutoUpdateEnabled() { return (GetValueLong(_autoUpdate
 
 void StatisticsParams::SetAutoUpdateEnabled(bool val) { SetValueLong(_autoUpdateTag, "if we want stats auto-update", (long)val); }
 
+bool StatisticsParams::GetBackgroundEnabled() const { return (GetValueLong(BackgroundTag, (long)false)); }
+
+void StatisticsParams::SetBackgroundEnabled(bool val) { SetValueLong(BackgroundTag, "if we want stats computed in the background", (long)val); }
+
 int StatisticsParams::GetCurrentMaxTS() const { return (int)(GetValueDouble(_maxTSTag, 0.0)); }
 
 void StatisticsParams::SetCurrentMaxTS(int ts) { SetValueDouble(_maxTSTag, "Maximum selected timestep for statistics", (double)ts); }
@@ -33,6 +33,13 @@ public:
     bool GetAutoUpdateEnabled();
     void SetAutoUpdateEnabled(bool state);
 
+    // If enabled, statistics are computed one grid at a time between
+    // GUI events, so that the GUI remains responsive
+    //
+    static const string BackgroundTag;
+    bool                GetBackgroundEnabled() const;
+    void                SetBackgroundEnabled(bool state);
+
     // Note: we'll use the Get/SetCurrentTimestep() from RendererParams to
     // represent the min timestep, MinTS, so we only need to keep track of MaxTS.
     int  GetCurrentMaxTS() const;
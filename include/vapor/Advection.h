@@ -7,6 +7,7 @@
 #define ADVECTION_H
 
 #include "vapor/Particle.h"
+#include "vapor/ParticleStream.h"
 #include "vapor/Field.h"
 #include "vapor/common.h"
 #include <string>
@@ -34,7 +35,7 @@ public:
     int AdvectTillTime(Field *velocityField, double startT, double deltaT, double targetT, ADVECTION_METHOD method = ADVECTION_METHOD::RK4);
 
     // Retrieve field values of a particle based on its location, and put the result in
-    // the "value" field or the "properties" field of a particle
+    // the "value" field or a property of its stream
     //   If "skipNonZero" is true, then this function only overwrites zeros.
     //   Otherwise, it will overwrite values anyway.
     int CalculateParticleValues(Field *scalarField, bool skipNonZero);
@@ -57,8 +58,8 @@ public:
     void UseSeedParticles(const std::vector<Particle> &seeds);
 
     // Retrieve the resulting particles as "streams."
-    size_t                       GetNumberOfStreams() const;
-    const std::vector<Particle> &GetStreamAt(size_t i) const;
+    size_t                GetNumberOfStreams() const;
+    const ParticleStream &GetStreamAt(size_t i) const;
 
     // Retrieve the maximum number of particles in any stream
     size_t GetMaxNumOfPart() const;
@@ -76,11 +77,12 @@ public:
     auto GetPropertyVarNames() const -> std::vector<std::string>;
 
 private:
-    std::vector<std::vector<Particle>> _streams;
-    std::string                        _valueVarName;
-    std::vector<std::string>           _propertyVarNames;
+    std::vector<ParticleStream> _streams;
+    std::string                 _valueVarName;
+    std::vector<std::string>    _propertyVarNames;
 
     const float      _lowerAngle, _upperAngle;          // Thresholds for step size adjustment
+    const size_t     _batchSize;                        // Number of streams advanced together
     float            _lowerAngleCos, _upperAngleCos;    // Cosine values of the threshold angles
     std::vector<int> _separatorCount; // how many separators does each stream have.
                                       // Useful to determine how many steps are there in a stream.
@@ -96,11 +98,19 @@ private:
     int _advectRK4(Field *, const Particle &, double deltaT,      // Input
                    Particle &p1) const;                           // Output
 
+    // Same as above, but advance n particles at once, each with its own deltaT.
+    // Velocities are requested from the field in batches, one per stage.
+    // The return code of particle i is stored in rv[i].
+    void _advectEulerBatch(Field *, size_t n, const Particle *p0, const double *deltaT,    // Input
+                           Particle *p1, int *rv) const;                                   // Output
+    void _advectRK4Batch(Field *, size_t n, const Particle *p0, const double *deltaT,      // Input
+                         Particle *p1, int *rv) const;                                     // Output
+
     // Get an adjust factor for deltaT based on how curvy the past two steps are.
     //   A value in range (0.0, 1.0) means shrink deltaT.
     //   A value in range (1.0, inf) means enlarge deltaT.
     //   A value equals to 1.0 means not touching deltaT.
-    float _calcAdjustFactor(const Particle &past2, const Particle &past1, const Particle &current) const;
+    float _calcAdjustFactor(const glm::vec3 &past2, const glm::vec3 &past1, const glm::vec3 &current) const;
 
     // Adjust input "val" according to the bound specified by min and max.
     // Returns the value after adjustment.
@@ -109,9 +119,10 @@ private:
     // Print return code if it's non-zero and compiled in debug mode.
     void _printNonZero(int rtn, const char *file, const char *func, int line) const;
 
-    void        _calculateParticleIntegratedValue(Particle &p, const Particle &prev, const Field *scalarField, const bool skipNonZero, const float distScale,
+    // Integrate the value of particle i of stream s from that of particle i-1.
+    void        _calculateParticleIntegratedValue(ParticleStream &s, size_t i, const Field *scalarField, const bool skipNonZero, const float distScale,
                                                   const std::vector<double> &integrateWithinVolumeMin, const std::vector<double> &integrateWithinVolumeMax) const;
-    static bool _isParticleInsideVolume(const Particle &p, const std::vector<double> &min, const std::vector<double> &max);
+    static bool _isParticleInsideVolume(const glm::vec3 &loc, const std::vector<double> &min, const std::vector<double> &max);
 };
 }; // namespace flow
 
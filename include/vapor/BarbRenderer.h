@@ -153,12 +153,18 @@ private:
         float          colorSamples[10][3];
         float          alphaSamples[10];
         bool           needToRecalc;
+
+        mutable unsigned long generation;    // of the params the cache was last found clean for
     } _cacheParams;
 
     bool _isCacheDirty() const;
     void _saveCacheParams();
 
-    void _clearCache() { _cacheParams.fieldVarNames.clear(); }
+    void _clearCache()
+    {
+        _cacheParams.fieldVarNames.clear();
+        _cacheParams.generation = 0;
+    }
 
     struct Barb {
         float startPoint[3];
@@ -5,6 +5,8 @@
 #ifndef _BlkMemMgr_h_
 #define _BlkMemMgr_h_
 
+#include <mutex>
+#include <cstdint>
 #include <vapor/MyBase.h>
 
 namespace VAPoR {
@@ -19,6 +21,16 @@ namespace VAPoR {
 //! A block-based memory allocator. Allocates contiguous runs of
 //! memory blocks from a memory pool of user defined size.
 //!
+//! Free runs are kept on segregated free lists indexed by size class
+//! (a two-level segregated fit scheme). Alloc() takes a run from the
+//! smallest size class whose runs are all large enough, in constant time.
+//! Only if there is none is the free list of the request's own size class
+//! searched for a run that is large enough. FreeMem() runs in constant
+//! time regardless of how fragmented the pool is.
+//! Adjacent free runs are coalesced immediately when memory is freed.
+//!
+//! All methods are thread safe.
+//!
 //! N.B. the memory pool is stored in a static class member and
 //! can only be freed by calling RequestMemSize() with a zero value
 //! after all instances of this class have been destroyed
@@ -63,33 +75,105 @@ public:
     //! \b Alloc() calls.
     //! \param[in] page_aligned If true, start address of memory pool
     //! will be page aligned
+    //! \param[in] huge_pages If true, and supported by the platform, the
+    //! memory pool is backed by huge pages. Currently only supported
+    //! on Linux, where transparent huge pages are requested with
+    //! madvise(). Ignored elsewhere.
     //
-    static int RequestMemSize(size_t blk_size, size_t num_blks, bool page_aligned = true);
+    static int RequestMemSize(size_t blk_size, size_t num_blks, bool page_aligned = true, bool huge_pages = false);
 
     static size_t GetBlkSize() { return (_blk_size); }
 
+    //! Memory pool usage and fragmentation statistics
+    //
+    class Stats {
+    public:
+        Stats() : total_blks(0), free_blks(0), largest_free_run(0), num_free_runs(0), num_allocs(0) {}
+
+        size_t total_blks;          //!< Blocks in the memory pool
+        size_t free_blks;           //!< Blocks not currently allocated
+        size_t largest_free_run;    //!< Largest contiguous run of free blocks
+        size_t num_free_runs;       //!< Number of contiguous free runs
+        size_t num_allocs;          //!< Number of outstanding allocations
+
+        //! Fraction of free memory that cannot be used to satisfy a
+        //! request for the largest free run. 0.0 indicates no
+        //! fragmentation.
+        //
+        double Fragmentation() const { return (free_blks ? 1.0 - ((double)largest_free_run / (double)free_blks) : 0.0); }
+    };
+
+    //! Return statistics describing the state of the memory pool
+    //
+    static Stats GetStats();
+
 private:
+    // A reference to a run of blocks: an arena and a block offset
+    // within the arena. An arena of -1 is a null reference.
+    //
     typedef struct {
-        size_t _nfree;    // number of contiguous free blocks
-        size_t _nused;    // number of contiguous used blocks
-        void * _blk;      // pointer to first free/used block
-    } _mem_allocation_t;
+        int    arena;
+        size_t blk;
+    } _run_ref_t;
 
-    static vector<vector<_mem_allocation_t>> _mem_regions;
-    static vector<size_t>                    _mem_region_sizes;    // size of mem in blocks
-    static vector<unsigned char *>           _blks;                // memory pool
+    enum { _RUN_NONE = 0, _RUN_FREE = 1, _RUN_USED = 2 };
+
+    // A contiguous memory allocation carved into runs of blocks.
+    // Per-block metadata is only meaningful at the first block of a run,
+    // except for _runStart, which is maintained at the last block of a
+    // run so that a run's left neighbor can be found in constant time.
+    //
+    typedef struct {
+        unsigned char *    _mem;         // memory as allocated
+        unsigned char *    _blk;         // first block (aligned)
+        size_t             _size;        // size of allocation in bytes
+        size_t             _nblks;       // size of arena in blocks
+        bool               _huge;        // allocated with mmap()
+        vector<size_t>     _runLen;      // run length, at first block
+        vector<size_t>     _runStart;    // run start, at last block
+        vector<uint8_t>    _runState;    // _RUN_FREE, _RUN_USED, at first block
+        vector<_run_ref_t> _next;        // free list links, at first block
+        vector<_run_ref_t> _prev;
+    } _arena_t;
+
+    // Two-level segregated fit parameters. The first level indexes
+    // powers of two, the second level linearly subdivides each power
+    // of two into 2^_SL_BITS size classes.
+    //
+    enum { _SL_BITS = 3, _SL_COUNT = 1 << _SL_BITS, _FL_COUNT = 56 };
+
+    static vector<_arena_t *> _arenas;
+    static _run_ref_t         _freeLists[_FL_COUNT][_SL_COUNT];
+    static uint64_t           _flBitmap;
+    static uint32_t           _slBitmap[_FL_COUNT];
+
+    static size_t _num_free_runs;
+    static size_t _free_blks;
+    static size_t _num_allocs;
 
     static size_t _mem_size_max_req;    // max requested size of mem in blocks
     static bool   _page_aligned_req;    // requested page align memory
+    static bool   _huge_pages_req;      // requested huge page backing
     static size_t _blk_size_req;        // requested size of block in bytes
 
     static size_t _mem_size_max;    // max size of mem in blocks
     static bool   _page_aligned;    // page align memory
+    static bool   _huge_pages;      // back memory with huge pages
     static size_t _blk_size;        // size of block in bytes
 
     static int _ref_count;    // # instances of object.
 
-    static int _Reinit(size_t n);
+    static std::mutex _mutex;
+
+    static int  _Reinit(size_t n);
+    static void _FreeArenas();
+
+    static void _MappingInsert(size_t n, int &fl, int &sl);
+    static void _MappingSearch(size_t n, int &fl, int &sl);
+    static bool _FindSuitable(int &fl, int &sl);
+    static void _InsertFree(int arena, size_t blk, size_t len);
+    static void _RemoveFree(int arena, size_t blk);
+    static void _SetRun(_arena_t *a, size_t blk, size_t len, uint8_t state);
 };
 };    // namespace VAPoR
 
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <iostream>
+#include <vapor/common.h>
+#include <vapor/Grid.h>
+
+namespace VAPoR {
+
+//
+//! \class CellBVH
+//! \brief A bounding volume hierarchy for locating the cells of an
+//! unstructured grid containing a point
+//!
+//! This class builds a binary tree of axis-aligned bounding boxes over
+//! the bounding boxes of a set of cells. The tree is a linear BVH: the
+//! cells are sorted along a Morton (Z-order) curve through their centers,
+//! and each node is split where the Morton codes of its cells first
+//! differ. Construction is performed in parallel.
+//!
+//! The nodes are stored in a single array in depth-first order, with the
+//! left child of a node immediately following it, so that traversal
+//! walks through memory mostly sequentially.
+//!
+//! The tree only knows about cell bounding boxes. The caller decides
+//! whether a candidate cell actually contains a point.
+//
+class VDF_API CellBVH {
+public:
+    CellBVH() = default;
+
+    //! Build the hierarchy
+    //!
+    //! Any existing hierarchy is discarded.
+    //!
+    //! \param[in] boxes An array of \p ncells bounding boxes, six values per
+    //! cell ordered xmin, ymin, zmin, xmax, ymax, zmax. A cell whose
+    //! minimum exceeds its maximum along any axis is treated as empty and
+    //! is never returned by Find().
+    //! \param[in] ncells The number of cells. Cell indices returned
+    //! by Find() are offsets into \p boxes.
+    //
+    void Build(const float *boxes, size_t ncells);
+
+    //! Visit the cells whose bounding boxes contain a point
+    //!
+    //! The cells whose bounding boxes contain \p pt are passed, one at a
+    //! time, to \p visit, a callable with the signature
+    //! <tt>bool visit(size_t cell)</tt>. The search stops as soon as
+    //! \p visit returns true.
+    //!
+    //! \param[in] pt The 3D coordinates of the point
+    //! \param[in] visit The cell test
+    //!
+    //! \retval found True if \p visit returned true for some cell
+    //
+    template<typename Visit> bool Find(const CoordType &pt, Visit visit) const
+    {
+        if (_nodes.empty()) return (false);
+
+        uint32_t stack[_maxDepth];
+        int      sp = 0;
+        uint32_t i = 0;
+
+        for (;;) {
+            const node_t &node = _nodes[i];
+            if (_inside(node, pt)) {
+                if (node.count == 0) {
+                    stack[sp++] = node.first;
+                    i = i + 1;
+                    continue;
+                }
+                for (uint32_t k = node.first; k < node.first + node.count; k++) {
+                    if (visit((size_t)_cells[k])) return (true);
+                }
+            }
+            if (sp == 0) return (false);
+            i = stack[--sp];
+        }
+    }
+
+    //! Return the number of cells in the hierarchy
+    //!
+    //! Empty cells are not counted.
+    //
+    size_t GetNumCells() const { return (_cells.size()); }
+
+    //! Return the number of nodes in the hierarchy
+    //
+    size_t GetNumNodes() const { return (_nodes.size()); }
+
+    //! Return the number of levels in the hierarchy
+    //
+    int GetDepth() const;
+
+    friend std::ostream &operator<<(std::ostream &os, const CellBVH &bvh)
+    {
+        os << "Cells : " << bvh.GetNumCells() << std::endl;
+        os << "Nodes : " << bvh.GetNumNodes() << std::endl;
+        os << "Depth : " << bvh.GetDepth() << std::endl;
+        return (os);
+    }
+
+private:
+    // 32 bytes, so that two nodes share a cache line
+    //
+    struct node_t {
+        float    min[3];
+        float    max[3];
+        uint32_t first;    // Leaf: offset of first cell in _cells. Interior: index of right child
+        uint32_t count;    // Leaf: number of cells. Interior: zero
+    };
+
+    // Maximum number of cells in a leaf
+    //
+    static const uint32_t _maxLeafSize = 4;
+
+    // Bound on tree depth. 30 levels of Morton code bits, plus up to 32
+    // levels of median splits among cells with identical codes
+    //
+    static const int _maxDepth = 64;
+
+    std::vector<node_t>   _nodes;
+    std::vector<uint32_t> _cells;
+
+    static bool _inside(const node_t &node, const CoordType &pt)
+    {
+        return (pt[0] >= node.min[0] && pt[0] <= node.max[0] && pt[1] >= node.min[1] && pt[1] <= node.max[1] && pt[2] >= node.min[2] && pt[2] <= node.max[2]);
+    }
+
+    void _build(const float *boxes, const std::vector<uint32_t> &codes, size_t first, size_t last, size_t slot, std::vector<node_t> &nodes) const;
+    void _leaf(const float *boxes, size_t first, size_t last, node_t &node) const;
+};
+};    // namespace VAPoR
@@ -80,6 +80,15 @@ public:
     void move(int index, float delta);
 
     Color color(float value) const;
+
+    //! Compute the colors of an array of values (data coordinates)
+    //!
+    //! Equivalent to calling color(float) for each of the \p n elements
+    //! of \p values, but the control points and settings of the color map
+    //! are only read once.
+    //
+    void color(const float *values, size_t n, Color *colors) const;
+
     Color colorNormalized(float nv) const;
     Color getDivergingColor(float ratio, float index) const;
     Color getCorrectiveDivergingColor(float ratio, float index) const;
@@ -116,6 +125,10 @@ public:
 
 private:
     int leftIndex(float val) const;
+
+    static int   leftIndex(const vector<double> &cps, float val);
+    static Color colorNormalized(const vector<double> &cps, TFInterpolator::type itype, bool whitespace, float nv);
+    static Color divergingColor(const vector<double> &cps, bool whitespace, float ratio, float index);
 };
 
 class PARAMS_API ARGB {
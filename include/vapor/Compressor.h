@@ -283,6 +283,17 @@ public:
     //!
     bool &KeepAppOnOff() { return (_keepapp); };
 
+    //! Set or get the partial sort attribute
+    //!
+    //! When set (the default), Compress() and Decompose() locate the
+    //! largest coefficients of each collection by selection, in time
+    //! linear in the number of coefficients. When cleared, all
+    //! coefficients are fully sorted by magnitude. Both methods produce
+    //! identical significance maps; the attribute exists primarily for
+    //! benchmarking.
+    //!
+    bool &PartialSortOnOff() { return (_partialsort); };
+
     //! Set or get the min range clamping attribute
     //!
     //! When set, this attribute will clamp the minimum data value
@@ -353,6 +364,7 @@ private:
     size_t *       _L;    // wavelet coefficient book keeping array
     size_t         _LLen;
     bool           _keepapp;    // if true, approximation coeffs are not used in compression
+    bool           _partialsort;    // if true, select rather than sort coefficients
     bool           _clamp_min_flag;
     bool           _clamp_max_flag;
     bool           _epsilon_flag;
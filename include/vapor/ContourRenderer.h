@@ -73,14 +73,22 @@ private:
         double         sliceResolution;
         int            sliceOrientationMode;
 
-
+        mutable unsigned long generation;    // of the params the cache was last found clean for
     } _cacheParams;
 
     int  _buildCache(bool fast);
+    void _buildContoursGeneric(const Grid *grid, const Grid *heightGrid, const vector<float> &contours, bool flat, float Z0, vector<VertexData> &vertices) const;
+    void _buildContoursStructured(const Grid *grid, const Grid *heightGrid, const vector<float> &contours, bool flat, float Z0, vector<VertexData> &vertices) const;
+    static void _addCellContours(size_t nNodes, const DimsType *nodes, const float *values, const CoordType *coords, const float *contours, size_t nContours, const Grid *heightGrid, bool flat,
+                                 float Z0, vector<VertexData> &vertices);
     bool _isCacheDirty() const;
     void _saveCacheParams();
 
-    void _clearCache() { _cacheParams.varName.clear(); }
+    void _clearCache()
+    {
+        _cacheParams.varName.clear();
+        _cacheParams.generation = 0;
+    }
 
     vector<glm::vec3> _sliceQuad;
     glm::vec3         _finalOrigin;
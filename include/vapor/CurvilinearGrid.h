@@ -182,6 +182,19 @@ public:
     //
     virtual bool InsideGrid(const CoordType &coords) const override;
 
+    //! \copydoc Grid::GetValues()
+    //!
+    //! Consecutive points, such as those along a scanline, usually lie
+    //! in the same cell or in a neighboring one. These cells are tried
+    //! before the grid is searched for each point.
+    //
+    virtual void GetValues(const double *xyz, size_t n, float *values) const override;
+
+    // For grandparent inheritance of
+    // Grid::GetValues(const float *xyz, size_t n, float *values)
+    //
+    using Grid::GetValues;
+
     //! Returns reference to RegularGrid instance containing X user coordinates
     //!
     //! Returns reference to RegularGrid instance passed to constructor
@@ -263,6 +276,18 @@ private:
 
     bool _insideGrid(double x, double y, double z, size_t &i, size_t &j, size_t &k, double lambda[4], double zwgt[2]) const;
 
+    bool _findFace(double pt[2], size_t &i, size_t &j, double lambda[4], std::vector<DimsType> &nodes) const;
+
+    bool _insideNearbyFace(double pt[2], size_t &i, size_t &j, double lambda[4], std::vector<DimsType> &nodes) const;
+
+    bool _insideColumn(double x, double y, double z, size_t i, size_t j, size_t &k, double zwgt[2]) const;
+
+    // Same as GetValueNearestNeighbor() and GetValueLinear(), for a point
+    // already located in the grid by _insideGrid()
+    //
+    float _getValueNearestNeighbor(size_t i, size_t j, size_t k, const double lambda[4], const double zwgt[2]) const;
+    float _getValueLinear(size_t i, size_t j, size_t k, const double lambda[4], const double zwgt[2]) const;
+
     void _getIndicesHelper(const std::vector<double> &coords, std::vector<size_t> &indices) const;
 
     bool _insideGridHelperStretched(double z, size_t &k, double zwgt[2]) const;
@@ -2,6 +2,7 @@
 #include <algorithm>
 #include <map>
 #include <iostream>
+#include <memory>
 #include <vapor/MyBase.h>
 #include <vapor/NetCDFCFCollection.h>
 #include <vapor/Proj4API.h>
@@ -31,8 +32,32 @@ public:
     void AddCoordVar(const DC::CoordVar &var, const float *buf);
     void AddDataVar(const DC::DataVar &var, const float *buf);
 
+    //! Add a data variable without copying its values
+    //!
+    //! Like AddDataVar(), except that \p buf is referenced rather than
+    //! copied. \p buf must contain the values of the entire variable,
+    //! contiguously, and must remain valid and unmodified until the
+    //! variable is replaced or the DCRAM is destroyed. It is up to the
+    //! caller to keep the memory alive.
+    //
+    void AddDataVarRef(const DC::DataVar &var, const float *buf);
+
+    //! Return the in-memory values of a variable
+    //!
+    //! \param[in] varname Name of a variable added with AddCoordVar(),
+    //! AddDataVar() or AddDataVarRef()
+    //! \param[out] dims Dimension lengths of the variable
+    //!
+    //! \retval data A pointer to the contiguous values of the entire
+    //! variable, or NULL if \p varname is not held in memory
+    //
+    const float *GetVarData(string varname, vector<size_t> &dims) const;
+
 protected:
-    map<string, float*> _dataMap;
+    // Variable values. Owned copies are freed when released, referenced
+    // buffers are not
+    //
+    map<string, std::shared_ptr<const float>> _dataMap;
     
     void copyVarData(const DC::BaseVar &var, const float *buf, const size_t size);
     
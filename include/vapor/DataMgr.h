@@ -1,8 +1,16 @@
 #include <vector>
 #include <iostream>
 #include <list>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <functional>
+#include <unordered_set>
+#include <deque>
+#include <set>
 #include "vapor/VAssert.h"
 #include <vapor/BlkMemMgr.h>
+#include <vapor/RegionCache.h>
 #include <vapor/DC.h>
 #include <vapor/MyBase.h>
 #include <vapor/RegularGrid.h>
@@ -47,6 +55,18 @@ class DerivedCoordVar;
 //! not, unless otherwise documented, log an error message upon
 //! failure (return of false).
 //!
+//! The data access methods GetVariable(), GetVariableExtents(),
+//! GetDataRange(), VariableExists() and UnlockGrid() may be called
+//! concurrently from multiple threads. Reads from the underlying data
+//! collection are serialized, but cache lookups and grid construction
+//! proceed while another thread is reading. If several threads request
+//! the same region at the same time the region is read only once; the
+//! other threads wait for the read to complete. Clear() waits for
+//! reads in progress on other threads to finish. Methods that change
+//! the set of available variables (Initialize(), AddDerivedVar(),
+//! RemoveDerivedVar()) must not be called while other threads are
+//! accessing the class.
+//!
 //! \param level
 //! \parblock
 //! Grid refinement level for multiresolution variables.
@@ -545,10 +565,84 @@ public:
 
     //! Clear the memory cache
     //!
-    //! This method clears the internal memory cache of all entries
+    //! This method clears the internal memory cache of all entries.
+    //! Queued prefetch reads are discarded, and the method blocks until
+    //! any GetVariable() calls in progress on other threads have
+    //! returned, so that regions being read are not freed. Clear() must
+    //! not be called from within a data access method (e.g. by a
+    //! derived variable).
+    //!
+    //! \sa CancelPrefetch()
     //
     void Clear();
 
+    //! Read upcoming time steps into the memory cache in the background
+    //!
+    //! Queue the regions of the variables \p varnames for time steps
+    //! \p ts + 1 through \p ts + \p k to be read into the memory cache
+    //! by a background thread, so that subsequent GetVariable() calls
+    //! for those time steps are satisfied without reading from disk. The
+    //! method returns immediately. A new request replaces any queued
+    //! reads that have not yet started.
+    //!
+    //! Prefetched data never displace locked regions, or regions belonging
+    //! to time step \p ts or to the time steps being prefetched. If the
+    //! cache does not have room the read is dropped.
+    //!
+    //! \param[in] ts The time step currently being displayed
+    //! \param[in] k The number of time steps after \p ts to read. Time
+    //! steps past the last time step are ignored.
+    //! \param[in] varnames Variables to read
+    //! \param[in] level Refinement level, as for GetVariable()
+    //! \param[in] lod Level-of-detail, as for GetVariable()
+    //! \param[in] min Minimum extents of region of interest, as for
+    //! GetVariable()
+    //! \param[in] max Maximum extents of region of interest, as for
+    //! GetVariable()
+    //!
+    //! \sa CancelPrefetch(), GetPrefetchStats()
+    //
+    void PrefetchTimeSteps(size_t ts, size_t k, const std::vector<string> &varnames, int level, int lod, CoordType min, CoordType max);
+
+    //! Discard all queued prefetch reads
+    //!
+    //! A read that is already in progress is allowed to complete; the
+    //! method blocks until it has. No prefetch reads are made after the
+    //! method returns, until PrefetchTimeSteps() is called again.
+    //! CancelPrefetch() must not be called from within a data access
+    //! method (e.g. by a derived variable).
+    //
+    void CancelPrefetch();
+
+    //! Counters describing the effectiveness of PrefetchTimeSteps()
+    //
+    class PrefetchStats {
+    public:
+        PrefetchStats() : reads(0), dropped(0), hits(0), misses(0) {}
+
+        size_t reads;      //!< Regions read by the background thread
+        size_t dropped;    //!< Prefetch reads dropped for lack of memory
+        size_t hits;       //!< Requests satisfied by a prefetched region
+        size_t misses;     //!< Requests that had to read from disk
+    };
+
+    //! Return prefetch counters accumulated since the last call to
+    //! ResetPrefetchStats()
+    //
+    PrefetchStats GetPrefetchStats() const;
+
+    //! Reset all prefetch counters to zero
+    //
+    void ResetPrefetchStats();
+
+    //! \copydoc GridHelper::SetIndexCacheDir()
+    //
+    void SetIndexCacheDir(const string &dir);
+
+    //! \copydoc GridHelper::SetIndexCacheSize()
+    //
+    void SetIndexCacheSize(size_t max_size);
+
     //! Returns true if indicated data volume is available
     //!
     //! Returns true if the variable identified by the timestep, variable
@@ -636,6 +730,23 @@ public:
     //!
     void PurgeVariable(string varname);
 
+    //! Return the version of a variable
+    //!
+    //! The version of a variable is a counter that is incremented each
+    //! time the variable's data may have changed, i.e. whenever the
+    //! variable is freed from the cache because it was redefined or its
+    //! contents were replaced. The version of a derived variable also
+    //! reflects the versions of all of its inputs. Clients that cache
+    //! data computed from a variable may compare versions to decide
+    //! whether their cached data are still valid.
+    //!
+    //! \param[in] varname is the variable name
+    //!
+    //! \retval version The current version of \p varname. Zero is returned
+    //! for a variable that has never changed.
+    //
+    unsigned long GetVarVersion(string varname) const;
+
     class BlkExts {
     public:
         BlkExts(){};
@@ -719,19 +830,93 @@ protected:
     string              _proj4StringDefault;
     DimsType            _bs;
 
+    // index of all allocated regions
+    RegionCache _regionCache;
+
+    // Recursive mutex that serializes access to the DataMgr's internal
+    // state. Unlike std::recursive_mutex, the owning thread can give up
+    // all levels of ownership, and later restore them, while it performs
+    // file I/O or waits on a region that another thread is reading.
+    //
+    class Mutex {
+    public:
+        Mutex() : _depth(0) {}
+
+        void lock();
+        void unlock();
+
+        // Release all levels of ownership held by the calling thread and
+        // return the number of levels released
+        //
+        int release();
+
+        // Restore ownership previously given up with release()
+        //
+        void reacquire(int depth);
+
+        // Atomically release ownership and block until \p pred returns
+        // true, then restore ownership. \p pred is only evaluated while no
+        // thread owns the mutex.
+        //
+        void wait(const std::function<bool()> &pred);
+
+    private:
+        std::mutex              _m;
+        std::condition_variable _cv;
+        std::thread::id         _owner;
+        int                     _depth;
+    };
+
+    mutable Mutex _mutex;
+
+    // Serializes reads from _dc, which is not thread safe. To avoid
+    // deadlock _ioMutex must never be acquired by a thread that owns _mutex
+    //
+    // Only the DC methods that open, read, and close variables modify the
+    // DC's state, and these are only called with _ioMutex held (or from
+    // Initialize(), which may not run concurrently with data access). The
+    // metadata queries made without _ioMutex (GetDataVarInfo(),
+    // GetDimLensAtLevel(), etc.) are const and read state established
+    // when the DC was initialized.
+    //
+    std::recursive_mutex _ioMutex;
+
+    // Regions currently being read from the file system by the thread
+    // that owns _ioMutex.
+    //
+    std::unordered_set<RegionCache::Key, RegionCache::KeyHash> _inFlight;
+
+    // Number of _getVariable() calls in progress, guarded by _mutex.
+    // A reader holds the regions it has already obtained while it
+    // releases _mutex to read further regions, so Clear() waits for
+    // this to drop to zero rather than only for _inFlight to empty.
+    //
+    int _activeReads;
+
     typedef struct {
-        size_t              ts;
-        string              varname;
-        int                 level;
-        int                 lod;
-        DimsType            bmin;
-        DimsType            bmax;
-        int                 lock_counter;
-        void *              blks;
-    } region_t;
-
-    // a list of all allocated regions
-    std::list<region_t> _regionsList;
+        size_t    ts;
+        string    varname;
+        int       level;
+        int       lod;
+        CoordType min;
+        CoordType max;
+    } prefetch_t;
+
+    // Pending prefetch reads, guarded by _prefetchMutex. _prefetchMutex
+    // may be acquired while owning _mutex, but not the other way around.
+    //
+    std::deque<prefetch_t>  _prefetchQueue;
+    std::mutex              _prefetchMutex;
+    std::condition_variable _prefetchCV;
+    bool                    _prefetchStop;
+    bool                    _prefetchBusy;    // a read is in progress
+    std::thread             _prefetchThread;
+
+    // Time steps whose regions the prefetch thread may not evict, and
+    // prefetch counters. Both guarded by _mutex
+    //
+    std::set<size_t> _prefetchProtected;
+    PrefetchStats    _prefetchStats;
 
     VAPoR::BlkMemMgr *_blk_mem_mgr;
 
@@ -741,6 +926,10 @@ protected:
     mutable VarInfoCache<double> _varInfoCacheDouble;
     mutable VarInfoCache<void *> _varInfoCacheVoidPtr;
 
+    // Per variable change counters. See GetVarVersion()
+    //
+    std::map<string, unsigned long> _varVersions;
+
     std::map<string, BlkExts> _blkExtsCache;
 
     std::map<const Grid *, vector<float *>> _lockedFloatBlks;
@@ -809,6 +998,12 @@ protected:
 
     VAPoR::Grid *_getVariable(size_t ts, string varname, int level, int lod, DimsType min, DimsType max, bool lock, bool dataless);
 
+    // Return the values of varname if they are held in memory by the
+    // data collection and can be used in place for the region min, max
+    // at dims. Otherwise return NULL
+    //
+    float *_getInPlaceData(string varname, const DimsType &min, const DimsType &max, const DimsType &dims) const;
+
     int _parseOptions(vector<string> &options);
 
     template<typename T> T *_get_region_from_cache(size_t ts, string varname, int level, int lod, const DimsType &bmin, const DimsType &bmax, bool lock);
@@ -840,6 +1035,11 @@ protected:
     bool _free_lru();
     void _free_var(string varname);
 
+    bool _isPrefetchThread() const { return (std::this_thread::get_id() == _prefetchThread.get_id()); }
+    void _prefetchLoop();
+    void _prefetch(const prefetch_t &p);
+    void _stopPrefetch();
+
     int _level_correction(string varname, int &level) const;
     int _lod_correction(string varname, int &lod) const;
 
@@ -874,6 +1074,7 @@ protected:
     bool _getVarConnVars(string varname, string &face_node_var, string &node_face_var, string &face_edge_var, string &face_face_var, string &edge_node_var, string &edge_face_var) const;
 
     DerivedVar *     _getDerivedVar(string varname) const;
+    unsigned long    _getVarVersion(string varname, int depth) const;
     DerivedDataVar * _getDerivedDataVar(string varname) const;
     DerivedCoordVar *_getDerivedCoordVar(string varname) const;
 
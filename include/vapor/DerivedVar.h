@@ -1,5 +1,8 @@
 #include <iostream>
 #include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <vapor/DC.h>
 #include <vapor/MyBase.h>
 #include <vapor/Proj4API.h>
@@ -250,7 +253,55 @@ public:
 //!
 class VDF_API DerivedCoordVar_PCSFromLatLon : public DerivedCoordVar {
 public:
-    DerivedCoordVar_PCSFromLatLon(string derivedVarName, DC *dc, std::vector<string> inNames, string proj4String, bool uGridFlag, bool lonFlag);
+    //! \class ProjCache
+    //!
+    //! \brief Projected coordinates shared by a PCS X and Y variable pair
+    //!
+    //! Projecting a region of lat-lon coordinates produces both the X and
+    //! the Y PCS coordinates. An X and a Y variable constructed with the
+    //! same ProjCache pass the coordinate that they computed but did not
+    //! return to each other, so that each region is read and projected
+    //! only once. A cached region is discarded once it has been used, or
+    //! when the cache is full.
+    //
+    class VDF_API ProjCache {
+    public:
+        //! \param[in] max_regions Maximum number of regions held
+        //
+        ProjCache(size_t max_regions = 2) : _maxRegions(max_regions) {}
+
+        //! Copy a cached coordinate into \p region and discard it
+        //!
+        //! \retval status Returns true if the \p lonFlag coordinate of the
+        //! region was in the cache
+        //
+        bool Get(size_t ts, int lod, const std::vector<size_t> &min, const std::vector<size_t> &max, bool lonFlag, float *region);
+
+        //! Add the \p lonFlag coordinate of a region to the cache
+        //
+        void Put(size_t ts, int lod, const std::vector<size_t> &min, const std::vector<size_t> &max, bool lonFlag, std::vector<float> &coords);
+
+    private:
+        class entry_t {
+        public:
+            size_t              ts;
+            int                 lod;
+            std::vector<size_t> min;
+            std::vector<size_t> max;
+            bool                lonFlag;
+            std::vector<float>  coords;
+        };
+
+        std::mutex         _mutex;
+        std::list<entry_t> _regions;
+        size_t             _maxRegions;
+    };
+
+    //! \param[in] projCache Cache shared with the variable for the other
+    //! horizontal axis. May be NULL.
+    //
+    DerivedCoordVar_PCSFromLatLon(string derivedVarName, DC *dc, std::vector<string> inNames, string proj4String, bool uGridFlag, bool lonFlag,
+                                  std::shared_ptr<ProjCache> projCache = nullptr);
     virtual ~DerivedCoordVar_PCSFromLatLon() {}
 
     virtual int Initialize();
@@ -272,18 +323,19 @@ public:
     virtual bool VariableExists(size_t ts, int reflevel, int lod) const;
 
 private:
-    DC *                _dc;
-    string              _proj4String;
-    string              _lonName;
-    string              _latName;
-    string              _xCoordName;
-    string              _yCoordName;
-    bool                _make2DFlag;
-    bool                _uGridFlag;
-    bool                _lonFlag;
-    std::vector<size_t> _dimLens;
-    Proj4API            _proj4API;
-    DC::CoordVar        _coordVarInfo;
+    DC *                       _dc;
+    string                     _proj4String;
+    string                     _lonName;
+    string                     _latName;
+    string                     _xCoordName;
+    string                     _yCoordName;
+    bool                       _make2DFlag;
+    bool                       _uGridFlag;
+    bool                       _lonFlag;
+    std::vector<size_t>        _dimLens;
+    Proj4API                   _proj4API;
+    DC::CoordVar               _coordVarInfo;
+    std::shared_ptr<ProjCache> _projCache;
 
     int _setupVar();
 
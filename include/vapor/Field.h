@@ -41,6 +41,15 @@ public:
     virtual int GetVelocity(double time, const glm::vec3 &pos,    // input
                             glm::vec3 &vel) const = 0;            // output
 
+    //
+    // Get the velocity values at n positions, each at its own time.
+    // The return code for position i is stored in rvs[i], and is the same
+    // as GetVelocity() would return for that position.
+    // The default implementation simply calls GetVelocity() n times.
+    //
+    virtual void GetVelocities(size_t n, const double *times, const glm::vec3 *pos,    // input
+                               glm::vec3 *vels, int *rvs) const;                        // output
+
     //
     // Returns the number of empty velocity variable names.
     // It is 3 when the object is newly created, or is used to represent a scalar field
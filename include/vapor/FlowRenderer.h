@@ -107,7 +107,7 @@ private:
     int       _renderAdvection(const flow::Advection *adv);
     int       _renderAdvectionHelper(bool renderDirection = false);
     void      _prepareColormap(FlowParams *);
-    void      _particleHelper1(std::vector<float> &vec, const flow::Particle &p, bool singleColor) const;
+    void      _particleHelper1(std::vector<float> &vec, const flow::ParticleStream &stream, size_t i, bool singleColor) const;
     int       _drawALineStrip(const float *buf, size_t numOfParts, bool singleColor) const;
     void      _restoreGLState() const;
     glm::vec3 _getScales();
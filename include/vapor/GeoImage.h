@@ -103,6 +103,14 @@ protected:
 
     int TiffReadImage(int dirnum, unsigned char *texture) const;
 
+    // Open the TIFF file \p path, read the image at directory \p dirnum,
+    // and close the file. The file is accessed through its own handle, and
+    // no error messages are reported, so multiple threads may read
+    // different files concurrently. However, the TIFF library's error
+    // handler is global and should be disabled while they do.
+    //
+    static int TiffReadImage(string path, int dirnum, unsigned char *texture);
+
     TIFF *TiffGetHandle() const { return (_tif); }
 
     int CornerExtents(const double srccoords[4], double dstcoords[4], string proj4src) const;
@@ -11,6 +11,7 @@
 #endif
 #include <sstream>
 #include <fstream>
+#include <vector>
 #include <sys/stat.h>
 #include <vapor/MyBase.h>
 #include <vapor/UDUnitsClass.h>
@@ -23,6 +24,10 @@ namespace VAPoR {
 //! \brief A class for managing OSGeo Tile Map Service Specification images
 //! \author John Clyne
 //!
+//! Tiles read from the TMS are kept in a least recently used cache of
+//! bounded size. When a map is requested, the missing tiles covering it,
+//! along with a halo one tile wide around it, are read and decoded
+//! in parallel.
 //
 class RENDER_API GeoImageTMS : public GeoImage {
 public:
@@ -33,6 +38,18 @@ public:
 
     void SetLOD(int lod);
 
+    //! Set the maximum size of the tile cache
+    //!
+    //! Set the maximum size, in bytes, of the memory used to cache
+    //! image tiles. The least recently used tiles are discarded once
+    //! the cache grows beyond \p size. The tiles needed for a single
+    //! image are always retained while the image is constructed, even if
+    //! they exceed \p size.
+    //!
+    //! The default size is 256MB
+    //
+    void SetTileCacheSize(size_t size);
+
     unsigned char *GetImage(size_t ts, size_t &width, size_t &height);
 
     unsigned char *GetImage(size_t ts, const double pcsExtentsReq[4], string proj4StringReq, size_t maxWidthReq, size_t maxHeightReq, double pcsExtentsImg[4], double geoCornersImg[8],
@@ -46,8 +63,8 @@ private:
     unsigned char *_texture;    // storage for texture image
     size_t         _textureSize;
 
-    unsigned char *_tileBuf;    // storage for a single tile
-    size_t         _tileBufSize;
+    std::vector<unsigned char> _tileBuf;          // storage for a batch of decoded tiles
+    size_t                     _tileCacheSize;    // maximum size of _geotile's tiles in bytes
 
     GeoTileMercator *_geotile;
 
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <map>
+#include <list>
 #ifdef _WINDOWS
     #pragma warning(disable : 4251)
 #endif
@@ -140,10 +141,31 @@ public:
     //! to it is returned. If the tile does not exist (or if \p quadkey is
     //! not a valid key), the NULL pointer is returned
     //!
-    //! \sa Insert()
+    //! \note Returning a tile marks it as the most recently used tile.
+    //!
+    //! \sa Insert(), Evict()
     //
     const unsigned char *GetTile(std::string quadkey) const;
 
+    //! Return the number of image tiles contained in the class
+    //
+    size_t GetNumTiles() const { return (_tiles.size()); }
+
+    //! Return the total size in bytes of the image tiles contained in the class
+    //
+    size_t GetTilesSize() const { return (_tiles.size() * _tile_width * _tile_height * _pixel_size); }
+
+    //! Discard the least recently used image tiles
+    //!
+    //! Tiles are discarded, least recently used (see Insert() and GetTile())
+    //! first, until the total size of the remaining tiles does not exceed
+    //! \p maxSize bytes. Pointers previously returned by GetTile() for
+    //! discarded tiles become invalid.
+    //!
+    //! \param[in] maxSize Maximum size in bytes of the retained tiles
+    //
+    void Evict(size_t maxSize);
+
     //! Return a pointer to an image tile
     //!
     //! This method returns a pointer to the image tile associated with
@@ -271,8 +293,16 @@ public:
     void LatLongRectToPixelRect(const double geoSW[2], const double geoNE[2], int lod, size_t pixelSW[2], size_t pixelNE[2]) const;
 
 private:
-    size_t                                 _pixel_size;
-    std::map<std::string, unsigned char *> _tiles;
+    // A tile image, and its position in the LRU list
+    //
+    struct tile_t {
+        unsigned char *                  _image;
+        std::list<std::string>::iterator _lru;
+    };
+
+    size_t                         _pixel_size;
+    std::map<std::string, tile_t>  _tiles;
+    mutable std::list<std::string> _lru;    // Most recently used tile first
 
     void _CopyTileToMap(const unsigned char *tile, size_t tilePixelX0, size_t tilePixelY0, size_t tilePixelX1, size_t tilePixelY1, unsigned char *map, size_t pixelX0, size_t pixelX1, size_t nx,
                         size_t ny) const;
@@ -272,6 +272,28 @@ public:
         return (GetValue(coords));
     }
 
+    //! Get the reconstructed values of the sampled scalar function at
+    //! many points
+    //!
+    //! The value returned for each point is the value that GetValue() would
+    //! return. Grids that can reconstruct many points faster than one at a
+    //! time, such as RegularGrid, StretchedGrid, and LayeredGrid, override
+    //! this method.
+    //!
+    //! \param[in] xyz An array of 3 * \p n user coordinates: the X, Y, and Z
+    //! coordinates of each point in turn. Z is ignored if the geometry
+    //! dimension of the grid is two.
+    //! \param[in] n The number of points
+    //! \param[out] values An array of \p n reconstructed values
+    //!
+    //! \sa GetValue()
+    //
+    virtual void GetValues(const double *xyz, size_t n, float *values) const;
+
+    //! Same as above, but with single precision coordinates
+    //
+    void GetValues(const float *xyz, size_t n, float *values) const;
+
     //! Return the extents of the user coordinate system
     //!
     //! This pure virtual method returns min and max extents of
@@ -555,6 +577,90 @@ public:
         GetRange(min3, max3, range);
     }
 
+    //! Return the min, max, sum, and number of the non-missing data values
+    //!
+    //! This method reduces the data values of the grid points with indices
+    //! on or inside the box defined by \p min and \p max. Grid points whose
+    //! value is the missing value are ignored. Blocks are reduced in
+    //! parallel.
+    //!
+    //! \param[in] min Minimum indices of the box
+    //! \param[in] max Maximum indices of the box
+    //! \param[out] range[2] A two-element array containing the minimum
+    //! and maximum values, in that order. If \p count is zero both elements
+    //! are set to the missing value
+    //! \param[out] sum Sum of the values, accumulated in double precision
+    //! \param[out] count Number of values reduced
+    //!
+    //! \sa GetRange(), ForEachSpan()
+    //
+    virtual void GetStatistics(const DimsType &min, const DimsType &max, float range[2], double &sum, size_t &count) const;
+
+    //! Return the min, max, sum, and number of the non-missing data values
+    //! inside a box in user coordinates
+    //!
+    //! Same as above except that grid points are selected by their user
+    //! coordinates. A grid point is selected if it lies on or inside the
+    //! axis-aligned box defined by \p minu and \p maxu (see InsideBox). If
+    //! \p minu equals \p maxu all grid points are selected.
+    //
+    virtual void GetStatistics(const CoordType &minu, const CoordType &maxu, float range[2], double &sum, size_t &count) const;
+
+    //! Compute a histogram of the non-missing data values
+    //!
+    //! The interval [\p lo, \p hi] is divided into \p bins.size()
+    //! equal-width bins, the last of which includes \p hi. The count of
+    //! each bin is incremented by the number of values, at grid points with
+    //! indices on or inside the box defined by \p min and \p max, that
+    //! fall into the bin. Values outside of [\p lo, \p hi] are not counted.
+    //!
+    //! \param[in] min Minimum indices of the box
+    //! \param[in] max Maximum indices of the box
+    //! \param[in] lo Lower bound of the first bin
+    //! \param[in] hi Upper bound of the last bin
+    //! \param[in,out] bins The bins
+    //
+    virtual void GetHistogram(const DimsType &min, const DimsType &max, float lo, float hi, std::vector<long> &bins) const;
+
+    //! Visit the data values inside an index box as contiguous spans
+    //!
+    //! Data values are stored in blocks (see GetBlockSize()). This method
+    //! invokes \p visit once for each run of data values that are
+    //! contiguous in memory: the part of a row of a block, along the
+    //! fastest varying dimension, with indices on or inside the box defined
+    //! by \p min and \p max. Spans are visited in the same order as the
+    //! elements visited by cbegin(). Missing values are not skipped.
+    //!
+    //! \p visit is invoked as visit(const float *values, size_t n,
+    //! const DimsType &index), where \p n is the length of the span, and
+    //! \p index contains the indices of values[0].
+    //!
+    //! \param[in] min Minimum indices of the box
+    //! \param[in] max Maximum indices of the box, clamped to
+    //! GetDimensions() minus one
+    //!
+    //! \note Nothing is visited for dataless grids
+    //
+    template<typename Visitor> void ForEachSpan(const DimsType &min, const DimsType &max, Visitor visit) const
+    {
+        if (!_blks.size()) return;
+
+        DimsType cMax;
+        for (int i = 0; i < cMax.size(); i++) cMax[i] = std::min(max[i], _dims[i] - 1);
+
+        DimsType index;
+        for (index[2] = min[2]; index[2] <= cMax[2]; index[2]++) {
+            for (index[1] = min[1]; index[1] <= cMax[1]; index[1]++) {
+                index[0] = min[0];
+                while (index[0] <= cMax[0]) {
+                    size_t n = std::min(cMax[0] + 1, (index[0] / _bs[0] + 1) * _bs[0]) - index[0];
+                    visit(_spanPtr(index), n, index);
+                    index[0] += n;
+                }
+            }
+        }
+    }
+
     //! Return true if the specified point lies inside the grid
     //!
     //! This method can be used to determine if a point expressed in
@@ -1269,6 +1375,15 @@ protected:
 
     float TrilinearInterpolate(size_t i, size_t j, size_t k, const double xwgt, const double ywgt, const double zwgt) const;
 
+    // Same as AccessIJK() and TrilinearInterpolate(), but the data values
+    // are read directly from the blocks, and the bilinear interpolation of
+    // the two layers is vectorized. Results are identical as long as
+    // GetValueAtIndex() is not overridden.
+    //
+    float AccessIJKFast(size_t i, size_t j, size_t k) const;
+
+    float TrilinearInterpolateFast(size_t i, size_t j, size_t k, const double xwgt, const double ywgt, const double zwgt) const;
+
 private:
     DimsType             _dims;                   // dimensions of grid arrays
     DimsType             _bs = {{1, 1, 1}};       // dimensions of each block
@@ -1288,6 +1403,16 @@ private:
     mutable CoordType    _maxuCache = {{std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity()}};
 
     void _grid(const DimsType &dims, const DimsType &bs, const std::vector<float *> &blks, size_t topology_dimension);
+
+    void _getStatistics(const DimsType &min, const DimsType &max, float range[2], double &sum, size_t &count) const;
+
+    // Address of the data value at \p indices, which must not be out of bounds
+    //
+    const float *_spanPtr(const DimsType &indices) const
+    {
+        const float *blk = _blks[(indices[2] / _bs[2]) * _bdims[0] * _bdims[1] + (indices[1] / _bs[1]) * _bdims[0] + (indices[0] / _bs[0])];
+        return (&blk[(indices[2] % _bs[2]) * _bs[0] * _bs[1] + (indices[1] % _bs[1]) * _bs[0] + (indices[0] % _bs[0])]);
+    }
 };
 
 template void Grid::CopyToArr3<size_t>(const std::vector<size_t> &src, std::array<size_t, 3> &dst);
@@ -18,13 +18,50 @@
 namespace VAPoR {
 
 class UnstructuredGrid3D;
+class CellBVH;
 
 class VDF_API GridHelper : public Wasp::MyBase {
 public:
-    GridHelper(size_t max_size = 10) : _qtrCache(max_size) {}
+    //! Construct a grid helper
+    //!
+    //! The on-disk point location index cache directory is initialized
+    //! from the VAPOR_INDEX_CACHE_DIR environment variable, if set.
+    //!
+    //! \param[in] max_size Maximum number of point location indexes kept
+    //! in memory
+    //!
+    //! \sa SetIndexCacheDir(), SetIndexCacheSize()
+    //
+    GridHelper(size_t max_size = 10);
 
     ~GridHelper();
 
+    //! Set the directory of the on-disk point location index cache
+    //!
+    //! Building the quad trees used to locate points in curvilinear and
+    //! unstructured 2D or layered grids is expensive. If a cache
+    //! directory is set, each tree that is built is also written to a
+    //! file in \p dir, named after a hash of the coordinate and
+    //! connectivity data it was built from. When a tree is needed that is
+    //! not in memory, a matching file is read instead of building the tree.
+    //! The directory is created when the first tree is written.
+    //!
+    //! \param[in] dir Cache directory. An empty string disables the on-disk
+    //! cache.
+    //
+    void SetIndexCacheDir(const string &dir) { _indexCacheDir = dir; }
+
+    string GetIndexCacheDir() const { return (_indexCacheDir); }
+
+    //! Set the maximum number of point location indexes kept in memory
+    //!
+    //! Least recently used indexes are discarded if the cache already
+    //! holds more than \p max_size entries.
+    //!
+    //! \param[in] max_size Maximum number of cached indexes of each type
+    //
+    void SetIndexCacheSize(size_t max_size);
+
     string GetGridType(const DC::Mesh &m, const std::vector<DC::CoordVar> &cvarsinfo, const std::vector<vector<string>> &cdimnames) const;
 
     bool IsUnstructured(std::string gridType) const;
@@ -104,6 +141,12 @@ private:
 
         bool exists(const key_t &key) const;
 
+        void set_max_size(size_t max_size)
+        {
+            _max_size = max_size;
+            while (_cache_items_map.size() > _max_size) (void)remove_lru();
+        }
+
         size_t size() const { return _cache_items_map.size(); }
 
     private:
@@ -113,6 +156,13 @@ private:
     };
 
     lru_cache<string, std::shared_ptr<const QuadTreeRectangleP>> _qtrCache;
+    lru_cache<string, std::shared_ptr<const CellBVH>>            _bvhCache;
+    string                                                       _indexCacheDir;
+
+    // Memory regions (address, size in bytes) holding the data a point
+    // location index is built from
+    //
+    typedef std::vector<std::pair<const void *, size_t>> regions_t;
 
     RegularGrid *_make_grid_regular(const DimsType &dims, const std::vector<float *> &blkvec, const DimsType &bs, const DimsType &bmin, const DimsType &bmax
 
@@ -144,6 +194,10 @@ private:
     void _makeGridHelper(const DC::DataVar &var, const DimsType &roi_dims, const DimsType &dims, Grid *g) const;
 
     string _getQuadTreeRectangleKey(size_t ts, int level, int lod, const vector<DC::CoordVar> &cvarsinfo, const DimsType &bmin, const DimsType &bmax) const;
+
+    std::shared_ptr<const QuadTreeRectangleP> _getQuadTreeRectangle(const string &key, const regions_t &regions, string &path);
+
+    void _putQuadTreeRectangle(const string &key, const string &path, std::shared_ptr<const QuadTreeRectangleP> qtr);
 };
 
 };    // namespace VAPoR
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <vector>
+#include <vapor/common.h>
+#include <vapor/Grid.h>
+
+namespace VAPoR {
+
+//
+//! \class GridStatistics
+//! \brief Accumulates summary statistics of grid values
+//!
+//! This class computes the count, range, mean, variance, and quantiles
+//! (e.g. the median) of the values of one or more grids in a single
+//! pass over each grid. Values are visited in parallel, a block of the
+//! grid at a time.
+//!
+//! The mean and variance are accumulated in double precision. Each
+//! span of contiguous values is reduced with a two-pass method while it
+//! is in cache, and partial results are combined with Chan's pairwise
+//! formula, so they remain accurate for large grids and for data with a
+//! large mean.
+//!
+//! Quantiles are estimated from a fixed number of histogram bins, so
+//! memory use does not grow with the number of values. Bins are
+//! power-of-two wide and aligned at multiples of their width, and the
+//! bin width is doubled whenever the values seen so far no longer fit,
+//! so no prior knowledge of the data range is required. A quantile is
+//! accurate to within one bin width, see GetBinWidth().
+//!
+//! Missing values, and values that are not finite, are ignored.
+//
+class VDF_API GridStatistics {
+public:
+    //! \param[in] nbins The number of histogram bins used to estimate
+    //! quantiles. Must be at least 2.
+    //
+    GridStatistics(size_t nbins = 8192);
+
+    //! Discard all accumulated values
+    //
+    void Clear();
+
+    //! Accumulate the values of a grid inside a box
+    //!
+    //! \param[in] grid The grid whose values are accumulated
+    //! \param[in] minu Minimum user coordinates of the selection box
+    //! \param[in] maxu Maximum user coordinates of the selection box. If
+    //! \p minu and \p maxu are equal all of the grid's values are
+    //! accumulated.
+    //!
+    //! \sa Grid::GetStatistics()
+    //
+    void Add(const Grid *grid, const CoordType &minu, const CoordType &maxu);
+
+    //! Accumulate an array of values
+    //!
+    //! \param[in] values The values
+    //! \param[in] n The number of elements of \p values
+    //! \param[in] mv Missing value. Elements equal to \p mv are ignored.
+    //
+    void Add(const float *values, size_t n, float mv);
+
+    //! Accumulate the values accumulated by another instance
+    //
+    void Merge(const GridStatistics &s);
+
+    //! Return the number of values accumulated
+    //
+    size_t GetCount() const { return (_moments.count); }
+
+    //! Return the smallest value accumulated, or zero if there are none
+    //
+    float GetMin() const { return (_moments.count ? _moments.lo : 0.0f); }
+
+    //! Return the largest value accumulated, or zero if there are none
+    //
+    float GetMax() const { return (_moments.count ? _moments.hi : 0.0f); }
+
+    //! Return the mean of the values accumulated
+    //
+    double GetMean() const { return (_moments.mean); }
+
+    //! Return the population variance of the values accumulated
+    //
+    double GetVariance() const { return (_moments.count ? _moments.m2 / _moments.count : 0.0); }
+
+    //! Return the population standard deviation of the values accumulated
+    //
+    double GetStddev() const;
+
+    //! Return an estimate of a quantile of the values accumulated
+    //!
+    //! The estimate is interpolated linearly within the histogram bin
+    //! containing the quantile, and lies within GetBinWidth() of the
+    //! exact value.
+    //!
+    //! \param[in] q The quantile, in the range [0.0, 1.0]. 0.5 is the
+    //! median.
+    //!
+    //! \retval value The estimated quantile, or zero if no values have
+    //! been accumulated
+    //
+    float GetQuantile(double q) const;
+
+    //! Return the width of the histogram bins used to estimate quantiles
+    //
+    double GetBinWidth() const;
+
+private:
+    // Count, range, mean, and sum of squared differences from the mean
+    //
+    class moments_t {
+    public:
+        size_t count = 0;
+        float  lo = 0.0f;
+        float  hi = 0.0f;
+        double mean = 0.0;
+        double m2 = 0.0;
+
+        void merge(const moments_t &m);
+    };
+
+    size_t    _nbins;
+    moments_t _moments;
+
+    // Histogram bin i counts the values v with
+    // floor(v / 2^_exp) == _offset + i. The bins are allocated with
+    // the first value. _binLo and _binHi are the range of values counted
+    //
+    std::vector<size_t> _bins;
+    int                 _exp;
+    long long           _offset;
+    float               _binLo;
+    float               _binHi;
+
+    void _fit(float lo, float hi, int minExp);
+    void _addSpan(const float *values, size_t n, float mv, moments_t &m);
+    void _mergeBins(const GridStatistics &s);
+};
+};    // namespace VAPoR
@@ -61,6 +61,15 @@ public:
     //!
     float GetValue(const CoordType &coords) const override;
 
+    //! \copydoc Grid::GetValues()
+    //
+    virtual void GetValues(const double *xyz, size_t n, float *values) const override;
+
+    // For grandparent inheritance of
+    // Grid::GetValues(const float *xyz, size_t n, float *values)
+    //
+    using Grid::GetValues;
+
     //! \copydoc Grid::GetInterpolationOrder()
     //
     virtual int GetInterpolationOrder() const override { return _interpolationOrder; };
@@ -262,6 +271,14 @@ private:
     double _interpolateVaryingCoord(size_t i0, size_t j0, size_t k0, double x, double y) const;
 
     bool _insideGrid(const CoordType &coords, DimsType &indices, double wgts[3]) const;
+
+    // Same as above, with a caller provided buffer for the Z coordinates
+    // of the column of cells searched
+    //
+    bool _insideGrid(const CoordType &coords, DimsType &indices, double wgts[3], std::vector<double> &zcoords) const;
+
+    float _getValueNearestNeighbor(const CoordType &coords, std::vector<double> &zcoords) const;
+    float _getValueLinear(const CoordType &coords, std::vector<double> &zcoords) const;
 };
 };    // namespace VAPoR
 #endif
@@ -23,6 +23,8 @@
 #ifndef MAPPERFUNCTION_H
 #define MAPPERFUNCTION_H
 
+#include <vector>
+#include <mutex>
 #include <vapor/OpacityMap.h>
 #include <vapor/ColorMap.h>
 #include <vapor/TFInterpolator.h>
@@ -110,12 +112,26 @@ public:
     //! Build a color/opacity lookup table.
     //! Caller must supply an array to be filled in.
     //! Each entry isa 4-tuple: r,g,b,opacity.
+    //! The table is cached, and only recomputed after the mapper
+    //! function, its color map, or its opacity maps have changed.
     //! \param[out] clut lookup table of size _numEntries*4
     void makeLut(float *clut) const;
 
     void makeLut(std::vector<float> &clut) const;
     std::vector<float> makeLut() const;
 
+    //! Map an array of data values to colors and opacities
+    //!
+    //! Each value is quantized to the nearest entry of the lookup table
+    //! built by makeLut(), as with mapFloatToIndex(), and the entry is
+    //! written as four bytes: r,g,b,opacity, each scaled to [0,255].
+    //! Values outside of the mapping range are clamped to it. NaNs are
+    //! mapped to the first entry.
+    //! \param[in] values data values
+    //! \param[in] n number of elements of \p values
+    //! \param[out] rgba colors and opacities, of size n*4
+    void MapValues(const float *values, size_t n, unsigned char *rgba) const;
+
     //! Obtain minimum mapping (histo) value
     //! \return Minimum mapping value
     float getMinMapValue() const { return (getMinMaxMapValue()[0]); };
@@ -298,6 +314,17 @@ private:
     ParamsContainer *m_opacityMaps;
     ColorMap *       m_colorMap;
 
+    // Cached lookup tables, as floats and as bytes, and the generation of
+    // the node they were computed from. Zero if they have not been
+    // computed. All guarded by _lutMutex
+    //
+    mutable std::vector<float>         _lut;
+    mutable std::vector<unsigned char> _lut8;
+    mutable unsigned long              _lutGeneration;
+    mutable std::mutex                 _lutMutex;
+
+    void _updateLut() const;
+
     //!
     //! Map a point to the specified range, and quantize it.
     //! \param[in] x point value
@@ -36,6 +36,15 @@ public:
 
     float opacityDataAtNorm(float nv) const;
     float opacityData(float value) const;
+
+    //! Compute the opacities of an array of values (data coordinates)
+    //!
+    //! Equivalent to calling opacityData(float) for each of the \p n
+    //! elements of \p values, but the control points and settings of the
+    //! opacity map are only read once.
+    //
+    void opacityData(const float *values, size_t n, float *opacities) const;
+
     bool  inDataBounds(float value) const;
 
     void SetType(OpacityMap::Type type);
@@ -92,7 +101,24 @@ public:
     static string GetClassType() { return ("OpacityMapParams"); }
 
 private:
-    int leftControlIndex(float val) const;
+    // The settings that determine the opacity at a value
+    //
+    class shape_t {
+    public:
+        vector<double>       cps;
+        OpacityMap::Type     type;
+        TFInterpolator::type interpType;
+        double               mean;
+        double               ssq;
+        double               freq;
+        double               phase;
+    };
+
+    shape_t      getShape() const;
+    static float opacityDataAtNorm(const shape_t &shape, float nv);
+
+    int        leftControlIndex(float val) const;
+    static int leftControlIndex(const vector<double> &cps, float val);
 
     double normSSq(double ssq);
     double denormSSq(double ssq);
@@ -133,27 +133,37 @@ public:
 
     XmlNode *GetNode() const { return _node; }
 
+    //! Return the generation of the params
+    //!
+    //! The generation changes whenever the params, or any of their
+    //! children, are modified. Anything derived from the params remains
+    //! valid for as long as their generation is unchanged.
+    //!
+    //! \sa XmlNode::GetGeneration()
+    //
+    unsigned long GetGeneration() const { return (_node->GetGeneration()); }
+
     void BeginGroup(const string &description) { _ssave->BeginGroup(description); }
     void EndGroup() { _ssave->EndGroup(); }
     void IntermediateChange() { _ssave->IntermediateChange(); }
 
-    virtual vector<long> GetValueLongVec(const string tag) const;
+    virtual vector<long> GetValueLongVec(const string &tag) const;
 
-    virtual vector<long> GetValueLongVec(const string tag, const vector<long> &defaultVal) const;
+    virtual vector<long> GetValueLongVec(const string &tag, const vector<long> &defaultVal) const;
 
-    virtual long GetValueLong(const string tag, long defaultVal) const;
+    virtual long GetValueLong(const string &tag, long defaultVal) const;
 
-    virtual vector<double> GetValueDoubleVec(const string tag) const;
+    virtual vector<double> GetValueDoubleVec(const string &tag) const;
 
-    virtual vector<double> GetValueDoubleVec(const string tag, const vector<double> &defaultVal) const;
+    virtual vector<double> GetValueDoubleVec(const string &tag, const vector<double> &defaultVal) const;
 
-    virtual double GetValueDouble(const string tag, double defaultVal) const;
+    virtual double GetValueDouble(const string &tag, double defaultVal) const;
 
-    virtual vector<string> GetValueStringVec(const string tag) const;
+    virtual vector<string> GetValueStringVec(const string &tag) const;
 
-    virtual vector<string> GetValueStringVec(const string tag, const vector<string> &defaultVal) const;
+    virtual vector<string> GetValueStringVec(const string &tag, const vector<string> &defaultVal) const;
 
-    virtual string GetValueString(const string tag, string defaultVal) const;
+    virtual string GetValueString(const string &tag, string defaultVal) const;
 
     virtual void SetValueLongVec(const string &tag, string description, const vector<long> &values);
 
@@ -29,6 +29,7 @@
 
 #include <vapor/DataMgr.h>
 #include <vapor/ParamsBase.h>
+#include <vapor/XmlNodeDelta.h>
 #include <vapor/RenderParams.h>
 #include <vapor/ViewpointParams.h>
 #include <vapor/regionparams.h>
@@ -539,6 +540,7 @@ private:
         void Reinit(const XmlNode *rootNode)
         {
             _rootNode = rootNode;
+            _synced.clear();
             emitStateChange();
         }
 
@@ -568,7 +570,7 @@ private:
         bool GetUndoEnabled() const { return _addToUndoEnabled; }
 
         const XmlNode *GetTopUndo(string &description) const;
-        const XmlNode *GetTopRedo(string &description) const;
+        bool           GetTopRedo(string &description) const;
         const XmlNode *GetBase() const { return (_state0); }
 
         bool Undo();
@@ -584,21 +586,41 @@ private:
         void RegisterIntermediateStateChangeCB(std::function<void()> callback) { _intermediateStateChangeCBs.push_back(callback); }
 
     private:
+        // An undo step. The changes made by the step, or, for the step
+        // whose undo returns to the base state, _state0, the state after
+        // the step. The base state need not be the state before the step
+        //
+        class step_t {
+        public:
+            string        description;
+            XmlNodeDelta *delta;
+            XmlNode *     state;
+        };
+
         bool           _enabled;
         bool           _addToUndoEnabled = true;
         int            _stackSize;
         const XmlNode *_rootNode;
         const XmlNode *_state0;
 
-        std::stack<string>                       _groups;
-        std::deque<std::pair<string, XmlNode *>> _undoStack;
-        std::deque<std::pair<string, XmlNode *>> _redoStack;
+        // The state after the step at the top of the undo stack, or the
+        // base state if the undo stack is empty. _synced tracks which
+        // nodes of the tree rooted at _rootNode are unchanged since
+        // they were copied to _state
+        //
+        XmlNode *             _state;
+        XmlNodeDelta::SyncMap _synced;
+
+        std::stack<string> _groups;
+        std::deque<step_t> _undoStack;
+        std::deque<step_t> _redoStack;
 
         std::vector<bool *>                _stateChangeFlags;
         std::vector<std::function<void()>> _stateChangeCBs;
         std::vector<std::function<void()>> _intermediateStateChangeCBs;
 
-        void cleanStack(int maxN, std::deque<std::pair<string, XmlNode *>> &s);
+        bool pushUndo(string description);
+        void cleanStack(int maxN, std::deque<step_t> &s);
         void emitStateChange();
         void emitIntermediateStateChange();
     };
@@ -7,7 +7,6 @@
 
 #include "vapor/common.h"
 #include <glm/glm.hpp>
-#include <forward_list>
 
 namespace flow {
 enum FLOW_ERROR_CODE    // these enum values are available in the flow namespace.
@@ -28,6 +27,8 @@ enum FLOW_ERROR_CODE    // these enum values are available in the flow namespace
 };
 
 // Particle is not expected to serve as a base class.
+// Particles that belong to a trajectory are kept in a ParticleStream, which
+// also holds any properties associated with them.
 class FLOW_API Particle final {
 public:
     glm::vec3 location = {0.0f, 0.0f, 0.0f};
@@ -40,28 +41,9 @@ public:
     Particle(const glm::vec3 &loc, double t, float val = 0.0f);
     Particle(float x, float y, float z, double t, float val = 0.0f);
 
-    //
-    // The "property" field allows the user to keep one or more arbitrary values that
-    // are associated with this particle. It's up to the user to keep a record on
-    // what these values at each index stand for.
-    //
-    void AttachProperty(float v);
-    void ClearProperty();
-    // Remove the property at a certain index.
-    // If the index is out of bound, then nothing is performed
-    void RemoveProperty(size_t i);
-
-    auto GetPropertyList() const -> const std::forward_list<float> &;
-
     // A particle could be set to be at a special state.
     void SetSpecial(bool isSpecial);
     bool IsSpecial() const;
-
-private:
-    std::forward_list<float> _properties;
-    // Note on the choice of using a forward_list:
-    // Forward_list takes 8 bytes, whereas a vector or list take 24 bytes!
-    // Fun fact: the end() iterator of a forward_list is the nullptr.
 };
 
 };    // namespace flow
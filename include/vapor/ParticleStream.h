@@ -0,0 +1,85 @@
+/*
+ * Defines a stream of particles, i.e., the trajectory of a single seed,
+ * stored as a structure of arrays.
+ */
+
+#ifndef PARTICLESTREAM_H
+#define PARTICLESTREAM_H
+
+#include "vapor/Particle.h"
+#include <cmath>
+#include <vector>
+
+namespace flow {
+
+//
+// Locations, times, values, and each property of the particles in a stream
+// are kept in separate contiguous arrays. A property is a column with one
+// entry per particle, so attaching a property to every particle of a stream
+// costs a single allocation instead of one per particle.
+//
+// A particle in a "special" state (see Particle::SetSpecial()) is a separator
+// that breaks a stream into segments. Its property entries are nan.
+//
+class FLOW_API ParticleStream final {
+public:
+    // This class complies with rule of zero.
+    ParticleStream() = default;
+
+    size_t GetNumOfParticles() const { return _times.size(); }
+    bool   IsEmpty() const { return _times.empty(); }
+    void   Reserve(size_t n);
+    // Remove all particles and all properties.
+    void Clear();
+
+    // Append a particle, or insert one before the particle at index i.
+    // Property entries of the new particle are nan.
+    void PushBack(const Particle &p);
+    void Insert(size_t i, const Particle &p);
+
+    // Get or set the location, time, and value of the particle at index i.
+    // Setting a particle leaves its properties untouched.
+    Particle GetParticle(size_t i) const { return Particle(_locations[i], _times[i], _values[i]); }
+    void     SetParticle(size_t i, const Particle &p);
+
+    const glm::vec3 &GetLocation(size_t i) const { return _locations[i]; }
+    double           GetTime(size_t i) const { return _times[i]; }
+    float            GetValue(size_t i) const { return _values[i]; }
+    void             SetLocation(size_t i, const glm::vec3 &loc) { _locations[i] = loc; }
+    void             SetValue(size_t i, float v) { _values[i] = v; }
+
+    bool IsSpecial(size_t i) const { return (std::isnan(_times[i]) && std::isnan(_values[i])); }
+    void SetSpecial(size_t i, bool isSpecial);
+
+    // Contiguous arrays of GetNumOfParticles() elements.
+    const glm::vec3 *GetLocations() const { return _locations.data(); }
+    const double *   GetTimes() const { return _times.data(); }
+    const float *    GetValues() const { return _values.data(); }
+    float *          GetValues() { return _values.data(); }
+
+    //
+    // Properties are arbitrary values associated with each particle. It's up to
+    // the user to keep a record on what the property at each index stands for.
+    //
+    size_t GetNumOfProperties() const { return _properties.size(); }
+    // Add a property filled with nan, and return its index.
+    size_t AddProperty();
+    // Remove the property at a certain index.
+    // If the index is out of bound, then nothing is performed
+    void RemoveProperty(size_t i);
+    void ClearProperties();
+
+    // Contiguous array of GetNumOfParticles() entries of property i.
+    const float *GetProperty(size_t i) const { return _properties[i].data(); }
+    float *      GetProperty(size_t i) { return _properties[i].data(); }
+
+private:
+    std::vector<glm::vec3>          _locations;
+    std::vector<double>             _times;
+    std::vector<float>              _values;
+    std::vector<std::vector<float>> _properties;    // one column per property
+};
+
+};    // namespace flow
+
+#endif
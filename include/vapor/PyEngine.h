@@ -1,4 +1,7 @@
 #include <vector>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <vapor/MyPython.h>
 #include <vapor/DataMgr.h>
 #include <vapor/DC.h>
@@ -160,7 +163,8 @@ public:
     //! \param[in] outputVarArrays A list of regions of memory for each
     //! output NumPy Array that will be copied out of the Python environment after
     //! executing \p script. The size of the region copied is given by the
-    //! dimensions in \p outputVarDims
+    //! dimensions in \p outputVarDims. The arrays are copied directly into
+    //! these regions, regardless of the memory layout of the NumPy Arrays.
     //!
     static int Calculate(const string &script, vector<string> inputVarNames, vector<DimsType> inputVarDims, vector<float *> inputVarArrays, vector<string> outputVarNames,
                          vector<DimsType> outputVarDims, vector<float *> outputVarArrays);
@@ -200,9 +204,34 @@ private:
         string GetScriptStdout() const { return (_stdoutString); }
 
     private:
+        // The output of one execution of the script, computed over the
+        // region [_minAbs, _minAbs + _dims) of the variable. Results are
+        // keyed by the script, the time step, refinement level and
+        // lod, and the versions of the input variables (see
+        // DataMgr::GetVarVersion()) at the time the script was run.
+        //
+        class result_c {
+        public:
+            size_t                     _scriptHash;
+            size_t                     _ts;
+            int                        _level;
+            int                        _lod;
+            std::vector<unsigned long> _inputVersions;
+            DimsType                   _minAbs;
+            DimsType                   _dims;
+            std::vector<float>         _data;
+
+            bool Contains(const DimsType &min, const DimsType &max) const;
+        };
+
+        // Maximum number of results retained by each variable
+        //
+        static const int _maxResults = 2;
+
         DC::DataVar         _varInfo;
         std::vector<string> _inNames;
         string              _script;
+        size_t              _scriptHash;
         DataMgr *           _dataMgr;
         bool                _coordFlag;
         DC::FileTable       _fileTable;
@@ -210,9 +239,22 @@ private:
         bool                _meshMatchFlag;
         string              _stdoutString;
 
+        // Most recently used results first, guarded by _resultsMutex
+        //
+        std::list<std::shared_ptr<const result_c>> _results;
+        std::mutex                                 _resultsMutex;
+
         int _readRegionAll(int fd, const DimsType &min, const DimsType &max, float *region);
 
         int _readRegionSubset(int fd, const DimsType &min, const DimsType &max, float *region);
+
+        int _runScript(const std::vector<Grid *> &variables, const DimsType &outDims, float *out);
+
+        std::shared_ptr<result_c> _newResult(size_t ts, int level, int lod) const;
+
+        std::shared_ptr<const result_c> _findResult(const result_c &key, const DimsType &min, const DimsType &max);
+
+        void _putResult(const std::shared_ptr<const result_c> &result);
     };
 
     class func_c {
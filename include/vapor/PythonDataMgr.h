@@ -15,7 +15,13 @@ public:
     PythonDataMgr(string format, size_t mem_size, int nthreads = 0);
     virtual ~PythonDataMgr();
     
-    void AddRegularData(string name, const float *buf, vector<int> dims);
+    //! Add a variable sampled on a regular grid
+    //!
+    //! If \p copy is false the values in \p buf are used in place, and
+    //! must remain valid and unmodified for as long as the variable
+    //! exists. See DCRAM::AddDataVarRef().
+    //
+    void AddRegularData(string name, const float *buf, vector<int> dims, bool copy = true);
     DCRAM *GetDC() const;
     void ClearCache(string varname);
 };
@@ -251,6 +251,95 @@ public:
         }
     }
 
+    //! Write the tree to a binary stream
+    //!
+    //! The tree is written in the native byte order of the host. The
+    //! payload type \p S must be trivially copyable.
+    //!
+    //! \param[in] os Output stream, which should be opened in binary mode
+    //!
+    //! \retval status Returns false if \p os could not be written
+    //!
+    //! \sa Read()
+    //
+    bool Write(std::ostream &os) const
+    {
+        uint64_t header[] = {_nodes.size(), _rootidx, _maxDepth};
+        os.write((const char *)header, sizeof(header));
+
+        for (size_t i = 0; i < _nodes.size() && os; i++) { _nodes[i].write(os); }
+        return ((bool)os);
+    }
+
+    //! Replace the tree with one read from a binary stream
+    //!
+    //! \param[in] is Input stream positioned at a tree written by Write()
+    //! on a host with the same byte order
+    //!
+    //! \retval status Returns false if a complete, consistent tree could not
+    //! be read from \p is, in which case the current tree is left unchanged
+    //!
+    //! \sa Write()
+    //
+    bool Read(std::istream &is)
+    {
+        uint64_t nbytes = BytesRemaining(is);
+        return (Read(is, nbytes));
+    }
+
+    //! Replace the tree with one read from a binary stream of known length
+    //!
+    //! This method is identical to Read(std::istream &) except that no
+    //! more than \p nbytes bytes are trusted to remain in \p is. Counts
+    //! read from a corrupt stream that would exceed \p nbytes are rejected
+    //! without allocating memory for them.
+    //!
+    //! \param[in,out] nbytes Number of bytes remaining in \p is. On
+    //! success, decremented by the number of bytes read.
+    //!
+    //! \sa BytesRemaining()
+    //
+    bool Read(std::istream &is, uint64_t &nbytes)
+    {
+        uint64_t header[3];
+        if (nbytes < sizeof(header)) return (false);
+        if (!is.read((char *)header, sizeof(header))) return (false);
+        nbytes -= sizeof(header);
+        if (header[0] == 0 || header[1] >= header[0]) return (false);
+
+        std::vector<node_t> nodes;
+        for (uint64_t i = 0; i < header[0]; i++) {
+            node_t node;
+            if (!node.read(is, header[0], nbytes)) return (false);
+            nodes.push_back(node);
+        }
+
+        _nodes.swap(nodes);
+        _rootidx = header[1];
+        _maxDepth = header[2];
+        return (true);
+    }
+
+    //! Return the number of bytes left in a stream
+    //!
+    //! Seeks to the end of \p is and back, so should be called once per
+    //! stream rather than once per read.
+    //!
+    //! \retval nbytes Bytes left in \p is, or the largest possible value
+    //! if \p is is not seekable
+    //
+    static uint64_t BytesRemaining(std::istream &is)
+    {
+        std::streampos pos = is.tellg();
+        if (pos < 0) return (std::numeric_limits<uint64_t>::max());
+
+        is.seekg(0, std::ios::end);
+        std::streampos end = is.tellg();
+        is.seekg(pos);
+        if (end < pos) return (0);
+        return ((uint64_t)(end - pos));
+    }
+
     friend std::ostream &operator<<(std::ostream &os, const QuadTreeRectangle &q)
     {
         os << "Num nodes : " << q._nodes.size() << std::endl;
@@ -387,6 +476,61 @@ private:
         const std::vector<S> &get_payloads() const { return (_payloads); }
         size_t                get_level() const { return (_level); }
 
+        void write(std::ostream &os) const
+        {
+            int32_t  level = _level;
+            uint8_t  is_leaf = _is_leaf;
+            uint64_t child0 = _child0;
+            uint64_t npayloads = _payloads.size();
+            T        bounds[] = {_rectangle._left, _rectangle._top, _rectangle._right, _rectangle._bottom};
+
+            os.write((const char *)&level, sizeof(level));
+            os.write((const char *)&is_leaf, sizeof(is_leaf));
+            os.write((const char *)&child0, sizeof(child0));
+            os.write((const char *)bounds, sizeof(bounds));
+            os.write((const char *)&npayloads, sizeof(npayloads));
+            if (npayloads) os.write((const char *)_payloads.data(), npayloads * sizeof(S));
+        }
+
+        // Read a node from a tree with nnodes nodes, checking that child
+        // indices are in range. nbytes is the number of bytes left in is,
+        // and is decremented by the number of bytes read
+        //
+        bool read(std::istream &is, uint64_t nnodes, uint64_t &nbytes)
+        {
+            int32_t  level;
+            uint8_t  is_leaf;
+            uint64_t child0;
+            uint64_t npayloads;
+            T        bounds[4];
+
+            const uint64_t headerSize = sizeof(level) + sizeof(is_leaf) + sizeof(child0) + sizeof(bounds) + sizeof(npayloads);
+            if (nbytes < headerSize) return (false);
+
+            is.read((char *)&level, sizeof(level));
+            is.read((char *)&is_leaf, sizeof(is_leaf));
+            is.read((char *)&child0, sizeof(child0));
+            is.read((char *)bounds, sizeof(bounds));
+            is.read((char *)&npayloads, sizeof(npayloads));
+            if (!is) return (false);
+            nbytes -= headerSize;
+            if (!is_leaf && child0 + 3 >= nnodes) return (false);
+
+            // Don't trust a corrupt count to size the allocation
+            //
+            if (npayloads > nbytes / sizeof(S)) return (false);
+
+            _payloads.resize(npayloads);
+            if (npayloads && !is.read((char *)_payloads.data(), npayloads * sizeof(S))) return (false);
+            nbytes -= npayloads * sizeof(S);
+
+            _level = level;
+            _is_leaf = is_leaf;
+            _child0 = child0;
+            _rectangle = rectangle_t(bounds[0], bounds[1], bounds[2], bounds[3]);
+            return (true);
+        }
+
     private:
         int            _level;
         bool           _is_leaf;
@@ -73,6 +73,33 @@ public:
     //
     void GetStats(std::vector<size_t> &payload_histo, std::vector<size_t> &level_histo) const;
 
+    //! Write the tree to a binary stream
+    //!
+    //! The serialized tree begins with a format identifier and version,
+    //! and is written in the native byte order of the host. It
+    //! can be restored with Read() by any number of threads: the subtree
+    //! partitioning used during construction is preserved.
+    //!
+    //! \param[in] os Output stream, which should be opened in binary mode
+    //!
+    //! \retval status Returns false if \p os could not be written
+    //!
+    //! \sa Read()
+    //
+    bool Write(std::ostream &os) const;
+
+    //! Replace the tree with one read from a binary stream
+    //!
+    //! \param[in] is Input stream positioned at a tree written by Write()
+    //!
+    //! \retval status Returns false if \p is does not contain a complete
+    //! tree in the current format version with the host byte order, in which
+    //! case the current tree is left unchanged
+    //!
+    //! \sa Write()
+    //
+    bool Read(std::istream &is);
+
     friend std::ostream &operator<<(std::ostream &os, const QuadTreeRectangleP &q)
     {
         for (int i = 0; i < q._qtrs.size(); i++) {
@@ -0,0 +1,182 @@
+#ifndef _RegionCache_h_
+#define _RegionCache_h_
+
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+#include <functional>
+#include <vapor/common.h>
+#include <vapor/Grid.h>
+
+namespace VAPoR {
+
+//
+//! \class RegionCache
+//! \brief Bookkeeping for the regions of variable data held in memory by
+//! the DataMgr
+//! \author John Clyne
+//!
+//! This class indexes blocked regions of variable data by the tuple
+//! (time step, variable name, refinement level, lod, block min, block max).
+//! Lookup, least-recently-used promotion, locking and unlocking are all
+//! constant time operations. Secondary indexes support removal of all
+//! regions belonging to a variable or to a time step.
+//!
+//! Regions may be locked multiple times. A locked region is never
+//! returned by EvictLRU().
+//!
+//! The class does not own the memory referenced by a region. Methods that
+//! remove regions from the cache return the region's memory pointer
+//! so that the caller may free it.
+//
+class VDF_API RegionCache {
+public:
+    //! Key uniquely identifying a cached region
+    //
+    class Key {
+    public:
+        Key() : ts(0), level(0), lod(0), bmin({{0, 0, 0}}), bmax({{0, 0, 0}}) {}
+        Key(size_t ts_, const std::string &varname_, int level_, int lod_, const DimsType &bmin_, const DimsType &bmax_)
+        : ts(ts_), varname(varname_), level(level_), lod(lod_), bmin(bmin_), bmax(bmax_)
+        {
+        }
+
+        bool operator==(const Key &rhs) const { return (ts == rhs.ts && level == rhs.level && lod == rhs.lod && bmin == rhs.bmin && bmax == rhs.bmax && varname == rhs.varname); }
+
+        size_t      ts;
+        std::string varname;
+        int         level;
+        int         lod;
+        DimsType    bmin;
+        DimsType    bmax;
+    };
+
+    //! Hash function for Key
+    //
+    class KeyHash {
+    public:
+        size_t operator()(const Key &k) const;
+    };
+
+    RegionCache();
+    ~RegionCache();
+
+    //! Look up a region
+    //!
+    //! If found the region becomes the most recently used region,
+    //! and if \p lock is true the region's lock count is incremented.
+    //!
+    //! \param[out] prefetched If not NULL, set to true if the region was
+    //! inserted with \p prefetched true and this is the first time it has
+    //! been found with a non-NULL \p prefetched argument. Otherwise set
+    //! to false.
+    //!
+    //! \retval blks Returns the region's memory, or NULL if the region
+    //! is not in the cache
+    //
+    void *Find(const Key &key, bool lock, bool *prefetched = NULL);
+
+    //! Add a region to the cache
+    //!
+    //! The region becomes the most recently used region. The region
+    //! identified by \p key must not already be in the cache, and \p blks
+    //! must be non-NULL and unique.
+    //!
+    //! \param[in] lock If true the region's lock count is initialized to 1,
+    //! otherwise 0.
+    //! \param[in] prefetched Marks the region as read ahead of need.
+    //! See Find().
+    //
+    void Insert(const Key &key, void *blks, bool lock, bool prefetched = false);
+
+    //! Remove a region from the cache
+    //!
+    //! \param[in] force If true the region is removed even if it is locked
+    //!
+    //! \retval blks Returns the removed region's memory, or NULL if the
+    //! region is not in the cache or is locked and \p force is false
+    //
+    void *Remove(const Key &key, bool force);
+
+    //! Decrement the lock count of the region with memory \p blks
+    //!
+    //! \retval status Returns false if no locked region with memory \p blks
+    //! exists
+    //
+    bool Unlock(const void *blks);
+
+    //! Remove the least recently used unlocked region
+    //!
+    //! \retval blks Returns the removed region's memory, or NULL if
+    //! every region in the cache is locked
+    //
+    void *EvictLRU();
+
+    //! Remove the least recently used unlocked region for which
+    //! \p evictable returns true
+    //!
+    //! Unlike EvictLRU() this method is linear in the number of
+    //! unlocked regions that are skipped.
+    //!
+    //! \retval blks Returns the removed region's memory, or NULL if no
+    //! unlocked region is evictable
+    //
+    void *EvictLRU(const std::function<bool(const Key &)> &evictable);
+
+    //! Remove all regions, locked or not, for variable \p varname
+    //!
+    //! \param[out] blks Memory of removed regions is appended to \p blks
+    //
+    void RemoveVar(const std::string &varname, std::vector<void *> &blks);
+
+    //! Remove all regions, locked or not, for time step \p ts
+    //!
+    //! \param[out] blks Memory of removed regions is appended to \p blks
+    //
+    void RemoveTimeStep(size_t ts, std::vector<void *> &blks);
+
+    //! Remove all regions, locked or not
+    //!
+    //! \param[out] blks Memory of removed regions is appended to \p blks
+    //
+    void Clear(std::vector<void *> &blks);
+
+    //! Return the number of regions in the cache
+    //
+    size_t Size() const { return (_byKey.size()); }
+
+    //! Return the number of regions with a non-zero lock count
+    //
+    size_t NumLocked() const { return (_locked.size()); }
+
+private:
+    typedef struct {
+        Key   key;
+        int   lock_counter;
+        bool  prefetched;
+        void *blks;
+    } region_t;
+
+    typedef std::list<region_t>::iterator region_itr_t;
+
+    // Unlocked regions in LRU order. The least recently used region is at
+    // the front of the list. Locked regions are kept on a separate list
+    // so that eviction never has to step over them. Entries are moved
+    // between the two lists with splice(), which keeps iterators valid.
+    //
+    std::list<region_t> _lru;
+    std::list<region_t> _locked;
+
+    std::unordered_map<Key, region_itr_t, KeyHash>                _byKey;
+    std::unordered_map<const void *, region_itr_t>                _byBlks;
+    std::unordered_map<std::string, std::unordered_set<void *>>   _byVar;
+    std::unordered_map<size_t, std::unordered_set<void *>>        _byTimeStep;
+
+    void _erase(region_itr_t itr);
+    void _removeBlks(const std::vector<void *> &victims, std::vector<void *> &blks);
+};
+};    // namespace VAPoR
+
+#endif    //	_RegionCache_h_
@@ -74,6 +74,15 @@ public:
     //
     virtual bool InsideGrid(const CoordType &coords) const override;
 
+    //! \copydoc Grid::GetValues()
+    //
+    virtual void GetValues(const double *xyz, size_t n, float *values) const override;
+
+    // For grandparent inheritance of
+    // Grid::GetValues(const float *xyz, size_t n, float *values)
+    //
+    using Grid::GetValues;
+
     class ConstCoordItrRG : public Grid::ConstCoordItrAbstract {
     public:
         ConstCoordItrRG(const RegularGrid *rg, bool begin);
@@ -121,6 +130,14 @@ protected:
 private:
     void _regularGrid(const CoordType &minu, const CoordType &maxu);
 
+    // Same as InsideGrid(), GetValueNearestNeighbor(), and GetValueLinear(),
+    // for coordinates that are already clamped. The latter two also
+    // require the point to be inside the grid.
+    //
+    bool  _insideGrid(const CoordType &cCoords) const;
+    float _getValueNearestNeighbor(const CoordType &cCoords) const;
+    float _getValueLinear(const CoordType &cCoords) const;
+
     CoordType _minu = {{0.0, 0.0, 0.0}};
     CoordType _maxu = {{0.0, 0.0, 0.0}};
     size_t    _geometryDim;
@@ -49,6 +49,7 @@ private:
         std::vector<double> sliceNormal;
         double              sliceOffset;
         int                 sliceOrientationMode;
+        unsigned long       generation;    // of the params the caches were last found clean for
     } _cacheParams;
 
     void _initVAO();
@@ -87,7 +88,11 @@ private:
 
     int _colorMapSize;
 
-    void _clearCache() { _cacheParams.varName.clear(); }
+    void _clearCache()
+    {
+        _cacheParams.varName.clear();
+        _cacheParams.generation = 0;
+    }
 };
 
 };    // namespace VAPoR
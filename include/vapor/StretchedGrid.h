@@ -93,6 +93,15 @@ public:
     //
     virtual bool InsideGrid(const CoordType &coords) const override;
 
+    //! \copydoc Grid::GetValues()
+    //
+    virtual void GetValues(const double *xyz, size_t n, float *values) const override;
+
+    // For grandparent inheritance of
+    // Grid::GetValues(const float *xyz, size_t n, float *values)
+    //
+    using Grid::GetValues;
+
     //! Returns reference to vector containing X user coordinates
     //!
     //! Returns reference to vector passed to constructor
@@ -162,6 +171,12 @@ private:
     void _stretchedGrid(const std::vector<double> &xcoords, const std::vector<double> &ycoords, const std::vector<double> &zcoords);
 
     bool _insideGrid(double x, double y, double z, size_t &i, size_t &j, size_t &k, double &xwgt, double &ywgt, double &zwgt) const;
+
+    // Same as GetValueNearestNeighbor() and GetValueLinear(), for
+    // coordinates that are already clamped
+    //
+    float _getValueNearestNeighbor(const CoordType &cCoords) const;
+    float _getValueLinear(const CoordType &cCoords) const;
 };
 };    // namespace VAPoR
 #endif
@@ -0,0 +1,111 @@
+#ifndef _TaskPool_h_
+#define _TaskPool_h_
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include "MyBase.h"
+
+namespace Wasp {
+
+//
+//! \class TaskPool
+//! \brief A persistent pool of worker threads with work stealing
+//!
+//! Tasks are identified by an index and are executed by a task function
+//! that is shared by all of the tasks in a batch. Each worker owns a
+//! queue of task indices. Workers execute tasks from the front of their
+//! own queue, and a worker whose queue is empty steals tasks from the
+//! back of another worker's queue.
+//!
+//! The worker threads are created once, by the constructor, and sleep
+//! between batches.
+//!
+//! Only one batch may be in progress at a time, and the methods of this
+//! class must not be called from within a task.
+//
+class COMMON_API TaskPool : public MyBase {
+public:
+    //! Task function type
+    //!
+    //! \param[in] worker Index of the worker executing the task, in the
+    //! range 0..GetNumThreads()-1. A task may use \p worker to select
+    //! per-thread resources.
+    //! \param[in] task Index of the task
+    //
+    typedef std::function<void(int worker, size_t task)> task_t;
+
+    //! Create a pool of \p nthreads worker threads
+    //!
+    //! If \p nthreads is less than one the number of processors is used.
+    //! The environment variable VAPOR_NTHREADS, if set, overrides
+    //! \p nthreads. If no worker thread can be created tasks are executed
+    //! by the calling thread.
+    //
+    TaskPool(int nthreads);
+    ~TaskPool();
+
+    //! Return the number of workers
+    //!
+    //! The value returned is always at least one.
+    //
+    int GetNumThreads() const { return (_workers.size()); }
+
+    //! Begin a batch of tasks executed by \p task
+    //!
+    //! Tasks are queued for execution with Push(). The batch is ended by
+    //! Wait().
+    //
+    void Begin(const task_t &task);
+
+    //! Queue task \p i of the current batch for execution
+    //!
+    //! The task may begin executing before Push() returns.
+    //!
+    //! \param[in] worker The worker whose queue receives the task. If -1,
+    //! queues are chosen round robin.
+    //
+    void Push(size_t i, int worker = -1);
+
+    //! Wait for all tasks of the current batch to complete and end
+    //! the batch
+    //
+    void Wait();
+
+    //! Execute tasks 0..n-1 and wait for them to complete
+    //!
+    //! The tasks are initially divided into contiguous ranges, one per
+    //! worker.
+    //
+    void ParFor(size_t n, const task_t &task);
+
+private:
+    class worker_t {
+    public:
+        std::mutex         _mutex;    // protects _queue
+        std::deque<size_t> _queue;
+    };
+
+    std::vector<worker_t *>   _workers;
+    std::vector<std::thread>  _threads;
+    std::mutex                _mutex;    // protects everything below
+    std::condition_variable   _workCV;
+    std::condition_variable   _doneCV;
+    task_t                    _task;
+    size_t                    _queued;     // tasks in queues, not yet started
+    size_t                    _pending;    // tasks pushed, not yet finished
+    int                       _next;       // next worker for round robin push
+    bool                      _stop;
+
+    void _run(int w);
+    bool _pop(int w, size_t &i);
+    bool _steal(int w, size_t &i);
+    void _done();
+};
+
+};    // namespace Wasp
+
+#endif
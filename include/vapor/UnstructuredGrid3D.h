@@ -5,7 +5,7 @@
 #include <memory>
 #include <vapor/common.h>
 #include <vapor/UnstructuredGrid2D.h>
-#include <vapor/QuadTreeRectangle.hpp>
+#include <vapor/CellBVH.h>
 
 
 #ifdef WIN32
@@ -15,29 +15,42 @@
 namespace VAPoR {
 
 //! \class UnstructuredGrid3D
-//! \brief class for a Layered unstructured grid.
+//! \brief class for a 3D unstructured grid.
 //!
+//! Points are located with a bounding volume hierarchy over the cells.
+//! Tetrahedral cells (four nodes) are interpolated with Barycentric
+//! coordinates, and hexahedral cells (eight nodes, ordered as in
+//! HexahedronToTets()) with trilinear interpolation. Cells with any
+//! other number of nodes are never found to contain a point.
+//!
+//! \sa CellBVH
 //
 class VDF_API UnstructuredGrid3D : public UnstructuredGrid {
 public:
-    //! Construct a unstructured grid sampling Layered scalar function
+    //! Construct a unstructured grid sampling 3D scalar function
     //!
+    //! \param[in] bvh A bounding volume hierarchy over the cells of the
+    //! grid, such as the one returned by GetCellBVH() for another grid
+    //! with the same coordinates. If null, one is built if the cells
+    //! have at least four nodes.
     //
     UnstructuredGrid3D(const DimsType &vertexDims, const DimsType &faceDims, const DimsType &edgeDims, const DimsType &bs, const std::vector<float *> &blks, const int *vertexOnFace,
                        const int *faceOnVertex, const int *faceOnFace,
                        Location location,    // node,face, edge
                        size_t maxVertexPerFace, size_t maxFacePerVertex, long nodeOffset, long cellOffset, const UnstructuredGridCoordless &xug, const UnstructuredGridCoordless &yug,
-                       const UnstructuredGridCoordless &zug);
+                       const UnstructuredGridCoordless &zug, std::shared_ptr<const CellBVH> bvh);
 
     UnstructuredGrid3D(const std::vector<size_t> &vertexDims, const std::vector<size_t> &faceDims, const std::vector<size_t> &edgeDims, const std::vector<size_t> &bs, const std::vector<float *> &blks,
                        const int *vertexOnFace, const int *faceOnVertex, const int *faceOnFace,
                        Location location,    // node,face, edge
                        size_t maxVertexPerFace, size_t maxFacePerVertex, long nodeOffset, long cellOffset, const UnstructuredGridCoordless &xug, const UnstructuredGridCoordless &yug,
-                       const UnstructuredGridCoordless &zug);
+                       const UnstructuredGridCoordless &zug, std::shared_ptr<const CellBVH> bvh);
 
     UnstructuredGrid3D() = default;
     virtual ~UnstructuredGrid3D() = default;
 
+    std::shared_ptr<const CellBVH> GetCellBVH() const { return (_bvh); }
+
     virtual DimsType GetCoordDimensions(size_t dim) const override;
 
     virtual size_t GetGeometryDim() const override;
@@ -103,10 +116,15 @@ protected:
     virtual void GetUserExtentsHelper(CoordType &minu, CoordType &maxu) const override;
 
 private:
-    UnstructuredGridCoordless _xug;
-    UnstructuredGridCoordless _yug;
-    UnstructuredGridCoordless _zug;
+    UnstructuredGridCoordless      _xug;
+    UnstructuredGridCoordless      _yug;
+    UnstructuredGridCoordless      _zug;
+    std::shared_ptr<const CellBVH> _bvh;
+
+    bool _insideGrid(const CoordType &coords, size_t &cell, std::vector<size_t> &nodes, double *lambda, int &nlambda) const;
+
+    bool _insideCell(size_t cell, const CoordType &coords, std::vector<size_t> &nodes, double *lambda, int &nlambda) const;
 
-    bool _insideGrid(const CoordType &coords, DimsType &cindices, std::vector<size_t> &nodes2D, std::vector<double> &lambda, float zwgt[2]) const;
+    std::shared_ptr<CellBVH> _makeCellBVH() const;
 };
 };    // namespace VAPoR
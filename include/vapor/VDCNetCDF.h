@@ -1,5 +1,8 @@
 #include <vector>
 #include <map>
+#include <list>
+#include <set>
+#include <mutex>
 #include <algorithm>
 #include <iostream>
 #include "vapor/VDC.h"
@@ -127,6 +130,26 @@ public:
     //
     size_t GetVariableThreshold() const { return _variable_threshold; };
 
+    //! Set the maximum number of idle data files kept open for reading
+    //!
+    //! A data file opened to read a variable is not closed when the
+    //! variable is closed. It is kept open so that subsequent reads from
+    //! the same file need not reopen it. At most \p n such files are kept
+    //! open, and the least recently used ones are closed first. A value
+    //! of zero closes each file as soon as its variable is closed.
+    //! The default is 16. All of the files share one set of decoding
+    //! threads.
+    //!
+    //! \sa GetMaxIdleFiles()
+    //
+    void SetMaxIdleFiles(size_t n) { _readPool.SetMaxIdle(n); }
+
+    //! Return the maximum number of idle data files kept open for reading
+    //!
+    //! \sa SetMaxIdleFiles()
+    //
+    size_t GetMaxIdleFiles() const { return _readPool.GetMaxIdle(); }
+
     //! \copydoc VDC::OpenVariableWrite()
     //
     int OpenVariableWrite(size_t ts, string varname, int lod = -1);
@@ -215,6 +238,47 @@ private:
         double _mv;
     };
 
+    // Pool of handles on data files open for reading. A handle is checked
+    // out while a variable is open on it, since a WASP object reads one
+    // variable at a time, and returned when the variable is closed. Up to
+    // GetMaxIdle() returned handles stay open, least recently used first
+    // to be closed. The handles share one TaskPool, since a VDCNetCDF
+    // reads from one file at a time.
+    //
+    class WASPPool {
+    public:
+        WASPPool(int nthreads, size_t maxIdle) : _taskPool(nthreads), _maxIdle(maxIdle) {}
+        ~WASPPool();
+
+        // Return a handle on the file at path, open for reading, or NULL
+        // if the file can't be opened.
+        WASP *Checkout(const string &path);
+
+        // Return a handle obtained from Checkout(). A handle on a file
+        // purged while it was checked out is closed and deleted. Returns
+        // false, and does nothing, if wasp didn't come from this pool.
+        bool Return(WASP *wasp);
+
+        // Close the idle handles on the file at path, and arrange for the
+        // checked out ones to be closed when they are returned
+        void Purge(const string &path);
+
+        void   SetMaxIdle(size_t n);
+        size_t GetMaxIdle() const { return (_maxIdle); }
+
+    private:
+        std::mutex                           _mutex;
+        Wasp::TaskPool                       _taskPool;
+        size_t                               _maxIdle;
+        std::list<std::pair<string, WASP *>> _idle;      // most recently used first
+        std::map<WASP *, string>             _busy;      // checked out
+        std::set<WASP *>                     _purged;    // checked out, then purged
+
+        void _evict(size_t n);
+    };
+
+    WASPPool _readPool;
+
     Wasp::SmartBuf _sb_slice_buffer;
     Wasp::SmartBuf _mask_buffer;
 
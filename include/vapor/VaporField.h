@@ -69,6 +69,10 @@ public:
                             glm::vec3 &vel) const override;       // output
     virtual int GetScalar(double time, const glm::vec3 &pos,      // input
                           float &scalar) const override;          // output
+    // Velocity grids are looked up once per batch, and positions that fall
+    // in the same mesh share a single cell search for all three components.
+    virtual void GetVelocities(size_t n, const double *times, const glm::vec3 *pos,    // input
+                               glm::vec3 *vels, int *rvs) const override;               // output
 
     //
     // Functions for interaction with VAPOR components
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <vapor/VolumeRegular.h>
 
 namespace VAPoR {
@@ -20,6 +21,9 @@ namespace VAPoR {
 //! 4. Groups bounding boxs recursively into a tree, i.e. a bounding box at level n
 //!    would encapsulate the 4 associated bounding boxes at level n-1
 //!
+//! Steps 3 and 4 are skipped if the coordinates are the same as those last
+//! loaded, e.g. when only the time step changes.
+//!
 //! The glsl code does the following:
 //! 1. Find the initial border face that the ray intersects with by traversing
 //!    the tree built on the CPU
@@ -55,6 +59,10 @@ private:
     bool _useHighPrecisionTriangleRoutine;
     bool _gridHasInvertedCoordinateSystemHandiness;
 
+    // Checksum of the coordinates the bounding boxes were computed from
+    bool     _hasAccelerationData;
+    uint64_t _coordChecksum;
+
     bool        _needsHighPrecisionTriangleRoutine(const Grid *grid);
     static bool _need32BitForCoordinates(const Grid *grid);
 
@@ -4,13 +4,28 @@
 
 namespace VAPoR {
 
+//! \class VolumeResampled
+//! \ingroup Public_Render
+//!
+//! \brief Resampled grid rendering algorithm
+//!
+//! Renders any 3D grid, such as a curvilinear one, by first resampling
+//! it onto a regular grid with the same dimensions that spans the
+//! grid's user extents. Rendering is then done as in VolumeRegular.
+
 class VolumeResampled : public VolumeRegular {
 public:
-    VolumeResampled(GLManager *gl) : VolumeRegular(gl) {}
+    VolumeResampled(GLManager *gl, VolumeRenderer *renderer) : VolumeRegular(gl, renderer) {}
 
     static std::string GetName() { return "Resampled"; }
 
     virtual int LoadData(const Grid *grid);
+    virtual int LoadSecondaryData(const Grid *grid);
+
+private:
+    std::vector<double> _minExts, _maxExts;    // Extents sampled, from the primary variable
+
+    int _loadDataResampled(const Grid *grid, Texture3D *dataTexture, Texture3D *missingTexture, bool *hasMissingData);
 };
 
 }    // namespace VAPoR
@@ -8,7 +8,7 @@
 #include <netcdf.h>
 #include <vapor/NetCDFCpp.h>
 #include <vapor/Compressor.h>
-#include <vapor/EasyThreads.h>
+#include <vapor/TaskPool.h>
 #include <vapor/utils.h>
 
 namespace VAPoR {
@@ -107,9 +107,21 @@ public:
     //! of 0, the default, indicates that the thread count should be
     //! determined by the environment in a platform-specific manner, for
     //! example using sysconf(_SC_NPROCESSORS_ONLN) under *nix OSes.
+    //! The threads are created once, by the constructor, and are reused
+    //! by every subsequent read and write.
     //!
     //
     WASP(int nthreads = 0);
+
+    //! Construct a WASP object that uses an existing pool of threads
+    //!
+    //! \param[in] pool Worker threads used to encode and decode
+    //! compressed data. The pool is not owned by the WASP object, and
+    //! must outlive it. Several WASP objects may share a pool, provided
+    //! that no two of them read or write concurrently.
+    //
+    WASP(Wasp::TaskPool *pool);
+
     virtual ~WASP();
 
     //! Create a new NetCDF data set with support for WASP conventions
@@ -629,7 +641,8 @@ public:
     static string AttNameVersion() { return ("WASP.Version"); }
 
 private:
-    Wasp::EasyThreads * _et;
+    Wasp::TaskPool *    _pool;
+    bool                _ownPool;
     int                 _nthreads;
     vector<NetCDFCpp>   _ncdfcs;
     vector<NetCDFCpp *> _ncdfcptrs;         // pointers into _ncdfcs;
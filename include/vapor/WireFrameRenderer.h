@@ -60,6 +60,7 @@ private:
         int                 lod;
         std::vector<double> boxMin, boxMax;
 
+        mutable unsigned long generation;    // of the params the cache was last found clean for
     } _cacheParams;
 
     // Helper class to keep track of which cell edges have been drawn so
@@ -111,7 +112,11 @@ private:
     void _saveCacheParams();
     void _drawCell(const GLuint *cellNodeIndices, int n, bool layered, const std::vector<GLuint> &nodeMap, GLuint invalidIndex, std::vector<unsigned int> &indices, DrawList &drawList) const;
 
-    void _clearCache() { _cacheParams.varName.clear(); }
+    void _clearCache()
+    {
+        _cacheParams.varName.clear();
+        _cacheParams.generation = 0;
+    }
 };
 
 };    // namespace VAPoR
@@ -10,6 +10,8 @@
 #include <vector>
 #include <string>
 #include <stack>
+#include <atomic>
+#include <algorithm>
 #include <vapor/MyBase.h>
 #ifdef WIN32
     #pragma warning(disable : 4251)
@@ -17,6 +19,105 @@
 
 namespace VAPoR {
 
+//
+//! \class XmlKey
+//! \brief An interned Xml element tag
+//!
+//! All XmlKey's constructed from equal tags refer to a single, shared
+//! copy of the tag. Hence XmlKey's are compared by address, and copying
+//! one never allocates memory. Interned tags are never freed.
+//
+class PARAMS_API XmlKey {
+public:
+    XmlKey(const string &tag) : _str(_intern(tag)) {}
+
+    const string &str() const { return (*_str); }
+
+    bool operator==(const XmlKey &rhs) const { return (_str == rhs._str); }
+    bool operator!=(const XmlKey &rhs) const { return (_str != rhs._str); }
+
+private:
+    const string *_str;
+
+    static const string *_intern(const string &tag);
+};
+
+//
+//! \class XmlElementMap
+//! \brief The data elements of a single type of an XmlNode
+//!
+//! Elements are stored contiguously, sorted by tag, and keyed by
+//! XmlKey's. Lookups use a binary search on the tag. Since keys are
+//! interned, a lookup by XmlKey then compares only the address of the
+//! element found. Inserting or erasing an element invalidates references
+//! to the other elements.
+//
+template<class T> class XmlElementMap {
+public:
+    typedef std::pair<XmlKey, T>                             value_type;
+    typedef typename std::vector<value_type>::iterator       iterator;
+    typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+    iterator       begin() { return (_elements.begin()); }
+    iterator       end() { return (_elements.end()); }
+    const_iterator begin() const { return (_elements.begin()); }
+    const_iterator end() const { return (_elements.end()); }
+    bool           empty() const { return (_elements.empty()); }
+    size_t         size() const { return (_elements.size()); }
+    void           clear() { _elements.clear(); }
+
+    const_iterator find(const string &tag) const
+    {
+        size_t i = _lowerBound(tag);
+        return (i < _elements.size() && _elements[i].first.str() == tag ? begin() + i : end());
+    }
+    const_iterator find(const XmlKey &key) const
+    {
+        size_t i = _lowerBound(key.str());
+        return (i < _elements.size() && _elements[i].first == key ? begin() + i : end());
+    }
+    iterator find(const string &tag) { return (begin() + (static_cast<const XmlElementMap &>(*this).find(tag) - _elements.cbegin())); }
+    iterator find(const XmlKey &key) { return (begin() + (static_cast<const XmlElementMap &>(*this).find(key) - _elements.cbegin())); }
+
+    size_t count(const string &tag) const { return (find(tag) != end()); }
+    size_t count(const XmlKey &key) const { return (find(key) != end()); }
+
+    T &operator[](const string &tag)
+    {
+        size_t i = _lowerBound(tag);
+        if (i < _elements.size() && _elements[i].first.str() == tag) return (_elements[i].second);
+        return (_elements.insert(begin() + i, value_type(XmlKey(tag), T()))->second);
+    }
+    T &operator[](const XmlKey &key)
+    {
+        size_t i = _lowerBound(key.str());
+        if (i < _elements.size() && _elements[i].first == key) return (_elements[i].second);
+        return (_elements.insert(begin() + i, value_type(key, T()))->second);
+    }
+
+    void erase(const string &tag)
+    {
+        iterator itr = find(tag);
+        if (itr != end()) _elements.erase(itr);
+    }
+    void erase(const XmlKey &key)
+    {
+        iterator itr = find(key);
+        if (itr != end()) _elements.erase(itr);
+    }
+
+    bool operator==(const XmlElementMap &rhs) const { return (_elements == rhs._elements); }
+    bool operator!=(const XmlElementMap &rhs) const { return (_elements != rhs._elements); }
+
+private:
+    std::vector<value_type> _elements;
+
+    size_t _lowerBound(const string &tag) const
+    {
+        return (std::lower_bound(_elements.begin(), _elements.end(), tag, [](const value_type &e, const string &t) { return (e.first.str() < t); }) - _elements.begin());
+    }
+};
+
 //
 //! \class XmlNode
 //! \brief An Xml tree
@@ -92,7 +193,11 @@ public:
 
     string GetTag() const { return (_tag); }
 
-    void SetTag(string tag) { _tag = tag; }
+    void SetTag(string tag)
+    {
+        _tag = tag;
+        _touch();
+    }
 
     //! Set or get that node's attributes
     //!
@@ -495,6 +600,17 @@ public:
     //!
     virtual XmlNode *GetRoot() const;
 
+    //! Return the generation of the tree rooted at this node
+    //!
+    //! The generation changes whenever this node, or any of its
+    //! descendants, is modified by the methods of this class. No two
+    //! nodes ever share a generation. Hence anything derived from the
+    //! tree rooted at this node remains valid for as long as the node's
+    //! generation is unchanged. Changes made through the references
+    //! returned by Tag() and Attrs() are not tracked.
+    //
+    unsigned long GetGeneration() const { return (_generation); }
+
     static const std::vector<XmlNode *> &GetAllocatedNodes() { return (_allocatedNodes); }
 
     // Following is a substitute for exporting the "<<" operator in windows.
@@ -511,16 +627,24 @@ private:
 
     static std::vector<XmlNode *> _allocatedNodes;
 
-    map<string, vector<long>>   _longmap;      // node's long data
-    map<string, vector<double>> _doublemap;    // node's double data
-    map<string, string>         _stringmap;    // node's string data
-    map<string, string>         _attrmap;      // node's attributes
+    XmlElementMap<vector<long>>   _longmap;      // node's long data
+    XmlElementMap<vector<double>> _doublemap;    // node's double data
+    XmlElementMap<string>         _stringmap;    // node's string data
+    map<string, string>           _attrmap;      // node's attributes
 
     vector<XmlNode *> _children;    // node's children
     string            _tag;         // node's tag name
 
     size_t   _asciiLimit;    // length limit beyond which element data are encoded
     XmlNode *_parent;        // Node's parent
+
+    friend class XmlNodeDelta;
+
+    static std::atomic<unsigned long> _generationCounter;
+    unsigned long                     _generation;    // see GetGeneration()
+
+    void _touch();
+    void _deleteChildren();
 };
 // ostream& VAPoR::operator<< (ostream& os, const XmlNode& node);
 
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <map>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <vapor/XmlNode.h>
+
+namespace VAPoR {
+
+//
+//! \class XmlNodeDelta
+//! \brief The differences between two versions of an Xml tree
+//!
+//! An XmlNodeDelta records the changes that transform one version of an
+//! XmlNode tree into another: the data elements that were set or added,
+//! the children that were added or removed, and the order of the
+//! children. Only the changed elements, and copies of the added and
+//! removed subtrees, are stored. The changes can be applied to a tree
+//! equal to the older version, transforming it into the newer version,
+//! or reverted on a tree equal to the newer version.
+//!
+//! Nodes are identified by the path of tags from the root, which is
+//! unique since a node's children have distinct tags.
+//
+class PARAMS_API XmlNodeDelta {
+public:
+    //! Generations, see XmlNode::GetGeneration(), of the nodes of a tree
+    //! that the nodes of a copy of the tree were last made equal to.
+    //! Indexed by the nodes of the copy.
+    //
+    typedef std::unordered_map<const XmlNode *, unsigned long> SyncMap;
+
+    XmlNodeDelta() {}
+    ~XmlNodeDelta();
+
+    //! Make a copy of a tree equal to the tree, recording the changes
+    //!
+    //! The tree rooted at \p copy is changed to be equal to the tree
+    //! rooted at \p node, and the changes made are appended to this
+    //! delta. Subtrees of \p node whose generation is recorded in \p synced
+    //! for the corresponding subtree of \p copy are unchanged, and are
+    //! skipped. Hence the cost is proportional to the size of the
+    //! changes, rather than the size of the tree, if \p synced is
+    //! maintained across calls. \p synced is updated for each node of
+    //! \p copy that is visited.
+    //!
+    //! \param[in,out] copy Root of the copy to change
+    //! \param[in] node Root of the tree to make \p copy equal to
+    //! \param[in,out] synced Generations of the nodes of \p node, indexed
+    //! by the nodes of \p copy that are equal to them.
+    //!
+    //! \retval changed True if \p copy was changed
+    //
+    bool Update(XmlNode *copy, const XmlNode *node, SyncMap &synced);
+
+    //! Return true if no changes have been recorded
+    //
+    bool Empty() const { return (_changes.empty()); }
+
+    //! Transform a tree from the older version to the newer version
+    //!
+    //! \param[in,out] root Root of a tree equal to the older version
+    //
+    void Apply(XmlNode *root) const;
+
+    //! Transform a tree from the newer version to the older version
+    //!
+    //! \param[in,out] root Root of a tree equal to the newer version
+    //
+    void Revert(XmlNode *root) const;
+
+private:
+    // The changes to a single node, identified by the tags on the path
+    // from the root to the node. Only the data elements that changed
+    // are stored in before and after. An element missing from one of
+    // them did not exist in that version.
+    //
+    class elements_t {
+    public:
+        XmlElementMap<std::vector<long>>   longs;
+        XmlElementMap<std::vector<double>> doubles;
+        XmlElementMap<std::string>         strings;
+        std::map<std::string, std::string> attrs;
+    };
+
+    class change_t {
+    public:
+        change_t() : attrsChanged(false) {}
+        ~change_t();
+
+        std::vector<std::string> path;
+        elements_t               before;
+        elements_t               after;
+        bool                     attrsChanged;
+        std::vector<XmlNode *>   removed;        // copies of removed children
+        std::vector<XmlNode *>   added;          // copies of added children
+        std::vector<std::string> orderBefore;    // child tags, if children changed
+        std::vector<std::string> orderAfter;
+    };
+
+    std::vector<change_t *> _changes;
+
+    XmlNodeDelta(const XmlNodeDelta &) = delete;
+    XmlNodeDelta &operator=(const XmlNodeDelta &) = delete;
+
+    void        _update(XmlNode *copy, const XmlNode *node, std::vector<std::string> &path, SyncMap &synced);
+    static void _apply(XmlNode *root, const change_t &c, bool forward);
+};
+};    // namespace VAPoR
@@ -103,6 +103,43 @@ double SignedTriArea2D(const double a[2], const double b[2], const double c[2]);
 //! are positive.
 bool BarycentricCoordsTri(const double verts[], const double pt[], double lambda[]);
 
+//! Compute the Barycentric coordinates for a point inside a tetrahedron
+//!
+//! \param[in] verts a 12-element array of 3D tetrahedron Cartesian
+//! coordinates, ordered x1, y1, z1, x2, y2, z2, ..., x4, y4, z4.
+//! \param[in] pt the 3D Cartesian coordinates
+//! \param[out] lambda The four Barycentric coordinates for point \pt.
+//!
+//! \retval inside a flag indicating whether the point \p pt
+//! is inside (or on a face) of the tetrahedron. I.e. all of the
+//! Barycentric coordinates are positive. False is also returned if the
+//! tetrahedron is degenerate.
+//
+bool BarycentricCoordsTet(const double verts[], const double pt[], double lambda[]);
+
+//! Compute the trilinear interpolation weights for a point inside a
+//! hexahedron
+//!
+//! This function inverts the trilinear mapping from the unit cube to the
+//! hexahedron, using Newton's method, to find the parametric coordinates
+//! of the point \p pt. The weights returned in \p lambda are the
+//! trilinear interpolation weights for the eight vertices of the
+//! hexahedron, which must be ordered as in HexahedronToTets(). The
+//! hexahedron may be irregular, but should be convex.
+//!
+//! \param[in] verts a 24-element array of 3D hexahedron Cartesian
+//! coordinates, ordered x0, y0, z0, x1, y1, z1, ..., x7, y7, z7.
+//! \param[in] pt the 3D Cartesian coordinates
+//! \param[out] lambda The eight trilinear weights for point \pt.
+//!
+//! \retval inside a flag indicating whether the point \p pt
+//! is inside (or on a face) of the hexahedron. False is also returned
+//! if the parametric coordinates could not be found.
+//!
+//! \sa HexahedronToTets()
+//
+bool TrilinearCoordsHex(const double verts[], const double pt[], double lambda[]);
+
 //! Compute the Wachspress coordinates for a point inside an irregular,
 //! convex, n-sided, planar polygon.
 //!
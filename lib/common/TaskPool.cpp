@@ -0,0 +1,170 @@
+#include <sstream>
+#include <cstdlib>
+#include <system_error>
+#include <vapor/EasyThreads.h>
+#include <vapor/TaskPool.h>
+
+using namespace Wasp;
+
+TaskPool::TaskPool(int nthreads)
+{
+    _queued = 0;
+    _pending = 0;
+    _next = 0;
+    _stop = false;
+
+    if (nthreads < 1) nthreads = EasyThreads::NProc();
+    if (char *s = getenv("VAPOR_NTHREADS")) {
+        std::istringstream ist(s);
+        ist >> nthreads;
+    }
+    if (nthreads < 1) nthreads = 1;
+
+    for (int i = 0; i < nthreads; i++) _workers.push_back(new worker_t());
+
+    for (int i = 0; i < nthreads; i++) {
+        try {
+            _threads.push_back(std::thread(&TaskPool::_run, this, i));
+        } catch (const std::system_error &e) {
+            SetErrMsg("Failed to create thread : %s", e.what());
+            break;
+        }
+    }
+
+    // Only as many workers as there are threads to serve them. With no
+    // threads at all, Push() executes tasks in the calling thread.
+    //
+    size_t nworkers = _threads.size() > 0 ? _threads.size() : 1;
+    while (_workers.size() > nworkers) {
+        delete _workers.back();
+        _workers.pop_back();
+    }
+}
+
+TaskPool::~TaskPool()
+{
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _workCV.notify_all();
+
+    for (int i = 0; i < _threads.size(); i++) _threads[i].join();
+    for (int i = 0; i < _workers.size(); i++) delete _workers[i];
+}
+
+void TaskPool::Begin(const task_t &task)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _task = task;
+    _next = 0;
+}
+
+void TaskPool::Push(size_t i, int worker)
+{
+    if (_threads.empty()) {
+        _task(0, i);
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (worker < 0) {
+            worker = _next;
+            _next = (_next + 1) % _workers.size();
+        }
+        _queued++;
+        _pending++;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(_workers[worker]->_mutex);
+        _workers[worker]->_queue.push_back(i);
+    }
+
+    _workCV.notify_one();
+}
+
+void TaskPool::Wait()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _doneCV.wait(lock, [this] { return (_pending == 0); });
+    _task = nullptr;
+}
+
+void TaskPool::ParFor(size_t n, const task_t &task)
+{
+    Begin(task);
+
+    size_t nworkers = _workers.size();
+    for (size_t w = 0; w < nworkers; w++) {
+        size_t first = n * w / nworkers;
+        size_t last = n * (w + 1) / nworkers;
+        for (size_t i = first; i < last; i++) Push(i, w);
+    }
+
+    Wait();
+}
+
+bool TaskPool::_pop(int w, size_t &i)
+{
+    std::unique_lock<std::mutex> lock(_workers[w]->_mutex);
+    if (_workers[w]->_queue.empty()) return (false);
+
+    i = _workers[w]->_queue.front();
+    _workers[w]->_queue.pop_front();
+    return (true);
+}
+
+bool TaskPool::_steal(int w, size_t &i)
+{
+    int nworkers = _workers.size();
+    for (int k = 1; k < nworkers; k++) {
+        worker_t *victim = _workers[(w + k) % nworkers];
+
+        std::unique_lock<std::mutex> lock(victim->_mutex);
+        if (victim->_queue.empty()) continue;
+
+        i = victim->_queue.back();
+        victim->_queue.pop_back();
+        return (true);
+    }
+    return (false);
+}
+
+void TaskPool::_done()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _pending--;
+    if (_pending == 0) _doneCV.notify_all();
+}
+
+void TaskPool::_run(int w)
+{
+    for (;;) {
+        {
+            // Sleep until there is queued work. A task counted in _queued
+            // may already have been taken by another worker, in which
+            // case the pop and steal below fail and we come back here.
+            //
+            std::unique_lock<std::mutex> lock(_mutex);
+            _workCV.wait(lock, [this] { return (_stop || _queued > 0); });
+            if (_stop) return;
+        }
+
+        size_t i;
+        while (_pop(w, i) || _steal(w, i)) {
+            // The task function is fetched per task because the task may
+            // belong to a batch begun after this worker woke up.
+            //
+            task_t task;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _queued--;
+                task = _task;
+            }
+            task(w, i);
+            _done();
+        }
+    }
+}
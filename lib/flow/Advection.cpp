@@ -6,7 +6,7 @@
 using namespace flow;
 
 // Constructor;
-Advection::Advection() : _lowerAngle(3.0f), _upperAngle(15.0f)
+Advection::Advection() : _lowerAngle(3.0f), _upperAngle(15.0f), _batchSize(64)
 {
     _lowerAngleCos = glm::cos(glm::radians(_lowerAngle));
     _upperAngleCos = glm::cos(glm::radians(_upperAngle));
@@ -20,7 +20,7 @@ void Advection::UseSeedParticles(const std::vector<Particle> &seeds)
     _streams.clear();
     _streams.resize(seeds.size());
     for (size_t i = 0; i < seeds.size(); i++)
-      _streams[i].push_back(seeds[i]);
+      _streams[i].PushBack(seeds[i]);
 
     _separatorCount.assign(seeds.size(), 0);
 }
@@ -28,7 +28,7 @@ void Advection::UseSeedParticles(const std::vector<Particle> &seeds)
 int Advection::CheckReady() const
 {
     for (const auto &s : _streams) {
-        if (s.size() < 1) return NO_SEED_PARTICLE_YET;
+        if (s.IsEmpty()) return NO_SEED_PARTICLE_YET;
     }
 
     return 0;
@@ -46,135 +46,184 @@ int Advection::AdvectSteps(Field *velocity, double deltaT, size_t maxSteps, ADVE
       return PARAMS_ERROR;
 
     // The particle advection process can be parallelized per particle
-    // Each stream represents a trajectory for a single particle
-    #pragma omp parallel for
-    for (size_t streamIdx = 0; streamIdx < _streams.size(); streamIdx++) {
-        auto& s = _streams[streamIdx];
-        size_t numberOfSteps = s.size() - _separatorCount[streamIdx];
-        while (numberOfSteps < maxSteps) {
-            auto &past0 = s.back();
-            if (past0.IsSpecial())    // If the last particle is marked "special,"
-                break;                // terminate stream immediately.
-
-            double dt = deltaT;
-            if (s.size() > 2)    // If there are at least 3 particles in the stream and
-            {                    // neither is a separator, we also adjust *dt*
-                const auto &past1 = s[s.size() - 2];
-                const auto &past2 = s[s.size() - 3];
-                if ((!past1.IsSpecial()) && (!past2.IsSpecial())) {
-                    // We enforce a factor of 20.0f as a limit of how much the step size
-                    // can be adjusted by _calcAdjustFactor().
-                    // I.e., the adjusted value can be at most 20X larger or 20X smaller.
-                    // The choice of 20.0f is just an empirical value that seems to work well.
-                    double mindt = deltaT / 20.0, maxdt = deltaT * 20.0;
-                    dt = past0.time - past1.time;    // step size used by last integration
-                    dt *= _calcAdjustFactor(past2, past1, past0);
-                    if (dt > 0)    // integrate forward
-                        dt = glm::clamp(dt, mindt, maxdt);
-                    else    // integrate backward
-                        dt = glm::clamp(dt, maxdt, mindt);
+    // Each stream represents a trajectory for a single particle.
+    // Streams are advanced in batches, so that the field is queried for
+    // the velocities of a whole batch of particles at once.
+    const size_t numOfBatches = (_streams.size() + _batchSize - 1) / _batchSize;
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t batchIdx = 0; batchIdx < numOfBatches; batchIdx++) {
+        const size_t firstStream = batchIdx * _batchSize;
+        const size_t lastStream = std::min(firstStream + _batchSize, _streams.size());
+
+        // Streams of this batch that are still being advanced, and the number
+        // of steps taken by each of them.
+        std::vector<size_t> active, steps, nextActive, nextSteps;
+        for (size_t streamIdx = firstStream; streamIdx < lastStream; streamIdx++) {
+            active.push_back(streamIdx);
+            steps.push_back(_streams[streamIdx].GetNumOfParticles() - _separatorCount[streamIdx]);
+        }
+
+        std::vector<Particle> past0s, p1s;
+        std::vector<double>   dts;
+        std::vector<int>      rvs;
+
+        while (!active.empty()) {
+            // Gather the last particle of every stream that still advances.
+            nextActive.clear();
+            nextSteps.clear();
+            past0s.clear();
+            dts.clear();
+            for (size_t a = 0; a < active.size(); a++) {
+                const size_t streamIdx = active[a];
+                const auto & s = _streams[streamIdx];
+                if (steps[a] >= maxSteps) continue;
+
+                const size_t last = s.GetNumOfParticles() - 1;
+                if (s.IsSpecial(last))    // If the last particle is marked "special,"
+                    continue;             // terminate stream immediately.
+                Particle past0 = s.GetParticle(last);
+
+                double dt = deltaT;
+                if (last >= 2)    // If there are at least 3 particles in the stream and
+                {                 // neither is a separator, we also adjust *dt*
+                    if ((!s.IsSpecial(last - 1)) && (!s.IsSpecial(last - 2))) {
+                        // We enforce a factor of 20.0f as a limit of how much the step size
+                        // can be adjusted by _calcAdjustFactor().
+                        // I.e., the adjusted value can be at most 20X larger or 20X smaller.
+                        // The choice of 20.0f is just an empirical value that seems to work well.
+                        double mindt = deltaT / 20.0, maxdt = deltaT * 20.0;
+                        dt = past0.time - s.GetTime(last - 1);    // step size used by last integration
+                        dt *= _calcAdjustFactor(s.GetLocation(last - 2), s.GetLocation(last - 1), past0.location);
+                        if (dt > 0)    // integrate forward
+                            dt = glm::clamp(dt, mindt, maxdt);
+                        else    // integrate backward
+                            dt = glm::clamp(dt, maxdt, mindt);
+                    }
                 }
+
+                nextActive.push_back(streamIdx);
+                nextSteps.push_back(steps[a]);
+                past0s.push_back(past0);
+                dts.push_back(dt);
             }
+            active.swap(nextActive);
+            steps.swap(nextSteps);
+            if (active.empty()) break;
 
-            Particle p1;
-            int      rv = 0;
+            p1s.assign(active.size(), Particle());
+            rvs.assign(active.size(), 0);
             switch (method) {
             case ADVECTION_METHOD::EULER:
-                rv = _advectEuler(velocity, past0, dt, p1);
-                _printNonZero(rv, __FILE__, __func__, __LINE__);
+                _advectEulerBatch(velocity, active.size(), past0s.data(), dts.data(), p1s.data(), rvs.data());
                 break;
             case ADVECTION_METHOD::RK4:
-                rv = _advectRK4(velocity, past0, dt, p1);
-                _printNonZero(rv, __FILE__, __func__, __LINE__);
+                _advectRK4Batch(velocity, active.size(), past0s.data(), dts.data(), p1s.data(), rvs.data());
                 break;
             }
 
-            if (rv == SUCCESS) {
-                // The new particle *may* be the same as the old particle in case
-                // there's a sink, meaning the velocity is zero.
-                // In that case, we mark p1 as "special" and terminate the current stream.
-                if (p1.location == past0.location) {
-                    p1.SetSpecial(true);
-                    s.emplace_back(p1);
-                    _separatorCount[streamIdx]++;
-                    break;
-                } else {
-                    happened = true;
-                    s.emplace_back(p1);
-                    numberOfSteps++;
-                }
-            } else if (rv == MISSING_VAL) {
-                // This is the annoying part: there are multiple possiblities.
-                // 1) past0 is really located at a missing value location;
-                // 2) past0 is inside the volume, but really close to the boundary,
-                //    causing RK4 method to fail;
-                // 3) past0 is not at a missing location, but out of the volume.
-                //
-                // Note that we need to detect and deal with each of these possibilities
-                //   here instead of using the periodic capabilities of a grid class,
-                //   because the advection code needs to have knowledge when a pathline
-                //   exits from one side and comes back from another sice, and record
-                //   this event by inserting a separator. The separator will later be used
-                //   by the rendering code to break a pathline into segments.
-
-                glm::vec3 vel;
-                bool isMissing = (velocity->GetVelocity(past0.time, past0.location, vel) == MISSING_VAL);
-                bool isInside = velocity->InsideVolumeVelocity(past0.time, past0.location);
-
-                if (isInside && isMissing) {    // Case 1)
-                    // We identified a particle at a bad location.
-                    // We mark it as special, and terminate the current stream.
-                    past0.SetSpecial(true);
-                    _separatorCount[streamIdx]++;
-                    break;
-                } else if (isInside && (!isMissing)) {    // Case 2)
-                    // Use Euler advection for this particle.
-                    rv = _advectEuler(velocity, past0, dt, p1);
-                    assert(rv == 0);
-                    s.emplace_back(p1);
-                    numberOfSteps++;
-                } else {    // Case 3)
-                    // We identified a particle that's out of the volume.
-                    // We treat it depending on field periodicity.
-                    // In case of no periodicity, we mark this particle special and
-                    //    terminate the current stream.
-                    // In case of periodicity enabled, we apply it!
-                    if ((!_isPeriodic[0]) && (!_isPeriodic[1]) && (!_isPeriodic[2])) {
-                        past0.SetSpecial(true);
+            // Append the new particles, and decide which streams keep advancing.
+            nextActive.clear();
+            nextSteps.clear();
+            for (size_t a = 0; a < active.size(); a++) {
+                const size_t    streamIdx = active[a];
+                auto &          s = _streams[streamIdx];
+                const size_t    last = s.GetNumOfParticles() - 1;
+                const Particle &past0 = past0s[a];
+                const double    dt = dts[a];
+                Particle &      p1 = p1s[a];
+                int             rv = rvs[a];
+                size_t          numberOfSteps = steps[a];
+                _printNonZero(rv, __FILE__, __func__, __LINE__);
+
+                if (rv == SUCCESS) {
+                    // The new particle *may* be the same as the old particle in case
+                    // there's a sink, meaning the velocity is zero.
+                    // In that case, we mark p1 as "special" and terminate the current stream.
+                    if (p1.location == past0.location) {
+                        p1.SetSpecial(true);
+                        s.PushBack(p1);
                         _separatorCount[streamIdx]++;
-                        break;
+                        continue;
                     } else {
-                        auto loc = past0.location;
-                        for (int i = 0; i < 3; i++) {
-                            if (_isPeriodic[i]) 
-                              loc[i] = _applyPeriodic(loc[i], _periodicBounds[i][0], _periodicBounds[i][1]);
-                        }
-
-                        // Notice that loc isn't guaranteed to be inside the volume right now,
-                        // since periodic ain't enabled for all directions.
-                        // As a result, we need to test again
-                        if (velocity->InsideVolumeVelocity(past0.time, loc)) {
-                            past0.location = loc;
-                            Particle separator;
-                            separator.SetSpecial(true);
-                            auto it = s.end();
-                            --it;
-                            s.insert(it, separator);
+                        happened = true;
+                        s.PushBack(p1);
+                        numberOfSteps++;
+                    }
+                } else if (rv == MISSING_VAL) {
+                    // This is the annoying part: there are multiple possiblities.
+                    // 1) past0 is really located at a missing value location;
+                    // 2) past0 is inside the volume, but really close to the boundary,
+                    //    causing RK4 method to fail;
+                    // 3) past0 is not at a missing location, but out of the volume.
+                    //
+                    // Note that we need to detect and deal with each of these possibilities
+                    //   here instead of using the periodic capabilities of a grid class,
+                    //   because the advection code needs to have knowledge when a pathline
+                    //   exits from one side and comes back from another sice, and record
+                    //   this event by inserting a separator. The separator will later be used
+                    //   by the rendering code to break a pathline into segments.
+
+                    glm::vec3 vel;
+                    bool isMissing = (velocity->GetVelocity(past0.time, past0.location, vel) == MISSING_VAL);
+                    bool isInside = velocity->InsideVolumeVelocity(past0.time, past0.location);
+
+                    if (isInside && isMissing) {    // Case 1)
+                        // We identified a particle at a bad location.
+                        // We mark it as special, and terminate the current stream.
+                        s.SetSpecial(last, true);
+                        _separatorCount[streamIdx]++;
+                        continue;
+                    } else if (isInside && (!isMissing)) {    // Case 2)
+                        // Use Euler advection for this particle.
+                        rv = _advectEuler(velocity, past0, dt, p1);
+                        assert(rv == 0);
+                        s.PushBack(p1);
+                        numberOfSteps++;
+                    } else {    // Case 3)
+                        // We identified a particle that's out of the volume.
+                        // We treat it depending on field periodicity.
+                        // In case of no periodicity, we mark this particle special and
+                        //    terminate the current stream.
+                        // In case of periodicity enabled, we apply it!
+                        if ((!_isPeriodic[0]) && (!_isPeriodic[1]) && (!_isPeriodic[2])) {
+                            s.SetSpecial(last, true);
                             _separatorCount[streamIdx]++;
+                            continue;
                         } else {
-                            past0.SetSpecial(true);
-                            _separatorCount[streamIdx]++;
-                            break;
+                            auto loc = past0.location;
+                            for (int i = 0; i < 3; i++) {
+                                if (_isPeriodic[i]) 
+                                  loc[i] = _applyPeriodic(loc[i], _periodicBounds[i][0], _periodicBounds[i][1]);
+                            }
+
+                            // Notice that loc isn't guaranteed to be inside the volume right now,
+                            // since periodic ain't enabled for all directions.
+                            // As a result, we need to test again
+                            if (velocity->InsideVolumeVelocity(past0.time, loc)) {
+                                s.SetLocation(last, loc);
+                                Particle separator;
+                                separator.SetSpecial(true);
+                                s.Insert(last, separator);
+                                _separatorCount[streamIdx]++;
+                            } else {
+                                s.SetSpecial(last, true);
+                                _separatorCount[streamIdx]++;
+                                continue;
+                            }
                         }
                     }
-                }
 
-            }       // end (rv == MISSING_VAL) condition
-            else    // Advection wasn't successful for other reasons
-                break;
+                }       // end (rv == MISSING_VAL) condition
+                else    // Advection wasn't successful for other reasons
+                    continue;
 
-        }    // end loop for particle
-    }        // end loop for streams
+                nextActive.push_back(streamIdx);
+                nextSteps.push_back(numberOfSteps);
+            }    // end loop for streams in this batch
+            active.swap(nextActive);
+            steps.swap(nextSteps);
+        }    // end loop for particles
+    }        // end loop for batches
 
     velocity->UnlockParams();
 
@@ -194,7 +243,7 @@ int Advection::AdvectTillTime(Field *velocity, double startT, double deltaT, dou
     size_t maxSteps = 10000;
     for (auto &s : _streams)    // Process one stream at a time
     {
-        Particle p0 = s.back();    // Start from the last particle in this stream
+        Particle p0 = s.GetParticle(s.GetNumOfParticles() - 1);    // Start from the last particle in this stream
         if (p0.time < startT)      // Skip this stream if it didn't advance to startT
             continue;
 
@@ -204,10 +253,9 @@ int Advection::AdvectTillTime(Field *velocity, double startT, double deltaT, dou
             // Check if the particle is inside of the volume.
             // Wrap it along periodic dimensions if applicable.
             if (!velocity->InsideVolumeVelocity(p0.time, p0.location)) {
-                bool locChanged = false;
-                auto itr = s.end();
-                --itr;    // pointing to the last element
-                auto loc = itr->location;
+                bool         locChanged = false;
+                const size_t last = s.GetNumOfParticles() - 1;
+                auto         loc = s.GetLocation(last);
                 for (int i = 0; i < 3; i++) {
                     if (_isPeriodic[i]) {
                         loc[i] = _applyPeriodic(loc[i], _periodicBounds[i][0], _periodicBounds[i][1]);
@@ -218,13 +266,13 @@ int Advection::AdvectTillTime(Field *velocity, double startT, double deltaT, dou
                     break;          // break the while loop
 
                 // See if the new location is inside of the volume
-                if (velocity->InsideVolumeVelocity(itr->time, loc)) {
-                    itr->location = loc;
-                    p0 = *itr;    // p0 is equal to the wrapped particle
+                if (velocity->InsideVolumeVelocity(s.GetTime(last), loc)) {
+                    s.SetLocation(last, loc);
+                    p0 = s.GetParticle(last);    // p0 is equal to the wrapped particle
 
                     Particle separator;
                     separator.SetSpecial(true);
-                    s.insert(itr, separator);
+                    s.Insert(last, separator);
                     _separatorCount[streamIdx]++;
                 } else {
                     break;    // break the while loop
@@ -232,16 +280,15 @@ int Advection::AdvectTillTime(Field *velocity, double startT, double deltaT, dou
 
             } // Finish the out-of-volume condition
 
-            double dt = deltaT;
-            if (s.size() > 2)    // If there are at least 3 particles in the stream,
-            {                    // we also adjust *dt*
+            double       dt = deltaT;
+            const size_t n = s.GetNumOfParticles();
+            if (n > 2)    // If there are at least 3 particles in the stream,
+            {             // we also adjust *dt*
                 double mindt = deltaT / 20.0, maxdt = deltaT * 20.0;
                 maxdt = glm::min(maxdt, targetT - p0.time);
-                const auto &past1 = s[s.size() - 2];
-                const auto &past2 = s[s.size() - 3];
-                if ((!past1.IsSpecial()) && (!past2.IsSpecial())) {
-                    dt = p0.time - past1.time;    // step size used by last integration
-                    dt *= _calcAdjustFactor(past2, past1, p0);
+                if ((!s.IsSpecial(n - 2)) && (!s.IsSpecial(n - 3))) {
+                    dt = p0.time - s.GetTime(n - 2);    // step size used by last integration
+                    dt *= _calcAdjustFactor(s.GetLocation(n - 3), s.GetLocation(n - 2), p0.location);
                     dt = glm::clamp(dt, mindt, maxdt);
                 }
             }
@@ -262,7 +309,7 @@ int Advection::AdvectTillTime(Field *velocity, double startT, double deltaT, dou
                 break;
             } else {    // Advection successful, keep the new particle.
                 happened = true;
-                s.push_back(p1);
+                s.PushBack(p1);
                 p0 = p1;
             }
 
@@ -296,17 +343,17 @@ int Advection::CalculateParticleValues(Field *scalar, bool skipNonZero)
         _valueVarName = scalar->ScalarName;
 
         for (auto &s : _streams) {
-            for (auto &p : s) {
+            for (size_t i = 0; i < s.GetNumOfParticles(); i++) {
                 // Skip this particle if it's a separator
-                if (p.IsSpecial()) continue;
+                if (s.IsSpecial(i)) continue;
 
                 // Do not evaluate this particle if its value is non-zero
-                if (skipNonZero && p.value != 0.0f) continue;
+                if (skipNonZero && s.GetValue(i) != 0.0f) continue;
 
                 float value;
-                int   rv = scalar->GetScalar(p.time, p.location, value);
-                if (rv == 0)            // The end of a stream could be outside of the volume,
-                    p.value = value;    // so let's only color it when the return value is 0.
+                int   rv = scalar->GetScalar(s.GetTime(i), s.GetLocation(i), value);
+                if (rv == 0)                // The end of a stream could be outside of the volume,
+                    s.SetValue(i, value);    // so let's only color it when the return value is 0.
             }
         }
 
@@ -316,23 +363,22 @@ int Advection::CalculateParticleValues(Field *scalar, bool skipNonZero)
     else {
         size_t mostSteps = 0;
         for (auto &s : _streams) {
-            if (s.size() > mostSteps) mostSteps = s.size();
+            if (s.GetNumOfParticles() > mostSteps) mostSteps = s.GetNumOfParticles();
         }
 
         _valueVarName = scalar->ScalarName;
 
         for (size_t i = 0; i < mostSteps; i++) {
             for (auto &s : _streams) {
-                if (i < s.size()) {
-                    auto &p = s[i];
-                    if (p.IsSpecial()) continue;
+                if (i < s.GetNumOfParticles()) {
+                    if (s.IsSpecial(i)) continue;
 
                     // Do not evaluate this particle if its value is non-zero
-                    if (skipNonZero && p.value != 0.0f) continue;
+                    if (skipNonZero && s.GetValue(i) != 0.0f) continue;
 
                     float val;
-                    int   rv = scalar->GetScalar(p.time, p.location, val);
-                    if (rv == 0) p.value = val;
+                    int   rv = scalar->GetScalar(s.GetTime(i), s.GetLocation(i), val);
+                    if (rv == 0) s.SetValue(i, val);
                 }
             }    // end of a stream
         }        // end of all steps
@@ -352,12 +398,10 @@ int Advection::CalculateParticleIntegratedValues(Field *scalar, const bool skipN
         _valueVarName = scalar->ScalarName;
 
         for (auto &s : _streams) {
-            if (s.size() && !s[0].IsSpecial()) s[0].value = 0;
+            if (!s.IsEmpty() && !s.IsSpecial(0)) s.SetValue(0, 0);
 
-            for (int i = 1; i < s.size(); i++) {
-                auto &prev = s[i - 1];
-                auto &p = s[i];
-                _calculateParticleIntegratedValue(p, prev, scalar, skipNonZero, distScale, integrateWithinVolumeMin, integrateWithinVolumeMax);
+            for (size_t i = 1; i < s.GetNumOfParticles(); i++) {
+                _calculateParticleIntegratedValue(s, i, scalar, skipNonZero, distScale, integrateWithinVolumeMin, integrateWithinVolumeMax);
             }
         }
 
@@ -367,20 +411,18 @@ int Advection::CalculateParticleIntegratedValues(Field *scalar, const bool skipN
     else {
         size_t mostSteps = 0;
         for (auto &s : _streams) {
-            if (s.size() > mostSteps) mostSteps = s.size();
+            if (s.GetNumOfParticles() > mostSteps) mostSteps = s.GetNumOfParticles();
         }
 
         _valueVarName = scalar->ScalarName;
 
         for (auto &s : _streams)
-            if (s.size() && !s[0].IsSpecial()) s[0].value = 0;
+            if (!s.IsEmpty() && !s.IsSpecial(0)) s.SetValue(0, 0);
 
         for (size_t i = 1; i < mostSteps; i++) {
             for (auto &s : _streams) {
-                if (i < s.size()) {
-                    auto &prev = s[i - 1];
-                    auto &p = s[i];
-                    _calculateParticleIntegratedValue(p, prev, scalar, skipNonZero, distScale, integrateWithinVolumeMin, integrateWithinVolumeMax);
+                if (i < s.GetNumOfParticles()) {
+                    _calculateParticleIntegratedValue(s, i, scalar, skipNonZero, distScale, integrateWithinVolumeMin, integrateWithinVolumeMax);
                 }
             }    // end of a stream
         }        // end of all steps
@@ -389,33 +431,35 @@ int Advection::CalculateParticleIntegratedValues(Field *scalar, const bool skipN
     return 0;
 }
 
-void Advection::_calculateParticleIntegratedValue(Particle &p, const Particle &prev, const Field *scalarField, const bool skipNonZero, const float distScale,
+void Advection::_calculateParticleIntegratedValue(ParticleStream &s, size_t i, const Field *scalarField, const bool skipNonZero, const float distScale,
                                                   const std::vector<double> &integrateWithinVolumeMin, const std::vector<double> &integrateWithinVolumeMax) const
 {
     // Skip this particle if it is a separator
-    if (p.IsSpecial()) return;
-    if (prev.IsSpecial()) {
-        p.value = 0;
+    if (s.IsSpecial(i)) return;
+    if (s.IsSpecial(i - 1)) {
+        s.SetValue(i, 0);
         return;
     }
 
     // Do not evaluate this particle if its value is non-zero
-    if (skipNonZero && p.value != 0.0f) return;
+    if (skipNonZero && s.GetValue(i) != 0.0f) return;
 
-    if (!_isParticleInsideVolume(p, integrateWithinVolumeMin, integrateWithinVolumeMax)) {
-        p.value = prev.value;
+    const float prevValue = s.GetValue(i - 1);
+
+    if (!_isParticleInsideVolume(s.GetLocation(i), integrateWithinVolumeMin, integrateWithinVolumeMax)) {
+        s.SetValue(i, prevValue);
         return;
     }
 
     float value;
-    int   rv = scalarField->GetScalar(p.time, p.location, value);
+    int   rv = scalarField->GetScalar(s.GetTime(i), s.GetLocation(i), value);
     if (rv != 0) {    // If non-0, then outside the volume
-        p.value = prev.value;
+        s.SetValue(i, prevValue);
         return;
     }
 
-    float dist = glm::distance(prev.location, p.location);
-    p.value = prev.value + value * dist * distScale;
+    float dist = glm::distance(s.GetLocation(i - 1), s.GetLocation(i));
+    s.SetValue(i, prevValue + value * dist * distScale);
 }
 
 void Advection::SetAllStreamValuesToFinalValue(int realNSamples)
@@ -424,18 +468,18 @@ void Advection::SetAllStreamValuesToFinalValue(int realNSamples)
         float finalValue = 0;
 
         int sampleCount = 0;
-        for (auto &p : s) {
-            if (!p.IsSpecial()) {
-                finalValue = p.value;
+        for (size_t i = 0; i < s.GetNumOfParticles(); i++) {
+            if (!s.IsSpecial(i)) {
+                finalValue = s.GetValue(i);
                 sampleCount++;
             }
             if (sampleCount == realNSamples) break;
         }
 
         int setCount = 0;
-        for (auto &p : s) {
-            if (!p.IsSpecial()) {
-                p.value = finalValue;
+        for (size_t i = 0; i < s.GetNumOfParticles(); i++) {
+            if (!s.IsSpecial(i)) {
+                s.SetValue(i, finalValue);
                 setCount++;
             }
             if (setCount == sampleCount) break;
@@ -450,46 +494,45 @@ int Advection::CalculateParticleProperties(Field *scalar)
 
     // Proceed if there is no current scalar property
     _propertyVarNames.emplace_back(scalar->ScalarName);
+    const size_t propIdx = _propertyVarNames.size() - 1;
+    for (auto &s : _streams) {
+        size_t idx = s.AddProperty();
+        assert(idx == propIdx);
+    }
 
     // Test if this scalar field is the same as the one used to calculate particle values,
     //   if so, copy over the values.
     if (scalar->ScalarName == _valueVarName) {
-        for (auto &s : _streams) {
-            for (auto &p : s) { p.AttachProperty(p.value); }
-        }
+        for (auto &s : _streams) { std::copy(s.GetValues(), s.GetValues() + s.GetNumOfParticles(), s.GetProperty(propIdx)); }
 
         return 0;
     }
 
     // In case this property field is a brand new variable, we do the actual sampling work.
+    // At the end of a flow line, a particle might be outside of the volume.
+    // Its property stays nan in that case.
     if (scalar->IsSteady) {
         if (scalar->LockParams() != 0) return PARAMS_ERROR;
 
         for (auto &s : _streams) {
-            for (auto &p : s) {
-                if (p.IsSpecial()) continue;
-
-                // At the end of a flow line, a particle might be outside of the volume.
-                // We attach something in that case as well.
-                float val = std::nanf("1");
-                scalar->GetScalar(p.time, p.location, val);
-                p.AttachProperty(val);
+            float *prop = s.GetProperty(propIdx);
+            for (size_t i = 0; i < s.GetNumOfParticles(); i++) {
+                if (s.IsSpecial(i)) continue;
+
+                scalar->GetScalar(s.GetTime(i), s.GetLocation(i), prop[i]);
             }
         }
     } else {
         size_t mostSteps = 0;
         for (const auto &s : _streams)
-            if (s.size() > mostSteps) mostSteps = s.size();
+            if (s.GetNumOfParticles() > mostSteps) mostSteps = s.GetNumOfParticles();
 
         for (size_t i = 0; i < mostSteps; i++) {
             for (auto &s : _streams) {
-                if (i < s.size()) {
-                    auto &p = s[i];
-                    if (p.IsSpecial()) continue;
+                if (i < s.GetNumOfParticles()) {
+                    if (s.IsSpecial(i)) continue;
 
-                    float value = std::nanf("1");
-                    scalar->GetScalar(p.time, p.location, value);
-                    p.AttachProperty(value);
+                    scalar->GetScalar(s.GetTime(i), s.GetLocation(i), s.GetProperty(propIdx)[i]);
                 }
             }
         }
@@ -503,8 +546,8 @@ void Advection::CalculateParticleHistogram(std::vector<double> &outBounds, std::
     std::vector<float> samples;
 
     for (const auto &s : _streams)
-        for (const auto &p : s)
-            if (!p.IsSpecial()) samples.push_back(p.value);
+        for (size_t i = 0; i < s.GetNumOfParticles(); i++)
+            if (!s.IsSpecial(i)) samples.push_back(s.GetValue(i));
 
     auto  bounds = std::minmax_element(samples.begin(), samples.end());
     float minValue = *bounds.first;
@@ -558,10 +601,79 @@ int Advection::_advectRK4(Field *velocity, const Particle &p0, double dt, Partic
     return 0;
 }
 
-float Advection::_calcAdjustFactor(const Particle &p2, const Particle &p1, const Particle &p0) const
+void Advection::_advectEulerBatch(Field *velocity, size_t n, const Particle *p0, const double *dt, Particle *p1, int *rv) const
+{
+    std::vector<double>    times(n);
+    std::vector<glm::vec3> locs(n), v0(n);
+    for (size_t i = 0; i < n; i++) {
+        times[i] = p0[i].time;
+        locs[i] = p0[i].location;
+    }
+
+    velocity->GetVelocities(n, times.data(), locs.data(), v0.data(), rv);
+
+    for (size_t i = 0; i < n; i++) {
+        if (rv[i] != 0) continue;
+        float dt32 = float(dt[i]);    // glm is strict about data types (which is a good thing).
+        p1[i].location = p0[i].location + dt32 * v0[i];
+        p1[i].time = p0[i].time + dt[i];
+    }
+}
+
+void Advection::_advectRK4Batch(Field *velocity, size_t n, const Particle *p0, const double *dt, Particle *p1, int *rv) const
+{
+    std::vector<glm::vec3> k1(n), k2(n), k3(n), k4(n);
+
+    // Particles still being advanced. A particle drops out at the first
+    // stage that fails, leaving that stage's return code in rv.
+    std::vector<size_t>    live(n);
+    std::vector<double>    times(n);
+    std::vector<glm::vec3> locs(n), vels(n);
+    std::vector<int>       rvs(n);
+    for (size_t i = 0; i < n; i++) live[i] = i;
+
+    // Evaluate stage k at p0 advanced by frac*dt along the previous stage,
+    // for all live particles, and drop those that failed.
+    auto stage = [&](std::vector<glm::vec3> &k, const std::vector<glm::vec3> *prev, double frac) {
+        for (size_t m = 0; m < live.size(); m++) {
+            const size_t i = live[m];
+            if (prev) {
+                times[m] = p0[i].time + dt[i] * frac;
+                locs[m] = p0[i].location + float(dt[i] * frac) * (*prev)[i];
+            } else {
+                times[m] = p0[i].time;
+                locs[m] = p0[i].location;
+            }
+        }
+        velocity->GetVelocities(live.size(), times.data(), locs.data(), vels.data(), rvs.data());
+
+        size_t kept = 0;
+        for (size_t m = 0; m < live.size(); m++) {
+            const size_t i = live[m];
+            k[i] = vels[m];
+            rv[i] = rvs[m];
+            _printNonZero(rv[i], __FILE__, __func__, __LINE__);
+            if (rv[i] == 0) live[kept++] = i;
+        }
+        live.resize(kept);
+    };
+
+    stage(k1, nullptr, 0.0);
+    stage(k2, &k1, 0.5);
+    stage(k3, &k2, 0.5);
+    stage(k4, &k3, 1.0);
+
+    for (size_t i : live) {
+        const float dt32 = float(dt[i]);    // glm is strict about data types (which is a good thing).
+        p1[i].location = p0[i].location + dt32 / 6.0f * (k1[i] + 2.0f * (k2[i] + k3[i]) + k4[i]);
+        p1[i].time = p0[i].time + dt[i];
+    }
+}
+
+float Advection::_calcAdjustFactor(const glm::vec3 &p2, const glm::vec3 &p1, const glm::vec3 &p0) const
 {
-    glm::vec3 p2p1 = p1.location - p2.location;
-    glm::vec3 p1p0 = p0.location - p1.location;
+    glm::vec3 p2p1 = p1 - p2;
+    glm::vec3 p1p0 = p0 - p1;
     float     denominator = glm::length(p2p1) * glm::length(p1p0);
     float     cosine;
     if (denominator < 1e-7)
@@ -579,7 +691,7 @@ float Advection::_calcAdjustFactor(const Particle &p2, const Particle &p1, const
 
 size_t Advection::GetNumberOfStreams() const { return _streams.size(); }
 
-const std::vector<Particle> &Advection::GetStreamAt(size_t i) const
+const ParticleStream &Advection::GetStreamAt(size_t i) const
 {
     // Since this function is almost always used together with GetNumberOfStreams(),
     // I'm offloading the range check to std::vector.
@@ -591,7 +703,7 @@ size_t Advection::GetMaxNumOfPart() const
     size_t max = 0;
     size_t idx = 0;
     for (const auto &s : _streams) {
-        size_t num = s.size() - _separatorCount[idx];
+        size_t num = s.GetNumOfParticles() - _separatorCount[idx];
         if (num > max) max = num;
         idx++;
     }
@@ -601,8 +713,7 @@ size_t Advection::GetMaxNumOfPart() const
 void Advection::ClearParticleProperties()
 {
     _propertyVarNames.clear();
-    for (auto &stream : _streams)
-        for (auto &part : stream) part.ClearProperty();
+    for (auto &stream : _streams) stream.ClearProperties();
 }
 
 void Advection::RemoveParticleProperty(const std::string &varToRemove)
@@ -615,17 +726,15 @@ void Advection::RemoveParticleProperty(const std::string &varToRemove)
     else {
         auto rmI = std::distance(_propertyVarNames.begin(), itr);
         _propertyVarNames.erase(itr);
-        for (auto &stream : _streams)
-            for (auto &part : stream) part.RemoveProperty(rmI);
+        for (auto &stream : _streams) stream.RemoveProperty(rmI);
     }
 }
 
 void Advection::ResetParticleValues()
 {
     for (auto &stream : _streams) {
-        std::for_each(stream.begin(), stream.end(), [](Particle &p) {
-            if (!p.IsSpecial()) p.value = 0.0f;
-        });
+        for (size_t i = 0; i < stream.GetNumOfParticles(); i++)
+            if (!stream.IsSpecial(i)) stream.SetValue(i, 0.0f);
     }
 }
 
@@ -689,9 +798,9 @@ auto Advection::GetValueVarName() const -> std::string { return _valueVarName; }
 
 auto Advection::GetPropertyVarNames() const -> std::vector<std::string> { return _propertyVarNames; }
 
-bool Advection::_isParticleInsideVolume(const Particle &p, const std::vector<double> &min, const std::vector<double> &max)
+bool Advection::_isParticleInsideVolume(const glm::vec3 &loc, const std::vector<double> &min, const std::vector<double> &max)
 {
-    if (p.location[0] < min[0] || p.location[1] < min[1] || p.location[0] > max[0] || p.location[1] > max[1]) { return false; }
-    if (min.size() > 2 && (p.location[2] < min[2] || p.location[2] > max[2])) { return false; }
+    if (loc[0] < min[0] || loc[1] < min[1] || loc[0] > max[0] || loc[1] > max[1]) { return false; }
+    if (min.size() > 2 && (loc[2] < min[2] || loc[2] > max[2])) { return false; }
     return true;
 }
@@ -2,7 +2,6 @@
 #include <fstream>
 #include <sstream>
 #include <algorithm>
-#include <iterator>    // std::distance
 #include <cctype>
 #include "vapor/AdvectionIO.h"
 #include "vapor/UDUnitsClass.h"
@@ -50,23 +49,25 @@ auto flow::OutputFlowlinesNumSteps(const Advection *adv, const char *filename, s
     for (size_t s_idx = 0; s_idx < adv->GetNumberOfStreams(); s_idx++) {
         const auto &stream = adv->GetStreamAt(s_idx);
 
+        // A quick sanity check
+        assert(stream.GetNumOfProperties() == propertyNames.size());
+
         size_t step = 0;
-        for (const auto &p : stream) {
-            if (!p.IsSpecial()) {
+        for (size_t i = 0; i < stream.GetNumOfParticles(); i++) {
+            if (!stream.IsSpecial(i)) {
+                const auto &loc = stream.GetLocation(i);
+
                 // Let's convert the time!
-                udunits.DecodeTime(p.time, &year, &month, &day, &hour, &minute, &second);
+                udunits.DecodeTime(stream.GetTime(i), &year, &month, &day, &hour, &minute, &second);
 
                 // Let's also convert geo coordinates if needed.
-                cX = p.location.x;
-                cY = p.location.y;
+                cX = loc.x;
+                cY = loc.y;
                 if (needGeoConversion) { proj4API.Transform(&cX, &cY, 1); }
 
-                std::fprintf(f, "%lu, %f, %f, %f, %4.4d-%2.2d-%2.2d_%2.2d:%2.2d:%2.2d", s_idx, cX, cY, p.location.z, year, month, day, hour, minute, second);
+                std::fprintf(f, "%lu, %f, %f, %f, %4.4d-%2.2d-%2.2d_%2.2d:%2.2d:%2.2d", s_idx, cX, cY, loc.z, year, month, day, hour, minute, second);
 
-                auto props = p.GetPropertyList();
-                // A quick sanity check
-                assert(std::distance(props.cbegin(), props.cend()) == propertyNames.size());
-                for (const auto &val : props) std::fprintf(f, ", %f", val);
+                for (size_t j = 0; j < stream.GetNumOfProperties(); j++) std::fprintf(f, ", %f", stream.GetProperty(j)[i]);
 
                 std::fprintf(f, "\n");    // end of one line
                 step++;
@@ -123,24 +124,26 @@ auto flow::OutputFlowlinesMaxTime(const Advection *adv, const char *filename, do
     for (size_t s_idx = 0; s_idx < adv->GetNumberOfStreams(); s_idx++) {
         const auto &stream = adv->GetStreamAt(s_idx);
 
-        for (const auto &p : stream) {
-            if (p.time > maxTime) break;
+        // A quick sanity check
+        assert(stream.GetNumOfProperties() == propertyNames.size());
+
+        for (size_t i = 0; i < stream.GetNumOfParticles(); i++) {
+            if (stream.GetTime(i) > maxTime) break;
+
+            if (!stream.IsSpecial(i)) {
+                const auto &loc = stream.GetLocation(i);
 
-            if (!p.IsSpecial()) {
                 // Let's convert the time!
-                udunits.DecodeTime(p.time, &year, &month, &day, &hour, &minute, &second);
+                udunits.DecodeTime(stream.GetTime(i), &year, &month, &day, &hour, &minute, &second);
 
                 // Let's also convert geo coordinates if needed.
-                cX = p.location.x;
-                cY = p.location.y;
+                cX = loc.x;
+                cY = loc.y;
                 if (needGeoConversion) { proj4API.Transform(&cX, &cY, 1); }
 
-                std::fprintf(f, "%lu, %f, %f, %f, %4.4d-%2.2d-%2.2d_%2.2d:%2.2d:%2.2d", s_idx, cX, cY, p.location.z, year, month, day, hour, minute, second);
+                std::fprintf(f, "%lu, %f, %f, %f, %4.4d-%2.2d-%2.2d_%2.2d:%2.2d:%2.2d", s_idx, cX, cY, loc.z, year, month, day, hour, minute, second);
 
-                auto props = p.GetPropertyList();
-                // A quick sanity check
-                assert(std::distance(props.cbegin(), props.cend()) == propertyNames.size());
-                for (const auto &val : props) std::fprintf(f, ", %f", val);
+                for (size_t j = 0; j < stream.GetNumOfProperties(); j++) std::fprintf(f, ", %f", stream.GetProperty(j)[i]);
 
                 std::fprintf(f, "\n");    // end of one line
             }
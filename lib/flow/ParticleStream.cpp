@@ -0,0 +1,63 @@
+#include "vapor/ParticleStream.h"
+
+using namespace flow;
+
+void ParticleStream::Reserve(size_t n)
+{
+    _locations.reserve(n);
+    _times.reserve(n);
+    _values.reserve(n);
+    for (auto &prop : _properties) prop.reserve(n);
+}
+
+void ParticleStream::Clear()
+{
+    _locations.clear();
+    _times.clear();
+    _values.clear();
+    _properties.clear();
+}
+
+void ParticleStream::PushBack(const Particle &p)
+{
+    _locations.push_back(p.location);
+    _times.push_back(p.time);
+    _values.push_back(p.value);
+    for (auto &prop : _properties) prop.push_back(std::nanf("1"));
+}
+
+void ParticleStream::Insert(size_t i, const Particle &p)
+{
+    _locations.insert(_locations.begin() + i, p.location);
+    _times.insert(_times.begin() + i, p.time);
+    _values.insert(_values.begin() + i, p.value);
+    for (auto &prop : _properties) prop.insert(prop.begin() + i, std::nanf("1"));
+}
+
+void ParticleStream::SetParticle(size_t i, const Particle &p)
+{
+    _locations[i] = p.location;
+    _times[i] = p.time;
+    _values[i] = p.value;
+}
+
+void ParticleStream::SetSpecial(size_t i, bool isSpecial)
+{
+    // Use the same convention as a single Particle.
+    Particle p = GetParticle(i);
+    p.SetSpecial(isSpecial);
+    SetParticle(i, p);
+}
+
+size_t ParticleStream::AddProperty()
+{
+    _properties.emplace_back(_times.size(), std::nanf("1"));
+    return _properties.size() - 1;
+}
+
+void ParticleStream::RemoveProperty(size_t i)
+{
+    if (i < _properties.size()) _properties.erase(_properties.begin() + i);
+}
+
+void ParticleStream::ClearProperties() { _properties.clear(); }
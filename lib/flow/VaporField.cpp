@@ -1,5 +1,16 @@
 #include "vapor/VaporField.h"
 #include "vapor/ConstantGrid.h"
+#include "vapor/RegularGrid.h"
+#include "vapor/StretchedGrid.h"
+#include "vapor/utils.h"
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+#endif
+#include <map>
+#include <memory>
 
 using namespace flow;
 
@@ -215,6 +226,257 @@ int VaporField::GetVelocityIntersection(size_t ts, glm::vec3 &minxyz, glm::vec3
     return 0;
 }
 
+namespace {
+
+//
+// Samples the three components of a velocity field at one position.
+//
+// When the three grids are all RegularGrid or all StretchedGrid, and share
+// the same mesh, blocking, and interpolation order, the cell containing a
+// position is located once and used for all three components. With linear
+// interpolation the three components are interpolated together with SIMD
+// instructions.
+// The result is identical to calling Grid::GetValue() on each grid, which
+// is what happens for any other combination of grids, and for the
+// components of a cell that touches a missing value.
+//
+class VelocitySampler {
+public:
+    VelocitySampler(const std::array<const VAPoR::Grid *, 3> &grids);
+
+    void Sample(const VAPoR::CoordType &coords, float vel[3]) const;
+
+    float GetMissingValue(int i) const { return _mv[i]; }
+
+private:
+    enum { SLOW, REGULAR, STRETCHED };
+
+    std::array<const VAPoR::Grid *, 3> _grids;
+    float                              _mv[3];
+    int                                _mesh = SLOW;
+    int                                _order = 0;
+    VAPoR::DimsType                    _dims, _bs, _bdims;
+    VAPoR::CoordType                   _minu, _maxu, _delta;
+    const std::vector<double> *        _coords[3] = {nullptr, nullptr, nullptr};    // StretchedGrid only
+
+    bool _locate(const VAPoR::CoordType &coords, size_t idx[3], double wgt[3], bool upper[3]) const;
+    void _sampleNode(const size_t idx[3], const bool upper[3], float vel[3]) const;
+    void _sampleCell(const VAPoR::CoordType &coords, const size_t idx[3], const double wgt[3], float vel[3]) const;
+};
+
+VelocitySampler::VelocitySampler(const std::array<const VAPoR::Grid *, 3> &grids) : _grids(grids)
+{
+    for (int i = 0; i < 3; i++) _mv[i] = grids[i]->GetMissingValue();
+
+    const VAPoR::Grid *g0 = grids[0];
+    std::string        type = g0->GetType();
+    if (type != VAPoR::RegularGrid::GetClassType() && type != VAPoR::StretchedGrid::GetClassType()) return;
+    if (g0->GetGeometryDim() != 3 || g0->GetNumDimensions() != 3) return;
+
+    const auto &dims = g0->GetDimensions();
+    for (int d = 0; d < 3; d++)
+        if (dims[d] < 2) return;
+
+    for (const auto *g : grids) {
+        if (g->GetType() != type) return;
+        if (g->GetDimensions() != dims) return;
+        if (g->GetBlockSize() != g0->GetBlockSize()) return;
+        if (g->GetBlks().empty()) return;
+        if (g->GetInterpolationOrder() != g0->GetInterpolationOrder()) return;
+        for (bool p : g->GetPeriodic())
+            if (p) return;
+    }
+
+    _order = g0->GetInterpolationOrder();
+    _dims = dims;
+    for (int d = 0; d < 3; d++) {
+        _bs[d] = g0->GetBlockSize()[d];
+        _bdims[d] = ((_dims[d] - 1) / _bs[d]) + 1;
+    }
+
+    if (type == VAPoR::RegularGrid::GetClassType()) {
+        g0->GetUserExtents(_minu, _maxu);
+        for (int i = 1; i < 3; i++) {
+            VAPoR::CoordType minu, maxu;
+            grids[i]->GetUserExtents(minu, maxu);
+            if (minu != _minu || maxu != _maxu) return;
+        }
+        for (int d = 0; d < 3; d++) _delta[d] = (_maxu[d] - _minu[d]) / (double)(_dims[d] - 1);
+        _mesh = REGULAR;
+    } else {
+        const auto *sg0 = dynamic_cast<const VAPoR::StretchedGrid *>(g0);
+        if (!sg0) return;
+        for (int i = 1; i < 3; i++) {
+            const auto *sg = dynamic_cast<const VAPoR::StretchedGrid *>(grids[i]);
+            if (!sg) return;
+            if (sg->GetXCoords() != sg0->GetXCoords() || sg->GetYCoords() != sg0->GetYCoords() || sg->GetZCoords() != sg0->GetZCoords()) return;
+        }
+        _coords[0] = &sg0->GetXCoords();
+        _coords[1] = &sg0->GetYCoords();
+        _coords[2] = &sg0->GetZCoords();
+        _mesh = STRETCHED;
+    }
+}
+
+// Find the cell containing coords, and the interpolation weight of the
+// lower node along each axis, exactly as RegularGrid::GetValueLinear() and
+// StretchedGrid::GetValueLinear() do. upper tells along which axes the
+// upper node is the nearest one, as decided by GetValueNearestNeighbor().
+//
+bool VelocitySampler::_locate(const VAPoR::CoordType &coords, size_t idx[3], double wgt[3], bool upper[3]) const
+{
+    if (_mesh == REGULAR) {
+        for (int d = 0; d < 3; d++)
+            if (coords[d] < _minu[d] || coords[d] > _maxu[d]) return false;
+
+        for (int d = 0; d < 3; d++) {
+            idx[d] = (size_t)floor((coords[d] - _minu[d]) / _delta[d]);
+            double frac = ((coords[d] - _minu[d]) - (idx[d] * _delta[d])) / _delta[d];
+            wgt[d] = 1.0 - frac;
+            upper[d] = frac > 0.5;
+        }
+    } else {
+        for (int d = 0; d < 3; d++) {
+            const std::vector<double> &c = *_coords[d];
+            if (!Wasp::BinarySearchRange(c, coords[d], idx[d])) return false;
+            wgt[d] = 1.0 - (coords[d] - c[idx[d]]) / (c[idx[d] + 1] - c[idx[d]]);
+            upper[d] = wgt[d] < 0.5;
+        }
+    }
+    return true;
+}
+
+// Value of the three components at the node nearest to a position, as
+// Grid::AccessIJK() would return it.
+//
+void VelocitySampler::_sampleNode(const size_t idx[3], const bool upper[3], float vel[3]) const
+{
+    size_t n[3];
+    for (int d = 0; d < 3; d++) n[d] = std::min(idx[d] + (upper[d] ? 1 : 0), _dims[d] - 1);
+
+    size_t blk = (n[2] / _bs[2]) * _bdims[0] * _bdims[1] + (n[1] / _bs[1]) * _bdims[0] + (n[0] / _bs[0]);
+    size_t off = (n[2] % _bs[2]) * _bs[0] * _bs[1] + (n[1] % _bs[1]) * _bs[0] + (n[0] % _bs[0]);
+    for (int comp = 0; comp < 3; comp++) vel[comp] = _grids[comp]->GetBlks()[blk][off];
+}
+
+// Trilinear interpolation of the three components of one cell, identical
+// to Grid::TrilinearInterpolate() on each component.
+//
+void VelocitySampler::_sampleCell(const VAPoR::CoordType &coords, const size_t idx[3], const double wgt[3], float vel[3]) const
+{
+    // Nodes beyond the last one are clamped, as Grid::AccessIJK() does.
+    // The top layer is only needed if the cell isn't on the last plane.
+    //
+    const bool   top = idx[2] < _dims[2] - 1;
+    const size_t i[2] = {idx[0], std::min(idx[0] + 1, _dims[0] - 1)};
+    const size_t j[2] = {idx[1], std::min(idx[1] + 1, _dims[1] - 1)};
+    const size_t k[2] = {idx[2], std::min(idx[2] + 1, _dims[2] - 1)};
+
+    // Gather the 8 corners of all three components. Node addresses are
+    // computed once since the grids share the same blocking.
+    // Lane 3 is padding.
+    //
+    alignas(32) float corner[8][4];
+    bool              missing[3] = {false, false, false};
+    const int         nlayers = top ? 2 : 1;
+    for (int kk = 0; kk < nlayers; kk++) {
+        for (int jj = 0; jj < 2; jj++) {
+            for (int ii = 0; ii < 2; ii++) {
+                size_t blk = (k[kk] / _bs[2]) * _bdims[0] * _bdims[1] + (j[jj] / _bs[1]) * _bdims[0] + (i[ii] / _bs[0]);
+                size_t off = (k[kk] % _bs[2]) * _bs[0] * _bs[1] + (j[jj] % _bs[1]) * _bs[0] + (i[ii] % _bs[0]);
+
+                float *c = corner[kk * 4 + jj * 2 + ii];
+                for (int comp = 0; comp < 3; comp++) {
+                    c[comp] = _grids[comp]->GetBlks()[blk][off];
+                    if (c[comp] == _mv[comp]) missing[comp] = true;
+                }
+                c[3] = 0.0f;
+            }
+        }
+    }
+    if (!top)
+        for (int n = 4; n < 8; n++)
+            for (int comp = 0; comp < 4; comp++) corner[n][comp] = 0.0f;
+
+    // Bilinear interpolation of the bottom and top layers, for all three
+    // components at once. Computed in double precision and rounded to
+    // float like Grid::BilinearInterpolate().
+    //
+    alignas(16) float layer[2][4];
+#if defined(__AVX__)
+    const __m256d xw = _mm256_set1_pd(wgt[0]), xw1 = _mm256_set1_pd(1.0 - wgt[0]);
+    const __m256d yw = _mm256_set1_pd(wgt[1]), yw1 = _mm256_set1_pd(1.0 - wgt[1]);
+    for (int l = 0; l < nlayers; l++) {
+        const __m256d c0 = _mm256_cvtps_pd(_mm_load_ps(corner[l * 4 + 0]));
+        const __m256d c1 = _mm256_cvtps_pd(_mm_load_ps(corner[l * 4 + 1]));
+        const __m256d c2 = _mm256_cvtps_pd(_mm_load_ps(corner[l * 4 + 2]));
+        const __m256d c3 = _mm256_cvtps_pd(_mm_load_ps(corner[l * 4 + 3]));
+        const __m256d lo = _mm256_mul_pd(_mm256_add_pd(_mm256_mul_pd(c0, xw), _mm256_mul_pd(c1, xw1)), yw);
+        const __m256d hi = _mm256_mul_pd(_mm256_add_pd(_mm256_mul_pd(c2, xw), _mm256_mul_pd(c3, xw1)), yw1);
+        _mm_store_ps(layer[l], _mm256_cvtpd_ps(_mm256_add_pd(lo, hi)));
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    const __m128d xw = _mm_set1_pd(wgt[0]), xw1 = _mm_set1_pd(1.0 - wgt[0]);
+    const __m128d yw = _mm_set1_pd(wgt[1]), yw1 = _mm_set1_pd(1.0 - wgt[1]);
+    for (int l = 0; l < nlayers; l++) {
+        for (int h = 0; h < 4; h += 2) {
+            const __m128d c0 = _mm_cvtps_pd(_mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)&corner[l * 4 + 0][h]));
+            const __m128d c1 = _mm_cvtps_pd(_mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)&corner[l * 4 + 1][h]));
+            const __m128d c2 = _mm_cvtps_pd(_mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)&corner[l * 4 + 2][h]));
+            const __m128d c3 = _mm_cvtps_pd(_mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)&corner[l * 4 + 3][h]));
+            const __m128d lo = _mm_mul_pd(_mm_add_pd(_mm_mul_pd(c0, xw), _mm_mul_pd(c1, xw1)), yw);
+            const __m128d hi = _mm_mul_pd(_mm_add_pd(_mm_mul_pd(c2, xw), _mm_mul_pd(c3, xw1)), yw1);
+            _mm_storel_pi((__m64 *)&layer[l][h], _mm_cvtpd_ps(_mm_add_pd(lo, hi)));
+        }
+    }
+#else
+    for (int l = 0; l < nlayers; l++) {
+        for (int comp = 0; comp < 3; comp++) {
+            const float *c = &corner[l * 4][0];
+            layer[l][comp] = ((c[0 * 4 + comp] * wgt[0] + c[1 * 4 + comp] * (1.0 - wgt[0])) * wgt[1]) + ((c[2 * 4 + comp] * wgt[0] + c[3 * 4 + comp] * (1.0 - wgt[0])) * (1.0 - wgt[1]));
+        }
+    }
+#endif
+
+    // Linear interpolation along Z. Components that touch a missing value
+    // take the general path, which knows how to interpolate around them.
+    //
+    for (int comp = 0; comp < 3; comp++) {
+        if (missing[comp]) {
+            vel[comp] = _grids[comp]->GetValue(coords);
+        } else if (!top) {
+            vel[comp] = layer[0][comp];
+        } else if (layer[0][comp] == _mv[comp] || layer[1][comp] == _mv[comp]) {
+            vel[comp] = _grids[comp]->GetValue(coords);
+        } else {
+            vel[comp] = layer[0][comp] * wgt[2] + layer[1][comp] * (1.0 - wgt[2]);
+        }
+    }
+}
+
+void VelocitySampler::Sample(const VAPoR::CoordType &coords, float vel[3]) const
+{
+    if (_mesh == SLOW) {
+        for (int i = 0; i < 3; i++) vel[i] = _grids[i]->GetValue(coords);
+        return;
+    }
+
+    size_t idx[3];
+    double wgt[3];
+    bool   upper[3];
+    if (!_locate(coords, idx, wgt, upper)) {
+        for (int i = 0; i < 3; i++) vel[i] = _mv[i];
+        return;
+    }
+
+    if (_order == 0)
+        _sampleNode(idx, upper, vel);
+    else
+        _sampleCell(coords, idx, wgt, vel);
+}
+
+};    // namespace
+
 int VaporField::GetVelocity(double time, const glm::vec3 &pos, glm::vec3 &velocity) const
 {
     const std::array<double, 3> coords{pos.x, pos.y, pos.z};
@@ -297,6 +559,124 @@ int VaporField::GetVelocity(double time, const glm::vec3 &pos, glm::vec3 &veloci
     }    // end of unsteady condition
 }
 
+void VaporField::GetVelocities(size_t n, const double *times, const glm::vec3 *pos, glm::vec3 *vels, int *rvs) const
+{
+    if (IsSteady) {
+        std::array<const VAPoR::Grid *, 3> grids;
+        for (int i = 0; i < 3; i++) {
+            if (_params_locked) {
+                grids[i] = _c_velocity_grids[i];
+            } else {
+                auto currentTS = _params->GetCurrentTimestep();
+                grids[i] = _getAGrid(currentTS, VelocityNames[i]);
+            }
+            if (grids[i] == nullptr) {
+                for (size_t p = 0; p < n; p++) {
+                    vels[p] = glm::vec3(0.0f);
+                    rvs[p] = GRID_ERROR;
+                }
+                return;
+            }
+        }
+
+        const VelocitySampler sampler(grids);
+        const float           mult = _params_locked ? _c_vel_mult : _params->GetVelocityMultiplier();
+        for (size_t p = 0; p < n; p++) {
+            const VAPoR::CoordType coords{pos[p].x, pos[p].y, pos[p].z};
+            float                  v[3];
+            sampler.Sample(coords, v);
+
+            bool hasMissing = false;
+            for (int i = 0; i < 3; i++) {
+                float mv = sampler.GetMissingValue(i);
+                // If missing values are represented using NaN, you cannot compare equality with them!
+                if (v[i] == mv || (std::isnan(mv) && std::isnan(v[i]))) hasMissing = true;
+            }
+
+            vels[p] = glm::vec3(v[0], v[1], v[2]);
+            if (hasMissing) {
+                rvs[p] = MISSING_VAL;
+            } else {
+                vels[p] *= mult;
+                rvs[p] = SUCCESS;
+            }
+        }
+    } else {
+        // Positions of a batch are usually within the same one or two
+        // time steps, so keep a sampler for each time step seen.
+        //
+        std::map<size_t, std::unique_ptr<VelocitySampler>> samplers;
+        auto getSampler = [&](size_t ts) -> const VelocitySampler * {
+            auto it = samplers.find(ts);
+            if (it != samplers.end()) return it->second.get();
+
+            std::array<const VAPoR::Grid *, 3> grids;
+            for (int i = 0; i < 3; i++) {
+                grids[i] = _getAGrid(ts, VelocityNames[i]);
+                if (grids[i] == nullptr) return (samplers[ts] = nullptr).get();
+            }
+            return (samplers[ts] = std::unique_ptr<VelocitySampler>(new VelocitySampler(grids))).get();
+        };
+
+        const float mult = _params->GetVelocityMultiplier();
+        for (size_t p = 0; p < n; p++) {
+            const double time = times[p];
+            vels[p] = glm::vec3(0.0f);
+
+            // First check if the query time is within range
+            if (time < _timestamps.front() || time > _timestamps.back()) {
+                rvs[p] = TIME_ERROR;
+                continue;
+            }
+
+            // Then we locate the floor time step
+            size_t floorTS = 0;
+            int    rv = LocateTimestamp(time, floorTS);
+            VAssert(rv == 0);
+
+            const VAPoR::CoordType coords{pos[p].x, pos[p].y, pos[p].z};
+            float                  v[3];
+
+            // Find the velocity values at floor time step
+            const VelocitySampler *floorSampler = getSampler(floorTS);
+            if (floorSampler == nullptr) {
+                rvs[p] = GRID_ERROR;
+                continue;
+            }
+            floorSampler->Sample(coords, v);
+            glm::vec3 floorVelocity(v[0], v[1], v[2]);
+            if (v[0] == floorSampler->GetMissingValue(0) || v[1] == floorSampler->GetMissingValue(1) || v[2] == floorSampler->GetMissingValue(2)) {
+                rvs[p] = MISSING_VAL;
+                continue;
+            }
+
+            if (time == _timestamps[floorTS]) {
+                vels[p] = floorVelocity * mult;
+                rvs[p] = 0;
+                continue;
+            }
+
+            // Find the velocity values at the ceiling time step
+            VAssert(_timestamps[floorTS + 1] > _timestamps[floorTS]);
+            const VelocitySampler *ceilSampler = getSampler(floorTS + 1);
+            if (ceilSampler == nullptr) {
+                rvs[p] = GRID_ERROR;
+                continue;
+            }
+            ceilSampler->Sample(coords, v);
+            glm::vec3 ceilingVelocity(v[0], v[1], v[2]);
+            if (v[0] == ceilSampler->GetMissingValue(0) || v[1] == ceilSampler->GetMissingValue(1) || v[2] == ceilSampler->GetMissingValue(2)) {
+                rvs[p] = MISSING_VAL;
+                continue;
+            }
+
+            float weight = (time - _timestamps[floorTS]) / (_timestamps[floorTS + 1] - _timestamps[floorTS]);
+            vels[p] = glm::mix(floorVelocity, ceilingVelocity, weight) * mult;
+            rvs[p] = 0;
+        }
+    }
+}
+
 int VaporField::GetScalar(double time, const glm::vec3 &pos, float &scalar) const
 {
     // When this variable doesn't exist, it doesn't make sense to get a scalar value
@@ -326,6 +326,11 @@ void ColorMap::move(int index, float delta)
 ColorMap::Color ColorMap::getDivergingColor(float ratio, float index) const
 {
     vector<double> cps = GetControlPoints();
+    return (divergingColor(cps, GetUseWhitespace(), ratio, index));
+}
+
+ColorMap::Color ColorMap::divergingColor(const vector<double> &cps, bool whitespace, float ratio, float index)
+{
     float          hsv1[3] = {(float)cps[4 * index], (float)cps[4 * index + 1], (float)cps[4 * index + 2]};
     float          hsv2[3] = {(float)cps[4 * index + 4], (float)cps[4 * index + 5], (float)cps[4 * index + 6]};
     float          rgb1[3], rgb2[3];
@@ -341,7 +346,7 @@ ColorMap::Color ColorMap::getDivergingColor(float ratio, float index) const
     rgb2[1] = rgb2[1] * 255.0;
     rgb2[2] = rgb2[2] * 255.0;
 
-    if (GetUseWhitespace())
+    if (whitespace)
         TFInterpolator::correctiveDivergentInterpolation(rgb2, rgb1, rgbOutput, ratio);
     else
         TFInterpolator::divergentInterpolation(rgb2, rgb1, rgbOutput, ratio);
@@ -359,6 +364,21 @@ ColorMap::Color ColorMap::color(float value) const
     return colorNormalized(nv);
 }
 
+void ColorMap::color(const float *values, size_t n, Color *colors) const
+{
+    vector<double>       cps = GetControlPoints();
+    vector<double>       bounds = GetDataBounds();
+    TFInterpolator::type itype = GetInterpType();
+    bool                 whitespace = GetUseWhitespace();
+    float                minv = bounds[0];
+    float                maxv = bounds[1];
+
+    for (size_t i = 0; i < n; i++) {
+        float nv = (values[i] - minv) / (maxv - minv);
+        colors[i] = colorNormalized(cps, itype, whitespace, nv);
+    }
+}
+
 namespace {
 
 void lab2lch(const float lab[3], float lch[3])
@@ -409,13 +429,21 @@ void clamp3(float c[3], const vector<float> &min, const vector<float> &max)
 ColorMap::Color ColorMap::colorNormalized(float nv) const
 {
     vector<double> cps = GetControlPoints();
+    return (colorNormalized(cps, GetInterpType(), GetUseWhitespace(), nv));
+}
+
+ColorMap::Color ColorMap::colorNormalized(const vector<double> &cps, TFInterpolator::type itype, bool whitespace, float nv)
+{
+    int n = (int)(cps.size() / 4);
+
     //
     // Find the bounding control points
     //
-    int index = leftIndex(nv);
+    int index = leftIndex(cps, nv);
 
-    if (index < 0) return controlPointColor(0);
-    if (index >= numControlPoints() - 1) return controlPointColor(numControlPoints() - 1);
+    if (n == 0) return Color();
+    if (index < 0) return Color(cps[0], cps[1], cps[2]);
+    if (index >= n - 1) return Color(cps[4 * (n - 1)], cps[4 * (n - 1) + 1], cps[4 * (n - 1) + 2]);
 
     VAssert(index >= 0 && index * 4 + 7 < cps.size());
     double leftVal = cps[4 * index + 3];
@@ -424,11 +452,8 @@ ColorMap::Color ColorMap::colorNormalized(float nv) const
     float ratio = (nv - leftVal) / (rightVal - leftVal);
 
     if (ratio > 0.f && ratio < 1.f) {
-        TFInterpolator::type itype = GetInterpType();
         if (itype == TFInterpolator::diverging) {
-            ColorMap::Color divergingColor;
-            divergingColor = getDivergingColor(ratio, index);
-            return divergingColor;
+            return divergingColor(cps, whitespace, ratio, index);
         } else if (itype == TFInterpolator::linear) {
             float h = TFInterpolator::interpCirc(itype,
                                                  cps[4 * index],    // hue
@@ -575,11 +600,17 @@ ColorMap::Color ColorMap::colorNormalized(float nv) const
 //----------------------------------------------------------------------------
 int ColorMap::leftIndex(float val) const
 {
-    int n = numControlPoints();
+    vector<double> cps = GetControlPoints();
+    return (leftIndex(cps, val));
+}
+
+int ColorMap::leftIndex(const vector<double> &cps, float val)
+{
+    int n = (int)(cps.size() / 4);
     if (n == 0) return -1;
 
     for (int i = 0; i < n; i++)
-        if (controlPointValueNormalized(i) > val) return i - 1;
+        if ((float)cps[4 * i + 3] > val) return i - 1;
 
     return n - 1;
 }
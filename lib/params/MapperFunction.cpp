@@ -55,7 +55,7 @@ static ParamsRegistrar<MapperFunction> registrar(MapperFunction::GetClassType())
 // Constructor for empty, default Mapper function
 //----------------------------------------------------------------------------
 
-MapperFunction::MapperFunction(ParamsBase::StateSave *ssave) : ParamsBase(ssave, MapperFunction::GetClassType()), _numEntries(256)
+MapperFunction::MapperFunction(ParamsBase::StateSave *ssave) : ParamsBase(ssave, MapperFunction::GetClassType()), _numEntries(256), _lutGeneration(0)
 {
     m_colorMap = NULL;
     m_opacityMaps = NULL;
@@ -80,7 +80,7 @@ MapperFunction::MapperFunction(ParamsBase::StateSave *ssave) : ParamsBase(ssave,
     setMinMaxMapValue(1., -1.);
 }
 
-MapperFunction::MapperFunction(ParamsBase::StateSave *ssave, XmlNode *node) : ParamsBase(ssave, node), _numEntries(256)
+MapperFunction::MapperFunction(ParamsBase::StateSave *ssave, XmlNode *node) : ParamsBase(ssave, node), _numEntries(256), _lutGeneration(0)
 {
     m_colorMap = NULL;
     m_opacityMaps = NULL;
@@ -110,7 +110,7 @@ MapperFunction::MapperFunction(ParamsBase::StateSave *ssave, XmlNode *node) : Pa
     }
 }
 
-MapperFunction::MapperFunction(const MapperFunction &rhs) : ParamsBase(rhs), _numEntries(256)
+MapperFunction::MapperFunction(const MapperFunction &rhs) : ParamsBase(rhs), _numEntries(256), _lutGeneration(0)
 {
     m_colorMap = NULL;
     m_opacityMaps = NULL;
@@ -139,6 +139,8 @@ MapperFunction &MapperFunction::operator=(const MapperFunction &rhs)
     m_opacityMaps = new ParamsContainer(rhs._ssave, rhs.m_opacityMaps->GetNode());
     m_opacityMaps->SetParent(this);
 
+    _lutGeneration = 0;
+
     return (*this);
 }
 
@@ -283,17 +285,87 @@ void MapperFunction::hsvValue(float value, float *h, float *s, float *v) const
     }
 }
 
+//----------------------------------------------------------------------------
+// Recompute the cached lookup tables if the mapper function has changed
+// since they were computed. The colors and opacities of all of the
+// entries are computed together, so the settings of the color map and of
+// each opacity map are only read once. Must be called with _lutMutex held,
+// and the tables may only be read while it is held.
+//----------------------------------------------------------------------------
+void MapperFunction::_updateLut() const
+{
+    unsigned long generation = GetNode()->GetGeneration();
+    if (_lutGeneration == generation) return;
+
+    const size_t n = _numEntries;
+
+    vector<float> values(n);
+    float         minValue = getMinMapValue();
+    float         step = (getMaxMapValue() - minValue) / float(_numEntries - 1);
+    for (int i = 0; i < _numEntries; i++) values[i] = minValue + i * step;
+
+    vector<ColorMap::Color> colors(n);
+    m_colorMap->color(values.data(), n, colors.data());
+
+    _lut.resize(4 * n);
+    for (size_t i = 0; i < n; i++) colors[i].toRGB(&_lut[4 * i]);
+
+    // Composite the opacity maps as getOpacityValueData() does. Entries
+    // are saturated once their scaled opacity exceeds one
+    //
+    float           opacScale = getOpacityScale();
+    CompositionType composition = getOpacityComposition();
+    vector<float>   opacity(n, composition == MULTIPLICATION ? 1.0 : 0.0);
+    vector<float>   omapOpacity(n);
+    vector<int>     count(n, 0);
+    vector<bool>    saturated(n, false);
+
+    for (int i = 0; i < getNumOpacityMaps(); i++) {
+        OpacityMap *omap = GetOpacityMap(i);
+        if (!omap->IsEnabled()) continue;
+
+        double omin = omap->minValue();
+        double omax = omap->maxValue();
+        omap->opacityData(values.data(), n, omapOpacity.data());
+
+        for (size_t j = 0; j < n; j++) {
+            if (saturated[j] || !(values[j] >= omin && values[j] <= omax)) continue;
+
+            if (composition == ADDITION) {
+                opacity[j] += omapOpacity[j];
+            } else {
+                opacity[j] *= omapOpacity[j];
+            }
+            count[j]++;
+
+            if (opacity[j] * opacScale > 1.0) saturated[j] = true;
+        }
+    }
+
+    for (size_t j = 0; j < n; j++) {
+        if (saturated[j])
+            _lut[4 * j + 3] = 1.0;
+        else
+            _lut[4 * j + 3] = count[j] ? opacity[j] * opacScale : 0.0;
+    }
+
+    _lut8.resize(4 * n);
+    for (size_t i = 0; i < 4 * n; i++) {
+        float v = std::min(std::max(_lut[i], 0.0f), 1.0f);
+        _lut8[i] = (unsigned char)(v * 255.0f + 0.5f);
+    }
+
+    _lutGeneration = generation;
+}
+
 //----------------------------------------------------------------------------
 // Populate at a RGBA lookup table
 //----------------------------------------------------------------------------
 void MapperFunction::makeLut(float *clut) const
 {
-    float step = (getMaxMapValue() - getMinMapValue()) / float(_numEntries - 1);
-    for (int i = 0; i < _numEntries; i++) {
-        float v = getMinMapValue() + i * step;
-        m_colorMap->color(v).toRGB(&clut[4 * i]);
-        clut[4 * i + 3] = getOpacityValueData(v);
-    }
+    std::lock_guard<std::mutex> lock(_lutMutex);
+    _updateLut();
+    std::copy(_lut.begin(), _lut.end(), clut);
 }
 
 //----------------------------------------------------------------------------
@@ -301,10 +373,9 @@ void MapperFunction::makeLut(float *clut) const
 //----------------------------------------------------------------------------
 void MapperFunction::makeLut(std::vector<float> &clut) const
 {
-    float *cluta = new float[4 * _numEntries];
-    makeLut(cluta);
-    clut.assign(cluta, cluta + 4 * _numEntries);
-    delete[] cluta;
+    std::lock_guard<std::mutex> lock(_lutMutex);
+    _updateLut();
+    clut = _lut;
 }
 
 std::vector<float> MapperFunction::makeLut() const
@@ -314,6 +385,42 @@ std::vector<float> MapperFunction::makeLut() const
     return v;
 }
 
+//----------------------------------------------------------------------------
+// Map data values to RGBA bytes with the cached lookup table
+//----------------------------------------------------------------------------
+void MapperFunction::MapValues(const float *values, size_t n, unsigned char *rgba) const
+{
+    // Map with a copy of the table, so that other threads can update it
+    // while we use it
+    //
+    vector<unsigned char> lut8;
+    {
+        std::lock_guard<std::mutex> lock(_lutMutex);
+        _updateLut();
+        lut8 = _lut8;
+    }
+
+    const unsigned char *lut = lut8.data();
+    const float          minValue = getMinMapValue();
+    const float          scale = (float)(_numEntries - 1) / (getMaxMapValue() - minValue);
+    const float          maxIndex = (float)(_numEntries - 1);
+
+    // Branch free, so the quantization vectorizes. Comparisons
+    // with NaN are false, so NaNs are mapped to index zero
+    //
+    for (size_t i = 0; i < n; i++) {
+        float p = (values[i] - minValue) * scale + 0.5f;
+        p = p > 0.0f ? p : 0.0f;
+        p = p < maxIndex ? p : maxIndex;
+
+        const unsigned char *entry = lut + 4 * (int)p;
+        rgba[4 * i + 0] = entry[0];
+        rgba[4 * i + 1] = entry[1];
+        rgba[4 * i + 2] = entry[2];
+        rgba[4 * i + 3] = entry[3];
+    }
+}
+
 //! Set both minimum and maximum mapping (histo) values
 //! \param[in] val1 minimum value
 //! \param[in] val2 maximum value
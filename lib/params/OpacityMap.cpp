@@ -276,23 +276,52 @@ float OpacityMap::opacityData(float value) const
     return opacityDataAtNorm(nv);
 }
 
+void OpacityMap::opacityData(const float *values, size_t n, float *opacities) const
+{
+    shape_t shape = getShape();
+    double  minv = minValue();
+    double  maxv = maxValue();
+
+    for (size_t i = 0; i < n; i++) {
+        float nv = (values[i] - minv) / (maxv - minv);
+        opacities[i] = opacityDataAtNorm(shape, nv);
+    }
+}
+
 //----------------------------------------------------------------------------
 //
 //----------------------------------------------------------------------------
-float OpacityMap::opacityDataAtNorm(float nv) const
+float OpacityMap::opacityDataAtNorm(float nv) const { return opacityDataAtNorm(getShape(), nv); }
+
+OpacityMap::shape_t OpacityMap::getShape() const
 {
-    vector<double> cps = GetControlPoints();
+    shape_t shape;
+    shape.cps = GetControlPoints();
+    shape.type = GetType();
+    shape.interpType = GetInterpType();
+    shape.mean = GetMean();
+    shape.ssq = GetSSQ();
+    shape.freq = GetFreq();
+    shape.phase = GetPhase();
+    return (shape);
+}
+
+float OpacityMap::opacityDataAtNorm(const shape_t &shape, float nv)
+{
+    const vector<double> &cps = shape.cps;
     if (nv < 0.0) { nv = 0; }
 
     if (nv > 1.0) { nv = 1.0; }
-    OpacityMap::Type _type = GetType();
-    switch (_type) {
+    switch (shape.type) {
     case CONTROL_POINT: {
         //
         // Find the bounding control points
         //
-        int index = leftControlIndex(nv);
-        if (numControlPoints() == 1) return controlPointOpacity(index);
+        int n = (int)cps.size() / 2;
+        if (n == 0) return 0.0;
+        if (n == 1) return cps[0];
+
+        int index = leftControlIndex(cps, nv);
 
         double val0 = cps[2 * index + 1];
         double val1 = cps[2 * index + 3];
@@ -300,7 +329,7 @@ float OpacityMap::opacityDataAtNorm(float nv) const
         float ratio = (nv - val0) / (val1 - val0);
 
         if (ratio > 0. && ratio < 1.) {
-            float o = TFInterpolator::interpolate(GetInterpType(), cps[2 * index], cps[2 * index + 2], ratio);
+            float o = TFInterpolator::interpolate(shape.interpType, cps[2 * index], cps[2 * index + 2], ratio);
             return o;
         }
 
@@ -310,15 +339,15 @@ float OpacityMap::opacityDataAtNorm(float nv) const
     }
 
     case GAUSSIAN: {
-        return pow(M_E, -((nv - GetMean()) * (nv - GetMean())) / (2.0 * GetSSQ()));
+        return pow(M_E, -((nv - shape.mean) * (nv - shape.mean)) / (2.0 * shape.ssq));
     }
 
     case INVERTED_GAUSSIAN: {
-        return 1.0 - pow(M_E, -((nv - GetMean()) * (nv - GetMean())) / (2.0 * GetSSQ()));
+        return 1.0 - pow(M_E, -((nv - shape.mean) * (nv - shape.mean)) / (2.0 * shape.ssq));
     }
 
     case SINE: {
-        return (0.5 + sin(GetFreq() * M_PI * nv + GetPhase()) / 2);
+        return (0.5 + sin(shape.freq * M_PI * nv + shape.phase) / 2);
     }
     }
 
@@ -357,8 +386,13 @@ vector<double> OpacityMap::GetDataBounds() const
 int OpacityMap::leftControlIndex(float normval) const
 {
     vector<double> cps = GetControlPoints();
-    int            left = 0;
-    int            right = cps.size() / 2 - 1;
+    return (leftControlIndex(cps, normval));
+}
+
+int OpacityMap::leftControlIndex(const vector<double> &cps, float normval)
+{
+    int left = 0;
+    int right = cps.size() / 2 - 1;
 
     //
     // Iterate, keeping left to the left of ctrl point
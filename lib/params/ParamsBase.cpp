@@ -108,7 +108,7 @@ void ParamsBase::SetParent(ParamsBase *parent)
     _ssave->Save(GetNode(), "Set parent node");
 }
 
-vector<long> ParamsBase::GetValueLongVec(const string tag) const
+vector<long> ParamsBase::GetValueLongVec(const string &tag) const
 {
     vector<long> empty;
     if (!_node->HasElementLong(tag)) return (empty);
@@ -116,7 +116,7 @@ vector<long> ParamsBase::GetValueLongVec(const string tag) const
     return (_node->GetElementLong(tag));
 }
 
-vector<long> ParamsBase::GetValueLongVec(const string tag, const vector<long> &defaultVal) const
+vector<long> ParamsBase::GetValueLongVec(const string &tag, const vector<long> &defaultVal) const
 {
     if (!_node->HasElementLong(tag)) return (defaultVal);
 
@@ -130,17 +130,16 @@ vector<long> ParamsBase::GetValueLongVec(const string tag, const vector<long> &d
     return (v);
 }
 
-long ParamsBase::GetValueLong(const string tag, long defaultVal) const
+long ParamsBase::GetValueLong(const string &tag, long defaultVal) const
 {
-    vector<long> defaultValVec(1, defaultVal);
-    vector<long> v = ParamsBase::GetValueLongVec(tag, defaultValVec);
+    const vector<long> &v = _node->GetElementLong(tag);
 
     if (!v.size()) return (defaultVal);
 
     return (v[0]);
 }
 
-vector<double> ParamsBase::GetValueDoubleVec(const string tag) const
+vector<double> ParamsBase::GetValueDoubleVec(const string &tag) const
 {
     vector<double> empty;
 
@@ -153,7 +152,7 @@ vector<double> ParamsBase::GetValueDoubleVec(const string tag) const
     return (_node->GetElementDouble(tag));
 }
 
-vector<double> ParamsBase::GetValueDoubleVec(const string tag, const vector<double> &defaultVal) const
+vector<double> ParamsBase::GetValueDoubleVec(const string &tag, const vector<double> &defaultVal) const
 {
     if (!_node->HasElementDouble(tag)) return (defaultVal);
 
@@ -167,17 +166,16 @@ vector<double> ParamsBase::GetValueDoubleVec(const string tag, const vector<doub
     return (v);
 }
 
-double ParamsBase::GetValueDouble(const string tag, double defaultVal) const
+double ParamsBase::GetValueDouble(const string &tag, double defaultVal) const
 {
-    vector<double> defaultValVec(1, defaultVal);
-    vector<double> v = ParamsBase::GetValueDoubleVec(tag, defaultValVec);
+    const vector<double> &v = _node->GetElementDouble(tag);
 
     if (!v.size()) return (defaultVal);
 
     return (v[0]);
 }
 
-vector<string> ParamsBase::GetValueStringVec(const string tag) const
+vector<string> ParamsBase::GetValueStringVec(const string &tag) const
 {
     vector<string> empty;
     if (!_node->HasElementString(tag)) return (empty);
@@ -190,7 +188,7 @@ vector<string> ParamsBase::GetValueStringVec(const string tag) const
     return (v);
 }
 
-vector<string> ParamsBase::GetValueStringVec(const string tag, const vector<string> &defaultVal) const
+vector<string> ParamsBase::GetValueStringVec(const string &tag, const vector<string> &defaultVal) const
 {
     if (!_node->HasElementString(tag)) return (defaultVal);
 
@@ -208,7 +206,7 @@ vector<string> ParamsBase::GetValueStringVec(const string tag, const vector<stri
     return (v);
 }
 
-string ParamsBase::GetValueString(const string tag, string defaultVal) const
+string ParamsBase::GetValueString(const string &tag, string defaultVal) const
 {
     if (!_node->HasElementString(tag)) return (defaultVal);
 
@@ -228,8 +226,7 @@ void ParamsBase::SetValueLong(const string &tag, string description, long value)
 
 void ParamsBase::SetValueLongVec(const string &tag, string description, const vector<long> &values)
 {
-    vector<long> current = GetValueLongVec(tag);
-    if (current == values) return;
+    if (_node->GetElementLong(tag) == values) return;
 
     _node->SetElementLong(tag, values);
 
@@ -244,8 +241,7 @@ void ParamsBase::SetValueDouble(const string &tag, string description, double va
 
 void ParamsBase::SetValueDoubleVec(const string &tag, string description, const vector<double> &values)
 {
-    vector<double> current = GetValueDoubleVec(tag);
-    if (current == values) return;
+    if (_node->GetElementDouble(tag) == values) return;
 
     _node->SetElementDouble(tag, values);
 
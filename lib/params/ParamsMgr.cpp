@@ -1141,6 +1141,7 @@ ParamsMgr::PMgrStateSave::PMgrStateSave(int stackSize) : StateSave()
     _stackSize = stackSize;
     _rootNode = NULL;
     _state0 = NULL;
+    _state = NULL;
     _undoStack.clear();
     _redoStack.clear();
 }
@@ -1150,6 +1151,7 @@ ParamsMgr::PMgrStateSave::~PMgrStateSave()
     cleanStack(0, _undoStack);
     cleanStack(0, _redoStack);
     if (_state0) delete _state0;
+    if (_state) delete _state;
 }
 
 void ParamsMgr::PMgrStateSave::Save(const XmlNode *node, string description)
@@ -1165,27 +1167,20 @@ void ParamsMgr::PMgrStateSave::Save(const XmlNode *node, string description)
     vector<string> pathvec = node->GetPathVec();
     if ((!pathvec.size()) || (pathvec[0] != _rootTag)) { return; }
 
-    if (GetUndoEnabled()) {
-        const XmlNode *topNode = NULL;
-        string         s;
-        topNode = GetTopUndo(s);
-        if (topNode && (*topNode == *_rootNode)) {
-            // Don't save tree if no changes
-            return;
-        }
-    }
-
     if (!_groups.empty()) { return; }
 
     if (!_state0) { _state0 = new XmlNode(*_rootNode); }
 
-    // Delete oldest elements if needed
-    //
-    cleanStack(_stackSize, _undoStack);
-
-    // It not inside a group push this element onto the stack
+    // It not inside a group push the changes onto the stack
     //
-    if (GetUndoEnabled()) _undoStack.push_back(make_pair(description, new XmlNode(*_rootNode)));
+    if (GetUndoEnabled()) {
+        if (!pushUndo(description)) {
+            // Don't save state if no changes
+            return;
+        }
+    } else {
+        cleanStack(_stackSize, _undoStack);
+    }
 
 //#define DEBUG
 #ifdef DEBUG
@@ -1223,38 +1218,56 @@ void ParamsMgr::PMgrStateSave::EndGroup()
     //
     if (_groups.size()) return;
 
-    const XmlNode *topNode = NULL;
-    string         s;
-    topNode = GetTopUndo(s);
+    if (!_state0) { _state0 = new XmlNode(*_rootNode); }
 
-    if (topNode && (*topNode == *_rootNode)) {
-        // Don't save tree if no changes
+    if (!pushUndo(desc)) {
+        // Don't save state if no changes
         //
         return;
     }
 
-    if (!_state0) { _state0 = new XmlNode(*_rootNode); }
-
 #ifdef DEBUG
     cout << "ParamsMgr::PMgrStateSave::EndGroup() : saving "
          << " : " << desc << endl;
 #endif
 
-    // Delete oldest elements if needed
-    //
-    cleanStack(_stackSize, _undoStack);
-
     // Clear redo stack
     //
     cleanStack(0, _redoStack);
 
-    _undoStack.push_back(make_pair(desc, new XmlNode(*_rootNode)));
-
     emitStateChange();
 }
 
 void ParamsMgr::PMgrStateSave::IntermediateChange() { emitIntermediateStateChange(); }
 
+// Bring _state up to date with the current state, and push the changes
+// onto the undo stack. Only the nodes that changed since _state was last
+// updated are visited. Returns false, without pushing anything, if
+// nothing changed since the step at the top of the undo stack
+//
+bool ParamsMgr::PMgrStateSave::pushUndo(string description)
+{
+    XmlNodeDelta *delta = new XmlNodeDelta();
+    if (_state) {
+        delta->Update(_state, _rootNode, _synced);
+    } else {
+        _state = new XmlNode(*_rootNode);
+        _synced.clear();
+    }
+
+    if (delta->Empty() && _undoStack.size()) {
+        delete delta;
+        return (false);
+    }
+
+    // Delete oldest elements if needed
+    //
+    cleanStack(_stackSize, _undoStack);
+
+    _undoStack.push_back({description, delta, NULL});
+    return (true);
+}
+
 const XmlNode *ParamsMgr::PMgrStateSave::GetTopUndo(string &description) const
 {
     VAssert(_rootNode);
@@ -1262,23 +1275,19 @@ const XmlNode *ParamsMgr::PMgrStateSave::GetTopUndo(string &description) const
 
     if (!_undoStack.size()) return (NULL);
 
-    const pair<string, XmlNode *> &p1 = _undoStack.back();
-
-    description = p1.first;
-    return (p1.second);
+    description = _undoStack.back().description;
+    return (_state);
 }
 
-const XmlNode *ParamsMgr::PMgrStateSave::GetTopRedo(string &description) const
+bool ParamsMgr::PMgrStateSave::GetTopRedo(string &description) const
 {
     VAssert(_rootNode);
     description.clear();
 
-    if (!_redoStack.size()) return (NULL);
-
-    const pair<string, XmlNode *> &p1 = _redoStack.back();
+    if (!_redoStack.size()) return (false);
 
-    description = p1.first;
-    return (p1.second);
+    description = _redoStack.back().description;
+    return (true);
 }
 
 bool ParamsMgr::PMgrStateSave::Undo()
@@ -1287,15 +1296,31 @@ bool ParamsMgr::PMgrStateSave::Undo()
 
     if (!_undoStack.size()) return (false);
 
-    pair<string, XmlNode *> &p1 = _undoStack.back();
+    step_t step = _undoStack.back();
+    _undoStack.pop_back();
+
+    // Revert the changes made by the step, unless it is the oldest step,
+    // in which case return to the base state. The state after the
+    // oldest step is kept for Redo()
+    //
+    if (_undoStack.size()) {
+        step.delta->Revert(_state);
+    } else {
+        VAssert(_state0);
+        if (step.state) delete step.state;
+        step.state = _state;
+        _state = new XmlNode(*_state0);
+    }
+
+    // The current state is about to be replaced with _state
+    //
+    _synced.clear();
 
     // Delete oldest elements if needed
     //
     cleanStack(_stackSize, _redoStack);
 
-    _redoStack.push_back(p1);
-
-    _undoStack.pop_back();
+    _redoStack.push_back(step);
 
     emitStateChange();
 
@@ -1308,15 +1333,24 @@ bool ParamsMgr::PMgrStateSave::Redo()
 
     if (!_redoStack.size()) return (false);
 
-    pair<string, XmlNode *> &p1 = _redoStack.back();
+    step_t step = _redoStack.back();
+    _redoStack.pop_back();
+
+    if (step.state) {
+        if (_state) delete _state;
+        _state = step.state;
+        step.state = NULL;
+    } else {
+        step.delta->Apply(_state);
+    }
+
+    _synced.clear();
 
     // Delete oldest elements if needed
     //
     cleanStack(_stackSize, _undoStack);
 
-    _undoStack.push_back(p1);
-
-    _redoStack.pop_back();
+    _undoStack.push_back(step);
 
     emitStateChange();
 
@@ -1332,14 +1366,15 @@ void ParamsMgr::PMgrStateSave::Clear()
     while (_groups.size()) _groups.pop();
 }
 
-void ParamsMgr::PMgrStateSave::cleanStack(int maxN, std::deque<std::pair<string, XmlNode *>> &s)
+void ParamsMgr::PMgrStateSave::cleanStack(int maxN, std::deque<step_t> &s)
 {
     // Delete oldest elements if needed
     //
     while (s.size() > maxN) {
-        pair<string, XmlNode *> &p1 = s.front();
+        step_t &step = s.front();
 
-        if (p1.second) { delete p1.second; }
+        if (step.delta) { delete step.delta; }
+        if (step.state) { delete step.state; }
 
         s.pop_front();
     }
@@ -25,6 +25,8 @@
 #include "vapor/VAssert.h"
 #include <cctype>
 #include <algorithm>
+#include <mutex>
+#include <unordered_set>
 #include <expat.h>
 #include <vapor/XmlNode.h>
 #include <vapor/STLUtils.h>
@@ -42,6 +44,7 @@ vector<long>           XmlNode::_emptyLongVec;
 vector<string>         XmlNode::_emptyStringVec;
 string                 XmlNode::_emptyString;
 std::vector<XmlNode *> XmlNode::_allocatedNodes;
+std::atomic<unsigned long> XmlNode::_generationCounter(0);
 };    // namespace VAPoR
 
 namespace {
@@ -107,6 +110,8 @@ XmlNode::XmlNode(const string &tag, const map<string, string> &attrs, size_t num
 
     if (numChildrenHint) _children.reserve(numChildrenHint);
 
+    _touch();
+
 #ifdef MEMCHECK
     _allocatedNodes.push_back(this);
 #endif
@@ -129,6 +134,8 @@ XmlNode::XmlNode(const string &tag, size_t numChildrenHint)
 
     if (numChildrenHint) _children.reserve(numChildrenHint);
 
+    _touch();
+
 #ifdef MEMCHECK
     _allocatedNodes.push_back(this);
 #endif
@@ -145,6 +152,8 @@ XmlNode::XmlNode()
     _asciiLimit = 1024;
     _parent = NULL;
 
+    _touch();
+
 #ifdef MEMCHECK
     _allocatedNodes.push_back(this);
 #endif
@@ -157,6 +166,8 @@ XmlNode::XmlNode(const XmlNode &rhs)
     _children.clear();
     for (int i = 0; i < rhs._children.size(); i++) { AddChild(rhs._children[i]); }
 
+    _touch();
+
 #ifdef MEMCHECK
     _allocatedNodes.push_back(this);
 #endif
@@ -180,6 +191,7 @@ XmlNode &XmlNode::operator=(const XmlNode &rhs)
     _children.clear();
     for (int i = 0; i < rhs._children.size(); i++) { AddChild(rhs._children[i]); }
 
+    _touch();
     return (*this);
 }
 
@@ -207,7 +219,7 @@ bool XmlNode::operator==(const XmlNode &rhs) const
 
 XmlNode::~XmlNode()
 {
-    DeleteAll();
+    _deleteChildren();
 
 #ifdef MEMCHECK
     std::vector<XmlNode *>::iterator itr;
@@ -224,6 +236,7 @@ void XmlNode::SetElementLong(const string &tag, const vector<long> &values)
 {
     VAssert(IsValidXMLElement(tag));
     _longmap[tag] = values;
+    _touch();
 }
 
 void XmlNode::SetElementLong(const vector<string> &tags, const vector<long> &values)
@@ -241,6 +254,7 @@ void XmlNode::SetElementLong(const vector<string> &tags, const vector<long> &val
     string tag = tags[tags.size() - 1];
     VAssert(IsValidXMLElement(tag));
     currNode->_longmap[tag] = values;
+    currNode->_touch();
 }
 
 void XmlNode::SetElementDouble(const vector<string> &tags, const vector<double> &values)
@@ -258,11 +272,12 @@ void XmlNode::SetElementDouble(const vector<string> &tags, const vector<double>
     string tag = tags[tags.size() - 1];
     VAssert(IsValidXMLElement(tag));
     currNode->_doublemap[tag] = values;
+    currNode->_touch();
 }
 
 const vector<long> &XmlNode::GetElementLong(const string &tag) const
 {
-    map<string, vector<long>>::const_iterator p = _longmap.find(tag);
+    XmlElementMap<vector<long>>::const_iterator p = _longmap.find(tag);
 
     // see if entry for this key (tag) already exists
     //
@@ -273,7 +288,7 @@ const vector<long> &XmlNode::GetElementLong(const string &tag) const
 
 bool XmlNode::HasElementLong(const string &tag) const
 {
-    map<string, vector<long>>::const_iterator p = _longmap.find(tag);
+    XmlElementMap<vector<long>>::const_iterator p = _longmap.find(tag);
     return (p != _longmap.end());
 }
 
@@ -281,11 +296,12 @@ void XmlNode::SetElementDouble(const string &tag, const vector<double> &values)
 {
     VAssert(IsValidXMLElement(tag));
     _doublemap[tag] = values;
+    _touch();
 }
 
 const vector<double> &XmlNode::GetElementDouble(const string &tag) const
 {
-    map<string, vector<double>>::const_iterator p = _doublemap.find(tag);
+    XmlElementMap<vector<double>>::const_iterator p = _doublemap.find(tag);
 
     // see if entry for this key (tag) already exists
     //
@@ -297,7 +313,7 @@ const vector<double> &XmlNode::GetElementDouble(const string &tag) const
 bool XmlNode::HasElementDouble(const string &tag) const
 {
     if (_doublemap.empty()) return false;
-    map<string, vector<double>>::const_iterator p = _doublemap.find(tag);
+    XmlElementMap<vector<double>>::const_iterator p = _doublemap.find(tag);
     return (p != _doublemap.end());
 }
 
@@ -306,6 +322,7 @@ void XmlNode::SetElementString(const string &tag, const string &str)
     VAssert(IsValidXMLElement(tag));
 
     _stringmap[tag] = str;
+    _touch();
 }
 
 void XmlNode::SetElementStringVec(const string &tag, const vector<string> &strvec)
@@ -345,7 +362,7 @@ void XmlNode::SetElementStringVec(const vector<string> &tags, const vector<strin
 
 const string &XmlNode::GetElementString(const string &tag) const
 {
-    map<string, string>::const_iterator p = _stringmap.find(tag);
+    XmlElementMap<string>::const_iterator p = _stringmap.find(tag);
 
     // see if entry for this key (tag) already exists
     //
@@ -363,7 +380,7 @@ void XmlNode::GetElementStringVec(const string &tag, vector<string> &vec) const
 
 bool XmlNode::HasElementString(const string &tag) const
 {
-    map<string, string>::const_iterator p = _stringmap.find(tag);
+    XmlElementMap<string>::const_iterator p = _stringmap.find(tag);
     return (p != _stringmap.end());
 }
 
@@ -378,6 +395,7 @@ XmlNode *XmlNode::NewChild(const string &tag, const map<string, string> &attrs,
     mychild->_parent = this;
 
     _children.push_back(mychild);
+    _touch();
     return (mychild);
 }
 
@@ -394,6 +412,7 @@ XmlNode *XmlNode::AddChild(const XmlNode &child)
     mychild->_parent = this;
 
     _children.push_back(mychild);
+    _touch();
     return (mychild);
 }
 
@@ -541,6 +560,7 @@ void XmlNode::SetParent(XmlNode *parent)
     // Remove from current parent's list of children
     //
     if (_parent) {
+        _parent->_touch();
         vector<XmlNode *>::iterator itr = _parent->_children.begin();
         for (; itr != _parent->_children.end(); ++itr) {
             XmlNode *node = *itr;
@@ -556,11 +576,20 @@ void XmlNode::SetParent(XmlNode *parent)
     if (parent) { parent->_children.push_back(this); }
 
     _parent = parent;
+    _touch();
 }
 
 // Recursively delete all descendants of this node
 //
 void XmlNode::DeleteAll()
+{
+    if (_children.empty()) return;
+
+    _deleteChildren();
+    _touch();
+}
+
+void XmlNode::_deleteChildren()
 {
     for (int i = 0; i < (int)_children.size(); i++) {
         if (_children[i]) {
@@ -573,6 +602,25 @@ void XmlNode::DeleteAll()
     _children.clear();
 }
 
+const string *XmlKey::_intern(const string &tag)
+{
+    // The pool is never destroyed, so that keys remain valid during
+    // static destruction
+    //
+    static std::mutex                  mutex;
+    static std::unordered_set<string> *pool = new std::unordered_set<string>();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return (&*pool->insert(tag).first);
+}
+
+// Give this node, and each of its ancestors, a new generation
+//
+void XmlNode::_touch()
+{
+    for (XmlNode *node = this; node; node = node->_parent) node->_generation = ++_generationCounter;
+}
+
 vector<string> XmlNode::GetPathVec() const
 {
     vector<string> path;
@@ -620,10 +668,10 @@ ostream &XmlNode::streamOut(ostream &os, const XmlNode &node)
 namespace VAPoR {
 std::ostream &operator<<(ostream &os, const VAPoR::XmlNode &node)
 {
-    map<string, vector<long>>::const_iterator   plong;
-    map<string, vector<double>>::const_iterator pdouble;
-    map<string, string>::const_iterator         pstring;
-    map<string, string>::const_iterator         pattr;
+    XmlElementMap<vector<long>>::const_iterator   plong;
+    XmlElementMap<vector<double>>::const_iterator pdouble;
+    XmlElementMap<string>::const_iterator         pstring;
+    map<string, string>::const_iterator           pattr;
 
     int i;
 
@@ -646,7 +694,7 @@ std::ostream &operator<<(ostream &os, const VAPoR::XmlNode &node)
     os << ">" << endl;
 
     for (; plong != node._longmap.end(); plong++) {
-        const string &tag = plong->first;
+        const string &tag = plong->first.str();
 
         const vector<long> &v = plong->second;
 
@@ -659,7 +707,7 @@ std::ostream &operator<<(ostream &os, const VAPoR::XmlNode &node)
     }
 
     for (; pdouble != node._doublemap.end(); pdouble++) {
-        const string &tag = pdouble->first;
+        const string &tag = pdouble->first.str();
 
         os << "<" << tag << " Type=\"Double\">" << endl;
 
@@ -672,7 +720,7 @@ std::ostream &operator<<(ostream &os, const VAPoR::XmlNode &node)
     }
 
     for (; pstring != node._stringmap.end(); pstring++) {
-        const string &tag = pstring->first;
+        const string &tag = pstring->first.str();
 
         os << "<" << tag << " Type=\"String\">" << endl;
 
@@ -0,0 +1,235 @@
+#include <map>
+#include "vapor/VAssert.h"
+#include <vapor/XmlNodeDelta.h>
+
+using namespace VAPoR;
+using namespace std;
+
+namespace {
+
+// Record in before and after the elements of "from" that differ from, or
+// are missing from, "to", and the elements of "to" missing from "from"
+//
+template<class T> bool diffElements(const XmlElementMap<T> &from, const XmlElementMap<T> &to, XmlElementMap<T> &before, XmlElementMap<T> &after)
+{
+    // Both are sorted by tag, and usually hold the same tags
+    //
+    bool changed = false;
+    auto f = from.begin();
+    auto t = to.begin();
+    while (f != from.end() || t != to.end()) {
+        if (t == to.end() || (f != from.end() && f->first != t->first && f->first.str() < t->first.str())) {
+            before[f->first] = f->second;
+            ++f;
+            changed = true;
+        } else if (f == from.end() || f->first != t->first) {
+            after[t->first] = t->second;
+            ++t;
+            changed = true;
+        } else {
+            if (f->second != t->second) {
+                before[f->first] = f->second;
+                after[t->first] = t->second;
+                changed = true;
+            }
+            ++f;
+            ++t;
+        }
+    }
+    return (changed);
+}
+
+// Change the elements recorded in before and after from their before
+// version to their after version
+//
+template<class T> void setElements(XmlElementMap<T> &elements, const XmlElementMap<T> &before, const XmlElementMap<T> &after)
+{
+    for (const auto &e : before) {
+        if (!after.count(e.first)) elements.erase(e.first);
+    }
+    for (const auto &e : after) elements[e.first] = e.second;
+}
+
+// Sort children into the order of their tags in order
+//
+void orderChildren(vector<XmlNode *> &children, const vector<string> &order)
+{
+    VAssert(children.size() == order.size());
+
+    map<string, XmlNode *> byTag;
+    for (auto child : children) byTag[child->GetTag()] = child;
+
+    for (size_t i = 0; i < order.size(); i++) {
+        auto itr = byTag.find(order[i]);
+        VAssert(itr != byTag.end());
+        children[i] = itr->second;
+    }
+}
+
+// Record the generations of the subtree rooted at node, for the equal
+// subtree rooted at copy
+//
+void sync(const XmlNode *copy, const XmlNode *node, XmlNodeDelta::SyncMap &synced)
+{
+    synced[copy] = node->GetGeneration();
+    for (int i = 0; i < node->GetNumChildren(); i++) sync(copy->GetChild(i), node->GetChild(i), synced);
+}
+
+void unsync(const XmlNode *copy, XmlNodeDelta::SyncMap &synced)
+{
+    synced.erase(copy);
+    for (int i = 0; i < copy->GetNumChildren(); i++) unsync(copy->GetChild(i), synced);
+}
+
+};    // namespace
+
+XmlNodeDelta::change_t::~change_t()
+{
+    for (auto child : removed) delete child;
+    for (auto child : added) delete child;
+}
+
+XmlNodeDelta::~XmlNodeDelta()
+{
+    for (auto c : _changes) delete c;
+}
+
+bool XmlNodeDelta::Update(XmlNode *copy, const XmlNode *node, SyncMap &synced)
+{
+    VAssert(copy && node);
+
+    size_t         n = _changes.size();
+    vector<string> path;
+    _update(copy, node, path, synced);
+
+    return (_changes.size() != n);
+}
+
+void XmlNodeDelta::_update(XmlNode *copy, const XmlNode *node, vector<string> &path, SyncMap &synced)
+{
+    // Neither the node, nor any of its descendants, has changed since
+    // the copy was made equal to it
+    //
+    SyncMap::const_iterator itr = synced.find(copy);
+    if (itr != synced.end() && itr->second == node->GetGeneration()) return;
+
+    change_t *c = new change_t();
+    bool      changed = false;
+
+    if (diffElements(copy->_longmap, node->_longmap, c->before.longs, c->after.longs)) {
+        setElements(copy->_longmap, c->before.longs, c->after.longs);
+        changed = true;
+    }
+    if (diffElements(copy->_doublemap, node->_doublemap, c->before.doubles, c->after.doubles)) {
+        setElements(copy->_doublemap, c->before.doubles, c->after.doubles);
+        changed = true;
+    }
+    if (diffElements(copy->_stringmap, node->_stringmap, c->before.strings, c->after.strings)) {
+        setElements(copy->_stringmap, c->before.strings, c->after.strings);
+        changed = true;
+    }
+    if (copy->_attrmap != node->_attrmap) {
+        c->before.attrs = copy->_attrmap;
+        c->after.attrs = node->_attrmap;
+        c->attrsChanged = true;
+        copy->_attrmap = node->_attrmap;
+        changed = true;
+    }
+
+    // Children are matched by tag. Usually they are unchanged, and
+    // in the same order
+    //
+    vector<pair<XmlNode *, const XmlNode *>> matched;
+
+    bool sameChildren = copy->_children.size() == node->_children.size();
+    for (size_t i = 0; sameChildren && i < node->_children.size(); i++) sameChildren = copy->_children[i]->_tag == node->_children[i]->_tag;
+
+    if (sameChildren) {
+        for (size_t i = 0; i < node->_children.size(); i++) matched.push_back(make_pair(copy->_children[i], node->_children[i]));
+    } else {
+        map<string, const XmlNode *> nodeChildren;
+        map<string, XmlNode *>       copyChildren;
+        for (auto child : node->_children) nodeChildren[child->_tag] = child;
+        for (auto child : copy->_children) {
+            copyChildren[child->_tag] = child;
+            c->orderBefore.push_back(child->_tag);
+        }
+
+        for (size_t i = 0; i < copy->_children.size();) {
+            XmlNode *child = copy->_children[i];
+            if (nodeChildren.count(child->_tag)) {
+                i++;
+                continue;
+            }
+            copy->_children.erase(copy->_children.begin() + i);
+            child->_parent = NULL;
+            unsync(child, synced);
+            c->removed.push_back(child);
+        }
+
+        for (auto child : node->_children) {
+            c->orderAfter.push_back(child->_tag);
+
+            auto itr = copyChildren.find(child->_tag);
+            if (itr != copyChildren.end()) {
+                matched.push_back(make_pair(itr->second, child));
+                continue;
+            }
+            c->added.push_back(new XmlNode(*child));
+            sync(copy->AddChild(child), child, synced);
+        }
+
+        orderChildren(copy->_children, c->orderAfter);
+        changed = true;
+    }
+
+    if (changed) {
+        c->path = path;
+        _changes.push_back(c);
+    } else {
+        delete c;
+    }
+
+    for (const auto &m : matched) {
+        path.push_back(m.second->_tag);
+        _update(m.first, m.second, path, synced);
+        path.pop_back();
+    }
+
+    synced[copy] = node->GetGeneration();
+}
+
+void XmlNodeDelta::_apply(XmlNode *root, const change_t &c, bool forward)
+{
+    XmlNode *node = root;
+    for (const auto &tag : c.path) {
+        node = node->GetChild(tag);
+        VAssert(node);
+    }
+
+    const elements_t &from = forward ? c.before : c.after;
+    const elements_t &to = forward ? c.after : c.before;
+
+    setElements(node->_longmap, from.longs, to.longs);
+    setElements(node->_doublemap, from.doubles, to.doubles);
+    setElements(node->_stringmap, from.strings, to.strings);
+    if (c.attrsChanged) node->_attrmap = to.attrs;
+
+    for (auto child : forward ? c.removed : c.added) node->DeleteChild(child->_tag);
+    for (auto child : forward ? c.added : c.removed) node->AddChild(child);
+
+    const vector<string> &order = forward ? c.orderAfter : c.orderBefore;
+    if (order.size()) orderChildren(node->_children, order);
+
+    node->_touch();
+}
+
+void XmlNodeDelta::Apply(XmlNode *root) const
+{
+    for (size_t i = 0; i < _changes.size(); i++) _apply(root, *_changes[i], true);
+}
+
+void XmlNodeDelta::Revert(XmlNode *root) const
+{
+    for (size_t i = _changes.size(); i > 0; i--) _apply(root, *_changes[i - 1], false);
+}
@@ -76,6 +76,7 @@ BarbRenderer::BarbRenderer(const ParamsMgr *pm, string winName, string dataSetNa
     _vectorScaleFactor = .2;
     _maxThickness = .2;
     _maxValue = 0.f;
+    _cacheParams.generation = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -111,12 +112,20 @@ void BarbRenderer::_saveCacheParams()
     _cacheParams.needToRecalc = p->GetNeedToRecalculateScales();
     _cacheParams.useSingleColor = p->UseSingleColor();
     p->GetBox()->GetExtents(_cacheParams.boxMin, _cacheParams.boxMax);
+    _cacheParams.generation = 0;
 }
 
 bool BarbRenderer::_isCacheDirty() const
 {
     BarbParams *p = dynamic_cast<BarbParams *>(GetActiveParams());
     VAssert(p);
+
+    // Nothing in the params has changed since the cache was last found
+    // to be clean
+    //
+    unsigned long generation = p->GetGeneration();
+    if (_cacheParams.generation == generation) return false;
+
     if (_cacheParams.fieldVarNames != p->GetFieldVariableNames()) return true;
     if (_cacheParams.heightVarName != p->GetHeightVariableName()) return true;
     if (_cacheParams.colorVarName != p->GetColorMapVariableName()) return true;
@@ -133,6 +142,7 @@ bool BarbRenderer::_isCacheDirty() const
     if (_cacheParams.boxMin != min) return true;
     if (_cacheParams.boxMax != max) return true;
 
+    _cacheParams.generation = generation;
     return false;
 }
 
@@ -38,6 +38,10 @@
 #include <vapor/GLManager.h>
 #include <vapor/LegacyGL.h>
 #include <vapor/ArbitrarilyOrientedRegularGrid.h>
+#include <vapor/StructuredGrid.h>
+#include <vapor/OpenMPSupport.h>
+#include <algorithm>
+#include <cmath>
 
 using namespace VAPoR;
 
@@ -53,6 +57,7 @@ static RendererRegistrar<ContourRenderer> registrar(ContourRenderer::GetClassTyp
 ContourRenderer::ContourRenderer(const ParamsMgr *pm, string winName, string dataSetName, string instName, DataMgr *dataMgr)
 : Renderer(pm, winName, dataSetName, ContourParams::GetClassType(), ContourRenderer::GetClassType(), instName, dataMgr), _VAO(0), _VBO(0), _nVertices(0)
 {
+    _cacheParams.generation = 0;
 }
 
 ContourRenderer::~ContourRenderer()
@@ -79,11 +84,19 @@ void ContourRenderer::_saveCacheParams()
     _cacheParams.sliceOffset = p->GetValueDouble(p->SliceOffsetTag, 0);
     _cacheParams.sliceResolution = p->GetValueDouble(RenderParams::SampleRateTag, 200);
     _cacheParams.sliceOrientationMode = p->GetValueLong(RenderParams::SlicePlaneOrientationModeTag, 0);
+    _cacheParams.generation = 0;
 }
 
 bool ContourRenderer::_isCacheDirty() const
 {
     ContourParams *p = (ContourParams *)GetActiveParams();
+
+    // Nothing in the params has changed since the cache was last found
+    // to be clean
+    //
+    unsigned long generation = p->GetGeneration();
+    if (_cacheParams.generation == generation) return false;
+
     if (_cacheParams.varName != p->GetVariableName()) return true;
     if (_cacheParams.heightVarName != p->GetHeightVariableName()) return true;
     if (_cacheParams.ts != p->GetCurrentTimestep()) return true;
@@ -105,6 +118,7 @@ bool ContourRenderer::_isCacheDirty() const
     if (_cacheParams.boxMax != max) return true;
     if (_cacheParams.contourValues != contourValues) return true;
 
+    _cacheParams.generation = generation;
     return false;
 }
 
@@ -199,7 +213,7 @@ int ContourRenderer::_buildCache(bool fast)
         });
 
         if (fast) {
-            _cacheParams.varName = "";
+            _clearCache();
             if (grid) delete grid;
             if (grid2) delete grid2;
             if (heightGrid) delete heightGrid;
@@ -207,8 +221,104 @@ int ContourRenderer::_buildCache(bool fast)
         }
     }
 
+    float Z0 = GetDefaultZ(_dataMgr, _cacheParams.ts);
+
+    // Sorted contour values, so that the contours crossing a cell can be
+    // found from the range of the cell's node values.
+    //
+    vector<float> sortedContours(contours.begin(), contours.end());
+    std::sort(sortedContours.begin(), sortedContours.end());
+
+    const auto &gridDims = grid->GetDimensions();
+    if (dynamic_cast<const StructuredGrid *>(grid) && grid->GetTopologyDim() == 2 && gridDims[0] > 1 && gridDims[1] > 1)
+        _buildContoursStructured(grid, heightGrid, sortedContours, dims == 2, Z0, vertices);
+    else
+        _buildContoursGeneric(grid, heightGrid, sortedContours, dims == 2, Z0, vertices);
+
+    _nVertices = vertices.size();
+    glBindVertexArray(_VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, _VBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(VertexData), vertices.data(), GL_DYNAMIC_DRAW);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    if (grid) delete grid;
+    if (grid2) delete grid2;
+    if (heightGrid) delete heightGrid;
+
+    return 0;
+}
+
+// Find the contours that cross a cell whose node values lie in [vmin, vmax].
+// A contour crosses an edge if one end is <= the contour value and the other
+// is greater, so the contours sought are those in [vmin, vmax).
+//
+static void ContourRange(const vector<float> &contours, float vmin, float vmax, size_t &first, size_t &last)
+{
+    first = std::lower_bound(contours.begin(), contours.end(), vmin) - contours.begin();
+    last = std::lower_bound(contours.begin() + first, contours.end(), vmax) - contours.begin();
+}
+
+// Copy the node values of row j of a 2D structured grid to row
+//
+static void GetRowValues(const Grid *grid, size_t j, float *row)
+{
+    const auto &dims = grid->GetDimensions();
+    const auto &blks = grid->GetBlks();
+
+    if (blks.empty()) {
+        for (size_t i = 0; i < dims[0]; i++) row[i] = grid->GetValueAtIndex(DimsType{i, j, 0});
+        return;
+    }
+
+    const auto & bs = grid->GetBlockSize();
+    const size_t bdims0 = ((dims[0] - 1) / bs[0]) + 1;
+    const size_t yb = j / bs[1];
+    const size_t y = j % bs[1];
+    for (size_t xb = 0; xb < bdims0; xb++) {
+        const float *blk = blks[yb * bdims0 + xb] + y * bs[0];
+        size_t       n = std::min(bs[0], dims[0] - xb * bs[0]);
+        std::copy(blk, blk + n, row + xb * bs[0]);
+    }
+}
+
+void ContourRenderer::_addCellContours(size_t nNodes, const DimsType *nodes, const float *values, const CoordType *coords, const float *contours, size_t nContours, const Grid *heightGrid,
+                                       bool flat, float Z0, vector<VertexData> &vertices)
+{
+    for (size_t ci = 0; ci != nContours; ci++) {
+        for (size_t a = nNodes - 1, b = 0; b < nNodes; a++, b++) {
+            if (a == nNodes) a = 0;
+            float contour = contours[ci];
+
+            if ((values[a] <= contour && values[b] <= contour) || (values[a] > contour && values[b] > contour)) continue;
+
+            float t = (contour - values[a]) / (values[b] - values[a]);
+            float v[3];
+            v[0] = coords[a][0] + t * (coords[b][0] - coords[a][0]);
+            v[1] = coords[a][1] + t * (coords[b][1] - coords[a][1]);
+            v[2] = coords[a][2] + t * (coords[b][2] - coords[a][2]);
+
+            if (flat) v[2] = Z0;
+
+            if (heightGrid) {
+                float aHeight = heightGrid->GetValueAtIndex(nodes[a]);
+                float bHeight = heightGrid->GetValueAtIndex(nodes[b]);
+                v[2] = aHeight + t * (bHeight - aHeight);
+            }
+
+            vertices.push_back({v[0], v[1], v[2], contour});
+        }
+    }
+}
+
+void ContourRenderer::_buildContoursGeneric(const Grid *grid, const Grid *heightGrid, const vector<float> &contours, bool flat, float Z0, vector<VertexData> &vertices) const
+{
+    CoordType boxMin = {0.0, 0.0, 0.0};
+    CoordType boxMax = {0.0, 0.0, 0.0};
+    Grid::CopyToArr3(_cacheParams.boxMin, boxMin);
+    Grid::CopyToArr3(_cacheParams.boxMax, boxMax);
+
     double mv = grid->GetMissingValue();
-    float  Z0 = GetDefaultZ(_dataMgr, _cacheParams.ts);
 
     Grid::ConstCellIterator it = grid->ConstCellBegin(boxMin, boxMax);
 
@@ -225,50 +335,89 @@ int ContourRenderer::_buildCache(bool fast)
 
         bool hasMissing = false;
         for (int i = 0; i < nodes.size(); i++) {
-            grid->GetUserCoordinates(nodes[i], coords[i]);
             values[i] = grid->GetValueAtIndex(nodes[i]);
-            if (values[i] == mv) { hasMissing = true; }
+            if (values[i] == mv || std::isnan(values[i])) { hasMissing = true; }
         }
-        if (hasMissing) continue;
+        if (hasMissing || nodes.empty()) continue;
 
-        for (int ci = 0; ci != contours.size(); ci++) {
-            for (int a = nodes.size() - 1, b = 0; b < nodes.size(); a++, b++) {
-                if (a == nodes.size()) a = 0;
-                float contour = contours[ci];
+        size_t first, last;
+        ContourRange(contours, *std::min_element(values.begin(), values.begin() + nodes.size()), *std::max_element(values.begin(), values.begin() + nodes.size()), first, last);
+        if (first == last) continue;
 
-                if ((values[a] <= contour && values[b] <= contour) || (values[a] > contour && values[b] > contour)) continue;
+        for (int i = 0; i < nodes.size(); i++) grid->GetUserCoordinates(nodes[i], coords[i]);
 
-                float t = (contour - values[a]) / (values[b] - values[a]);
-                float v[3];
-                v[0] = coords[a][0] + t * (coords[b][0] - coords[a][0]);
-                v[1] = coords[a][1] + t * (coords[b][1] - coords[a][1]);
-                v[2] = coords[a][2] + t * (coords[b][2] - coords[a][2]);
+        _addCellContours(nodes.size(), nodes.data(), values.data(), coords.data(), contours.data() + first, last - first, heightGrid, flat, Z0, vertices);
+    }
+}
 
-                if (dims == 2) v[2] = Z0;
+// Marching squares over the quads of a 2D structured grid. Rows of cells
+// are processed in parallel, in chunks whose output is concatenated in
+// order, so the vertices are the same as those of the generic path.
+//
+void ContourRenderer::_buildContoursStructured(const Grid *grid, const Grid *heightGrid, const vector<float> &contours, bool flat, float Z0, vector<VertexData> &vertices) const
+{
+    if (contours.empty()) return;
+
+    const double mv = grid->GetMissingValue();
+    const size_t nx = grid->GetDimensions()[0];
+    const size_t ny = grid->GetDimensions()[1];
+
+    const size_t               rowsPerChunk = 16;
+    const size_t               nChunks = ((ny - 1) + rowsPerChunk - 1) / rowsPerChunk;
+    vector<vector<VertexData>> chunkVertices(nChunks);
+
+#pragma omp parallel for schedule(dynamic)
+    for (size_t c = 0; c < nChunks; c++) {
+        vector<float> row0(nx), row1(nx);
+        vector<float> cellMin(nx - 1), cellMax(nx - 1);
+
+        const size_t firstRow = c * rowsPerChunk;
+        const size_t lastRow = std::min(firstRow + rowsPerChunk, ny - 1);
+
+        GetRowValues(grid, firstRow, row0.data());
+        for (size_t j = firstRow; j < lastRow; j++) {
+            GetRowValues(grid, j + 1, row1.data());
+
+            // Range of the node values of each cell in the row. Cells whose
+            // range contains no contour are skipped without further work.
+            //
+            for (size_t i = 0; i < nx - 1; i++) {
+                cellMin[i] = std::min(std::min(row0[i], row0[i + 1]), std::min(row1[i], row1[i + 1]));
+                cellMax[i] = std::max(std::max(row0[i], row0[i + 1]), std::max(row1[i], row1[i + 1]));
+            }
 
-                if (heightGrid) {
-                    float aHeight = heightGrid->GetValueAtIndex(nodes[a]);
-                    float bHeight = heightGrid->GetValueAtIndex(nodes[b]);
-                    v[2] = aHeight + t * (bHeight - aHeight);
+            for (size_t i = 0; i < nx - 1; i++) {
+                if (cellMax[i] <= contours.front() || cellMin[i] > contours.back()) continue;
+
+                // Counter-clockwise, as returned by StructuredGrid::GetCellNodes()
+                //
+                const float values[4] = {row0[i], row0[i + 1], row1[i + 1], row1[i]};
+
+                bool hasMissing = false;
+                for (int k = 0; k < 4; k++) {
+                    if (values[k] == mv || std::isnan(values[k])) hasMissing = true;
                 }
+                if (hasMissing) continue;
+
+                size_t first, last;
+                ContourRange(contours, cellMin[i], cellMax[i], first, last);
+                if (first == last) continue;
 
-                vertices.push_back({v[0], v[1], v[2], contour});
+                const DimsType nodes[4] = {{i, j, 0}, {i + 1, j, 0}, {i + 1, j + 1, 0}, {i, j + 1, 0}};
+                CoordType      coords[4];
+                for (int k = 0; k < 4; k++) grid->GetUserCoordinates(nodes[k], coords[k]);
+
+                _addCellContours(4, nodes, values, coords, contours.data() + first, last - first, heightGrid, flat, Z0, chunkVertices[c]);
             }
+
+            std::swap(row0, row1);
         }
     }
 
-    _nVertices = vertices.size();
-    glBindVertexArray(_VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, _VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(VertexData), vertices.data(), GL_DYNAMIC_DRAW);
-    glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-    if (grid) delete grid;
-    if (grid2) delete grid2;
-    if (heightGrid) delete heightGrid;
-
-    return 0;
+    size_t nVertices = 0;
+    for (const auto &cv : chunkVertices) nVertices += cv.size();
+    vertices.reserve(vertices.size() + nVertices);
+    for (const auto &cv : chunkVertices) vertices.insert(vertices.end(), cv.begin(), cv.end());
 }
 
 int ContourRenderer::_paintGL(bool fast)
@@ -417,14 +417,14 @@ int FlowRenderer::_renderAdvection(const flow::Advection *adv)
         }
 
         for (int s = 0; s < nStreams; s++) {
-            const vector<flow::Particle> &stream = adv->GetStreamAt(s);
+            const flow::ParticleStream &stream = adv->GetStreamAt(s);
             sv.clear();
-            int sn = stream.size();
+            int sn = stream.GetNumOfParticles();
             if (_cache_isSteady) sn = std::min(sn, (int)maxSamples);
 
             for (int i = 0; i < sn + 1; i++) {
                 // "IsSpecial" means don't render this sample.
-                if (i == sn || stream[i].IsSpecial()) {
+                if (i == sn || stream.IsSpecial(i)) {
                     int svn = sv.size();
 
                     if (svn < 2) {
@@ -445,13 +445,12 @@ int FlowRenderer::_renderAdvection(const flow::Advection *adv)
                     sizes.push_back(svn + 2);
                     sv.clear();
                 } else {
-                    const flow::Particle &p = stream[i];
-
                     if (_cache_isSteady) {
-                        sv.push_back({p.location, p.value});
+                        sv.push_back({stream.GetLocation(i), stream.GetValue(i)});
                     } else {
-                        if (p.time > _timestamps.at(_cache_currentTS)) continue;
-                        if (p.time >= startingTime) sv.push_back({p.location, p.value});
+                        double time = stream.GetTime(i);
+                        if (time > _timestamps.at(_cache_currentTS)) continue;
+                        if (time >= startingTime) sv.push_back({stream.GetLocation(i), stream.GetValue(i)});
                     }
                 }
             }
@@ -655,9 +654,8 @@ int FlowRenderer::_renderFromAnAdvectionLegacy(const flow::Advection *adv, FlowP
         std::vector<float> vec;
         for (size_t s = 0; s < numOfStreams; s++) {
             const auto &stream = adv->GetStreamAt(s);
-            for (size_t i = 0; i < stream.size() && i < numOfPart; i++) {
-                const auto &p = stream[i];
-                _particleHelper1(vec, p, singleColor);
+            for (size_t i = 0; i < stream.GetNumOfParticles() && i < numOfPart; i++) {
+                _particleHelper1(vec, stream, i, singleColor);
             }    // Finish processing a stream
             if (!vec.empty()) {
                 _drawALineStrip(vec.data(), vec.size() / 4, singleColor);
@@ -673,16 +671,16 @@ int FlowRenderer::_renderFromAnAdvectionLegacy(const flow::Advection *adv, FlowP
         std::vector<float> vec;
         for (size_t s = 0; s < numOfStreams; s++) {
             const auto &stream = adv->GetStreamAt(s);
-            for (const auto &p : stream) {
-                if (p.IsSpecial())    // If p is a separator, directly send it to the helper function
+            for (size_t i = 0; i < stream.GetNumOfParticles(); i++) {
+                if (stream.IsSpecial(i))    // If p is a separator, directly send it to the helper function
                 {
-                    _particleHelper1(vec, p, singleColor);
+                    _particleHelper1(vec, stream, i, singleColor);
                 } else    // Otherwise, examine its timestamp to decide how to handle
                 {         // Finish this stream once we go beyond the current TS
-                    if (p.time > _timestamps.at(_cache_currentTS)) break;
+                    if (stream.GetTime(i) > _timestamps.at(_cache_currentTS)) break;
 
                     // Only start this stream if the current time stamp passes startingTime
-                    if (p.time >= startingTime) _particleHelper1(vec, p, singleColor);
+                    if (stream.GetTime(i) >= startingTime) _particleHelper1(vec, stream, i, singleColor);
                 }
             }    // Finish processing a stream
 
@@ -696,14 +694,15 @@ int FlowRenderer::_renderFromAnAdvectionLegacy(const flow::Advection *adv, FlowP
     return 0;
 }
 
-void FlowRenderer::_particleHelper1(std::vector<float> &vec, const flow::Particle &p, bool singleColor) const
+void FlowRenderer::_particleHelper1(std::vector<float> &vec, const flow::ParticleStream &stream, size_t i, bool singleColor) const
 {
-    if (!p.IsSpecial())    // p isn't a separator
+    if (!stream.IsSpecial(i))    // p isn't a separator
     {
-        vec.push_back(p.location.x);
-        vec.push_back(p.location.y);
-        vec.push_back(p.location.z);
-        vec.push_back(p.value);
+        const glm::vec3 &loc = stream.GetLocation(i);
+        vec.push_back(loc.x);
+        vec.push_back(loc.y);
+        vec.push_back(loc.z);
+        vec.push_back(stream.GetValue(i));
     } else if (vec.size() > 0)    // p is a separator and vec is non-empty
     {
         _drawALineStrip(vec.data(), vec.size() / 4, singleColor);
@@ -37,94 +37,23 @@ void myTiffErrHandler(const char *module, const char *fmt, va_list ap)
     }
 }
 
-};    // namespace
-
-GeoImage::GeoImage(int pixelsize, int nbands) : _pixelsize(pixelsize), _nbands(nbands)
-{
-    VAssert(pixelsize = 8);
-    VAssert(nbands = 4);
-    _tif = NULL;
-    _path.clear();
-}
-
-GeoImage::GeoImage() : _pixelsize(8), _nbands(4)
-{
-    _path.clear();
-    _tif = NULL;
-}
-
-GeoImage::~GeoImage() { GeoImage::TiffClose(); }
-
-int GeoImage::TiffOpen(string path)
-{
-    TIFFSetErrorHandler(myTiffErrHandler);
-
-    GeoImage::TiffClose();
-
-    // Check for a valid file name (this avoids Linux crash):
-    //
-    struct stat statbuf;
-    if (stat(path.c_str(), &statbuf) < 0) {
-        SetErrMsg("Invalid tiff file: %s\n", path.c_str());
-        return -1;
-    }
-
-    // Not using memory-mapped IO (m) is reputed to help plug
-    // leaks (but doesn't do any good on windows for me)
-    //
-    _tif = XTIFFOpen(path.c_str(), "rm");
-    if (!_tif) {
-        SetErrMsg("Unable to open tiff file: %s\n", path.c_str());
-        return -1;
-    }
-
-    char emsg[1000];
-    int  ok = TIFFRGBAImageOK(_tif, emsg);
-    if (!ok) {
-        MyBase::SetErrMsg("Unable to process tiff file:\n %s\nError message: %s", path.c_str(), emsg);
-        return (-1);
-    }
-
-    // Check compression.  Some compressions, e.g. jpeg, cause crash on Linux
-    //
-#ifdef VAPOR3_0_0_ALPHA
-    short compr = 1;
-    ok = TIFFGetField(_tif, TIFFTAG_COMPRESSION, &compr);
-    if (ok) {
-        if (compr != COMPRESSION_NONE && compr != COMPRESSION_LZW && compr != COMPRESSION_JPEG && compr != COMPRESSION_CCITTRLE) {
-            MyBase::SetErrMsg("Unsupported Tiff compression");
-            return (-1);
-        }
-    }
-#endif
-
-    return (0);
-}
-
-void GeoImage::TiffClose()
-{
-    if (_tif) XTIFFClose(_tif);
-    _path.clear();
-    _tif = NULL;
-}
-
 // Return dimensions of image at selected directory number
 //
-int GeoImage::TiffGetImageDimensions(int dirnum, size_t &width, size_t &height) const
+int get_image_dimensions(TIFF *tif, int dirnum, size_t &width, size_t &height)
 {
-    VAssert(_tif != NULL);
+    VAssert(tif != NULL);
     width = 0;
     height = 0;
 
-    bool ok = (bool)TIFFSetDirectory(_tif, dirnum);
+    bool ok = (bool)TIFFSetDirectory(tif, dirnum);
     if (!ok) return (-1);
 
     uint32 w;
-    ok = (bool)TIFFGetField(_tif, TIFFTAG_IMAGEWIDTH, &w);
+    ok = (bool)TIFFGetField(tif, TIFFTAG_IMAGEWIDTH, &w);
     if (!ok) return (-1);
 
     uint32 h;
-    ok = (bool)TIFFGetField(_tif, TIFFTAG_IMAGELENGTH, &h);
+    ok = (bool)TIFFGetField(tif, TIFFTAG_IMAGELENGTH, &h);
     if (!ok) return (-1);
 
     width = (size_t)w;
@@ -133,19 +62,21 @@ int GeoImage::TiffGetImageDimensions(int dirnum, size_t &width, size_t &height)
     return (0);
 }
 
-// Read the indicated TIFF image and return it as a 2D texture.
+// Read the indicated TIFF image and return it as a 2D texture. No error
+// messages are reported, so that this may be called from multiple threads
+// on different handles
 //
-int GeoImage::TiffReadImage(int dirnum, unsigned char *texture) const
+int read_image(TIFF *tif, int dirnum, unsigned char *texture)
 {
-    VAssert(_tif != NULL);
+    VAssert(tif != NULL);
 
     uint32 *texuint32 = (uint32 *)texture;
 
-    bool ok = (bool)TIFFSetDirectory(_tif, dirnum);
+    bool ok = (bool)TIFFSetDirectory(tif, dirnum);
     if (!ok) return (-1);
 
     size_t w, h;
-    int    rc = GeoImage::TiffGetImageDimensions(dirnum, w, h);
+    int    rc = get_image_dimensions(tif, dirnum, w, h);
     if (rc < 0) return (-1);
 
     // Check if this is a 2-component 8-bit image.  These are read
@@ -153,10 +84,10 @@ int GeoImage::TiffReadImage(int dirnum, unsigned char *texture) const
     // apparently does not know how to get the alpha channel
     //
     short nsamples, nbitspersample;
-    ok = TIFFGetField(_tif, TIFFTAG_SAMPLESPERPIXEL, &nsamples);
+    ok = TIFFGetField(tif, TIFFTAG_SAMPLESPERPIXEL, &nsamples);
     if (!ok) return (-1);
 
-    ok = TIFFGetField(_tif, TIFFTAG_BITSPERSAMPLE, &nbitspersample);
+    ok = TIFFGetField(tif, TIFFTAG_BITSPERSAMPLE, &nbitspersample);
     if (!ok) return (-1);
 
     if (nsamples == 2 && nbitspersample == 8) {
@@ -165,24 +96,23 @@ int GeoImage::TiffReadImage(int dirnum, unsigned char *texture) const
         short   config;
         short   photometric;
 
-        TIFFGetField(_tif, TIFFTAG_PLANARCONFIG, &config);
+        TIFFGetField(tif, TIFFTAG_PLANARCONFIG, &config);
         if (!ok) return (-1);
 
-        TIFFGetField(_tif, TIFFTAG_PHOTOMETRIC, &photometric);
+        TIFFGetField(tif, TIFFTAG_PHOTOMETRIC, &photometric);
         if (!ok) return (-1);
 
-        buf = _TIFFmalloc(TIFFScanlineSize(_tif));
+        buf = _TIFFmalloc(TIFFScanlineSize(tif));
         VAssert(buf != NULL);
 
         unsigned char *charArray = (unsigned char *)buf;
-        int            scanlength = TIFFScanlineSize(_tif) / 2;
+        int            scanlength = TIFFScanlineSize(tif) / 2;
 
         if (config == PLANARCONFIG_CONTIG) {
             for (row = 0; row < h; row++) {
                 int revrow = h - row - 1;    // reverse, go bottom up
-                int rc = TIFFReadScanline(_tif, buf, row);
+                int rc = TIFFReadScanline(tif, buf, row);
                 if (rc < 0) {
-                    MyBase::SetErrMsg("Error reading tiff file:\n %s\n", _path.c_str());
                     _TIFFfree(buf);
                     return (-1);
                 }
@@ -203,9 +133,8 @@ int GeoImage::TiffReadImage(int dirnum, unsigned char *texture) const
             //
             for (s = 0; s < nsamples; s++) {
                 for (row = 0; row < h; row++) {
-                    int rc = TIFFReadScanline(_tif, buf, row, s);
+                    int rc = TIFFReadScanline(tif, buf, row, s);
                     if (rc < 0) {
-                        MyBase::SetErrMsg("Error reading tiff file:\n %s\n", _path.c_str());
                         _TIFFfree(buf);
                         return (-1);
                     }
@@ -232,16 +161,112 @@ int GeoImage::TiffReadImage(int dirnum, unsigned char *texture) const
     } else {
         // Read pixels, whether or not we are georeferenced:
 
-        ok = TIFFReadRGBAImage(_tif, w, h, texuint32, 0);
-        if (!ok) {
-            MyBase::SetErrMsg("Error reading tiff file:\n %s\n", _path.c_str());
-            return -1;
-        }
+        ok = TIFFReadRGBAImage(tif, w, h, texuint32, 0);
+        if (!ok) return -1;
 
         return (0);
     }
 }
 
+};    // namespace
+
+GeoImage::GeoImage(int pixelsize, int nbands) : _pixelsize(pixelsize), _nbands(nbands)
+{
+    VAssert(pixelsize = 8);
+    VAssert(nbands = 4);
+    _tif = NULL;
+    _path.clear();
+}
+
+GeoImage::GeoImage() : _pixelsize(8), _nbands(4)
+{
+    _path.clear();
+    _tif = NULL;
+}
+
+GeoImage::~GeoImage() { GeoImage::TiffClose(); }
+
+int GeoImage::TiffOpen(string path)
+{
+    TIFFSetErrorHandler(myTiffErrHandler);
+
+    GeoImage::TiffClose();
+
+    // Check for a valid file name (this avoids Linux crash):
+    //
+    struct stat statbuf;
+    if (stat(path.c_str(), &statbuf) < 0) {
+        SetErrMsg("Invalid tiff file: %s\n", path.c_str());
+        return -1;
+    }
+
+    // Not using memory-mapped IO (m) is reputed to help plug
+    // leaks (but doesn't do any good on windows for me)
+    //
+    _tif = XTIFFOpen(path.c_str(), "rm");
+    if (!_tif) {
+        SetErrMsg("Unable to open tiff file: %s\n", path.c_str());
+        return -1;
+    }
+
+    char emsg[1000];
+    int  ok = TIFFRGBAImageOK(_tif, emsg);
+    if (!ok) {
+        MyBase::SetErrMsg("Unable to process tiff file:\n %s\nError message: %s", path.c_str(), emsg);
+        return (-1);
+    }
+
+    // Check compression.  Some compressions, e.g. jpeg, cause crash on Linux
+    //
+#ifdef VAPOR3_0_0_ALPHA
+    short compr = 1;
+    ok = TIFFGetField(_tif, TIFFTAG_COMPRESSION, &compr);
+    if (ok) {
+        if (compr != COMPRESSION_NONE && compr != COMPRESSION_LZW && compr != COMPRESSION_JPEG && compr != COMPRESSION_CCITTRLE) {
+            MyBase::SetErrMsg("Unsupported Tiff compression");
+            return (-1);
+        }
+    }
+#endif
+
+    return (0);
+}
+
+void GeoImage::TiffClose()
+{
+    if (_tif) XTIFFClose(_tif);
+    _path.clear();
+    _tif = NULL;
+}
+
+// Return dimensions of image at selected directory number
+//
+int GeoImage::TiffGetImageDimensions(int dirnum, size_t &width, size_t &height) const { return (get_image_dimensions(_tif, dirnum, width, height)); }
+
+// Read the indicated TIFF image and return it as a 2D texture.
+//
+int GeoImage::TiffReadImage(int dirnum, unsigned char *texture) const
+{
+    int rc = read_image(_tif, dirnum, texture);
+    if (rc < 0) {
+        MyBase::SetErrMsg("Error reading tiff file:\n %s\n", _path.c_str());
+        return (-1);
+    }
+    return (0);
+}
+
+int GeoImage::TiffReadImage(string path, int dirnum, unsigned char *texture)
+{
+    TIFF *tif = XTIFFOpen(path.c_str(), "rm");
+    if (!tif) return (-1);
+
+    char emsg[1000];
+    int  rc = TIFFRGBAImageOK(tif, emsg) ? read_image(tif, dirnum, texture) : -1;
+
+    XTIFFClose(tif);
+    return (rc);
+}
+
 // Project extents (ll, ur) given in PCS coordinates in srccoords using the
 // specified projection in proj4src
 // into 4 corners and return the extents (ll, ur) in the projected
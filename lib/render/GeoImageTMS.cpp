@@ -3,6 +3,8 @@
 #include "vapor/VAssert.h"
 #include <cmath>
 #include <cstdio>
+#include <algorithm>
+#include <set>
 #ifdef WIN32
     #include <geotiff/geotiff.h>
     #include <geotiff/geo_normalize.h>
@@ -16,6 +18,7 @@
 #include <vapor/GeoTileMercator.h>
 #include <vapor/TMSUtils.h>
 #include <vapor/GeoImageTMS.h>
+#include <vapor/OpenMPSupport.h>
 
 using namespace VAPoR;
 using namespace Wasp;
@@ -27,8 +30,7 @@ GeoImageTMS::GeoImageTMS() : GeoImage(8, 4)
     _maxLOD = 0;
     _texture = NULL;
     _textureSize = 0;
-    _tileBuf = NULL;
-    _tileBufSize = 0;
+    _tileCacheSize = 256 * 1024 * 1024;
     _geotile = NULL;
 
     // The default projection string for imagery centered at 0 degrees
@@ -45,9 +47,6 @@ GeoImageTMS::~GeoImageTMS()
     if (_texture) delete[] _texture;
     _textureSize = 0;
 
-    if (_tileBuf) delete[] _tileBuf;
-    _tileBufSize = 0;
-
     if (_geotile) delete _geotile;
 }
 
@@ -80,21 +79,17 @@ int GeoImageTMS::Initialize(string dir, vector<double> times)
     //
     _geotile = new GeoTileMercator(w, h, 4);
 
-    //
-    // Allocate space to buffer a tile
-    //
-    size_t size = w * h * 4;
-    if (_tileBufSize < size) {
-        delete[] _tileBuf;
-        _tileBuf = new unsigned char[size];
-        _tileBufSize = size;
-    }
-
     return (0);
 }
 
 void GeoImageTMS::SetLOD(int lod) { _currentLOD = lod; }
 
+void GeoImageTMS::SetTileCacheSize(size_t size)
+{
+    _tileCacheSize = size;
+    if (_geotile) _geotile->Evict(_tileCacheSize);
+}
+
 unsigned char *GeoImageTMS::GetImage(size_t ts, size_t &width, size_t &height)
 {
     _geotile->GetTileSize(width, height);
@@ -347,27 +342,87 @@ int GeoImageTMS::_getMap(const size_t pixelSW[2], const size_t pixelNE[2], int l
         nytiles = ntiles - ((tileY1 == tileY0) ? 0 : (tileY0 - tileY1 - 1));
     }
 
-    // Make sure tiles need for this map are loaded. If not, read
-    // and load them
+    // Find the tiles needed for this map that are not already loaded,
+    // plus those in a one tile wide halo around the map, so that small
+    // pans don't have to wait on the file system. Halo tiles are
+    // optional: it is not an error if they can't be read
+    //
+    struct tile_t {
+        size_t x;
+        size_t y;
+        bool   required;
+    };
+    vector<tile_t> missing;
+    set<string>    quadkeys;
+
+    // First pass collects the map's tiles, the second the halo. With
+    // wraparound a halo tile may also be one of the map's tiles
     //
-    size_t tileY = tileY0;
-    for (size_t y = 0; y < nytiles; y++) {
-        size_t tileX = tileX0;
-        for (size_t x = 0; x < nxtiles; x++) {
-            string quadkey = _geotile->TileXYToQuadKey(tileX, tileY, lod);
-            if (!_geotile->GetTile(quadkey)) {
-                int rc = _tileRead(_dir, tileX, tileY, lod, _tileBuf);
-                if (rc < 0) return (-1);
-
-                rc = _geotile->Insert(quadkey, _tileBuf);
-                VAssert(!(rc < 0));
+    for (int pass = 0; pass < 2; pass++) {
+        for (long y = -1; y <= (long)nytiles; y++) {
+            bool haloRow = y < 0 || y >= (long)nytiles;
+            long tileY = (long)tileY0 + y;
+            if (haloRow && (tileY < 0 || tileY >= (long)ntiles)) continue;
+            tileY %= ntiles;
+
+            for (long x = -1; x <= (long)nxtiles; x++) {
+                bool required = !haloRow && x >= 0 && x < (long)nxtiles;
+                if (required != (pass == 0)) continue;
+
+                size_t tileX = (tileX0 + ntiles + x) % ntiles;
+                string quadkey = _geotile->TileXYToQuadKey(tileX, tileY, lod);
+                if (quadkeys.count(quadkey) || _geotile->GetTile(quadkey)) continue;
+
+                quadkeys.insert(quadkey);
+                missing.push_back(tile_t{tileX, (size_t)tileY, required});
             }
-            tileX = (tileX + 1) % ntiles;
         }
+    }
 
-        tileY = (tileY + 1) % ntiles;
+    // Read and decode the missing tiles in parallel, one batch at a
+    // time, and insert them into the cache. The TIFF library's error
+    // handler is not thread safe, so it's disabled while tiles are read
+    //
+    size_t w, h;
+    _geotile->GetTileSize(w, h);
+    size_t tileSize = w * h * 4;
+    size_t batchSize = std::min(missing.size(), (size_t)(4 * omp_get_max_threads()));
+    if (_tileBuf.size() < batchSize * tileSize) _tileBuf.resize(batchSize * tileSize);
+
+    TIFFErrorHandler errHandler = TIFFSetErrorHandler(NULL);
+    for (size_t first = 0; first < missing.size(); first += batchSize) {
+        size_t      n = std::min(batchSize, missing.size() - first);
+        vector<int> status(n);
+
+#pragma omp parallel for schedule(dynamic, 1)
+        for (long i = 0; i < (long)n; i++) {
+            const tile_t &tile = missing[first + i];
+            string        path = TMSUtils::TilePath(_dir, tile.x, tile.y, lod);
+            status[i] = path.empty() ? -1 : GeoImage::TiffReadImage(path, 0, _tileBuf.data() + i * tileSize);
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            const tile_t &tile = missing[first + i];
+            if (status[i] < 0) {
+                if (!tile.required) continue;
+
+                TIFFSetErrorHandler(errHandler);
+                SetErrMsg("Failed to read tile %d %d %d", tile.x, tile.y, lod);
+                return (-1);
+            }
+
+            int rc = _geotile->Insert(_geotile->TileXYToQuadKey(tile.x, tile.y, lod), _tileBuf.data() + i * tileSize);
+            VAssert(!(rc < 0));
+        }
     }
+    TIFFSetErrorHandler(errHandler);
 
     int rc = _geotile->GetMap(pixelSW[0], pixelSW[1], pixelNE[0], pixelNE[1], lod, texture);
+
+    // Trim the cache. Tiles used by this map are the most recently used,
+    // and are the last to go
+    //
+    _geotile->Evict(_tileCacheSize);
+
     return (rc);
 }
@@ -2,6 +2,7 @@
 #include <cstring>
 #include <algorithm>
 #include <sstream>
+#include "vapor/VAssert.h"
 #include "vapor/GeoTile.h"
 
 using namespace std;
@@ -13,6 +14,7 @@ GeoTile::GeoTile(size_t tile_width, size_t tile_height, size_t pixel_size, doubl
     _tile_height = tile_height;
     _pixel_size = pixel_size;
     _tiles.clear();
+    _lru.clear();
 
     _MinLongitude = min_lon;
     _MinLatitude = min_lat;
@@ -22,10 +24,10 @@ GeoTile::GeoTile(size_t tile_width, size_t tile_height, size_t pixel_size, doubl
 
 GeoTile::~GeoTile()
 {
-    std::map<string, unsigned char *>::iterator p;
+    std::map<string, tile_t>::iterator p;
 
     for (p = _tiles.begin(); p != _tiles.end(); ++p) {
-        if (p->second) delete[] p->second;
+        if (p->second._image) delete[] p->second._image;
     }
 }
 
@@ -50,13 +52,15 @@ int GeoTile::Insert(std::string quadkey, const unsigned char *image)
     int    rc = QuadKeyToTileXY(quadkey, tileX, tileY, lod);
     if (rc < 0) return (rc);    // invalid quadkey
 
-    std::map<string, unsigned char *>::iterator p = _tiles.find(quadkey);
-    unsigned char *                             imgptr;
+    std::map<string, tile_t>::iterator p = _tiles.find(quadkey);
+    unsigned char *                    imgptr;
     if (p != _tiles.end()) {
-        imgptr = p->second;    // tile already exists;
+        imgptr = p->second._image;    // tile already exists;
+        _lru.splice(_lru.begin(), _lru, p->second._lru);
     } else {
         imgptr = new unsigned char[_tile_width * _tile_height * _pixel_size];
-        _tiles[quadkey] = imgptr;
+        _lru.push_front(quadkey);
+        _tiles[quadkey] = tile_t{imgptr, _lru.begin()};
     }
     memcpy(imgptr, image, _tile_width * _tile_height * _pixel_size);
     return (0);
@@ -64,14 +68,27 @@ int GeoTile::Insert(std::string quadkey, const unsigned char *image)
 
 const unsigned char *GeoTile::GetTile(string quadkey) const
 {
-    map<string, unsigned char *>::const_iterator p = _tiles.find(quadkey);
+    map<string, tile_t>::const_iterator p = _tiles.find(quadkey);
     if (p != _tiles.end()) {
-        return (p->second);    // tile already exists;
+        _lru.splice(_lru.begin(), _lru, p->second._lru);
+        return (p->second._image);    // tile already exists;
     } else {
         return (NULL);
     }
 }
 
+void GeoTile::Evict(size_t maxSize)
+{
+    while (!_lru.empty() && GetTilesSize() > maxSize) {
+        map<string, tile_t>::iterator p = _tiles.find(_lru.back());
+        VAssert(p != _tiles.end());
+
+        delete[] p->second._image;
+        _tiles.erase(p);
+        _lru.pop_back();
+    }
+}
+
 int GeoTile::GetMap(size_t pixelX0, size_t pixelY0, size_t pixelX1, size_t pixelY1, int lod, unsigned char *map_image) const
 {
     //
@@ -337,14 +337,21 @@ vector<float> Histo::getDataSamplesIterating(const Grid *grid, const int stride)
     VAssert(grid);
     vector<float> samples;
 
-    float               missingValue = grid->GetMissingValue();
-    Grid::ConstIterator enditr = grid->cend();
+    float           missingValue = grid->GetMissingValue();
+    const DimsType &dims = grid->GetDimensions();
+    DimsType        max = {dims[0] - 1, dims[1] - 1, dims[2] - 1};
+    size_t          step = stride > 0 ? stride : 1;
+
+    // Sample every stride'th grid point in index order, i.e. the points
+    // whose linear index is a multiple of the stride
+    //
+    grid->ForEachSpan(DimsType{0, 0, 0}, max, [&](const float *values, size_t n, const DimsType &index) {
+        size_t offset = index[0] + dims[0] * (index[1] + dims[1] * index[2]);
+        for (size_t i = (step - offset % step) % step; i < n; i += step) {
+            if (values[i] != missingValue) samples.push_back(values[i]);
+        }
+    });
 
-    for (auto itr = grid->cbegin(); itr != enditr; itr += stride) {
-        float v = *itr;
-        if (v != missingValue) samples.push_back(v);
-    }
-    
     return samples;
 }
 
@@ -382,6 +389,11 @@ vector<float> Histo::getDataSamplesSampling(const Grid *grid, const vector<doubl
     if (deltas[Y] == 0) jSamples = 1;
     if (deltas[Z] == 0) kSamples = 1;
 
+    // Collect the sample points and sample them with a single batched call
+    //
+    std::vector<double> points;
+    points.reserve(iSamples * jSamples * kSamples * 3);
+
     for (int k = 0; k < kSamples; k++) {
         coords[Y] = yStartPoint;
 
@@ -389,16 +401,24 @@ vector<float> Histo::getDataSamplesSampling(const Grid *grid, const vector<doubl
             coords[X] = xStartPoint;
 
             for (int i = 0; i < iSamples; i++) {
-                varValue = grid->GetValue(coords);
-                missingValue = grid->GetMissingValue();
-                if (varValue != missingValue) samples.push_back(varValue);
+                points.insert(points.end(), coords.begin(), coords.end());
                 coords[X] += deltas[X];
             }
             coords[Y] += deltas[Y];
         }
         coords[Z] += deltas[Z];
     }
-    
+
+    size_t        n = points.size() / 3;
+    vector<float> values(n);
+    grid->GetValues(points.data(), n, values.data());
+
+    missingValue = grid->GetMissingValue();
+    for (size_t i = 0; i < n; i++) {
+        varValue = values[i];
+        if (varValue != missingValue) samples.push_back(varValue);
+    }
+
     return samples;
 }
 
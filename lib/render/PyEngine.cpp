@@ -3,6 +3,8 @@
 #include <vector>
 #include <map>
 #include <new>
+#include <cstring>
+#include <functional>
 #include <vapor/utils.h>
 #include <vapor/DataMgrUtils.h>
 #include <vapor/PyEngine.h>
@@ -41,12 +43,6 @@ void free_arrays(vector<float *> &arrays)
     }
 }
 
-void free_arrays(vector<float *> &inputVarArrays, vector<float *> &outputVarArrays)
-{
-    free_arrays(inputVarArrays);
-    free_arrays(outputVarArrays);
-}
-
 int alloc_arrays(const vector<DimsType> &dimsVectors, vector<float *> &arrays)
 {
     arrays.clear();
@@ -65,32 +61,18 @@ int alloc_arrays(const vector<DimsType> &dimsVectors, vector<float *> &arrays)
     return (0);
 }
 
-int alloc_arrays(const vector<DimsType> &inputVarDims, const vector<DimsType> &outputVarDims, vector<float *> &inputVarArrays, vector<float *> &outputVarArrays)
-{
-    inputVarArrays.clear();
-    outputVarArrays.clear();
-
-    int rc = alloc_arrays(inputVarDims, inputVarArrays);
-    if (rc < 0) return (rc);
-
-    rc = alloc_arrays(outputVarDims, outputVarArrays);
-    if (rc < 0) {
-        free_arrays(inputVarArrays);
-        return (rc);
-    }
-
-    return (0);
-}
-
+// Copy the subregion [min, max] of the array src, with dimensions dims,
+// to dst. Rows along the fastest varying axis are contiguous in both
+// arrays and are copied whole
+//
 void copy_region(const float *src, float *dst, const DimsType &min, const DimsType &max, const DimsType &dims)
 {
-    DimsType coord = min;
-    for (size_t i = 0; i < VProduct(Grid::Dims(min, max).data(), min.size()); i++) {
-        size_t offset = LinearizeCoords(coord.data(), dims.data(), coord.size());
-
-        dst[i] = src[offset];
-
-        IncrementCoords(min.data(), max.data(), coord.data(), min.size(), 0);
+    size_t nx = max[0] - min[0] + 1;
+    for (size_t k = min[2]; k <= max[2]; k++) {
+        for (size_t j = min[1]; j <= max[1]; j++) {
+            const float *row = src + (k * dims[1] + j) * dims[0] + min[0];
+            dst = std::copy(row, row + nx, dst);
+        }
     }
 }
 
@@ -490,11 +472,28 @@ int PyEngine::_python2c(PyObject *dict, vector<string> outputVarNames, vector<Di
             }
         }
 
-        float *dataArray = (float *)PyArray_DATA(varArray);
         size_t nelements = VProduct(dims.data(), dims.size());
-
         float *outArray = outputVarArrays[i];
-        for (size_t j = 0; j < nelements; j++) { outArray[j] = dataArray[j]; }
+
+        if (PyArray_IS_C_CONTIGUOUS(varArray)) {
+            memcpy(outArray, PyArray_DATA(varArray), nelements * sizeof(*outArray));
+            continue;
+        }
+
+        // Strided array (e.g. a transposed or sliced view). Wrap the
+        // destination in an array and let NumPy do the copy
+        //
+        PyObject *outObj = PyArray_SimpleNewFromData(nd, pyDims, NPY_FLOAT32, outArray);
+        if (!outObj) {
+            SetErrMsg("PyArray_SimpleNewFromData() : %s", MyPython::Instance()->PyErr().c_str());
+            return -1;
+        }
+        int rc = PyArray_CopyInto((PyArrayObject *)outObj, varArray);
+        Py_DECREF(outObj);
+        if (rc < 0) {
+            SetErrMsg("PyArray_CopyInto() : %s", MyPython::Instance()->PyErr().c_str());
+            return -1;
+        }
     }
 
     return (0);
@@ -506,6 +505,7 @@ PyEngine::DerivedPythonVar::DerivedPythonVar(string varName, string units, DC::X
 {
     _inNames = inNames;
     _script = script;
+    _scriptHash = std::hash<string>()(script);
     _dataMgr = dataMgr;
     _coordFlag = coordFlag;
     _dims = {1, 1, 1};
@@ -619,24 +619,69 @@ int PyEngine::DerivedPythonVar::CloseVariable(int fd)
     return (0);
 }
 
-int PyEngine::DerivedPythonVar::_readRegionAll(int fd, const DimsType &min, const DimsType &max, float *region)
+bool PyEngine::DerivedPythonVar::result_c::Contains(const DimsType &min, const DimsType &max) const
 {
-    DC::FileTable::FileObject *f = _fileTable.GetEntry(fd);
+    for (int i = 0; i < min.size(); i++) {
+        if (min[i] < _minAbs[i] || max[i] >= _minAbs[i] + _dims[i]) return (false);
+    }
+    return (true);
+}
+
+std::shared_ptr<PyEngine::DerivedPythonVar::result_c> PyEngine::DerivedPythonVar::_newResult(size_t ts, int level, int lod) const
+{
+    std::shared_ptr<result_c> result(new result_c());
+    result->_scriptHash = _scriptHash;
+    result->_ts = ts;
+    result->_level = level;
+    result->_lod = lod;
+    for (int i = 0; i < _inNames.size(); i++) { result->_inputVersions.push_back(_dataMgr->GetVarVersion(_inNames[i])); }
+    result->_minAbs = {0, 0, 0};
+    result->_dims = {1, 1, 1};
 
-    vector<Grid *> variables;
+    return (result);
+}
 
-    size_t ts = f->GetTS();
-    int    level = f->GetLevel();
-    int    lod = f->GetLOD();
+std::shared_ptr<const PyEngine::DerivedPythonVar::result_c> PyEngine::DerivedPythonVar::_findResult(const result_c &key, const DimsType &min, const DimsType &max)
+{
+    std::lock_guard<std::mutex> guard(_resultsMutex);
+
+    auto itr = _results.begin();
+    while (itr != _results.end()) {
+        const result_c &r = **itr;
 
-    int rc = DataMgrUtils::GetGrids(_dataMgr, ts, _inNames, false, &level, &lod, variables);
-    if (rc < 0) return (-1);
+        // Results computed from older versions of the inputs can never
+        // be used again
+        //
+        if (r._inputVersions != key._inputVersions) {
+            itr = _results.erase(itr);
+            continue;
+        }
+
+        if (r._scriptHash == key._scriptHash && r._ts == key._ts && r._level == key._level && r._lod == key._lod && r.Contains(min, max)) {
+            _results.splice(_results.begin(), _results, itr);
+            return (_results.front());
+        }
+        ++itr;
+    }
+
+    return (nullptr);
+}
+
+void PyEngine::DerivedPythonVar::_putResult(const std::shared_ptr<const result_c> &result)
+{
+    std::lock_guard<std::mutex> guard(_resultsMutex);
 
+    _results.push_front(result);
+    while (_results.size() > _maxResults) _results.pop_back();
+}
+
+int PyEngine::DerivedPythonVar::_runScript(const vector<Grid *> &variables, const DimsType &outDims, float *out)
+{
     vector<varinfo_t> varInfoVec;
     get_var_info(_dataMgr, variables, _inNames, _coordFlag, varInfoVec);
 
-    vector<DimsType>       inputVarDims;
-    vector<string>         inputNames;
+    vector<DimsType> inputVarDims;
+    vector<string>   inputNames;
     for (int i = 0; i < varInfoVec.size(); i++) {
         const varinfo_t &vref = varInfoVec[i];
 
@@ -648,16 +693,8 @@ int PyEngine::DerivedPythonVar::_readRegionAll(int fd, const DimsType &min, cons
         }
     }
 
-    vector<size_t> dims_vec, dummy;
-    (void)GetDimLensAtLevel(level, dims_vec, dummy);
-
-    DimsType dims = {1, 1, 1};
-    Grid::CopyToArr3(dims_vec, dims);
-    vector<DimsType> outputVarDims = {dims};
-
     vector<float *> inputVarArrays;
-    vector<float *> outputVarArrays;
-    rc = alloc_arrays(inputVarDims, outputVarDims, inputVarArrays, outputVarArrays);
+    int             rc = alloc_arrays(inputVarDims, inputVarArrays);
     if (rc < 0) {
         SetErrMsg("Error allocating  memory");
         return (-1);
@@ -671,106 +708,105 @@ int PyEngine::DerivedPythonVar::_readRegionAll(int fd, const DimsType &min, cons
     (void)MyPython::Instance()->PyOut();
 
     vector<string> outputVarNames = {_derivedVarName};
-    rc = PyEngine::Calculate(_script, inputNames, inputVarDims, inputVarArrays, outputVarNames, outputVarDims, outputVarArrays);
+    rc = PyEngine::Calculate(_script, inputNames, inputVarDims, inputVarArrays, outputVarNames, {outDims}, {out});
 
     //
     // Capture any stdout
     //
     _stdoutString = MyPython::Instance()->PyOut().c_str();
 
-    if (rc < 0) {
-        free_arrays(inputVarArrays, outputVarArrays);
-        return (-1);
-    }
-
-    copy_region(outputVarArrays[0], region, min, max, outputVarDims[0]);
-
-    free_arrays(inputVarArrays, outputVarArrays);
+    free_arrays(inputVarArrays);
 
-    return (0);
+    return (rc);
 }
 
-int PyEngine::DerivedPythonVar::_readRegionSubset(int fd, const DimsType &min, const DimsType &max, float *region)
+int PyEngine::DerivedPythonVar::_readRegionAll(int fd, const DimsType &min, const DimsType &max, float *region)
 {
     DC::FileTable::FileObject *f = _fileTable.GetEntry(fd);
 
-    vector<Grid *> variables;
-
     size_t ts = f->GetTS();
     int    level = f->GetLevel();
     int    lod = f->GetLOD();
 
-    int rc = DataMgrUtils::GetGrids(_dataMgr, ts, _inNames, min, max, false, &level, &lod, variables);
-    if (rc < 0) return (-1);
+    // The script is run over the entire domain, so any region of a
+    // previous result for this time step can be reused
+    //
+    std::shared_ptr<result_c>       newResult = _newResult(ts, level, lod);
+    std::shared_ptr<const result_c> result = _findResult(*newResult, min, max);
 
-    vector<varinfo_t> varInfoVec;
-    get_var_info(_dataMgr, variables, _inNames, _coordFlag, varInfoVec);
+    if (!result) {
+        vector<Grid *> variables;
+        int            rc = DataMgrUtils::GetGrids(_dataMgr, ts, _inNames, false, &level, &lod, variables);
+        if (rc < 0) return (-1);
 
-    vector<DimsType>       inputVarDims;
-    vector<string>         inputNames;
-    for (int i = 0; i < varInfoVec.size(); i++) {
-        const varinfo_t &vref = varInfoVec[i];
+        vector<size_t> dims_vec, dummy;
+        (void)GetDimLensAtLevel(level, dims_vec, dummy);
+        Grid::CopyToArr3(dims_vec, newResult->_dims);
 
-        inputNames.push_back(vref._name);
-        inputVarDims.push_back(vref._dims);
-        for (int j = 0; j < vref._coordNames.size(); j++) {
-            inputNames.push_back(vref._coordNames[j]);
-            inputVarDims.push_back(vref._coordDims[j]);
-        }
-    }
+        newResult->_data.resize(VProduct(newResult->_dims.data(), newResult->_dims.size()));
+        rc = _runScript(variables, newResult->_dims, newResult->_data.data());
 
-    // output and input variable(s) (if they exist) are all defined
-    // on the same mesh (they have same dimensions)
-    //
-    vector<DimsType>       outputVarDims;
-    DimsType               minAbs = {0, 0, 0};
-    if (inputVarDims.size()) {
-        outputVarDims.push_back(inputVarDims[0]);
-        minAbs = variables[0]->GetMinAbs();
-    } else {
-        outputVarDims.push_back(Grid::Dims(min, max));
-    }
+        for (int i = 0; i < variables.size(); i++) delete variables[i];
+        if (rc < 0) return (-1);
 
-    vector<float *> inputVarArrays;
-    vector<float *> outputVarArrays;
-    rc = alloc_arrays(inputVarDims, outputVarDims, inputVarArrays, outputVarArrays);
-    if (rc < 0) {
-        SetErrMsg("Error allocating  memory");
-        return (-1);
+        _putResult(newResult);
+        result = newResult;
     }
 
-    grid2c(varInfoVec, inputVarArrays);
+    copy_region(result->_data.data(), region, min, max, result->_dims);
 
-    //
-    // clear stdout from static class
-    //
-    (void)MyPython::Instance()->PyOut();
+    return (0);
+}
 
-    vector<string> outputVarNames = {_derivedVarName};
-    rc = PyEngine::Calculate(_script, inputNames, inputVarDims, inputVarArrays, outputVarNames, outputVarDims, outputVarArrays);
+int PyEngine::DerivedPythonVar::_readRegionSubset(int fd, const DimsType &min, const DimsType &max, float *region)
+{
+    DC::FileTable::FileObject *f = _fileTable.GetEntry(fd);
 
+    size_t ts = f->GetTS();
+    int    level = f->GetLevel();
+    int    lod = f->GetLOD();
+
+    // A previous result may be reused if it covers the requested region
     //
-    // Capture any stdout
-    //
-    _stdoutString = MyPython::Instance()->PyOut().c_str();
+    std::shared_ptr<result_c>       newResult = _newResult(ts, level, lod);
+    std::shared_ptr<const result_c> result = _findResult(*newResult, min, max);
 
-    if (rc < 0) {
-        free_arrays(inputVarArrays, outputVarArrays);
-        return (-1);
+    if (!result) {
+        vector<Grid *> variables;
+        int            rc = DataMgrUtils::GetGrids(_dataMgr, ts, _inNames, min, max, false, &level, &lod, variables);
+        if (rc < 0) return (-1);
+
+        // output and input variable(s) (if they exist) are all defined
+        // on the same mesh (they have same dimensions)
+        //
+        if (variables.size()) {
+            newResult->_minAbs = variables[0]->GetMinAbs();
+            newResult->_dims = variables[0]->GetDimensions();
+        } else {
+            newResult->_minAbs = min;
+            newResult->_dims = Grid::Dims(min, max);
+        }
+
+        newResult->_data.resize(VProduct(newResult->_dims.data(), newResult->_dims.size()));
+        rc = _runScript(variables, newResult->_dims, newResult->_data.data());
+
+        for (int i = 0; i < variables.size(); i++) delete variables[i];
+        if (rc < 0) return (-1);
+
+        _putResult(newResult);
+        result = newResult;
     }
 
     // The min and max coordinates input to this method are relative to
     // the entire domain. We need to correct them by substracting off the
-    // origin of the ROI contained in the Grid objects
+    // origin of the ROI contained in the result
     //
     DimsType min_roi, max_roi;
     for (int i = 0; i < min.size(); i++) {
-        min_roi[i] = (min[i] - minAbs[i]);
-        max_roi[i] = (max[i] - minAbs[i]);
+        min_roi[i] = (min[i] - result->_minAbs[i]);
+        max_roi[i] = (max[i] - result->_minAbs[i]);
     }
-    copy_region(outputVarArrays[0], region, min_roi, max_roi, outputVarDims[0]);
-
-    free_arrays(inputVarArrays, outputVarArrays);
+    copy_region(result->_data.data(), region, min_roi, max_roi, result->_dims);
 
     return (0);
 }
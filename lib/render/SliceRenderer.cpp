@@ -46,6 +46,7 @@ SliceRenderer::SliceRenderer(const ParamsMgr *pm, string winName, string dataSet
     _dataValueTextureID = 0;
 
     _cacheParams.textureSampleRate = 200;
+    _cacheParams.generation = 0;
 
     SliceParams *p = dynamic_cast<SliceParams *>(GetActiveParams());
     VAssert(p);
@@ -393,7 +394,13 @@ int SliceRenderer::_paintGL(bool fast)
 
     _initializeState();
 
-    if (_isDataCacheDirty() || _isBoxCacheDirty()) {
+    // Nothing in the params has changed since the caches were last found
+    // to be clean
+    //
+    unsigned long generation = GetActiveParams()->GetGeneration();
+    bool          paramsChanged = _cacheParams.generation != generation;
+
+    if (paramsChanged && (_isDataCacheDirty() || _isBoxCacheDirty())) {
         _resetCache();
 
         // If we're in fast mode, degrade the quality of the slice for better interactivity
@@ -407,7 +414,8 @@ int SliceRenderer::_paintGL(bool fast)
         if (rc < 0) return -1;
     }
 
-    if (_isColormapCacheDirty()) _resetColormapCache();
+    if (paramsChanged && _isColormapCacheDirty()) _resetColormapCache();
+    _cacheParams.generation = generation;
 
     _configureShader();
     if (CheckGLError() != 0) {
@@ -2,11 +2,13 @@
 #include <vector>
 #include <array>
 #include <algorithm>
+#include <cstdint>
 #include <vapor/glutil.h>
 #include <glm/glm.hpp>
 #include <vapor/GLManager.h>
 #include <vapor/ShaderManager.h>
 #include <vapor/Progress.h>
+#include <vapor/OpenMPSupport.h>
 
 #ifndef FLT16_MAX
     #define FLT16_MAX 6.55E4
@@ -25,6 +27,14 @@ static VolumeAlgorithmRegistrar<VolumeCellTraversalIso> registration2;
 
 #define MAX_LEVELS 12
 
+// Mip levels with fewer bounding boxes per side than this are reduced
+// serially
+#define MIN_PARALLEL_MIP_SIZE 4096
+
+// FNV-1a parameters for the checksum of the coordinates
+#define CHECKSUM_OFFSET 14695981039346656037ULL
+#define CHECKSUM_PRIME  1099511628211ULL
+
 #define FI_LEFT  0
 #define FI_RIGHT 1
 #define FI_UP    2
@@ -120,7 +130,9 @@ static bool ComputeSideBBoxes(ivec3 side, int fastDim, int slowDim, vec3 *boxMin
     ivec3 index = (side + 1) / 2 * (cellDims - 1);
     int   sideID = GetFaceIndexFromFace(side);
 
-    for (index[slowDim] = 0; index[slowDim] < cellDims[slowDim]; index[slowDim]++) {
+#pragma omp parallel for schedule(static) firstprivate(index)
+    for (int slow = 0; slow < cellDims[slowDim]; slow++) {
+        index[slowDim] = slow;
         for (index[fastDim] = 0; index[fastDim] < cellDims[fastDim]; index[fastDim]++) {
             vec3 v0, v1, v2, v3;
             GetFaceVertices(index, side, coordData, coordDims, v0, v1, v2, v3);
@@ -132,7 +144,7 @@ static bool ComputeSideBBoxes(ivec3 side, int fastDim, int slowDim, vec3 *boxMin
     return false;
 }
 
-VolumeCellTraversal::VolumeCellTraversal(GLManager *gl, VolumeRenderer *renderer) : VolumeRegular(gl, renderer), _useHighPrecisionTriangleRoutine(false)
+VolumeCellTraversal::VolumeCellTraversal(GLManager *gl, VolumeRenderer *renderer) : VolumeRegular(gl, renderer), _useHighPrecisionTriangleRoutine(false), _hasAccelerationData(false), _coordChecksum(0)
 {
     _coordTexture.Generate(GL_NEAREST);
     _minTexture.Generate(GL_NEAREST);
@@ -162,16 +174,54 @@ int VolumeCellTraversal::LoadData(const Grid *grid)
         return -1;
     }
 
-    Progress::Start("Load coord data", nCoords);
-    auto coord = grid->ConstCoordBegin();
-    for (size_t i = 0; i < nCoords; ++i, ++coord) {
-        Progress::Update(i);
-        data[i * 3] = (*coord)[0];
-        data[i * 3 + 1] = (*coord)[1];
-        data[i * 3 + 2] = (*coord)[2];
+    // Gather the coordinates in parallel, a batch of z slices at a time,
+    // along with a checksum of each slice
+    //
+    const long       batch = std::max(8, omp_get_max_threads());
+    vector<uint64_t> sliceChecksums(d);
+
+    Progress::Start("Load coord data", d);
+    for (long z0 = 0; z0 < (long)d; z0 += batch) {
+        Progress::Update(z0);
+
+        const long z1 = std::min((long)d, z0 + batch);
+#pragma omp parallel for schedule(dynamic)
+        for (long z = z0; z < z1; z++) {
+            DimsType  index = {0, 0, (size_t)z};
+            CoordType coord;
+            float *   p = data + z * w * h * 3;
+            uint64_t  checksum = CHECKSUM_OFFSET;
+            for (index[1] = 0; index[1] < h; index[1]++) {
+                for (index[0] = 0; index[0] < w; index[0]++, p += 3) {
+                    grid->GetUserCoordinates(index, coord);
+                    for (int c = 0; c < 3; c++) {
+                        p[c] = coord[c];
+
+                        uint32_t bits;
+                        memcpy(&bits, &p[c], sizeof(bits));
+                        checksum = (checksum ^ bits) * CHECKSUM_PRIME;
+                    }
+                }
+            }
+            sliceChecksums[z] = checksum;
+        }
     }
     Progress::Finish();
 
+    // The bounding boxes and their mipmaps depend only on the coordinates.
+    // If these are the same as last time, e.g. only the time step of a
+    // grid with fixed coordinates changed, the textures are still current
+    //
+    uint64_t checksum = CHECKSUM_OFFSET;
+    for (int i = 0; i < 3; i++) checksum = (checksum ^ dims[i]) * CHECKSUM_PRIME;
+    for (auto c : sliceChecksums) checksum = (checksum ^ c) * CHECKSUM_PRIME;
+
+    if (_hasAccelerationData && checksum == _coordChecksum) {
+        delete[] data;
+        return 0;
+    }
+    _hasAccelerationData = false;
+
     _coordTexture.TexImage(GL_RGB32F, dims[0], dims[1], dims[2], GL_RGB, GL_FLOAT, data);
 
     // ---------------------------------------
@@ -266,6 +316,7 @@ int VolumeCellTraversal::LoadData(const Grid *grid)
             if (mUpW == 1) ix = 0;
             if (mUpH == 1) iy = 0;
 
+#pragma omp parallel for schedule(static) if (mW * mH >= MIN_PARALLEL_MIP_SIZE)
             for (int y = 0; y < mH; y++) {
                 for (int x = 0; x < mW; x++) {
                     vec3 v0 = minMip[level - 1][z * mUpS * mUpS + (y * 2) * mUpS + x * 2];
@@ -340,6 +391,9 @@ int VolumeCellTraversal::LoadData(const Grid *grid)
     delete[] data;
     delete[] boxMins;
     delete[] boxMaxs;
+
+    _hasAccelerationData = true;
+    _coordChecksum = checksum;
     return 0;
 }
 
@@ -1,56 +1,121 @@
 #include <vapor/VolumeResampled.h>
 #include <vector>
+#include <algorithm>
 #include <vapor/glutil.h>
 #include <glm/glm.hpp>
+#include <vapor/Progress.h>
+#include <vapor/OpenMPSupport.h>
 
 using std::vector;
 
 using namespace VAPoR;
 
-// static VolumeAlgorithmRegistrar<VolumeResampled> registration;
+static VolumeAlgorithmRegistrar<VolumeResampled> registration;
 
 int VolumeResampled::LoadData(const Grid *grid)
 {
-    VolumeRegular::LoadData(grid);
-#define S 1
-    const vector<size_t> dims = grid->GetDimensions();
-    const size_t         w = dims[0] * S, h = dims[1] * S, d = dims[2] * S;
-    float *              data = new float[w * h * d];
-
-    vector<double> min, max;
-    grid->GetUserExtents(min, max);
-
-    for (int z = 0; z < d; z++) {
-        printf("Resampling... %i/%li\n", z, d);
-        const float zSamplePos = (z + 0.5f) / (float)d * (max[2] - min[2]) + min[2];
-        for (int y = 0; y < h; y++) {
-            const float ySamplePos = (y + 0.5f) / (float)h * (max[1] - min[1]) + min[1];
-            for (int x = 0; x < w; x++) {
-                const float xSamplePos = (x + 0.5f) / (float)w * (max[0] - min[0]) + min[0];
-                data[z * w * h + y * w + x] = grid->GetValue(xSamplePos, ySamplePos, zSamplePos);
+    VolumeGLSL::LoadData(grid);
+    if (grid->GetNumDimensions() != 3) {
+        Wasp::MyBase::SetErrMsg("Variable has a volume of 0");
+        return -1;
+    }
+    auto tmp = grid->GetDimensions();
+    _dataDimensions = {tmp[0], tmp[1], tmp[2]};
+    _hasSecondData = false;
+    grid->GetUserExtents(_minExts, _maxExts);
+    return _loadDataResampled(grid, &_data, &_missing, &_hasMissingData);
+}
+
+// The color mapped variable is resampled at the same positions as the
+// primary variable, so that the two textures line up, even if its own
+// extents differ
+//
+int VolumeResampled::LoadSecondaryData(const Grid *grid)
+{
+    _hasSecondData = false;
+    auto tmp = grid->GetDimensions();
+    auto dims = std::vector<size_t>{tmp[0], tmp[1], tmp[2]};
+    if (_dataDimensions != dims) {
+        Wasp::MyBase::SetErrMsg("Secondary (color mapped) variable has different grid from primary variable");
+        return -1;
+    }
+    if (!_data2.Initialized()) _data2.Generate();
+    if (!_missing2.Initialized()) _missing2.Generate();
+    int ret = _loadDataResampled(grid, &_data2, &_missing2, &_hasMissingData2);
+    if (ret >= 0) _hasSecondData = true;
+    return ret;
+}
+
+int VolumeResampled::_loadDataResampled(const Grid *grid, Texture3D *dataTexture, Texture3D *missingTexture, bool *hasMissingData)
+{
+    auto         tmp = grid->GetDimensions();
+    const size_t w = tmp[0], h = tmp[1], d = tmp[2];
+    const size_t nVerts = w * h * d;
+    float *      data = new float[nVerts];
+
+    const vector<double> &min = _minExts, &max = _maxExts;
+
+    // Sample positions at the centers of the voxels of the texture
+    //
+    vector<float> samplePos[3];
+    for (int a = 0; a < 3; a++) {
+        samplePos[a].resize(tmp[a]);
+        for (size_t i = 0; i < tmp[a]; i++) samplePos[a][i] = (i + 0.5f) / (float)tmp[a] * (max[a] - min[a]) + min[a];
+    }
+
+    // Z slices are sampled in parallel, each with a single batched call
+    // writing straight into the texture data. Progress is reported, and
+    // cancellation checked, between batches of slices
+    //
+    const long batch = std::max(8, omp_get_max_threads());
+
+    Progress::Start("Resample volume data", d, true);
+    for (long z0 = 0; z0 < (long)d; z0 += batch) {
+        Progress::Update(z0);
+        if (Progress::Cancelled()) {
+            delete[] data;
+            return -1;
+        }
+
+        const long z1 = std::min((long)d, z0 + batch);
+#pragma omp parallel
+        {
+            vector<double> xyz(w * h * 3);
+
+#pragma omp for schedule(dynamic)
+            for (long z = z0; z < z1; z++) {
+                for (size_t y = 0; y < h; y++) {
+                    for (size_t x = 0; x < w; x++) {
+                        double *p = &xyz[(y * w + x) * 3];
+                        p[0] = samplePos[0][x];
+                        p[1] = samplePos[1][y];
+                        p[2] = samplePos[2][z];
+                    }
+                }
+                grid->GetValues(xyz.data(), w * h, data + z * w * h);
             }
         }
     }
+    Progress::Finish();
 
-    _data.TexImage(GL_R32F, w, h, d, GL_RED, GL_FLOAT, data);
+    int ret = dataTexture->TexImage(GL_R32F, w, h, d, GL_RED, GL_FLOAT, data);
 
-    _hasMissingData = grid->HasMissingData();
-    if (_hasMissingData) {
-        printf("Loading missing data...\n");
+    *hasMissingData = grid->HasMissingData();
+    if (ret == 0 && *hasMissingData) {
         const float    missingValue = grid->GetMissingValue();
-        unsigned char *missingMask = new unsigned char[w * h * d];
-        memset(missingMask, 0, w * h * d);
+        unsigned char *missingMask = new unsigned char[nVerts];
+        memset(missingMask, 0, nVerts);
 
-        for (size_t i = 0; i < w * h * d; i++)
+        for (size_t i = 0; i < nVerts; i++)
             if (data[i] == missingValue) missingMask[i] = 255;
 
         glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-        _missing.TexImage(GL_R8, dims[0], dims[1], dims[2], GL_RED, GL_UNSIGNED_BYTE, missingMask);
+        ret = missingTexture->TexImage(GL_R8, w, h, d, GL_RED, GL_UNSIGNED_BYTE, missingMask);
         glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 
         delete[] missingMask;
     }
 
     delete[] data;
-    return 0;
+    return ret;
 }
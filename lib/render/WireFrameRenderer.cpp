@@ -51,6 +51,7 @@ static RendererRegistrar<WireFrameRenderer> registrar(WireFrameRenderer::GetClas
 WireFrameRenderer::WireFrameRenderer(const ParamsMgr *pm, string winName, string dataSetName, string instName, DataMgr *dataMgr)
 : Renderer(pm, winName, dataSetName, WireFrameParams::GetClassType(), WireFrameRenderer::GetClassType(), instName, dataMgr), _VAO(0), _VBO(0), _EBO(0)
 {
+    _cacheParams.generation = 0;
 }
 
 WireFrameRenderer::~WireFrameRenderer()
@@ -70,11 +71,19 @@ void WireFrameRenderer::_saveCacheParams()
     _cacheParams.level = p->GetRefinementLevel();
     _cacheParams.lod = p->GetCompressionLevel();
     p->GetBox()->GetExtents(_cacheParams.boxMin, _cacheParams.boxMax);
+    _cacheParams.generation = 0;
 }
 
 bool WireFrameRenderer::_isCacheDirty() const
 {
     WireFrameParams *p = (WireFrameParams *)GetActiveParams();
+
+    // Nothing in the params has changed since the cache was last found
+    // to be clean
+    //
+    unsigned long generation = p->GetGeneration();
+    if (_cacheParams.generation == generation) return false;
+
     if (_cacheParams.varName != p->GetVariableName()) return true;
     if (_cacheParams.heightVarName != p->GetHeightVariableName()) return true;
     if (_cacheParams.ts != p->GetCurrentTimestep()) return true;
@@ -87,6 +96,7 @@ bool WireFrameRenderer::_isCacheDirty() const
     if (_cacheParams.boxMin != min) return true;
     if (_cacheParams.boxMax != max) return true;
 
+    _cacheParams.generation = generation;
     return false;
 }
 
@@ -338,7 +348,7 @@ int WireFrameRenderer::_paintGL(bool fast)
     if (rc != 0) return rc;
 
     if (Progress::Cancelled()) {
-        _cacheParams.varName = "";
+        _clearCache();
         return 0;
     }
 
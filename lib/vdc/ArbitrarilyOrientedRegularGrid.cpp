@@ -212,6 +212,14 @@ void ArbitrarilyOrientedRegularGrid::_populateData(
     float missingValue = grid->GetMissingValue();
     size_t index = 0;
 
+    // Gather the sample points that fall inside the box, then sample
+    // them all with one call to the source grid
+    //
+    std::vector<double> xyz;
+    std::vector<size_t> inside;
+    xyz.reserve(_sideSize * _sideSize * 3);
+    inside.reserve(_sideSize * _sideSize);
+
     for (size_t j = 0; j < _sideSize; j++) {
         for (size_t i = 0; i < _sideSize; i++) {
             VAPoR::CoordType p;
@@ -223,11 +231,18 @@ void ArbitrarilyOrientedRegularGrid::_populateData(
                 _myBlks[index] = missingValue;
             }
             else {
-                _myBlks[index] = grid->GetValue(p);
+                xyz.insert(xyz.end(), p.begin(), p.end());
+                inside.push_back(index);
             }
             index++;
         }
     }
+
+    std::vector<float> values(inside.size());
+    grid->GetValues(xyz.data(), inside.size(), values.data());
+    for (size_t k = 0; k < inside.size(); k++) {
+        _myBlks[inside[k]] = values[k];
+    }
 }
 
 // clang-format on
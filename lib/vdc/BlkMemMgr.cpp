@@ -7,31 +7,194 @@
 #ifndef WIN32
     #include <unistd.h>
 #endif
+#ifdef __linux__
+    #include <sys/mman.h>
+#endif
 
+#include "vapor/VAssert.h"
 #include <vapor/BlkMemMgr.h>
 
 using namespace Wasp;
 using namespace VAPoR;
 
+namespace {
+
+// Index of most significant set bit. n must be non-zero
+//
+inline int msb(uint64_t n)
+{
+    int r = 0;
+    while (n >>= 1) r++;
+    return (r);
+}
+
+// Index of least significant set bit. n must be non-zero
+//
+inline int lsb(uint64_t n)
+{
+    int r = 0;
+    while (!(n & 1)) {
+        n >>= 1;
+        r++;
+    }
+    return (r);
+}
+
+};    // namespace
+
 //
 //	Static member initialization
 //
 bool   BlkMemMgr::_page_aligned_req = true;
+bool   BlkMemMgr::_huge_pages_req = false;
 size_t BlkMemMgr::_mem_size_max_req = 32768;
 size_t BlkMemMgr::_blk_size_req = 32 * 32 * 32;
 
 bool   BlkMemMgr::_page_aligned = false;
+bool   BlkMemMgr::_huge_pages = false;
 size_t BlkMemMgr::_mem_size_max = 0;
 size_t BlkMemMgr::_blk_size = 0;
 
-vector<size_t>                               BlkMemMgr::_mem_region_sizes;
-vector<unsigned char *>                      BlkMemMgr::_blks;
-vector<vector<BlkMemMgr::_mem_allocation_t>> BlkMemMgr::_mem_regions;
-#ifdef VAPOR3_0_0_ALPHA
-#endif
+vector<BlkMemMgr::_arena_t *> BlkMemMgr::_arenas;
+BlkMemMgr::_run_ref_t         BlkMemMgr::_freeLists[BlkMemMgr::_FL_COUNT][BlkMemMgr::_SL_COUNT];
+uint64_t                      BlkMemMgr::_flBitmap = 0;
+uint32_t                      BlkMemMgr::_slBitmap[BlkMemMgr::_FL_COUNT];
+
+size_t BlkMemMgr::_num_free_runs = 0;
+size_t BlkMemMgr::_free_blks = 0;
+size_t BlkMemMgr::_num_allocs = 0;
+
+std::mutex BlkMemMgr::_mutex;
 
 int BlkMemMgr::_ref_count = 0;
 
+//
+// Map a run length to the size class it is filed under
+//
+void BlkMemMgr::_MappingInsert(size_t n, int &fl, int &sl)
+{
+    VAssert(n > 0);
+
+    if (n < _SL_COUNT) {
+        fl = 0;
+        sl = (int)n;
+    } else {
+        int f = msb(n);
+        sl = (int)((n >> (f - _SL_BITS)) - _SL_COUNT);
+        fl = f - _SL_BITS + 1;
+    }
+    VAssert(fl < _FL_COUNT);
+}
+
+//
+// Map a request to the smallest size class whose runs are all large
+// enough to satisfy it
+//
+void BlkMemMgr::_MappingSearch(size_t n, int &fl, int &sl)
+{
+    if (n >= _SL_COUNT) n += ((size_t)1 << (msb(n) - _SL_BITS)) - 1;
+    _MappingInsert(n, fl, sl);
+}
+
+//
+// Find the first non-empty size class at or above (fl, sl)
+//
+bool BlkMemMgr::_FindSuitable(int &fl, int &sl)
+{
+    uint32_t sl_map = sl < _SL_COUNT ? _slBitmap[fl] & (~0u << sl) : 0;
+    if (!sl_map) {
+        uint64_t fl_map = fl + 1 < _FL_COUNT ? _flBitmap & (~(uint64_t)0 << (fl + 1)) : 0;
+        if (!fl_map) return (false);
+
+        fl = lsb(fl_map);
+        sl_map = _slBitmap[fl];
+    }
+    VAssert(sl_map);
+    sl = lsb(sl_map);
+    return (true);
+}
+
+void BlkMemMgr::_SetRun(_arena_t *a, size_t blk, size_t len, uint8_t state)
+{
+    a->_runLen[blk] = len;
+    a->_runState[blk] = state;
+    a->_runStart[blk + len - 1] = blk;
+}
+
+void BlkMemMgr::_InsertFree(int arena, size_t blk, size_t len)
+{
+    _arena_t *a = _arenas[arena];
+    _SetRun(a, blk, len, _RUN_FREE);
+
+    int fl, sl;
+    _MappingInsert(len, fl, sl);
+
+    _run_ref_t head = _freeLists[fl][sl];
+    a->_next[blk] = head;
+    a->_prev[blk] = {-1, 0};
+    if (head.arena >= 0) _arenas[head.arena]->_prev[head.blk] = {arena, blk};
+    _freeLists[fl][sl] = {arena, blk};
+
+    _flBitmap |= (uint64_t)1 << fl;
+    _slBitmap[fl] |= 1u << sl;
+
+    _num_free_runs++;
+    _free_blks += len;
+}
+
+void BlkMemMgr::_RemoveFree(int arena, size_t blk)
+{
+    _arena_t *a = _arenas[arena];
+    VAssert(a->_runState[blk] == _RUN_FREE);
+
+    size_t len = a->_runLen[blk];
+    int    fl, sl;
+    _MappingInsert(len, fl, sl);
+
+    _run_ref_t next = a->_next[blk];
+    _run_ref_t prev = a->_prev[blk];
+    if (next.arena >= 0) _arenas[next.arena]->_prev[next.blk] = prev;
+    if (prev.arena >= 0) {
+        _arenas[prev.arena]->_next[prev.blk] = next;
+    } else {
+        _freeLists[fl][sl] = next;
+        if (next.arena < 0) {
+            _slBitmap[fl] &= ~(1u << sl);
+            if (!_slBitmap[fl]) _flBitmap &= ~((uint64_t)1 << fl);
+        }
+    }
+
+    a->_runState[blk] = _RUN_NONE;
+    _num_free_runs--;
+    _free_blks -= len;
+}
+
+void BlkMemMgr::_FreeArenas()
+{
+    for (int i = 0; i < _arenas.size(); i++) {
+        _arena_t *a = _arenas[i];
+#ifdef __linux__
+        if (a->_huge) {
+            munmap(a->_mem, a->_size);
+        } else
+#endif
+        {
+            delete[] a->_mem;
+        }
+        delete a;
+    }
+    _arenas.clear();
+
+    for (int fl = 0; fl < _FL_COUNT; fl++) {
+        _slBitmap[fl] = 0;
+        for (int sl = 0; sl < _SL_COUNT; sl++) _freeLists[fl][sl] = {-1, 0};
+    }
+    _flBitmap = 0;
+    _num_free_runs = 0;
+    _free_blks = 0;
+    _num_allocs = 0;
+}
+
 int BlkMemMgr::_Reinit(size_t n)
 {
     long   page_size = 0;
@@ -40,6 +203,7 @@ int BlkMemMgr::_Reinit(size_t n)
     if (_mem_size_max_req == 0 || _blk_size_req == 0) return (false);
 
     _page_aligned = _page_aligned_req;
+    _huge_pages = _huge_pages_req;
     _mem_size_max = _mem_size_max_req;
     _blk_size = _blk_size_req;
 
@@ -53,12 +217,12 @@ int BlkMemMgr::_Reinit(size_t n)
     //
     size_t total_size = 0;
     int    r;
-    for (r = 0; r < _mem_regions.size(); r++) total_size += _mem_region_sizes[r];
+    for (r = 0; r < _arenas.size(); r++) total_size += _arenas[r]->_nblks;
 
     //
     // New region size is double preceding one
     //
-    if (r > 0) mem_size = _mem_region_sizes[r - 1] << 1;
+    if (r > 0) mem_size = _arenas[r - 1]->_nblks << 1;
 
     // Make sure region size will be large enough, and not too large
     //
@@ -76,9 +240,25 @@ int BlkMemMgr::_Reinit(size_t n)
 #endif
     }
 
-    unsigned char *blks;
+    unsigned char *blks = NULL;
+    bool           huge = false;
     do {
         size = (size_t)_blk_size * (size_t)mem_size;
+
+#ifdef __linux__
+        if (_huge_pages) {
+            void *p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p != MAP_FAILED) {
+    #ifdef MADV_HUGEPAGE
+                (void)madvise(p, size, MADV_HUGEPAGE);
+    #endif
+                blks = (unsigned char *)p;
+                huge = true;
+                break;
+            }
+        }
+#endif
+
         size += (size_t)page_size;
 
         blks = new (nothrow) unsigned char[size];
@@ -86,9 +266,9 @@ int BlkMemMgr::_Reinit(size_t n)
             SetDiagMsg("BlkMemMgr::_Reinit() : failed to allocate %d blocks, retrying", mem_size);
             mem_size = mem_size >> 1;
         }
-    } while (blks == NULL && mem_size > 0 && _blk_size > 0);
+    } while (blks == NULL && mem_size >= n && _blk_size > 0);
 
-    if (!blks && mem_size > 0 && _blk_size > 0) {
+    if (!blks) {
         SetDiagMsg("Memory allocation of %lu bytes failed", size);
         return (false);
     } else {
@@ -97,25 +277,31 @@ int BlkMemMgr::_Reinit(size_t n)
 
     unsigned char *blkptr = blks;
 
-    if (page_size) { blkptr += page_size - (((size_t)blks) % page_size); }
-
-    _mem_allocation_t         m;
-    vector<_mem_allocation_t> mem_region;
-    m._nfree = mem_size;
-    m._nused = 0;
-    m._blk = blkptr;
-    mem_region.push_back(m);
-
-    _mem_regions.push_back(mem_region);
-    _blks.push_back(blks);
-    _mem_region_sizes.push_back(mem_size);
+    // mmap()'d memory is always page aligned
+    //
+    if (page_size && !huge) { blkptr += page_size - (((size_t)blks) % page_size); }
+
+    _arena_t *a = new _arena_t;
+    a->_mem = blks;
+    a->_blk = blkptr;
+    a->_size = size;
+    a->_nblks = mem_size;
+    a->_huge = huge;
+    a->_runLen.resize(mem_size, 0);
+    a->_runStart.resize(mem_size, 0);
+    a->_runState.resize(mem_size, _RUN_NONE);
+    a->_next.resize(mem_size, {-1, 0});
+    a->_prev.resize(mem_size, {-1, 0});
+
+    _arenas.push_back(a);
+    _InsertFree(_arenas.size() - 1, 0, mem_size);
 
     return (true);
 }
 
-int BlkMemMgr::RequestMemSize(size_t blk_size, size_t num_blks, bool page_aligned)
+int BlkMemMgr::RequestMemSize(size_t blk_size, size_t num_blks, bool page_aligned, bool huge_pages)
 {
-    SetDiagMsg("BlkMemMgr::RequestMemSize(%u,%u,%d)", blk_size, num_blks, page_aligned);
+    SetDiagMsg("BlkMemMgr::RequestMemSize(%u,%u,%d,%d)", blk_size, num_blks, page_aligned, huge_pages);
 
     //
     // If there are no instances of this object, re-initialized
@@ -126,9 +312,12 @@ int BlkMemMgr::RequestMemSize(size_t blk_size, size_t num_blks, bool page_aligne
         return (-1);
     }
 
+    std::lock_guard<std::mutex> lock(_mutex);
+
     _blk_size_req = blk_size;
     _mem_size_max_req = num_blks;
     _page_aligned_req = page_aligned;
+    _huge_pages_req = huge_pages;
 
     return (0);
 }
@@ -137,6 +326,8 @@ BlkMemMgr::BlkMemMgr()
 {
     SetDiagMsg("BlkMemMgr::BlkMemMgr()");
 
+    std::lock_guard<std::mutex> lock(_mutex);
+
     //
     // If there are no other instances of this object, re-initialized
     // the static memory pool if needed
@@ -146,14 +337,10 @@ BlkMemMgr::BlkMemMgr()
         return;
     }
 
-    for (int i = 0; i < _blks.size(); i++) {
-        if (_blks[i]) delete[] _blks[i];
-    }
-    _mem_regions.clear();
-    _mem_region_sizes.clear();
-    _blks.clear();
+    _FreeArenas();
 
     _page_aligned = _page_aligned_req;
+    _huge_pages = _huge_pages_req;
     _mem_size_max = _mem_size_max_req;
     _blk_size = _blk_size_req;
 
@@ -164,62 +351,71 @@ BlkMemMgr::~BlkMemMgr()
 {
     SetDiagMsg("BlkMemMgr::~BlkMemMgr()");
 
+    std::lock_guard<std::mutex> lock(_mutex);
+
     if (_ref_count > 0) _ref_count--;
 
     if (_ref_count != 0) return;
 
-    for (int i = 0; i < _blks.size(); i++) {
-        if (_blks[i]) delete[] _blks[i];
-    }
-    _blks.clear();
-    _mem_regions.clear();
-    _mem_region_sizes.clear();
+    _FreeArenas();
 }
 
 void *BlkMemMgr::Alloc(size_t n, bool fill)
 {
     SetDiagMsg("BlkMemMgr::Alloc(%d)", n);
 
+    if (n == 0) return (NULL);
+
+    std::unique_lock<std::mutex> lock(_mutex);
+
     //
-    // Check each region, find the first run of blocks large enough
-    // to satisfy the request
+    // Find a free run in the smallest size class guaranteed to
+    // satisfy the request. Failing that, search the request's own
+    // size class.
     //
-    void *blk = NULL;
-    for (int r = 0; r < _mem_regions.size() && !blk; r++) {
-        vector<_mem_allocation_t> &mem_region = _mem_regions[r];
-        for (int i = 0; i < mem_region.size() && !blk; i++) {
-            if (n <= mem_region[i]._nfree) {    // Found a run of blocks
-                blk = mem_region[i]._blk;
-                mem_region[i]._nused = n;
-
-                //
-                // If run is strictly larger than request split it
-                //
-                if (n < mem_region[i]._nfree) {
-                    _mem_allocation_t m;
-                    m._nfree = mem_region[i]._nfree - n;
-                    m._nused = 0;
-                    m._blk = (unsigned char *)mem_region[i]._blk + (_blk_size * n);
-                    mem_region.insert(mem_region.begin() + i + 1, m);
-                }
-                mem_region[i]._nfree = 0;
-            }
-        }
+    int        fl, sl;
+    _run_ref_t run = {-1, 0};
+    _MappingSearch(n, fl, sl);
+    if (fl < _FL_COUNT && _FindSuitable(fl, sl)) {
+        run = _freeLists[fl][sl];
+    } else {
+        // Runs in the request's own size class may still be large
+        // enough, although not all of them are
+        //
+        _MappingInsert(n, fl, sl);
+        run = _freeLists[fl][sl];
+        while (run.arena >= 0 && _arenas[run.arena]->_runLen[run.blk] < n) run = _arenas[run.arena]->_next[run.blk];
     }
 
-    if (!blk) {
+    if (run.arena < 0) {
         // Couldn't find space in existing memory pool.
         // Try to allocate more memory.
         //
         if (!BlkMemMgr::_Reinit(n)) return (NULL);
 
+        lock.unlock();
         return (Alloc(n, fill));
     }
 
-    if (fill) {
-        unsigned char *ptr = (unsigned char *)blk;
-        for (size_t i = 0; i < n * _blk_size; i++) ptr[i] = 0;
-    }
+    _arena_t * a = _arenas[run.arena];
+    size_t     len = a->_runLen[run.blk];
+    VAssert(len >= n);
+
+    _RemoveFree(run.arena, run.blk);
+
+    //
+    // If run is strictly larger than request split it
+    //
+    if (n < len) _InsertFree(run.arena, run.blk + n, len - n);
+
+    _SetRun(a, run.blk, n, _RUN_USED);
+    _num_allocs++;
+
+    void *blk = a->_blk + (_blk_size * run.blk);
+
+    lock.unlock();
+
+    if (fill) memset(blk, 0, n * _blk_size);
 
     return (blk);
 }
@@ -228,35 +424,75 @@ void BlkMemMgr::FreeMem(void *ptr)
 {
     SetDiagMsg("BlkMemMgr::FreeMem()");
 
-    bool found = false;
-    for (int r = 0; r < _mem_regions.size() && !found; r++) {
-        vector<_mem_allocation_t> &mem_region = _mem_regions[r];
-        for (int i = 0; i < mem_region.size() && !found; i++) {
-            if (ptr == mem_region[i]._blk) {
-                found = true;
-                mem_region[i]._nfree = mem_region[i]._nused;
-                mem_region[i]._nused = 0;
-            }
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    //
+    // Find the arena containing ptr. There are only a handful of arenas
+    // since each one is at least double the size of its predecessor.
+    //
+    int    arena = -1;
+    size_t blk = 0;
+    for (int r = 0; r < _arenas.size(); r++) {
+        const _arena_t *a = _arenas[r];
+        unsigned char * p = (unsigned char *)ptr;
+        if (p >= a->_blk && p < a->_blk + a->_nblks * _blk_size && ((p - a->_blk) % _blk_size) == 0) {
+            arena = r;
+            blk = (p - a->_blk) / _blk_size;
+            break;
         }
     }
-    if (!found) cerr << "Failed to free block " << ptr << endl;
+
+    if (arena < 0 || _arenas[arena]->_runState[blk] != _RUN_USED) {
+        cerr << "Failed to free block " << ptr << endl;
+        return;
+    }
+
+    _arena_t *a = _arenas[arena];
+    size_t    len = a->_runLen[blk];
+    a->_runState[blk] = _RUN_NONE;
+    _num_allocs--;
 
     //
-    // Collapse any two adjacent runs of they're both free
+    // Coalesce with right and left neighbors if they're free
     //
-    bool collapse;
-    do {
-        collapse = false;
-        for (int r = 0; r < _mem_regions.size(); r++) {
-            vector<_mem_allocation_t> &mem_region = _mem_regions[r];
-            for (int i = 0; i < mem_region.size() - 1; i++) {
-                if (mem_region[i]._nfree && mem_region[i + 1]._nfree) {
-                    mem_region[i]._nfree += mem_region[i + 1]._nfree;
-                    mem_region.erase(mem_region.begin() + i + 1);
-                    collapse = true;
-                    break;
-                }
-            }
+    size_t right = blk + len;
+    if (right < a->_nblks && a->_runState[right] == _RUN_FREE) {
+        len += a->_runLen[right];
+        _RemoveFree(arena, right);
+    }
+
+    if (blk > 0) {
+        size_t left = a->_runStart[blk - 1];
+        if (a->_runState[left] == _RUN_FREE) {
+            len += a->_runLen[left];
+            _RemoveFree(arena, left);
+            blk = left;
+        }
+    }
+
+    _InsertFree(arena, blk, len);
+}
+
+BlkMemMgr::Stats BlkMemMgr::GetStats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    Stats stats;
+    for (int r = 0; r < _arenas.size(); r++) stats.total_blks += _arenas[r]->_nblks;
+    stats.free_blks = _free_blks;
+    stats.num_free_runs = _num_free_runs;
+    stats.num_allocs = _num_allocs;
+
+    // The largest run is in the highest non-empty size class
+    //
+    if (_flBitmap) {
+        int fl = msb(_flBitmap);
+        int sl = msb(_slBitmap[fl]);
+        for (_run_ref_t r = _freeLists[fl][sl]; r.arena >= 0; r = _arenas[r.arena]->_next[r.blk]) {
+            size_t len = _arenas[r.arena]->_runLen[r.blk];
+            if (len > stats.largest_free_run) stats.largest_free_run = len;
         }
-    } while (collapse);
+    }
+
+    return (stats);
 }
@@ -0,0 +1,285 @@
+#include <algorithm>
+#include <limits>
+#include <vapor/VAssert.h>
+#include <vapor/CellBVH.h>
+#include <vapor/OpenMPSupport.h>
+
+using namespace VAPoR;
+using namespace std;
+
+namespace {
+
+// Marks the slots of the node array that are not used by the tree
+//
+const uint32_t unusedSlot = std::numeric_limits<uint32_t>::max();
+
+// Don't split the hierarchy across threads below this many cells
+//
+const size_t minTaskSize = 1024;
+
+// Spread the lower 10 bits of v so that there are two zero bits between
+// each of them
+//
+uint32_t expandBits(uint32_t v)
+{
+    v = (v * 0x00010001u) & 0xFF0000FFu;
+    v = (v * 0x00000101u) & 0x0F00F00Fu;
+    v = (v * 0x00000011u) & 0xC30C30C3u;
+    v = (v * 0x00000005u) & 0x49249249u;
+    return (v);
+}
+
+// 30-bit Morton code for a point in the unit cube
+//
+uint32_t morton3D(float x, float y, float z)
+{
+    uint32_t xx = (uint32_t)std::min(std::max(x * 1024.0f, 0.0f), 1023.0f);
+    uint32_t yy = (uint32_t)std::min(std::max(y * 1024.0f, 0.0f), 1023.0f);
+    uint32_t zz = (uint32_t)std::min(std::max(z * 1024.0f, 0.0f), 1023.0f);
+    return ((expandBits(xx) << 2) | (expandBits(yy) << 1) | expandBits(zz));
+}
+
+// Sort chunks of keys in parallel, then merge pairs of sorted runs until
+// there is only one
+//
+void sortKeys(vector<uint64_t> &keys)
+{
+    int nchunks = omp_get_max_threads();
+    if (nchunks < 2 || keys.size() < minTaskSize * nchunks) {
+        std::sort(keys.begin(), keys.end());
+        return;
+    }
+
+    vector<size_t> bounds;
+    for (int i = 0; i <= nchunks; i++) bounds.push_back(keys.size() * i / nchunks);
+
+#pragma omp parallel for
+    for (int i = 0; i < nchunks; i++) { std::sort(keys.begin() + bounds[i], keys.begin() + bounds[i + 1]); }
+
+    vector<uint64_t> tmp(keys.size());
+    for (int width = 1; width < nchunks; width *= 2) {
+#pragma omp parallel for
+        for (int i = 0; i < nchunks; i += 2 * width) {
+            size_t lo = bounds[i];
+            size_t mid = bounds[std::min(i + width, nchunks)];
+            size_t hi = bounds[std::min(i + 2 * width, nchunks)];
+            std::merge(keys.begin() + lo, keys.begin() + mid, keys.begin() + mid, keys.begin() + hi, tmp.begin() + lo);
+        }
+        keys.swap(tmp);
+    }
+}
+
+// Return the index at which the sorted codes in [first, last) are split
+// between two children. The split is at the highest bit at which the
+// first and last codes differ: all codes in the range share the bits
+// above it, and the right child starts with the first code that has the
+// bit set. If all of the codes are identical the range is split in half.
+//
+size_t findSplit(const vector<uint32_t> &codes, size_t first, size_t last)
+{
+    uint32_t a = codes[first];
+    uint32_t b = codes[last - 1];
+    if (a == b) return ((first + last) / 2);
+
+    uint32_t x = a ^ b;
+    uint32_t bit = 1u << 31;
+    while (!(x & bit)) bit >>= 1;
+
+    uint32_t threshold = b & ~(bit - 1);
+    return (std::lower_bound(codes.begin() + first, codes.begin() + last, threshold) - codes.begin());
+}
+
+};    // namespace
+
+void CellBVH::Build(const float *boxes, size_t ncells)
+{
+    _nodes.clear();
+    _cells.clear();
+
+    VAssert(ncells < unusedSlot / 2);
+
+    // Bounds of the cell centers. Empty cells are left out of the tree
+    //
+    float cmin[] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+    float cmax[] = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+
+    vector<uint32_t> cells;
+    cells.reserve(ncells);
+    for (size_t c = 0; c < ncells; c++) {
+        const float *b = boxes + 6 * c;
+        if (b[0] > b[3] || b[1] > b[4] || b[2] > b[5]) continue;
+
+        cells.push_back((uint32_t)c);
+        for (int d = 0; d < 3; d++) {
+            float center = 0.5f * (b[d] + b[d + 3]);
+            cmin[d] = std::min(cmin[d], center);
+            cmax[d] = std::max(cmax[d], center);
+        }
+    }
+
+    size_t n = cells.size();
+    if (n == 0) return;
+
+    float scale[3];
+    for (int d = 0; d < 3; d++) scale[d] = cmax[d] > cmin[d] ? 1.0f / (cmax[d] - cmin[d]) : 0.0f;
+
+    // Sort the cells along a Morton curve through their centers. The
+    // Morton code goes in the upper half of the sort key, the cell index
+    // in the lower half
+    //
+    vector<uint64_t> keys(n);
+#pragma omp parallel for
+    for (long i = 0; i < (long)n; i++) {
+        const float *b = boxes + 6 * (size_t)cells[i];
+        float        x = (0.5f * (b[0] + b[3]) - cmin[0]) * scale[0];
+        float        y = (0.5f * (b[1] + b[4]) - cmin[1]) * scale[1];
+        float        z = (0.5f * (b[2] + b[5]) - cmin[2]) * scale[2];
+        keys[i] = ((uint64_t)morton3D(x, y, z) << 32) | cells[i];
+    }
+
+    sortKeys(keys);
+
+    vector<uint32_t> codes(n);
+    _cells.resize(n);
+#pragma omp parallel for
+    for (long i = 0; i < (long)n; i++) {
+        codes[i] = (uint32_t)(keys[i] >> 32);
+        _cells[i] = (uint32_t)(keys[i] & 0xFFFFFFFFu);
+    }
+    keys.clear();
+
+    // The subtree over the sorted cells [first, last) is placed in node
+    // slots [slot, slot + 2 * (last - first) - 1). That is enough room for
+    // the largest possible subtree over those cells, and means the
+    // position of every subtree is known before it is built, so that
+    // subtrees can be built independently. Slots not used by the tree
+    // are squeezed out afterwards.
+    //
+    node_t unused;
+    unused.count = unusedSlot;
+    vector<node_t> nodes(2 * n - 1, unused);
+
+    // Split the upper levels of the tree serially, until there are
+    // enough independent subtrees to keep all of the threads busy
+    //
+    struct range_t {
+        size_t first;
+        size_t last;
+        size_t slot;
+    };
+    vector<range_t> tasks(1, range_t{0, n, 0});
+    vector<range_t> top;
+    size_t          ntasks = 4 * omp_get_max_threads();
+    while (tasks.size() < ntasks) {
+        auto itr = std::max_element(tasks.begin(), tasks.end(), [](const range_t &a, const range_t &b) { return (a.last - a.first < b.last - b.first); });
+        if (itr->last - itr->first < minTaskSize) break;
+
+        range_t r = *itr;
+        tasks.erase(itr);
+
+        size_t split = findSplit(codes, r.first, r.last);
+        size_t right = r.slot + 2 * (split - r.first);
+        nodes[r.slot].first = (uint32_t)right;
+        nodes[r.slot].count = 0;
+        top.push_back(r);
+
+        tasks.push_back(range_t{r.first, split, r.slot + 1});
+        tasks.push_back(range_t{split, r.last, right});
+    }
+
+#pragma omp parallel for schedule(dynamic, 1)
+    for (long t = 0; t < (long)tasks.size(); t++) { _build(boxes, codes, tasks[t].first, tasks[t].last, tasks[t].slot, nodes); }
+
+    // Bounding boxes of the upper levels. Children were split off after
+    // their parents, so walking backwards visits children first
+    //
+    for (auto itr = top.rbegin(); itr != top.rend(); ++itr) {
+        node_t &      node = nodes[itr->slot];
+        const node_t &left = nodes[itr->slot + 1];
+        const node_t &right = nodes[node.first];
+        for (int d = 0; d < 3; d++) {
+            node.min[d] = std::min(left.min[d], right.min[d]);
+            node.max[d] = std::max(left.max[d], right.max[d]);
+        }
+    }
+
+    // Squeeze out the unused slots. Slot order is depth-first order, so it
+    // is preserved
+    //
+    vector<uint32_t> index(nodes.size());
+    uint32_t         m = 0;
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if (nodes[i].count != unusedSlot) index[i] = m++;
+    }
+
+    _nodes.resize(m);
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if (nodes[i].count == unusedSlot) continue;
+
+        node_t node = nodes[i];
+        if (node.count == 0) node.first = index[node.first];
+        _nodes[index[i]] = node;
+    }
+}
+
+void CellBVH::_build(const float *boxes, const vector<uint32_t> &codes, size_t first, size_t last, size_t slot, vector<node_t> &nodes) const
+{
+    node_t &node = nodes[slot];
+
+    if (last - first <= _maxLeafSize) {
+        _leaf(boxes, first, last, node);
+        return;
+    }
+
+    size_t split = findSplit(codes, first, last);
+    size_t right = slot + 2 * (split - first);
+
+    _build(boxes, codes, first, split, slot + 1, nodes);
+    _build(boxes, codes, split, last, right, nodes);
+
+    node.first = (uint32_t)right;
+    node.count = 0;
+    for (int d = 0; d < 3; d++) {
+        node.min[d] = std::min(nodes[slot + 1].min[d], nodes[right].min[d]);
+        node.max[d] = std::max(nodes[slot + 1].max[d], nodes[right].max[d]);
+    }
+}
+
+void CellBVH::_leaf(const float *boxes, size_t first, size_t last, node_t &node) const
+{
+    node.first = (uint32_t)first;
+    node.count = (uint32_t)(last - first);
+
+    for (int d = 0; d < 3; d++) {
+        node.min[d] = std::numeric_limits<float>::max();
+        node.max[d] = std::numeric_limits<float>::lowest();
+    }
+
+    for (size_t k = first; k < last; k++) {
+        const float *b = boxes + 6 * (size_t)_cells[k];
+        for (int d = 0; d < 3; d++) {
+            node.min[d] = std::min(node.min[d], b[d]);
+            node.max[d] = std::max(node.max[d], b[d + 3]);
+        }
+    }
+}
+
+int CellBVH::GetDepth() const
+{
+    if (_nodes.empty()) return (0);
+
+    int                              depth = 0;
+    vector<std::pair<uint32_t, int>> stack(1, std::make_pair(0u, 1));
+    while (!stack.empty()) {
+        uint32_t i = stack.back().first;
+        int      d = stack.back().second;
+        stack.pop_back();
+
+        depth = std::max(depth, d);
+        if (_nodes[i].count == 0) {
+            stack.push_back(std::make_pair(i + 1, d + 1));
+            stack.push_back(std::make_pair(_nodes[i].first, d + 1));
+        }
+    }
+    return (depth);
+}
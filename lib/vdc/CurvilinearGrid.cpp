@@ -8,6 +8,7 @@
 #include <vapor/CurvilinearGrid.h>
 #include <vapor/QuadTreeRectangleP.h>
 #include <vapor/vizutil.h>
+#include <vapor/OpenMPSupport.h>
 
 using namespace std;
 using namespace VAPoR;
@@ -408,6 +409,11 @@ float CurvilinearGrid::GetValueNearestNeighbor(const CoordType &coords) const
 
     if (!inside) return (GetMissingValue());
 
+    return (_getValueNearestNeighbor(i, j, k, lambda, zwgt));
+}
+
+float CurvilinearGrid::_getValueNearestNeighbor(size_t i, size_t j, size_t k, const double lambda[4], const double zwgt[2]) const
+{
     // Find closest point within face
     //
     double maxl = lambda[0];
@@ -495,9 +501,14 @@ float CurvilinearGrid::GetValueLinear(const CoordType &coords) const
     double z = GetGeometryDim() == 3 ? cCoords[2] : 0.0;
     bool   inside = _insideGrid(x, y, z, i, j, k, lambda, zwgt);
 
-    float mv = GetMissingValue();
+    if (!inside) return (GetMissingValue());
 
-    if (!inside) return (mv);
+    return (_getValueLinear(i, j, k, lambda, zwgt));
+}
+
+float CurvilinearGrid::_getValueLinear(size_t i, size_t j, size_t k, const double lambda[4], const double zwgt[2]) const
+{
+    float mv = GetMissingValue();
 
     // Use Wachspress coordinates as weights to do linear interpolation
     // along XY plane
@@ -611,22 +622,49 @@ bool CurvilinearGrid::_insideGridHelperTerrain(double x, double y, double z, con
 
     float z0, z1;
 
-    // Find k index of cell containing z. Already know i and j indices
+    // Find k index of cell containing z. Already know i and j indices.
+    // Only the Z coordinates of the levels probed by the search are
+    // interpolated across the triangle
     //
-    size_t         nz = GetDimensions()[2];
-    vector<double> zcoords(nz);
-    for (int kk = 0; kk < nz; kk++) {
-        // Interpolate Z coordinate across triangle
-        //
+    size_t nz = GetDimensions()[2];
+    auto   zAt = [&](size_t kk) -> double {
         float zk = _zrg.AccessIJK(iv[0], jv[0], kk) * lambda[0] + _zrg.AccessIJK(iv[1], jv[1], kk) * lambda[1] + _zrg.AccessIJK(iv[2], jv[2], kk) * lambda[2];
+        return (zk);
+    };
 
-        zcoords[kk] = zk;
-    }
+    if (nz < 2 || zAt(0) > zAt(nz - 1)) {
+        vector<double> zcoords(nz);
+        for (int kk = 0; kk < nz; kk++) zcoords[kk] = zAt(kk);
+
+        if (!Wasp::BinarySearchRange(zcoords, z, k)) return (false);
 
-    if (!Wasp::BinarySearchRange(zcoords, z, k)) return (false);
+        z0 = zcoords[k];
+        z1 = k < nz - 1 ? zcoords[k + 1] : z0;
+    } else {
+        // Same as Wasp::BinarySearchRange() for increasing Z
+        //
+        if (z < zAt(0)) return (false);
+        if (z == zAt(nz - 1)) {
+            k = nz - 2;
+        } else {
+            size_t first = 0;
+            size_t len = nz;
+            while (len > 0) {
+                size_t half = len >> 1;
+                if (z < zAt(first + half)) {
+                    len = half;
+                } else {
+                    first += half + 1;
+                    len -= half + 1;
+                }
+            }
+            if (first == nz) return (false);
+            k = first - 1;
+        }
 
-    z0 = zcoords[k];
-    z1 = k < nz - 1 ? zcoords[k + 1] : z0;
+        z0 = zAt(k);
+        z1 = zAt(k + 1);
+    }
 
     zwgt[0] = 1.0 - (z - z0) / (z1 - z0);
     zwgt[1] = 1.0 - zwgt[0];
@@ -679,27 +717,69 @@ bool CurvilinearGrid::_insideGrid(double x, double y, double z, size_t &i, size_
     for (int l = 0; l < 2; l++) zwgt[l] = 0.0;
     i = j = k = 0;
 
+    double           pt[] = {x, y};
+    vector<DimsType> nodes(8);
+    if (!_findFace(pt, i, j, lambda, nodes)) return (false);
+
+    return (_insideColumn(x, y, z, i, j, k, zwgt));
+}
+
+// Search the grid for the XY face containing a point. If found, set i and
+// j to the indices of the face, and provide the Wachspress weights for the
+// point
+//
+bool CurvilinearGrid::_findFace(double pt[2], size_t &i, size_t &j, double lambda[4], vector<DimsType> &nodes) const
+{
     // Find the indices for the faces that might contain the point
     //
     vector<DimsType> face_indices;
-    _qtr->GetPayloadContained(x, y, face_indices);
+    _qtr->GetPayloadContained(pt[0], pt[1], face_indices);
 
-    bool             inside = false;
-    double           pt[] = {x, y};
-    vector<DimsType> nodes(8);
     for (int ii = 0; ii < face_indices.size(); ii++) {
         if (_insideFace(face_indices[ii], pt, lambda, nodes)) {
             i = face_indices[ii][0];
             j = face_indices[ii][1];
-
-            inside = true;
-            break;
+            return (true);
         }
     }
+    return (false);
+}
 
-    if (!inside) return (false);
+// Search for a point inside the face (i, j), or one of the faces
+// surrounding it. If the point is strictly inside one of them, set i and j
+// to the indices of that face, provide the Wachspress weights for the
+// point, and return true. Since faces don't overlap, no other face
+// contains the point, so this is the face that _insideGrid() would find.
+// Points on or near the edges of the faces are left to _insideGrid()
+//
+bool CurvilinearGrid::_insideNearbyFace(double pt[2], size_t &i, size_t &j, double lambda[4], vector<DimsType> &nodes) const
+{
+    const DimsType &cdims = GetCellDimensions();
+
+    static const int offsets[][2] = {{0, 0}, {1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {-1, 1}, {1, -1}, {-1, -1}};
+    for (const auto &o : offsets) {
+        long ii = (long)i + o[0];
+        long jj = (long)j + o[1];
+        if (ii < 0 || jj < 0 || ii >= (long)cdims[0] || jj >= (long)cdims[1]) continue;
 
+        DimsType face = {(size_t)ii, (size_t)jj, 0};
+        if (!_insideFace(face, pt, lambda, nodes)) continue;
+        if (!(lambda[0] > 0.0 && lambda[1] > 0.0 && lambda[2] > 0.0 && lambda[3] > 0.0)) return (false);
+
+        i = face[0];
+        j = face[1];
+        return (true);
+    }
+    return (false);
+}
+
+// Find the index and the interpolation weights along Z of a point in the
+// column of cells above the XY face (i, j)
+//
+bool CurvilinearGrid::_insideColumn(double x, double y, double z, size_t i, size_t j, size_t &k, double zwgt[2]) const
+{
     if (GetGeometryDim() == 2) {
+        k = 0;
         zwgt[0] = 1.0;
         zwgt[1] = 0.0;
         return (true);
@@ -712,6 +792,49 @@ bool CurvilinearGrid::_insideGrid(double x, double y, double z, size_t &i, size_
     }
 }
 
+void CurvilinearGrid::GetValues(const double *xyz, size_t n, float *values) const
+{
+    // Coordinates on periodic boundaries need clamping, which is left to
+    // the general method
+    //
+    const vector<bool> &periodic = GetPeriodic();
+    if (!GetBlks().size() || std::find(periodic.begin(), periodic.end(), true) != periodic.end()) {
+        Grid::GetValues(xyz, n, values);
+        return;
+    }
+
+    const bool   linear = GetInterpolationOrder() != 0;
+    const float  mv = GetMissingValue();
+    const size_t chunk = 1024;
+    const long   nchunks = (n + chunk - 1) / chunk;
+
+    // Points are visited in order within a chunk, so that the face found
+    // for one point can be tried first for the next
+    //
+#pragma omp parallel for schedule(dynamic) if (nchunks > 1)
+    for (long c = 0; c < nchunks; c++) {
+        vector<DimsType> nodes(8);
+        bool             found = false;    // (i, j) is the face of the previous point
+        size_t           i = 0, j = 0, k = 0;
+        double           lambda[4], zwgt[2];
+
+        size_t end = std::min(n, (c + 1) * chunk);
+        for (size_t p = c * chunk; p < end; p++) {
+            double x = xyz[3 * p];
+            double y = xyz[3 * p + 1];
+            double z = GetGeometryDim() == 3 ? xyz[3 * p + 2] : 0.0;
+            double pt[] = {x, y};
+
+            found = (found && _insideNearbyFace(pt, i, j, lambda, nodes)) || _findFace(pt, i, j, lambda, nodes);
+            if (!found || !_insideColumn(x, y, z, i, j, k, zwgt)) {
+                values[p] = mv;
+                continue;
+            }
+            values[p] = linear ? _getValueLinear(i, j, k, lambda, zwgt) : _getValueNearestNeighbor(i, j, k, lambda, zwgt);
+        }
+    }
+}
+
 std::shared_ptr<QuadTreeRectangleP> CurvilinearGrid::_makeQuadTreeRectangle() const
 {
     const DimsType &dims = GetCellDimensions();
@@ -29,8 +29,6 @@ DCRAM::DCRAM()
 
 DCRAM::~DCRAM()
 {
-    for (const auto &it : _dataMap)
-        delete [] it.second;
     _dataMap.clear();
 }
 
@@ -177,14 +175,30 @@ void DCRAM::AddDataVar(const DC::DataVar &var, const float *buf)
 }
 
 
+void DCRAM::AddDataVarRef(const DC::DataVar &var, const float *buf)
+{
+    _dataVarsMap[var.GetName()] = var;
+    _dataMap[var.GetName()] = std::shared_ptr<const float>(buf, [](const float *) {});
+}
+
+
+const float *DCRAM::GetVarData(string varname, vector<size_t> &dims) const
+{
+    dims.clear();
+
+    auto itr = _dataMap.find(varname);
+    if (itr == _dataMap.end()) return (NULL);
+
+    if (!GetVarDimLens(varname, true, dims)) return (NULL);
+    return (itr->second.get());
+}
+
+
 void DCRAM::copyVarData(const DC::BaseVar &var, const float *buf, const size_t size)
 {
-    if (_dataMap.count(var.GetName()))
-        delete [] _dataMap[var.GetName()];
-    
     float *copy = new float[size];
     memcpy(copy, buf, sizeof(float)*size);
-    _dataMap[var.GetName()] = copy;
+    _dataMap[var.GetName()] = std::shared_ptr<const float>(copy, std::default_delete<float[]>());
 }
 
 
@@ -457,7 +471,7 @@ template<class T> int DCRAM::_readRegionTemplate(int fd, const vector<size_t> &m
     };
     
     if (_dataMap.count(varname)) {
-        float *data = _dataMap[varname];
+        const float *data = _dataMap[varname].get();
         vector<size_t> dimLens;
         GetVarDimLens(varname, true, dimLens);
         assert((dimLens.size() == min.size()) && (min.size() == max.size()));
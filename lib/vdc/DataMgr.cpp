@@ -481,10 +481,85 @@ template<typename T, enable_if_t<std::is_integral<T>::value, int> = 0> void _san
 
 template<typename T> bool contains(const vector<T> &v, T element) { return (find(v.begin(), v.end(), element) != v.end()); }
 
+// Increments a counter for the lifetime of the object
+//
+class ScopedCount {
+public:
+    ScopedCount(int &count) : _count(count) { _count++; }
+    ~ScopedCount() { _count--; }
+
+private:
+    int &_count;
+};
+
 
 
 };    // namespace
 
+void DataMgr::Mutex::lock()
+{
+    std::unique_lock<std::mutex> lk(_m);
+    if (_depth && _owner == std::this_thread::get_id()) {
+        _depth++;
+        return;
+    }
+    _cv.wait(lk, [this]() { return (_depth == 0); });
+    _owner = std::this_thread::get_id();
+    _depth = 1;
+}
+
+void DataMgr::Mutex::unlock()
+{
+    std::unique_lock<std::mutex> lk(_m);
+    VAssert(_depth > 0 && _owner == std::this_thread::get_id());
+
+    if (--_depth) return;
+
+    _owner = std::thread::id();
+    lk.unlock();
+    _cv.notify_all();
+}
+
+int DataMgr::Mutex::release()
+{
+    std::unique_lock<std::mutex> lk(_m);
+    if (!_depth || _owner != std::this_thread::get_id()) return (0);
+
+    int depth = _depth;
+    _depth = 0;
+    _owner = std::thread::id();
+    lk.unlock();
+    _cv.notify_all();
+    return (depth);
+}
+
+void DataMgr::Mutex::reacquire(int depth)
+{
+    if (!depth) return;
+
+    std::unique_lock<std::mutex> lk(_m);
+    _cv.wait(lk, [this]() { return (_depth == 0); });
+    _owner = std::this_thread::get_id();
+    _depth = depth;
+}
+
+void DataMgr::Mutex::wait(const std::function<bool()> &pred)
+{
+    std::unique_lock<std::mutex> lk(_m);
+    VAssert(_depth > 0 && _owner == std::this_thread::get_id());
+
+    if (pred()) return;
+
+    int depth = _depth;
+    _depth = 0;
+    _owner = std::thread::id();
+    _cv.notify_all();
+
+    _cv.wait(lk, [this, &pred]() { return (_depth == 0 && pred()); });
+    _owner = std::this_thread::get_id();
+    _depth = depth;
+}
+
 DataMgr::DataMgr(string format, size_t mem_size, int nthreads)
 {
     SetDiagMsg("DataMgr::DataMgr(%s,%d,%d)", format.c_str(), nthreads, mem_size);
@@ -501,8 +576,6 @@ DataMgr::DataMgr(string format, size_t mem_size, int nthreads)
 
     _PipeLines.clear();
 
-    _regionsList.clear();
-
     _varInfoCacheSize_T.Clear();
     _varInfoCacheDouble.Clear();
     _varInfoCacheVoidPtr.Clear();
@@ -513,12 +586,18 @@ DataMgr::DataMgr(string format, size_t mem_size, int nthreads)
     _proj4String.clear();
     _proj4StringDefault.clear();
     _bs = {64, 64, 64};
+
+    _activeReads = 0;
+    _prefetchStop = false;
+    _prefetchBusy = false;
 }
 
 DataMgr::~DataMgr()
 {
     SetDiagMsg("DataMgr::~DataMgr()");
 
+    _stopPrefetch();
+
     if (_dc) delete _dc;
     _dc = NULL;
 
@@ -577,6 +656,10 @@ int DataMgr::Initialize(const vector<string> &files, const std::vector<string> &
     int            rc = _parseOptions(deviceOptions);
     if (rc < 0) return (-1);
 
+    // The prefetch thread reads from _dc
+    //
+    _stopPrefetch();
+
     Clear();
     if (_dc) delete _dc;
 
@@ -733,6 +816,7 @@ vector<string> DataMgr::GetDataVarNames() const
 vector<string> DataMgr::GetDataVarNames(int ndim, VarType type) const
 {
     VAssert(_dc);
+    std::lock_guard<Mutex> guard(_mutex);
 
     if (_dataVarNamesCache[std::make_pair(type, ndim)].size()) { return (_dataVarNamesCache[std::make_pair(type, ndim)]); }
 
@@ -937,6 +1021,8 @@ vector<size_t> DataMgr::GetCRatios(string varname) const
 
 Grid *DataMgr::GetVariable(size_t ts, string varname, int level, int lod, bool lock)
 {
+    std::lock_guard<Mutex> guard(_mutex);
+
     SetDiagMsg("DataMgr::GetVariable(%d,%s,%d,%d,%d, %d)", ts, varname.c_str(), level, lod, lock);
 
     int rc = _level_correction(varname, level);
@@ -956,6 +1042,8 @@ Grid *DataMgr::GetVariable(size_t ts, string varname, int level, int lod, bool l
 
 Grid *DataMgr::GetVariable(size_t ts, string varname, int level, int lod, CoordType min, CoordType max, bool lock)
 {
+    std::lock_guard<Mutex> guard(_mutex);
+
 
     SetDiagMsg("DataMgr::GetVariable(%d, %s, %d, %d, %s, %s, %d)", ts, varname.c_str(), level, lod, vector_to_string(min).c_str(), vector_to_string(max).c_str(), lock);
 
@@ -1236,6 +1324,8 @@ int DataMgr::_setupConnVecs(size_t ts, string varname, int level, int lod, vecto
 
 Grid *DataMgr::_getVariable(size_t ts, string varname, int level, int lod, DimsType min, DimsType max, bool lock, bool dataless)
 {
+    ScopedCount activeRead(_activeReads);
+
     Grid *rg = NULL;
 
     string gridType = _get_grid_type(varname);
@@ -1265,15 +1355,31 @@ Grid *DataMgr::_getVariable(size_t ts, string varname, int level, int lod, DimsT
     int rc = _setupCoordVecs(ts, varname, level, lod, min, max, varnames, roi_dims, dimsvec, bsvec, bminvec, bmaxvec, !_gridHelper.IsUnstructured(gridType));
     if (rc < 0) return (NULL);
 
+    // Data held in memory by the data collection can be used in place,
+    // without copying it into the region cache, when a regular grid
+    // covers the entire variable at full resolution
+    //
+    float *inPlace = NULL;
+    if (!dataless && gridType == RegularGrid::GetClassType()) inPlace = _getInPlaceData(varname, min, max, dimsvec[0]);
+
     //
     // if dataless we only load coordinate data
     //
-    if (dataless) varnames[0].clear();
+    if (dataless || inPlace) varnames[0].clear();
 
     vector<float *> blkvec;
     rc = DataMgr::_get_regions<float>(ts, varnames, level, lod, true, dimsvec, bsvec, bminvec, bmaxvec, blkvec);
     if (rc < 0) return (NULL);
 
+    // A single block spanning the variable
+    //
+    if (inPlace) {
+        blkvec[0] = inPlace;
+        bsvec[0] = dimsvec[0];
+        bminvec[0] = {0, 0, 0};
+        bmaxvec[0] = {0, 0, 0};
+    }
+
     // Get dimensions for connectivity variables (if any)
     //
     vector<string>         conn_varnames;
@@ -1318,6 +1424,11 @@ Grid *DataMgr::_getVariable(size_t ts, string varname, int level, int lod, DimsT
     map_blk_to_vox(bsvec[0], dimsvec[0], bminvec[0], bmaxvec[0], gmin, gmax);
     rg->SetMinAbs(gmin);
 
+    // In place data is not in the region cache, so there is nothing to
+    // unlock
+    //
+    if (inPlace) blkvec[0] = NULL;
+
     //
     // Safe to remove locks now that were not explicitly requested
     //
@@ -1336,8 +1447,28 @@ Grid *DataMgr::_getVariable(size_t ts, string varname, int level, int lod, DimsT
     return (rg);
 }
 
+float *DataMgr::_getInPlaceData(string varname, const DimsType &min, const DimsType &max, const DimsType &dims) const
+{
+    const DCRAM *dcram = dynamic_cast<const DCRAM *>(_dc);
+    if (!dcram) return (NULL);
+
+    vector<size_t> dimsv;
+    const float *  data = dcram->GetVarData(varname, dimsv);
+    if (!data) return (NULL);
+
+    DimsType vdims = {1, 1, 1};
+    Grid::CopyToArr3(dimsv, vdims);
+    for (int i = 0; i < vdims.size(); i++) {
+        if (vdims[i] != dims[i] || min[i] != 0 || max[i] != dims[i] - 1) return (NULL);
+    }
+
+    return (const_cast<float *>(data));
+}
+
 Grid *DataMgr::GetVariable(size_t ts, string varname, int level, int lod, DimsType min, DimsType max, bool lock)
 {
+    std::lock_guard<Mutex> guard(_mutex);
+
 
     SetDiagMsg("DataMgr::GetVariable(%d, %s, %d, %d, %s, %s, %d)", ts, varname.c_str(), level, lod, vector_to_string(min).c_str(), vector_to_string(max).c_str(), lock);
 
@@ -1371,6 +1502,8 @@ Grid *DataMgr::GetVariable(size_t ts, string varname, int level, int lod, DimsTy
 
 int DataMgr::GetVariableExtents(size_t ts, string varname, int level, int lod, CoordType &min, CoordType &max)
 {
+    std::lock_guard<Mutex> guard(_mutex);
+
     SetDiagMsg("DataMgr::GetVariableExtents(%d, %s, %d, %d)", ts, varname.c_str(), level, lod);
 
     min = {0.0, 0.0, 0.0};
@@ -1426,6 +1559,8 @@ int DataMgr::GetDataRange(size_t ts, string varname, int level, int lod, vector<
 
 int DataMgr::GetDataRange(size_t ts, string varname, int level, int lod, CoordType min, CoordType max, vector<double> &range)
 {
+    std::lock_guard<Mutex> guard(_mutex);
+
     SetDiagMsg("DataMgr::GetDataRange(%d,%s)", ts, varname.c_str());
 
     range = {0.0, 0.0};
@@ -1475,6 +1610,8 @@ int DataMgr::GetDataRange(size_t ts, string varname, int level, int lod, CoordTy
 int DataMgr::GetDimLensAtLevel(string varname, int level, std::vector<size_t> &dims_at_level, std::vector<size_t> &bs_at_level, long ts) const
 {
     VAssert(_dc);
+    std::lock_guard<Mutex> guard(_mutex);
+
     dims_at_level.clear();
     bs_at_level.clear();
 
@@ -1559,6 +1696,8 @@ bool DataMgr::VariableExists(size_t ts, string varname, int level, int lod) cons
 {
     if (varname.empty()) return (false);
 
+    std::lock_guard<Mutex> guard(_mutex);
+
     // disable error reporting
     //
     bool enabled = EnableErrMsg(false);
@@ -1633,6 +1772,8 @@ bool DataMgr::IsVariableDerived(string name) const { return (_getDerivedVar(name
 
 int DataMgr::AddDerivedVar(DerivedDataVar *derivedVar)
 {
+    std::lock_guard<Mutex> guard(_mutex);
+
     string varname = derivedVar->GetName();
 
     if (_dvm.HasVar(varname)) {
@@ -1656,6 +1797,8 @@ int DataMgr::AddDerivedVar(DerivedDataVar *derivedVar)
 
 void DataMgr::RemoveDerivedVar(string varname)
 {
+    std::lock_guard<Mutex> guard(_mutex);
+
     if (!_dvm.HasVar(varname)) return;
 
     _dvm.RemoveVar(_dvm.GetVar(varname));
@@ -1675,21 +1818,28 @@ void DataMgr::RemoveDerivedVar(string varname)
 
 void DataMgr::Clear()
 {
-    _PipeLines.clear();
+    CancelPrefetch();
 
-    list<region_t>::iterator itr;
-    for (itr = _regionsList.begin(); itr != _regionsList.end(); itr++) {
-        const region_t &region = *itr;
+    std::lock_guard<Mutex> guard(_mutex);
 
-        if (region.blks) _blk_mem_mgr->FreeMem(region.blks);
-    }
-    _regionsList.clear();
+    // Regions obtained by reads in progress may not be freed out from
+    // under them
+    //
+    _mutex.wait([this]() { return (_activeReads == 0); });
+
+    _PipeLines.clear();
+
+    vector<void *> blks;
+    _regionCache.Clear(blks);
+    for (auto b : blks) { _blk_mem_mgr->FreeMem(b); }
 }
 
 void DataMgr::UnlockGrid(const Grid *rg)
 {
     SetDiagMsg("DataMgr::UnlockGrid()");
 
+    std::lock_guard<Mutex> guard(_mutex);
+
     const auto fb = _lockedFloatBlks.find(rg);
     if (fb != _lockedFloatBlks.end()) {
         auto &bvec = fb->second;
@@ -1705,6 +1855,141 @@ void DataMgr::UnlockGrid(const Grid *rg)
     }
 }
 
+void DataMgr::PrefetchTimeSteps(size_t ts, size_t k, const vector<string> &varnames, int level, int lod, CoordType min, CoordType max)
+{
+    SetDiagMsg("DataMgr::PrefetchTimeSteps(%d, %d)", ts, k);
+
+    std::lock_guard<Mutex> guard(_mutex);
+
+    size_t nts = GetNumTimeSteps();
+
+    _prefetchProtected.clear();
+    _prefetchProtected.insert(ts);
+
+    deque<prefetch_t> queue;
+    for (size_t t = ts + 1; t <= ts + k && t < nts; t++) {
+        _prefetchProtected.insert(t);
+        for (const auto &varname : varnames) { queue.push_back({t, varname, level, lod, min, max}); }
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(_prefetchMutex);
+        _prefetchQueue = queue;
+    }
+
+    // Start the prefetch thread on first use. Must be done while owning
+    // _mutex; see _isPrefetchThread()
+    //
+    if (!_prefetchThread.joinable()) { _prefetchThread = std::thread(&DataMgr::_prefetchLoop, this); }
+
+    _prefetchCV.notify_all();
+}
+
+void DataMgr::CancelPrefetch()
+{
+    std::unique_lock<std::mutex> lk(_prefetchMutex);
+    _prefetchQueue.clear();
+
+    _prefetchCV.wait(lk, [this]() { return (!_prefetchBusy); });
+}
+
+DataMgr::PrefetchStats DataMgr::GetPrefetchStats() const
+{
+    std::lock_guard<Mutex> guard(_mutex);
+
+    return (_prefetchStats);
+}
+
+void DataMgr::ResetPrefetchStats()
+{
+    std::lock_guard<Mutex> guard(_mutex);
+
+    _prefetchStats = PrefetchStats();
+}
+
+void DataMgr::SetIndexCacheDir(const string &dir)
+{
+    std::lock_guard<Mutex> guard(_mutex);
+
+    _gridHelper.SetIndexCacheDir(dir);
+}
+
+void DataMgr::SetIndexCacheSize(size_t max_size)
+{
+    std::lock_guard<Mutex> guard(_mutex);
+
+    _gridHelper.SetIndexCacheSize(max_size);
+}
+
+void DataMgr::_prefetchLoop()
+{
+    while (true) {
+        prefetch_t p;
+        {
+            std::unique_lock<std::mutex> lk(_prefetchMutex);
+            _prefetchCV.wait(lk, [this]() { return (_prefetchStop || !_prefetchQueue.empty()); });
+            if (_prefetchStop) return;
+
+            p = _prefetchQueue.front();
+            _prefetchQueue.pop_front();
+            _prefetchBusy = true;
+        }
+
+        _prefetch(p);
+
+        {
+            std::lock_guard<std::mutex> lk(_prefetchMutex);
+            _prefetchBusy = false;
+        }
+        _prefetchCV.notify_all();
+    }
+}
+
+// Read the regions needed to construct the grid for a prefetch request
+// into the cache. Follows the same path as GetVariable(), but does not
+// log errors, since a failed prefetch is not an error from the
+// perspective of the application.
+//
+void DataMgr::_prefetch(const prefetch_t &p)
+{
+    std::lock_guard<Mutex> guard(_mutex);
+
+    bool enabled = EnableErrMsg(false);
+
+    int level = p.level;
+    int lod = p.lod;
+    if (_level_correction(p.varname, level) < 0 || _lod_correction(p.varname, lod) < 0 || !VariableExists(p.ts, p.varname, level, lod)) {
+        EnableErrMsg(enabled);
+        return;
+    }
+
+    DimsType min_ui, max_ui;
+    int      rc = _find_bounding_grid(p.ts, p.varname, level, lod, p.min, p.max, min_ui, max_ui);
+    EnableErrMsg(enabled);
+    if (rc != 0) return;
+
+    Grid *g = _getVariable(p.ts, p.varname, level, lod, min_ui, max_ui, false, false);
+    if (g) delete g;
+}
+
+void DataMgr::_stopPrefetch()
+{
+    if (!_prefetchThread.joinable()) return;
+
+    {
+        std::lock_guard<std::mutex> lk(_prefetchMutex);
+        _prefetchStop = true;
+        _prefetchQueue.clear();
+    }
+    _prefetchCV.notify_all();
+    _prefetchThread.join();
+
+    // Allow PrefetchTimeSteps() to start a new thread
+    //
+    std::lock_guard<std::mutex> lk(_prefetchMutex);
+    _prefetchStop = false;
+}
+
 size_t DataMgr::GetNumDimensions(string varname) const
 {
     VAssert(_dc);
@@ -1755,25 +2040,16 @@ size_t DataMgr::GetVarGeometryDim(string varname) const
 
 template<typename T> T *DataMgr::_get_region_from_cache(size_t ts, string varname, int level, int lod, const DimsType &bmin, const DimsType &bmax, bool lock)
 {
-    list<region_t>::iterator itr;
-    for (itr = _regionsList.begin(); itr != _regionsList.end(); itr++) {
-        region_t &region = *itr;
-
-        if (region.ts == ts && region.varname.compare(varname) == 0 && region.level == level && region.lod == lod && region.bmin == bmin && region.bmax == bmax) {
-            // Increment the lock counter
-            region.lock_counter += lock ? 1 : 0;
+    // Increments the lock counter and makes the region the most recently used
+    //
+    bool  prefetched = false;
+    void *blks = _regionCache.Find(RegionCache::Key(ts, varname, level, lod, bmin, bmax), lock, _isPrefetchThread() ? NULL : &prefetched);
+    if (!blks) return (NULL);
 
-            // Move region to front of list
-            region_t tmp_region = region;
-            _regionsList.erase(itr);
-            _regionsList.push_back(tmp_region);
+    if (prefetched) _prefetchStats.hits++;
 
-            SetDiagMsg("DataMgr::_get_region_from_cache() - data in cache %xll\n", tmp_region.blks);
-            return ((T *)tmp_region.blks);
-        }
-    }
-
-    return (NULL);
+    SetDiagMsg("DataMgr::_get_region_from_cache() - data in cache %xll\n", blks);
+    return ((T *)blks);
 }
 
 template<typename T>
@@ -1903,7 +2179,10 @@ int DataMgr::_get_blocked_region_from_fs(size_t ts, string varname, int level, i
 template<typename T>
 T *DataMgr::_get_region_from_fs(size_t ts, string varname, int level, int lod, const DimsType &grid_dims, const DimsType &grid_bs, const DimsType &grid_bmin, const DimsType &grid_bmax, bool lock)
 {
-    T *blks = (T *)_alloc_region(ts, varname, level, lod, grid_bmin, grid_bmax, grid_bs, sizeof(T), lock, false);
+    // The region is always locked while it is being read so that it
+    // can't be evicted by another thread
+    //
+    T *blks = (T *)_alloc_region(ts, varname, level, lod, grid_bmin, grid_bmax, grid_bs, sizeof(T), true, false);
     if (!blks) return (NULL);
 
     vector<size_t> file_dimsv, file_bsv;
@@ -1923,6 +2202,11 @@ T *DataMgr::_get_region_from_fs(size_t ts, string varname, int level, int lod, c
 
     int nlevels = DataMgr::GetNumRefLevels(varname);
 
+    // Let other threads access the cache while we read. The caller
+    // owns _ioMutex and has marked the region as in flight.
+    //
+    int depth = _mutex.release();
+
     // If data aren't blocked on disk or if the requested level is not
     // available do a non-blocked read
     //
@@ -1931,11 +2215,16 @@ T *DataMgr::_get_region_from_fs(size_t ts, string varname, int level, int lod, c
     } else {
         rc = _get_blocked_region_from_fs(ts, varname, level, lod, file_bs, file_dims, grid_dims, grid_bs, grid_min, grid_max, blks);
     }
+
+    _mutex.reacquire(depth);
+
     if (rc < 0) {
         _free_region(ts, varname, level, lod, grid_bmin, grid_bmax, true);
         return (NULL);
     }
 
+    if (!lock) _unlock_blocks(blks);
+
     SetDiagMsg("DataMgr::GetGrid() - data read from fs\n");
     return (blks);
 }
@@ -1944,11 +2233,41 @@ template<typename T> T *DataMgr::_get_region(size_t ts, string varname, int leve
 {
     if (lod < -nlods) lod = -nlods;
 
+    // If another thread is reading this region from the file system
+    // wait for it to finish rather than reading the region a second time.
+    // While it is being read the region is in the cache, but its
+    // contents are not yet valid.
+    //
+    RegionCache::Key key(ts, varname, level, lod, bmin, bmax);
+    _mutex.wait([&]() { return (_inFlight.find(key) == _inFlight.end()); });
+
     // See if region is already in cache. If not, read from the
     // file system.
     //
     T *blks = _get_region_from_cache<T>(ts, varname, level, lod, bmin, bmax, lock);
-    if (!blks) { blks = (T *)_get_region_from_fs<T>(ts, varname, level, lod, dims, bs, bmin, bmax, lock); }
+    if (!blks) {
+        // File system reads are serialized. _mutex must be released
+        // before blocking on _ioMutex, and the cache checked again
+        // once we have it, in case another thread read the region while
+        // we were waiting.
+        //
+        int depth = _mutex.release();
+        std::lock_guard<std::recursive_mutex> ioGuard(_ioMutex);
+        _mutex.reacquire(depth);
+
+        blks = _get_region_from_cache<T>(ts, varname, level, lod, bmin, bmax, lock);
+        if (!blks) {
+            _inFlight.insert(key);
+            blks = (T *)_get_region_from_fs<T>(ts, varname, level, lod, dims, bs, bmin, bmax, lock);
+            _inFlight.erase(key);
+
+            if (_isPrefetchThread()) {
+                if (blks) _prefetchStats.reads++;
+                return (blks);
+            }
+            _prefetchStats.misses++;
+        }
+    }
     if (!blks) {
         SetErrMsg("Failed to read region from variable/timestep/level/lod (%s, %d, %d, %d)", varname.c_str(), ts, level, lod);
         return (NULL);
@@ -2027,83 +2346,57 @@ void *DataMgr::_alloc_region(size_t ts, string varname, int level, int lod, Dims
     void *blks;
     while (!(blks = (void *)_blk_mem_mgr->Alloc(nblocks, fill))) {
         if (!_free_lru()) {
+            if (_isPrefetchThread()) {
+                _prefetchStats.dropped++;
+                return (NULL);
+            }
             SetErrMsg("Failed to allocate requested memory");
             return (NULL);
         }
     }
 
-    region_t region;
+    _regionCache.Insert(RegionCache::Key(ts, varname, level, lod, bmin, bmax), blks, lock, _isPrefetchThread());
 
-    region.ts = ts;
-    region.varname = varname;
-    region.level = level;
-    region.lod = lod;
-    region.bmin = bmin;
-    region.bmax = bmax;
-    region.lock_counter = lock ? 1 : 0;
-    region.blks = blks;
-
-    _regionsList.push_back(region);
-
-    return (region.blks);
+    return (blks);
 }
 
 void DataMgr::_free_region(size_t ts, string varname, int level, int lod, DimsType bmin, DimsType bmax, bool forceFlag)
 {
-    list<region_t>::iterator itr;
-    for (itr = _regionsList.begin(); itr != _regionsList.end(); itr++) {
-        const region_t &region = *itr;
-
-        if (region.ts == ts && region.varname.compare(varname) == 0 && region.level == level && region.lod == lod && region.bmin == bmin && region.bmax == bmax) {
-            if (region.lock_counter == 0 || forceFlag) {
-                if (region.blks) _blk_mem_mgr->FreeMem(region.blks);
-
-                _regionsList.erase(itr);
-                return;
-            }
-        }
-    }
-
-    return;
+    void *blks = _regionCache.Remove(RegionCache::Key(ts, varname, level, lod, bmin, bmax), forceFlag);
+    if (blks) _blk_mem_mgr->FreeMem(blks);
 }
 
 void DataMgr::_free_var(string varname)
 {
-    list<region_t>::iterator itr;
-    for (itr = _regionsList.begin(); itr != _regionsList.end();) {
-        const region_t &region = *itr;
-
-        if (region.varname.compare(varname) == 0) {
-            if (region.blks) _blk_mem_mgr->FreeMem(region.blks);
-
-            _regionsList.erase(itr);
-            itr = _regionsList.begin();
-        } else
-            itr++;
-    }
+    vector<void *> blks;
+    _regionCache.RemoveVar(varname, blks);
+    for (auto b : blks) { _blk_mem_mgr->FreeMem(b); }
 
     _varInfoCacheSize_T.Purge(vector<string>(1, varname));
     _varInfoCacheDouble.Purge(vector<string>(1, varname));
     _varInfoCacheVoidPtr.Purge(vector<string>(1, varname));
+
+    _varVersions[varname]++;
 }
 
 bool DataMgr::_free_lru()
 {
-    // The least recently used region is at the front of the list
+    // Locked regions are never evicted. The prefetch thread additionally
+    // may not evict regions for the current time step or for the time
+    // steps it is reading ahead.
     //
-    list<region_t>::iterator itr;
-    for (itr = _regionsList.begin(); itr != _regionsList.end(); itr++) {
-        const region_t &region = *itr;
-
-        if (region.lock_counter == 0) {
-            if (region.blks) _blk_mem_mgr->FreeMem(region.blks);
-            _regionsList.erase(itr);
-            return (true);
-        }
+    void *blks;
+    if (_isPrefetchThread()) {
+        blks = _regionCache.EvictLRU([this](const RegionCache::Key &key) { return (_prefetchProtected.find(key.ts) == _prefetchProtected.end()); });
+    } else {
+        blks = _regionCache.EvictLRU();
     }
 
     // nothing to free
-    return (false);
+    if (!blks) return (false);
+
+    _blk_mem_mgr->FreeMem(blks);
+    return (true);
 }
 
 //
@@ -2799,16 +3092,7 @@ int DataMgr::_find_bounding_grid(size_t ts, string varname, int level, int lod,
 
 void DataMgr::_unlock_blocks(const void *blks)
 {
-    list<region_t>::iterator itr;
-    for (itr = _regionsList.begin(); itr != _regionsList.end(); itr++) {
-        region_t &region = *itr;
-
-        if (region.blks == blks && region.lock_counter > 0) {
-            region.lock_counter--;
-            return;
-        }
-    }
-    return;
+    (void)_regionCache.Unlock(blks);
 }
 
 vector<string> DataMgr::_getDataVarNamesDerived(int ndim) const
@@ -2995,6 +3279,33 @@ bool DataMgr::_getVarConnVars(string varname, string &face_node_var, string &nod
     return (true);
 }
 
+unsigned long DataMgr::GetVarVersion(string varname) const
+{
+    std::lock_guard<Mutex> guard(_mutex);
+
+    return (_getVarVersion(varname, 0));
+}
+
+unsigned long DataMgr::_getVarVersion(string varname, int depth) const
+{
+    unsigned long version = 0;
+
+    auto itr = _varVersions.find(varname);
+    if (itr != _varVersions.end()) version = itr->second;
+
+    // Versions only ever increase, so the sum over a derived variable's
+    // inputs changes whenever any of them does. The depth limit guards
+    // against derived variables that (incorrectly) depend on themselves
+    //
+    const DerivedVar *dvar = _getDerivedVar(varname);
+    if (!dvar || depth > 32) return (version);
+
+    vector<string> inputs = dvar->GetInputs();
+    for (int i = 0; i < inputs.size(); i++) { version += _getVarVersion(inputs[i], depth + 1); }
+
+    return (version);
+}
+
 DerivedVar *DataMgr::_getDerivedVar(string varname) const
 {
     DerivedVar *dvar;
@@ -3252,10 +3563,14 @@ int DataMgr::_initHorizontalCoordVars()
         vector<string> derivedCoordvars = coordvars;
         _assignHorizontalCoords(derivedCoordvars);
 
+        // X and Y are both computed from the same projection of lat and lon
+        //
+        auto projCache = std::make_shared<DerivedCoordVar_PCSFromLatLon::ProjCache>();
+
         // no duplicates
         //
         if (!_getDerivedCoordVar(derivedCoordvars[0])) {
-            DerivedCoordVar_PCSFromLatLon *derivedVar = new DerivedCoordVar_PCSFromLatLon(derivedCoordvars[0], _dc, coordvars, _proj4String, m.GetMeshType() != DC::Mesh::STRUCTURED, true);
+            DerivedCoordVar_PCSFromLatLon *derivedVar = new DerivedCoordVar_PCSFromLatLon(derivedCoordvars[0], _dc, coordvars, _proj4String, m.GetMeshType() != DC::Mesh::STRUCTURED, true, projCache);
 
             rc = derivedVar->Initialize();
             if (rc < 0) {
@@ -3267,7 +3582,7 @@ int DataMgr::_initHorizontalCoordVars()
         }
 
         if (!_getDerivedCoordVar(derivedCoordvars[1])) {
-            DerivedCoordVar_PCSFromLatLon *derivedVar = new DerivedCoordVar_PCSFromLatLon(derivedCoordvars[1], _dc, coordvars, _proj4String, m.GetMeshType() != DC::Mesh::STRUCTURED, false);
+            DerivedCoordVar_PCSFromLatLon *derivedVar = new DerivedCoordVar_PCSFromLatLon(derivedCoordvars[1], _dc, coordvars, _proj4String, m.GetMeshType() != DC::Mesh::STRUCTURED, false, projCache);
 
             rc = derivedVar->Initialize();
             if (rc < 0) {
@@ -482,7 +482,41 @@ int DerivedVar::ReadRegion(int fd, const std::vector<size_t> &min, const std::ve
 //
 //////////////////////////////////////////////////////////////////////////////
 
-DerivedCoordVar_PCSFromLatLon::DerivedCoordVar_PCSFromLatLon(string derivedVarName, DC *dc, vector<string> inNames, string proj4String, bool uGridFlag, bool lonFlag) : DerivedCoordVar(derivedVarName)
+bool DerivedCoordVar_PCSFromLatLon::ProjCache::Get(size_t ts, int lod, const vector<size_t> &min, const vector<size_t> &max, bool lonFlag, float *region)
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+
+    for (auto itr = _regions.begin(); itr != _regions.end(); ++itr) {
+        if (itr->ts == ts && itr->lod == lod && itr->min == min && itr->max == max && itr->lonFlag == lonFlag) {
+            std::copy(itr->coords.begin(), itr->coords.end(), region);
+            _regions.erase(itr);
+            return (true);
+        }
+    }
+    return (false);
+}
+
+void DerivedCoordVar_PCSFromLatLon::ProjCache::Put(size_t ts, int lod, const vector<size_t> &min, const vector<size_t> &max, bool lonFlag, vector<float> &coords)
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+
+    if (!_maxRegions) return;
+
+    entry_t entry;
+    entry.ts = ts;
+    entry.lod = lod;
+    entry.min = min;
+    entry.max = max;
+    entry.lonFlag = lonFlag;
+    entry.coords.swap(coords);
+
+    _regions.push_front(std::move(entry));
+    while (_regions.size() > _maxRegions) _regions.pop_back();
+}
+
+DerivedCoordVar_PCSFromLatLon::DerivedCoordVar_PCSFromLatLon(string derivedVarName, DC *dc, vector<string> inNames, string proj4String, bool uGridFlag, bool lonFlag,
+                                                             std::shared_ptr<ProjCache> projCache)
+: DerivedCoordVar(derivedVarName)
 {
     VAssert(inNames.size() == 2);
 
@@ -494,6 +528,7 @@ DerivedCoordVar_PCSFromLatLon::DerivedCoordVar_PCSFromLatLon(string derivedVarNa
     _uGridFlag = uGridFlag;
     _lonFlag = lonFlag;
     _dimLens.clear();
+    _projCache = projCache;
 }
 
 int DerivedCoordVar_PCSFromLatLon::Initialize()
@@ -593,6 +628,11 @@ int DerivedCoordVar_PCSFromLatLon::_readRegionHelper1D(DC::FileTable::FileObject
     string varname = f->GetVarname();
     int    lod = f->GetLOD();
 
+    // The other variable of the pair may already have computed this
+    // coordinate
+    //
+    if (_projCache && _projCache->Get(ts, lod, min, max, _lonFlag, region)) return (0);
+
     // Need temporary buffer space for the X or Y coordinate
     // NOT being returned (we still need to calculate it)
     //
@@ -631,8 +671,13 @@ int DerivedCoordVar_PCSFromLatLon::_readRegionHelper1D(DC::FileTable::FileObject
     make2D(lonBufPtr, latBufPtr, roidims);
 
     rc = _proj4API.Transform(lonBufPtr, latBufPtr, vproduct(roidims));
+    if (rc < 0) return (rc);
 
-    return (rc);
+    // Keep the coordinate in buf for the other variable of the pair
+    //
+    if (_projCache) _projCache->Put(ts, lod, min, max, !_lonFlag, buf);
+
+    return (0);
 }
 
 int DerivedCoordVar_PCSFromLatLon::_readRegionHelper2D(DC::FileTable::FileObject *f, const vector<size_t> &min, const vector<size_t> &max, float *region)
@@ -641,6 +686,8 @@ int DerivedCoordVar_PCSFromLatLon::_readRegionHelper2D(DC::FileTable::FileObject
     string varname = f->GetVarname();
     int    lod = f->GetLOD();
 
+    if (_projCache && _projCache->Get(ts, lod, min, max, _lonFlag, region)) return (0);
+
     // Need temporary buffer space for the X or Y coordinate
     // NOT being returned (we still need to calculate it)
     //
@@ -666,9 +713,11 @@ int DerivedCoordVar_PCSFromLatLon::_readRegionHelper2D(DC::FileTable::FileObject
     if (rc < 0) { return (rc); }
 
     rc = _proj4API.Transform(lonBufPtr, latBufPtr, nElements);
+    if (rc < 0) return (rc);
 
+    if (_projCache) _projCache->Put(ts, lod, min, max, !_lonFlag, buf);
 
-    return (rc);
+    return (0);
 }
 
 int DerivedCoordVar_PCSFromLatLon::ReadRegion(int fd, const vector<size_t> &min, const vector<size_t> &max, float *region)
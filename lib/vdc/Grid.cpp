@@ -18,12 +18,152 @@
 #include <vapor/utils.h>
 #include <vapor/Grid.h>
 #include <vapor/OpenMPSupport.h>
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+#endif
 
 using namespace std;
 using namespace VAPoR;
 
 namespace {
 
+// An index box, min and max, inclusive
+//
+typedef pair<DimsType, DimsType> box_t;
+
+// Split the index box [min, max], clipped to dims, along block boundaries.
+// The sub-boxes are returned in block order, one per block intersected.
+//
+vector<box_t> block_boxes(const DimsType &dims, const DimsType &bs, const DimsType &min, const DimsType &max)
+{
+    vector<box_t> boxes;
+
+    DimsType cMax;
+    for (int i = 0; i < 3; i++) {
+        cMax[i] = std::min(max[i], dims[i] - 1);
+        if (min[i] > cMax[i]) return (boxes);
+    }
+
+    for (size_t zb = min[2] / bs[2]; zb <= cMax[2] / bs[2]; zb++) {
+        for (size_t yb = min[1] / bs[1]; yb <= cMax[1] / bs[1]; yb++) {
+            for (size_t xb = min[0] / bs[0]; xb <= cMax[0] / bs[0]; xb++) {
+                DimsType bmin = {xb * bs[0], yb * bs[1], zb * bs[2]};
+                DimsType bmax = {bmin[0] + bs[0] - 1, bmin[1] + bs[1] - 1, bmin[2] + bs[2] - 1};
+                for (int i = 0; i < 3; i++) {
+                    bmin[i] = std::max(bmin[i], min[i]);
+                    bmax[i] = std::min(bmax[i], cMax[i]);
+                }
+                boxes.push_back(make_pair(bmin, bmax));
+            }
+        }
+    }
+    return (boxes);
+}
+
+// Partial result of a min, max, sum, and count reduction
+//
+class span_stats_t {
+public:
+    float  lo = std::numeric_limits<float>::infinity();
+    float  hi = -std::numeric_limits<float>::infinity();
+    double sum = 0.0;
+    size_t count = 0;
+
+    void merge(const span_stats_t &s)
+    {
+        if (!s.count) return;
+        lo = std::min(lo, s.lo);
+        hi = std::max(hi, s.hi);
+        sum += s.sum;
+        count += s.count;
+    }
+
+    void get(float mv, float range[2], double &rsum, size_t &rcount) const
+    {
+        range[0] = count ? lo : mv;
+        range[1] = count ? hi : mv;
+        rsum = sum;
+        rcount = count;
+    }
+};
+
+// Reduce the n values of a span that are not equal to mv
+//
+void reduce_span(const float *values, size_t n, float mv, span_stats_t &s)
+{
+    size_t i = 0;
+
+#if defined(__SSE2__) || defined(_M_X64)
+    if (n >= 4) {
+        const __m128 mvv = _mm_set1_ps(mv);
+        const __m128 inf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+        const __m128 ninf = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+        __m128       lo = _mm_set1_ps(s.lo);
+        __m128       hi = _mm_set1_ps(s.hi);
+        __m128d      sum0 = _mm_setzero_pd();
+        __m128d      sum1 = _mm_setzero_pd();
+        __m128i      count = _mm_setzero_si128();
+
+        for (; i + 4 <= n; i += 4) {
+            __m128 v = _mm_loadu_ps(values + i);
+            __m128 valid = _mm_cmpneq_ps(v, mvv);
+
+            // Missing values are replaced with the identity of each
+            // reduction: +inf for min, -inf for max, and 0 for sum
+            //
+            lo = _mm_min_ps(lo, _mm_or_ps(_mm_and_ps(valid, v), _mm_andnot_ps(valid, inf)));
+            hi = _mm_max_ps(hi, _mm_or_ps(_mm_and_ps(valid, v), _mm_andnot_ps(valid, ninf)));
+
+            __m128 vs = _mm_and_ps(valid, v);
+            sum0 = _mm_add_pd(sum0, _mm_cvtps_pd(vs));
+            sum1 = _mm_add_pd(sum1, _mm_cvtps_pd(_mm_movehl_ps(vs, vs)));
+
+            // valid lanes are all ones, i.e. -1
+            //
+            count = _mm_sub_epi32(count, _mm_castps_si128(valid));
+        }
+
+        float  los[4], his[4];
+        double sums[2];
+        int    counts[4];
+        _mm_storeu_ps(los, lo);
+        _mm_storeu_ps(his, hi);
+        _mm_storeu_pd(sums, _mm_add_pd(sum0, sum1));
+        _mm_storeu_si128((__m128i *)counts, count);
+
+        for (int k = 0; k < 4; k++) {
+            s.lo = std::min(s.lo, los[k]);
+            s.hi = std::max(s.hi, his[k]);
+            s.count += counts[k];
+        }
+        s.sum += sums[0] + sums[1];
+    }
+#endif
+
+    for (; i < n; i++) {
+        float v = values[i];
+        if (v == mv) continue;
+        s.lo = std::min(s.lo, v);
+        s.hi = std::max(s.hi, v);
+        s.sum += v;
+        s.count++;
+    }
+}
+
+// Add the n values of a span that are not equal to mv, and that are
+// inside [lo, hi], to nbins bins of width 1/scale
+//
+void histogram_span(const float *values, size_t n, float mv, float lo, float hi, double scale, size_t nbins, long *bins)
+{
+    for (size_t i = 0; i < n; i++) {
+        float v = values[i];
+        if (v == mv || !(v >= lo && v <= hi)) continue;
+
+        size_t bin = (size_t)((v - (double)lo) * scale);
+        bins[std::min(bin, nbins - 1)]++;
+    }
+}
+
 // Check for point on a quadralateral vertex
 //
 bool interpolate_point_on_node(const std::array<float, 4> &verts, double xwgt, double ywgt, float mv, float &v)
@@ -205,88 +345,120 @@ void Grid::SetValueIJK(size_t i, size_t j, size_t k, float v)
 
 void Grid::GetRange(float range[2]) const
 {
-    const auto missingVal = GetMissingValue();
-    const auto num_vals = _dims[0] * _dims[1] * _dims[2];
-    auto num_threads = size_t{1};
-#pragma omp parallel
-    {
-      if (omp_get_thread_num() == 0)
-        num_threads = omp_get_num_threads();
-    }
-    const auto stride_size = num_vals / num_threads;
-
-    auto min_vec = std::vector<float>(num_threads, missingVal);
-    auto max_vec = std::vector<float>(num_threads, missingVal);
-
-#pragma omp parallel for
-    for (size_t i = 0; i < num_threads; i++) {
-      auto beg = this->cbegin() + i * stride_size;
-      auto end = beg;
-      if (i < num_threads - 1) 
-        end += stride_size;
-      else
-        end = this->cend();
-
-      while (*beg == missingVal && beg != end)
-        ++beg;
-
-      if (beg != end) {
-        auto min = *beg;
-        auto max = *beg;
-        for (auto itr  = beg + 1; itr != end; ++itr) {
-          if (*itr != missingVal) {
-            min = std::min(*itr, min);      
-            max = std::max(*itr, max);      
-          }
-        }
-        min_vec[i] = min;
-        max_vec[i] = max;
-      }
-    } // finish omp section
+    DimsType max = {_dims[0] - 1, _dims[1] - 1, _dims[2] - 1};
+    double   sum;
+    size_t   count;
+    _getStatistics(DimsType{0, 0, 0}, max, range, sum, count);
+}
+
+void Grid::GetRange(const DimsType &min, const DimsType &max, float range[2]) const
+{
+    double sum;
+    size_t count;
+    GetStatistics(min, max, range, sum, count);
+}
+
+void Grid::GetStatistics(const DimsType &min, const DimsType &max, float range[2], double &sum, size_t &count) const
+{
+    DimsType cMin;
+    ClampIndex(min, cMin);
+
+    DimsType cMax;
+    ClampIndex(max, cMax);
+
+    _getStatistics(cMin, cMax, range, sum, count);
+}
 
-    if (std::all_of(min_vec.begin(), min_vec.end(), 
-        [missingVal](float v){return v == missingVal;})) {
-      range[0] = missingVal;
-      range[1] = missingVal;
+void Grid::_getStatistics(const DimsType &min, const DimsType &max, float range[2], double &sum, size_t &count) const
+{
+    float                mv = GetMissingValue();
+    vector<box_t>        boxes = block_boxes(_dims, _bs, min, max);
+    vector<span_stats_t> stats(boxes.size());
+
+#pragma omp parallel for schedule(dynamic) if (boxes.size() > 1)
+    for (long b = 0; b < (long)boxes.size(); b++) {
+        ForEachSpan(boxes[b].first, boxes[b].second, [&](const float *values, size_t n, const DimsType &) { reduce_span(values, n, mv, stats[b]); });
+    }
+
+    // Merge in block order so that the sum does not depend on the
+    // number of threads
+    //
+    span_stats_t total;
+    for (const auto &s : stats) total.merge(s);
+    total.get(mv, range, sum, count);
+}
+
+void Grid::GetStatistics(const CoordType &minu, const CoordType &maxu, float range[2], double &sum, size_t &count) const
+{
+    InsideBox pred(minu, maxu);
+
+    DimsType max = {_dims[0] - 1, _dims[1] - 1, _dims[2] - 1};
+    if (!pred.Enabled()) {
+        _getStatistics(DimsType{0, 0, 0}, max, range, sum, count);
+        return;
     }
-    else {
-      auto it = std::remove(min_vec.begin(), min_vec.end(), missingVal);
-      range[0] = *std::min_element(min_vec.begin(), it);
-      it = std::remove(max_vec.begin(), max_vec.end(), missingVal);
-      range[1] = *std::max_element(max_vec.begin(), it);
+
+    float                mv = GetMissingValue();
+    vector<box_t>        boxes = block_boxes(_dims, _bs, DimsType{0, 0, 0}, max);
+    vector<span_stats_t> stats(boxes.size());
+
+#pragma omp parallel for schedule(dynamic)
+    for (long b = 0; b < (long)boxes.size(); b++) {
+        ForEachSpan(boxes[b].first, boxes[b].second, [&](const float *values, size_t n, const DimsType &index) {
+            // Spans whose bounding box is inside the selection box are
+            // reduced as a whole. Otherwise test each grid point.
+            //
+            DimsType  last = {index[0] + n - 1, index[1], index[2]};
+            CoordType bmin = {0.0, 0.0, 0.0};
+            CoordType bmax = {0.0, 0.0, 0.0};
+            GetBoundingBox(index, last, bmin, bmax);
+            if (pred(bmin) && pred(bmax)) {
+                reduce_span(values, n, mv, stats[b]);
+                return;
+            }
+
+            DimsType  indices = index;
+            CoordType coords;
+            for (size_t i = 0; i < n; i++, indices[0]++) {
+                GetUserCoordinates(indices, coords);
+                if (pred(coords)) reduce_span(values + i, 1, mv, stats[b]);
+            }
+        });
     }
+
+    span_stats_t total;
+    for (const auto &s : stats) total.merge(s);
+    total.get(mv, range, sum, count);
 }
 
-void Grid::GetRange(const DimsType &min, const DimsType &max, float range[2]) const
+void Grid::GetHistogram(const DimsType &min, const DimsType &max, float lo, float hi, std::vector<long> &bins) const
 {
+    size_t nbins = bins.size();
+    if (!nbins || !(hi >= lo)) return;
+
     DimsType cMin;
     ClampIndex(min, cMin);
 
     DimsType cMax;
     ClampIndex(max, cMax);
 
-    float mv = GetMissingValue();
+    float         mv = GetMissingValue();
+    vector<box_t> boxes = block_boxes(_dims, _bs, cMin, cMax);
+    double        scale = hi > lo ? nbins / ((double)hi - (double)lo) : 0.0;
 
-    range[0] = range[1] = mv;
+    // One set of bins per thread, summed when done
+    //
+    int          nthreads = omp_get_max_threads();
+    vector<long> threadBins(nthreads * nbins, 0);
 
-    bool first = true;
-    for (size_t k = cMin[2]; k <= cMax[2]; k++) {
-        for (size_t j = cMin[1]; j <= cMax[1]; j++) {
-            for (size_t i = cMin[0]; i <= cMax[0]; i++) {
-                float v = AccessIJK(i, j, k);
-                if (first && v != mv) {
-                    range[0] = range[1] = v;
-                    first = false;
-                }
+#pragma omp parallel for schedule(dynamic) if (boxes.size() > 1)
+    for (long b = 0; b < (long)boxes.size(); b++) {
+        long *myBins = &threadBins[omp_get_thread_num() * nbins];
+        ForEachSpan(boxes[b].first, boxes[b].second, [&](const float *values, size_t n, const DimsType &) { histogram_span(values, n, mv, lo, hi, scale, nbins, myBins); });
+    }
 
-                if (!first) {
-                    if (v < range[0] && v != mv)
-                        range[0] = v;
-                    else if (v > range[1] && v != mv)
-                        range[1] = v;
-                }
-            }
-        }
+    for (int t = 0; t < nthreads; t++) {
+        for (size_t i = 0; i < nbins; i++) bins[i] += threadBins[t * nbins + i];
     }
 }
 
@@ -307,6 +479,25 @@ float Grid::GetValue(const CoordType &coords) const
 }
 
 
+void Grid::GetValues(const double *xyz, size_t n, float *values) const
+{
+    for (size_t i = 0; i < n; i++) values[i] = GetValue(xyz + 3 * i);
+}
+
+void Grid::GetValues(const float *xyz, size_t n, float *values) const
+{
+    // Convert the coordinates a chunk at a time to bound the size of the
+    // temporary buffer
+    //
+    const size_t   chunk = 16384;
+    vector<double> dxyz(3 * std::min(n, chunk));
+    for (size_t first = 0; first < n; first += chunk) {
+        size_t m = std::min(chunk, n - first);
+        for (size_t i = 0; i < 3 * m; i++) dxyz[i] = xyz[3 * first + i];
+        GetValues(dxyz.data(), m, values + first);
+    }
+}
+
 void Grid::GetUserCoordinates(size_t i, double &x, double &y, double &z) const
 {
     x = y = z = 0.0;
@@ -414,6 +605,76 @@ float Grid::TrilinearInterpolate(size_t i, size_t j, size_t k, const double xwgt
     return (v0 * zwgt + v1 * (1.0 - zwgt));
 }
 
+float Grid::AccessIJKFast(size_t i, size_t j, size_t k) const
+{
+    if (!_blks.size()) return (GetMissingValue());
+
+    DimsType indices = {std::min(i, _dims[0] - 1), std::min(j, _dims[1] - 1), std::min(k, _dims[2] - 1)};
+    return (*_spanPtr(indices));
+}
+
+float Grid::TrilinearInterpolateFast(size_t i, size_t j, size_t k, const double xwgt, const double ywgt, const double zwgt) const
+{
+    // Degenerate cells are left to the general method
+    //
+    if (!_blks.size() || _dims[0] < 2 || _dims[1] < 2) return (TrilinearInterpolate(i, j, k, xwgt, ywgt, zwgt));
+
+    VAssert(i < _dims[0]);
+    VAssert(j < _dims[1]);
+    VAssert(k < _dims[2]);
+
+    const float  mv = GetMissingValue();
+    const bool   top = _dims[2] > 1 && k < (_dims[2] - 1);
+    const size_t i1 = std::min(i + 1, _dims[0] - 1);
+    const size_t j1 = std::min(j + 1, _dims[1] - 1);
+
+    // Corners of the bottom (l = 0) and top (l = 1) layers, in the order
+    // used by BilinearInterpolate()
+    //
+    float verts[2][4];
+    int   nlayers = top ? 2 : 1;
+    for (int l = 0; l < nlayers; l++) {
+        size_t kk = k + l;
+        verts[l][0] = *_spanPtr(DimsType{i, j, kk});
+        verts[l][1] = *_spanPtr(DimsType{i1, j, kk});
+        verts[l][2] = *_spanPtr(DimsType{i, j1, kk});
+        verts[l][3] = *_spanPtr(DimsType{i1, j1, kk});
+        for (int c = 0; c < 4; c++) {
+            if (verts[l][c] == mv) return (TrilinearInterpolate(i, j, k, xwgt, ywgt, zwgt));
+        }
+    }
+    if (!top) {
+        for (int c = 0; c < 4; c++) verts[1][c] = 0.0f;
+    }
+
+    // Both layers at once, one per lane, in double precision like
+    // BilinearInterpolate()
+    //
+    float layer[2];
+#if defined(__SSE2__) || defined(_M_X64)
+    const __m128d xw = _mm_set1_pd(xwgt), xw1 = _mm_set1_pd(1.0 - xwgt);
+    const __m128d yw = _mm_set1_pd(ywgt), yw1 = _mm_set1_pd(1.0 - ywgt);
+    const __m128d c0 = _mm_set_pd(verts[1][0], verts[0][0]);
+    const __m128d c1 = _mm_set_pd(verts[1][1], verts[0][1]);
+    const __m128d c2 = _mm_set_pd(verts[1][2], verts[0][2]);
+    const __m128d c3 = _mm_set_pd(verts[1][3], verts[0][3]);
+    const __m128d lo = _mm_mul_pd(_mm_add_pd(_mm_mul_pd(c0, xw), _mm_mul_pd(c1, xw1)), yw);
+    const __m128d hi = _mm_mul_pd(_mm_add_pd(_mm_mul_pd(c2, xw), _mm_mul_pd(c3, xw1)), yw1);
+    double        r[2];
+    _mm_storeu_pd(r, _mm_add_pd(lo, hi));
+    layer[0] = r[0];
+    layer[1] = r[1];
+#else
+    for (int l = 0; l < 2; l++) { layer[l] = ((verts[l][0] * xwgt + verts[l][1] * (1.0 - xwgt)) * ywgt) + ((verts[l][2] * xwgt + verts[l][3] * (1.0 - xwgt)) * (1.0 - ywgt)); }
+#endif
+
+    if (!top) return (layer[0]);
+
+    if (layer[0] == mv || layer[1] == mv) return (TrilinearInterpolate(i, j, k, xwgt, ywgt, zwgt));
+
+    return (layer[0] * zwgt + layer[1] * (1.0 - zwgt));
+}
+
 /////////////////////////////////////////////////////////////////////////////
 //
 // Iterators
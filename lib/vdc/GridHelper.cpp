@@ -1,7 +1,15 @@
 #include <iostream>
 #include <sstream>
+#include <fstream>
+#include <iomanip>
+#include <cstdio>
+#include <cstring>
 #include <vector>
 #include <map>
+#include <random>
+#include <thread>
+#include <vapor/CFuncs.h>
+#include <vapor/FileUtils.h>
 #include <vapor/QuadTreeRectangleP.h>
 #include <vapor/GridHelper.h>
 #include <vapor/UnstructuredGrid3D.h>
@@ -100,12 +108,103 @@ bool isCurvilinear(const DC::Mesh &m, const vector<DC::CoordVar> &cvarsinfo, con
     return (true);
 }
 
+// Hash the contents of a set of memory regions. This is 64-bit FNV-1a,
+// except that the data are consumed a word at a time, since the regions
+// can be hundreds of megabytes, with an extra shift so that the high
+// bits of each word reach the low bits of the hash.
+//
+uint64_t hashRegions(const vector<std::pair<const void *, size_t>> &regions)
+{
+    const uint64_t prime = 0x100000001b3ULL;
+    uint64_t       h = 0xcbf29ce484222325ULL;
+
+    for (size_t r = 0; r < regions.size(); r++) {
+        const unsigned char *ptr = (const unsigned char *)regions[r].first;
+        size_t               n = regions[r].second;
+
+        h = (h ^ (uint64_t)n) * prime;
+
+        size_t i = 0;
+        for (; i + sizeof(uint64_t) <= n; i += sizeof(uint64_t)) {
+            uint64_t w;
+            memcpy(&w, ptr + i, sizeof(w));
+            h = (h ^ w) * prime;
+            h ^= h >> 32;
+        }
+        for (; i < n; i++) h = (h ^ ptr[i]) * prime;
+    }
+    return (h);
+}
 
 };    // namespace
 
 using namespace VAPoR;
 using namespace Wasp;
 
+GridHelper::GridHelper(size_t max_size) : _qtrCache(max_size), _bvhCache(max_size) { _indexCacheDir = GetEnvironmentalVariable("VAPOR_INDEX_CACHE_DIR"); }
+
+void GridHelper::SetIndexCacheSize(size_t max_size)
+{
+    _qtrCache.set_max_size(max_size);
+    _bvhCache.set_max_size(max_size);
+}
+
+std::shared_ptr<const QuadTreeRectangleP> GridHelper::_getQuadTreeRectangle(const string &key, const regions_t &regions, string &path)
+{
+    path.clear();
+
+    std::shared_ptr<const QuadTreeRectangleP> qtr = _qtrCache.get(key);
+    if (qtr || _indexCacheDir.empty()) return (qtr);
+
+    ostringstream oss;
+    oss << "qtr_" << std::hex << std::setw(16) << std::setfill('0') << hashRegions(regions) << ".bin";
+    path = FileUtils::JoinPaths({_indexCacheDir, oss.str()});
+
+    std::ifstream in(path.c_str(), std::ios::binary);
+    if (!in) return (qtr);
+
+    std::shared_ptr<QuadTreeRectangleP> newqtr(new QuadTreeRectangleP());
+    if (!newqtr->Read(in)) {
+        SetDiagMsg("Ignoring invalid point location index %s", path.c_str());
+        return (qtr);
+    }
+
+    // Found on disk, so there is no need to write it out again
+    //
+    path.clear();
+    qtr = newqtr;
+    (void)_qtrCache.put(key, qtr);
+    return (qtr);
+}
+
+void GridHelper::_putQuadTreeRectangle(const string &key, const string &path, std::shared_ptr<const QuadTreeRectangleP> qtr)
+{
+    if (!qtr) return;
+
+    (void)_qtrCache.put(key, qtr);
+
+    if (path.empty()) return;
+
+    // Write to a temporary file and rename it, so that a concurrent
+    // reader never sees a partially written index. The temporary name
+    // must be unique, since other threads or other processes sharing
+    // the cache directory may be writing the same index
+    //
+    (void)FileUtils::MakeDir(_indexCacheDir);
+    std::ostringstream oss;
+    oss << path << ".tmp." << std::hex << std::random_device()() << std::hash<std::thread::id>()(std::this_thread::get_id());
+    string tmppath = oss.str();
+
+    std::ofstream out(tmppath.c_str(), std::ios::binary);
+    bool          ok = out && qtr->Write(out);
+    out.close();
+
+    if (!ok || out.fail() || std::rename(tmppath.c_str(), path.c_str()) != 0) {
+        SetDiagMsg("Failed to write point location index %s", path.c_str());
+        std::remove(tmppath.c_str());
+    }
+}
+
 string GridHelper::_getQuadTreeRectangleKey(size_t ts, int level, int lod, const vector<DC::CoordVar> &cvarsinfo, const DimsType &bmin, const DimsType &bmax) const
 {
     VAssert(cvarsinfo.size() >= 2);
@@ -291,13 +390,24 @@ CurvilinearGrid *GridHelper::_make_grid_curvilinear(size_t ts, int level, int lo
 
     string qtr_key = _getQuadTreeRectangleKey(ts, level, lod, cvarsinfo, bmin2d, bmax2d);
 
+    // The horizontal coordinates the QuadTreeRectangle is built from
+    //
+    string    gridType = CurvilinearGrid::GetClassType();
+    regions_t regions = {{gridType.data(), gridType.size()},
+                         {dims2d.data(), sizeof(dims2d)},
+                         {bs2d.data(), sizeof(bs2d)},
+                         {blkvec[1], nblocks2d * block_size2d * sizeof(float)},
+                         {blkvec[2], nblocks2d * block_size2d * sizeof(float)}};
+
     // Try to get a shared pointer to the QuadTreeRectangle from the
-    // cache. If one does not exist the Grid class will make one. We use
+    // cache, or failing that from the on-disk cache. If one does not
+    // exist the Grid class will make one. We use
     // a shared pointer so that we can cache it for use by other Grid
     // classes. This a peformance optimization, necessary be creating
     // a QuadTreeRectangle is expensive.
     //
-    std::shared_ptr<const QuadTreeRectangleP> qtr = _qtrCache.get(qtr_key);
+    string                                    qtr_path;
+    std::shared_ptr<const QuadTreeRectangleP> qtr = _getQuadTreeRectangle(qtr_key, regions, qtr_path);
 
     CurvilinearGrid *g;
     if (Grid::GetNumDimensions(dims) == 3 && cvarsinfo[2].GetDimNames().size() == 3) {
@@ -330,10 +440,7 @@ CurvilinearGrid *GridHelper::_make_grid_curvilinear(size_t ts, int level, int lo
     // by UnstructuredGrid2D() and cache it for later use. The memory
     // will be garbage collected when all pointers to it go out of scope
     //
-    if (!qtr) {
-        qtr = g->GetQuadTreeRectangle();
-        (void)_qtrCache.put(qtr_key, qtr);
-    }
+    if (!qtr) { _putQuadTreeRectangle(qtr_key, qtr_path, g->GetQuadTreeRectangle()); }
 
     return (g);
 }
@@ -384,13 +491,26 @@ UnstructuredGrid2D *GridHelper::_make_grid_unstructured2d(size_t ts, int level,
 
     string qtr_key = _getQuadTreeRectangleKey(ts, level, lod, cvarsinfo, bmin, bmax);
 
+    // The horizontal coordinates and connectivity the QuadTreeRectangle is
+    // built from
+    //
+    string    gridType = UnstructuredGrid2D::GetClassType();
+    long      params[] = {(long)vertexDims[0], (long)faceDims[0], (long)maxVertexPerFace, vertexOffset};
+    regions_t regions = {{gridType.data(), gridType.size()},
+                         {params, sizeof(params)},
+                         {blkvec[1], xcblkptrs.size() * block_size * sizeof(float)},
+                         {blkvec[2], ycblkptrs.size() * block_size * sizeof(float)},
+                         {vertexOnFace, faceDims[0] * maxVertexPerFace * sizeof(int)}};
+
     // Try to get a shared pointer to the QuadTreeRectangle from the
-    // cache. If one does not exist the Grid class will make one. We use
+    // cache, or failing that from the on-disk cache. If one does not
+    // exist the Grid class will make one. We use
     // a shared pointer so that we can cache it for use by other Grid
     // classes. This a peformance optimization, necessary be creating
     // a QuadTreeRectangle is expensive.
     //
-    std::shared_ptr<const QuadTreeRectangleP> qtr = _qtrCache.get(qtr_key);
+    string                                    qtr_path;
+    std::shared_ptr<const QuadTreeRectangleP> qtr = _getQuadTreeRectangle(qtr_key, regions, qtr_path);
 
     UnstructuredGrid2D *g = new UnstructuredGrid2D(vertexDims, faceDims, edgeDims, bs, blkptrs, vertexOnFace, faceOnVertex, faceOnFace, location, maxVertexPerFace, maxFacePerVertex, vertexOffset,
                                                    faceOffset, xug, yug, zug, qtr);
@@ -399,10 +519,7 @@ UnstructuredGrid2D *GridHelper::_make_grid_unstructured2d(size_t ts, int level,
     // by UnstructuredGrid2D() and cache it for later use. The memory
     // will be garbage collected when all pointers to it go out of scope
     //
-    if (!qtr) {
-        qtr = g->GetQuadTreeRectangle();
-        (void)_qtrCache.put(qtr_key, qtr);
-    }
+    if (!qtr) { _putQuadTreeRectangle(qtr_key, qtr_path, g->GetQuadTreeRectangle()); }
 
     return (g);
 }
@@ -480,13 +597,26 @@ UnstructuredGridLayered *GridHelper::_make_grid_unstructured_layered(size_t ts,
 
     string qtr_key = _getQuadTreeRectangleKey(ts, level, lod, cvarsinfo, bmin, bmax);
 
+    // The horizontal coordinates and connectivity the QuadTreeRectangle is
+    // built from
+    //
+    string    gridType = UnstructuredGridLayered::GetClassType();
+    long      params[] = {(long)vertexDims[0], (long)faceDims[0], (long)maxVertexPerFace, vertexOffset};
+    regions_t regions = {{gridType.data(), gridType.size()},
+                         {params, sizeof(params)},
+                         {blkvec[1], xcblkptrs.size() * bs[0] * sizeof(float)},
+                         {blkvec[2], ycblkptrs.size() * bs[0] * sizeof(float)},
+                         {vertexOnFace, faceDims[0] * maxVertexPerFace * sizeof(int)}};
+
     // Try to get a shared pointer to the QuadTreeRectangle from the
-    // cache. If one does not exist the Grid class will make one. We use
+    // cache, or failing that from the on-disk cache. If one does not
+    // exist the Grid class will make one. We use
     // a shared pointer so that we can cache it for use by other Grid
     // classes. This a peformance optimization, necessary be creating
     // a QuadTreeRectangle is expensive.
     //
-    std::shared_ptr<const QuadTreeRectangleP> qtr = _qtrCache.get(qtr_key);
+    string                                    qtr_path;
+    std::shared_ptr<const QuadTreeRectangleP> qtr = _getQuadTreeRectangle(qtr_key, regions, qtr_path);
 
     UnstructuredGridLayered *g = new UnstructuredGridLayered(vertexDims, faceDims, edgeDims, bs, blkptrs, vertexOnFace, faceOnVertex, faceOnFace, location, maxVertexPerFace, maxFacePerVertex,
                                                              vertexOffset, faceOffset, xug, yug, zug, qtr);
@@ -495,10 +625,7 @@ UnstructuredGridLayered *GridHelper::_make_grid_unstructured_layered(size_t ts,
     // by UnstructuredGrid2D() and cache it for later use. The memory
     // will be garbage collected when all pointers to it go out of scope
     //
-    if (!qtr) {
-        qtr = g->GetQuadTreeRectangle();
-        (void)_qtrCache.put(qtr_key, qtr);
-    }
+    if (!qtr) { _putQuadTreeRectangle(qtr_key, qtr_path, g->GetQuadTreeRectangle()); }
 
     return (g);
 }
@@ -578,9 +705,21 @@ UnstructuredGrid3D *GridHelper::_make_grid_unstructured_3d(size_t ts, int level,
     UnstructuredGridCoordless zug(vertexDims, faceDims, edgeDims, bs, zcblkptrs, 3, vertexOnFace, faceOnVertex, faceOnFace, location, maxVertexPerFace, maxFacePerVertex, vertexOffset, faceOffset);
 
 
+    string bvh_key = _getQuadTreeRectangleKey(ts, level, lod, cvarsinfo, bmin, bmax);
+
+    // Try to get a shared pointer to the cell BVH from the cache. If one
+    // does not exist the Grid class will make one. As with the
+    // QuadTreeRectangle, building the BVH is expensive.
+    //
+    std::shared_ptr<const CellBVH> bvh = _bvhCache.get(bvh_key);
+
     UnstructuredGrid3D *g = new UnstructuredGrid3D(vertexDims, faceDims, edgeDims, bs, blkptrs, vertexOnFace, faceOnVertex, faceOnFace, location, maxVertexPerFace, maxFacePerVertex, vertexOffset,
-                                                   faceOffset, xug, yug, zug);
+                                                   faceOffset, xug, yug, zug, bvh);
 
+    if (!bvh && g->GetCellBVH()) {
+        bvh = g->GetCellBVH();
+        (void)_bvhCache.put(bvh_key, bvh);
+    }
 
     return (g);
 }
@@ -677,6 +816,7 @@ UnstructuredGrid *GridHelper::MakeGridUnstructured(string gridType, size_t ts, i
 GridHelper::~GridHelper()
 {
     while ((_qtrCache.remove_lru()) != NULL) {}
+    while ((_bvhCache.remove_lru()) != NULL) {}
 }
 
 string GridHelper::GetGridType(const DC::Mesh &m, const vector<DC::CoordVar> &cvarsinfo, const vector<vector<string>> &cdimnames) const
@@ -0,0 +1,275 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vapor/VAssert.h>
+#include <vapor/GridStatistics.h>
+#include <vapor/OpenMPSupport.h>
+
+using namespace VAPoR;
+using namespace std;
+
+namespace {
+
+// Grids are split into slabs of at least this many values, which are
+// visited in parallel
+//
+const size_t minSlabSize = 65536;
+
+// Return the index of the bin of width 2^exp containing v
+//
+long long binIndex(double v, int exp) { return ((long long)std::floor(std::ldexp(v, -exp))); }
+
+// Return the index of the bin of width 2^(exp + shift) containing the
+// bin with index i and width 2^exp
+//
+long long coarsenIndex(long long i, int shift)
+{
+    if (shift >= 62) return (i < 0 ? -1 : 0);
+    return (i >= 0 ? i >> shift : -((-i - 1) >> shift) - 1);
+}
+
+// Smallest bin width exponent for which the bin indices of values in
+// [lo, hi] are exactly representable
+//
+int minBinExp(float lo, float hi)
+{
+    float m = std::max(std::max(std::fabs(lo), std::fabs(hi)), std::numeric_limits<float>::min());
+    return (std::ilogb(m) - std::numeric_limits<double>::digits + 1);
+}
+
+};    // namespace
+
+void GridStatistics::moments_t::merge(const moments_t &m)
+{
+    if (!m.count) return;
+    if (!count) {
+        *this = m;
+        return;
+    }
+
+    // Chan et al. pairwise update
+    //
+    size_t n = count + m.count;
+    double d = m.mean - mean;
+    mean += d * ((double)m.count / n);
+    m2 += m.m2 + d * d * ((double)count * (double)m.count / n);
+    lo = std::min(lo, m.lo);
+    hi = std::max(hi, m.hi);
+    count = n;
+}
+
+GridStatistics::GridStatistics(size_t nbins)
+{
+    VAssert(nbins >= 2);
+    _nbins = nbins;
+    Clear();
+}
+
+void GridStatistics::Clear()
+{
+    _moments = moments_t();
+    _bins.clear();
+    _exp = 0;
+    _offset = 0;
+    _binLo = 0.0f;
+    _binHi = 0.0f;
+}
+
+void GridStatistics::_fit(float lo, float hi, int minExp)
+{
+    if (!_bins.empty()) {
+        lo = std::min(lo, _binLo);
+        hi = std::max(hi, _binHi);
+        minExp = std::max(minExp, _exp);
+    }
+
+    // The smallest bin width that fits [lo, hi] in _nbins bins. Widths
+    // below (hi - lo) / (_nbins + 1) never fit
+    //
+    int    exp = std::max(minExp, minBinExp(lo, hi));
+    double width = (double)hi - (double)lo;
+    if (width > 0.0) exp = std::max(exp, (int)std::floor(std::log2(width / (_nbins + 1))) - 1);
+    while (binIndex(hi, exp) - binIndex(lo, exp) >= (long long)_nbins) exp++;
+
+    if (_bins.empty()) {
+        _bins.assign(_nbins, 0);
+        _exp = exp;
+        _offset = binIndex(lo, exp);
+        _binLo = lo;
+        _binHi = hi;
+        return;
+    }
+
+    _binLo = lo;
+    _binHi = hi;
+    if (exp == _exp && binIndex(lo, exp) >= _offset && binIndex(hi, exp) < _offset + (long long)_nbins) return;
+
+    // Widen the bins. Bins are aligned at multiples of their width, so
+    // every old bin falls inside exactly one new bin
+    //
+    long long      offset = binIndex(lo, exp);
+    vector<size_t> bins(_nbins, 0);
+    for (size_t i = 0; i < _nbins; i++) {
+        if (_bins[i]) bins[coarsenIndex(_offset + (long long)i, exp - _exp) - offset] += _bins[i];
+    }
+    _bins.swap(bins);
+    _exp = exp;
+    _offset = offset;
+}
+
+void GridStatistics::_addSpan(const float *values, size_t n, float mv, moments_t &m)
+{
+    // First pass for the range and mean of the span, second pass, over
+    // values that are still in cache, for the squared differences from
+    // the mean and the histogram
+    //
+    moments_t s;
+    float     lo = std::numeric_limits<float>::max();
+    float     hi = std::numeric_limits<float>::lowest();
+    double    sum = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        float v = values[i];
+        if (v == mv || !std::isfinite(v)) continue;
+        lo = std::min(lo, v);
+        hi = std::max(hi, v);
+        sum += v;
+        s.count++;
+    }
+    if (!s.count) return;
+
+    _fit(lo, hi, std::numeric_limits<int>::lowest());
+
+    s.lo = lo;
+    s.hi = hi;
+    s.mean = sum / s.count;
+
+    double  scale = std::ldexp(1.0, -_exp);
+    size_t *bins = _bins.data();
+    for (size_t i = 0; i < n; i++) {
+        float v = values[i];
+        if (v == mv || !std::isfinite(v)) continue;
+        double d = v - s.mean;
+        s.m2 += d * d;
+        bins[(long long)std::floor(v * scale) - _offset]++;
+    }
+
+    m.merge(s);
+}
+
+void GridStatistics::_mergeBins(const GridStatistics &s)
+{
+    if (s._bins.empty()) return;
+
+    _fit(s._binLo, s._binHi, s._exp);
+
+    for (size_t i = 0; i < s._nbins; i++) {
+        if (s._bins[i]) _bins[coarsenIndex(s._offset + (long long)i, _exp - s._exp) - _offset] += s._bins[i];
+    }
+}
+
+void GridStatistics::Add(const float *values, size_t n, float mv) { _addSpan(values, n, mv, _moments); }
+
+void GridStatistics::Add(const Grid *grid, const CoordType &minu, const CoordType &maxu)
+{
+    const DimsType &dims = grid->GetDimensions();
+    for (int i = 0; i < dims.size(); i++) {
+        if (!dims[i]) return;
+    }
+
+    // Split the grid into slabs along its slowest varying dimension. The
+    // slabs, and hence the results, don't depend on the number of
+    // threads
+    //
+    int axis = 0;
+    for (int i = 1; i < dims.size(); i++) {
+        if (dims[i] > 1) axis = i;
+    }
+    size_t slice = 1;
+    for (int i = 0; i < axis; i++) slice *= dims[i];
+    size_t rows = std::max((size_t)1, minSlabSize / slice);
+    size_t nslabs = (dims[axis] + rows - 1) / rows;
+
+    float           mv = grid->GetMissingValue();
+    Grid::InsideBox pred(minu, maxu);
+
+    // Moments are merged in slab order. Histogram counts are exact, so
+    // one histogram per thread suffices
+    //
+    vector<moments_t>      slabMoments(nslabs);
+    vector<GridStatistics> threadStats(omp_get_max_threads(), GridStatistics(_nbins));
+
+#pragma omp parallel for schedule(dynamic) if (nslabs > 1)
+    for (long s = 0; s < (long)nslabs; s++) {
+        GridStatistics &ts = threadStats[omp_get_thread_num()];
+        moments_t &     m = slabMoments[s];
+
+        DimsType min = {0, 0, 0};
+        DimsType max = {dims[0] - 1, dims[1] - 1, dims[2] - 1};
+        min[axis] = s * rows;
+        max[axis] = std::min(dims[axis], (size_t)(s + 1) * rows) - 1;
+
+        grid->ForEachSpan(min, max, [&](const float *values, size_t n, const DimsType &index) {
+            if (!pred.Enabled()) {
+                ts._addSpan(values, n, mv, m);
+                return;
+            }
+
+            // Spans whose bounding box is inside the selection box are
+            // accumulated as a whole. Otherwise test each grid point.
+            //
+            DimsType  last = {index[0] + n - 1, index[1], index[2]};
+            CoordType bmin = {0.0, 0.0, 0.0};
+            CoordType bmax = {0.0, 0.0, 0.0};
+            grid->GetBoundingBox(index, last, bmin, bmax);
+            if (pred(bmin) && pred(bmax)) {
+                ts._addSpan(values, n, mv, m);
+                return;
+            }
+
+            DimsType  indices = index;
+            CoordType coords;
+            for (size_t i = 0; i < n; i++, indices[0]++) {
+                grid->GetUserCoordinates(indices, coords);
+                if (pred(coords)) ts._addSpan(values + i, 1, mv, m);
+            }
+        });
+    }
+
+    for (const auto &ts : threadStats) _mergeBins(ts);
+    for (const auto &m : slabMoments) _moments.merge(m);
+}
+
+void GridStatistics::Merge(const GridStatistics &s)
+{
+    _mergeBins(s);
+    _moments.merge(s._moments);
+}
+
+double GridStatistics::GetStddev() const { return (std::sqrt(GetVariance())); }
+
+double GridStatistics::GetBinWidth() const { return (_bins.empty() ? 0.0 : std::ldexp(1.0, _exp)); }
+
+float GridStatistics::GetQuantile(double q) const
+{
+    if (_bins.empty()) return (0.0f);
+
+    size_t total = 0;
+    for (size_t i = 0; i < _nbins; i++) total += _bins[i];
+
+    q = std::min(std::max(q, 0.0), 1.0);
+    double rank = q * (double)(total - 1);
+
+    // Interpolate within the bin holding the value of the given rank
+    //
+    size_t cum = 0;
+    for (size_t i = 0; i < _nbins; i++) {
+        if (!_bins[i]) continue;
+        if (cum + _bins[i] > rank) {
+            double f = (rank - cum + 0.5) / _bins[i];
+            double v = std::ldexp((double)(_offset + (long long)i) + f, _exp);
+            return ((float)std::min(std::max(v, (double)_binLo), (double)_binHi));
+        }
+        cum += _bins[i];
+    }
+    return (_binHi);
+}
@@ -120,6 +120,12 @@ void LayeredGrid::GetBoundingBox(const DimsType &min, const DimsType &max, Coord
 }
 
 bool LayeredGrid::_insideGrid(const CoordType &coords, DimsType &indices, double wgts[3]) const
+{
+    vector<double> zcoords;
+    return (_insideGrid(coords, indices, wgts, zcoords));
+}
+
+bool LayeredGrid::_insideGrid(const CoordType &coords, DimsType &indices, double wgts[3], vector<double> &zcoords) const
 {
     // Get indices and weights for horizontal slice
     //
@@ -162,17 +168,19 @@ bool LayeredGrid::_insideGrid(const CoordType &coords, DimsType &indices, double
 
     // Find k index of cell containing z. Already know i and j indices
     //
-    vector<double> zcoords;
-
+    // Interpolate Z coordinate across triangle, one vertex column at a
+    // time. The sum is accumulated in double precision, in the same order
+    // as the expression
+    // z(v0) * lambda[0] + z(v1) * lambda[1] + z(v2) * lambda[2], and
+    // rounded to float.
+    //
     size_t nz = GetDimensions()[2];
-    zcoords.reserve(nz);
-    for (int kk = 0; kk < nz; kk++) {
-        // Interpolate Z coordinate across triangle
-        //
-        float zk = _zrg.AccessIJK(iv[0], jv[0], kk) * lambda[0] + _zrg.AccessIJK(iv[1], jv[1], kk) * lambda[1] + _zrg.AccessIJK(iv[2], jv[2], kk) * lambda[2];
-
-        zcoords.push_back(zk);
+    zcoords.assign(nz, 0.0);
+    for (int v = 0; v < 3; v++) {
+        size_t kk = 0;
+        _zrg.ForEachSpan(DimsType{iv[v], jv[v], 0}, DimsType{iv[v], jv[v], nz - 1}, [&](const float *values, size_t, const DimsType &) { zcoords[kk++] += values[0] * lambda[v]; });
     }
+    for (size_t kk = 0; kk < nz; kk++) zcoords[kk] = (float)zcoords[kk];
 
     if (!Wasp::BinarySearchRange(zcoords, coords[2], indices[2])) return (false);
 
@@ -185,27 +193,39 @@ bool LayeredGrid::_insideGrid(const CoordType &coords, DimsType &indices, double
 }
 
 float LayeredGrid::GetValueNearestNeighbor(const CoordType &coords) const
+{
+    vector<double> zcoords;
+    return (_getValueNearestNeighbor(coords, zcoords));
+}
+
+float LayeredGrid::_getValueNearestNeighbor(const CoordType &coords, vector<double> &zcoords) const
 {
     DimsType indices;
     double   wgts[3];
-    bool     found = _insideGrid(coords, indices, wgts);
+    bool     found = _insideGrid(coords, indices, wgts, zcoords);
     if (!found) return (GetMissingValue());
 
     if (wgts[0] < 0.5) indices[0] += 1;
     if (wgts[1] < 0.5) indices[1] += 1;
     if (wgts[2] < 0.5) indices[2] += 1;
 
-    return (AccessIJK(indices[0], indices[1], indices[2]));
+    return (AccessIJKFast(indices[0], indices[1], indices[2]));
 }
 
 float LayeredGrid::GetValueLinear(const CoordType &coords) const
+{
+    vector<double> zcoords;
+    return (_getValueLinear(coords, zcoords));
+}
+
+float LayeredGrid::_getValueLinear(const CoordType &coords, vector<double> &zcoords) const
 {
     DimsType indices;
     double   wgts[3];
-    bool     found = _insideGrid(coords, indices, wgts);
+    bool     found = _insideGrid(coords, indices, wgts, zcoords);
     if (!found) return (GetMissingValue());
 
-    return (TrilinearInterpolate(indices[0], indices[1], indices[2], wgts[0], wgts[1], wgts[2]));
+    return (TrilinearInterpolateFast(indices[0], indices[1], indices[2], wgts[0], wgts[1], wgts[2]));
 }
 
 float LayeredGrid::GetValue(const CoordType &coords) const
@@ -233,6 +253,38 @@ float LayeredGrid::GetValue(const CoordType &coords) const
     return _getValueQuadratic(cCoords.data());
 }
 
+void LayeredGrid::GetValues(const double *xyz, size_t n, float *values) const
+{
+    // Quadratic interpolation is left to the general method
+    //
+    int interp_order = _interpolationOrder;
+    if (interp_order == 2 && GetDimensions()[2] < 3) interp_order = 1;
+    if (interp_order > 1) {
+        Grid::GetValues(xyz, n, values);
+        return;
+    }
+
+#pragma omp parallel
+    {
+        // Z coordinates of the column of cells searched, reused by all of
+        // the points handled by a thread
+        //
+        vector<double> zcoords;
+
+#pragma omp for schedule(dynamic, 256)
+        for (long p = 0; p < (long)n; p++) {
+            CoordType coords = {xyz[3 * p], xyz[3 * p + 1], xyz[3 * p + 2]};
+            CoordType cCoords;
+            ClampCoord(coords, cCoords);
+
+            if (interp_order == 0)
+                values[p] = _getValueNearestNeighbor(cCoords, zcoords);
+            else
+                values[p] = _getValueLinear(cCoords, zcoords);
+        }
+    }
+}
+
 void LayeredGrid::SetInterpolationOrder(int order)
 {
     if (order < 0 || order > 3) order = 2;
@@ -1,13 +1,58 @@
 #define ACCEPT_USE_OF_DEPRECATED_PROJ_API_H 1
 
 #include <iostream>
+#include <algorithm>
 #include <proj_api.h>
+#include <vapor/OpenMPSupport.h>
 #include <vapor/ResourcePath.h>
 #include <vapor/Proj4API.h>
 
 using namespace VAPoR;
 using namespace Wasp;
 
+namespace {
+
+// The float interface converts points to double precision in chunks of
+// this many, using buffers on the stack
+//
+const size_t chunkSize = 1024;
+
+// Don't split a transformation across threads below this many points.
+// Each thread must initialize its own copy of the projections
+//
+const size_t minParallelSize = 64 * chunkSize;
+
+// Transform up to chunkSize points in place. Returns the pj_transform()
+// error code
+//
+int transformChunk(projPJ pjSrc, projPJ pjDst, float *x, float *y, float *z, size_t n, int offset)
+{
+    double xd[chunkSize], yd[chunkSize], zd[chunkSize];
+
+    // Geographic coordinates are in degrees, proj4 wants radians
+    //
+    double inScale = pj_is_latlong(pjSrc) ? DEG_TO_RAD : 1.0;
+    double outScale = pj_is_latlong(pjDst) ? RAD_TO_DEG : 1.0;
+
+    for (size_t i = 0; i < n; i++) {
+        if (x) xd[i] = x[i * offset] * inScale;
+        if (y) yd[i] = y[i * offset] * inScale;
+        if (z) zd[i] = z[i * offset] * inScale;
+    }
+
+    int rc = pj_transform(pjSrc, pjDst, n, 1, x ? xd : NULL, y ? yd : NULL, NULL);
+    if (rc != 0) return (rc);
+
+    for (size_t i = 0; i < n; i++) {
+        if (x) x[i * offset] = xd[i] * outScale;
+        if (y) y[i * offset] = yd[i] * outScale;
+        if (z) z[i * offset] = zd[i] * outScale;
+    }
+    return (0);
+}
+
+};    // namespace
+
 Proj4API::Proj4API()
 {
     _pjSrc = NULL;
@@ -180,38 +225,67 @@ int Proj4API::Transform(float *x, float *y, size_t n, int offset) const { return
 
 int Proj4API::_Transform(void *pjSrc, void *pjDst, float *x, float *y, float *z, size_t n, int offset) const
 {
-    double *xd = NULL;
-    double *yd = NULL;
-    double *zd = NULL;
+    // no-op
+    //
+    if (pjSrc == NULL || pjDst == NULL) return (0);
 
-    if (x) {
-        xd = new double[n];
-        for (size_t i = 0; i < n; i++) xd[i] = x[i * offset];
-    }
-    if (y) {
-        yd = new double[n];
-        for (size_t i = 0; i < n; i++) yd[i] = y[i * offset];
-    }
-    if (z) {
-        zd = new double[n];
-        for (size_t i = 0; i < n; i++) zd[i] = z[i * offset];
+    long nchunks = (n + chunkSize - 1) / chunkSize;
+
+    if (n < minParallelSize || omp_get_max_threads() < 2) {
+        for (long c = 0; c < nchunks; c++) {
+            size_t first = c * chunkSize;
+            size_t m = std::min(chunkSize, n - first);
+            int    rc = transformChunk(pjSrc, pjDst, x ? x + first * offset : NULL, y ? y + first * offset : NULL, z ? z + first * offset : NULL, m, offset);
+            if (rc != 0) {
+                SetErrMsg("pj_transform() : %s", pj_strerrno(rc));
+                return (-1);
+            }
+        }
+        return (0);
     }
 
-    int rc = _Transform(pjSrc, pjDst, xd, yd, zd, n, 1);
+    // A projPJ may only be used by one thread at a time, so each thread
+    // makes its own copies of the projections, in its own proj4 context
+    //
+    char *srcdef = pj_get_def(pjSrc, 0);
+    char *dstdef = pj_get_def(pjDst, 0);
 
-    if (xd) {
-        for (size_t i = 0; i < n; i++) x[i * offset] = xd[i];
-        delete[] xd;
-    }
-    if (yd) {
-        for (size_t i = 0; i < n; i++) y[i * offset] = yd[i];
-        delete[] yd;
+    int err = 0;
+#pragma omp parallel
+    {
+        projCtx ctx = pj_ctx_alloc();
+        projPJ  src = pj_init_plus_ctx(ctx, srcdef);
+        projPJ  dst = pj_init_plus_ctx(ctx, dstdef);
+
+        int myerr = (src && dst) ? 0 : pj_ctx_get_errno(ctx);
+
+#pragma omp for schedule(dynamic, 4)
+        for (long c = 0; c < nchunks; c++) {
+            if (myerr != 0) continue;
+
+            size_t first = c * chunkSize;
+            size_t m = std::min(chunkSize, n - first);
+            myerr = transformChunk(src, dst, x ? x + first * offset : NULL, y ? y + first * offset : NULL, z ? z + first * offset : NULL, m, offset);
+        }
+
+        if (myerr != 0) {
+#pragma omp critical
+            err = myerr;
+        }
+
+        if (src) pj_free(src);
+        if (dst) pj_free(dst);
+        pj_ctx_free(ctx);
     }
-    if (zd) {
-        for (size_t i = 0; i < n; i++) z[i * offset] = zd[i];
-        delete[] zd;
+
+    pj_dalloc(srcdef);
+    pj_dalloc(dstdef);
+
+    if (err != 0) {
+        SetErrMsg("pj_transform() : %s", pj_strerrno(err));
+        return (-1);
     }
-    return (rc);
+    return (0);
 }
 
 int Proj4API::Transform(float *x, float *y, float *z, size_t n, int offset) const { return (Proj4API::_Transform(_pjSrc, _pjDst, x, y, z, n, offset)); }
@@ -18,7 +18,7 @@ PythonDataMgr::PythonDataMgr(string format, size_t mem_size, int nthreads)
 
 PythonDataMgr::~PythonDataMgr() {}
 
-void PythonDataMgr::AddRegularData(string name, const float *buf, vector<int> dimLens)
+void PythonDataMgr::AddRegularData(string name, const float *buf, vector<int> dimLens, bool copy)
 {
     auto dcr = GetDC();
     
@@ -85,7 +85,10 @@ void PythonDataMgr::AddRegularData(string name, const float *buf, vector<int> di
     vector<bool> periodic(dims.size(), false);
     auto v = DC::DataVar(name, "", DC::FLOAT, periodic, mesh.GetName(), /*timeCoordVar*/"", DC::Mesh::NODE);
     
-    dcr->AddDataVar(v, buf);
+    if (copy)
+        dcr->AddDataVar(v, buf);
+    else
+        dcr->AddDataVarRef(v, buf);
     ClearCache(name);
 }
 
@@ -99,6 +102,7 @@ DCRAM *PythonDataMgr::GetDC() const
 void PythonDataMgr::ClearCache(string varname)
 {
 //    printf("%s(%s)\n", __func__, varname.c_str());
+    std::lock_guard<Mutex> guard(_mutex);
     _free_var(varname);
     _dataVarNamesCache.clear();
 }
@@ -1,4 +1,5 @@
 #include <iostream>
+#include <algorithm>
 #include <vapor/VAssert.h>
 #include <vapor/utils.h>
 #include <cstdint>
@@ -11,6 +12,18 @@ using namespace std;
 using UInt32_tArr2 = std::array<uint32_t, 2>;
 using pType = UInt32_tArr2;
 
+namespace {
+
+// Leading bytes of a serialized tree. The version must be bumped
+// whenever the layout written by Write() changes. The byte order mark
+// catches trees written on a host with a different endianness.
+//
+const char     fileMagic[] = {'V', 'Q', 'T', 'R'};
+const uint32_t fileVersion = 1;
+const uint32_t byteOrderMark = 0x01020304;
+
+};    // namespace
+
 QuadTreeRectangleP::QuadTreeRectangleP(float left, float top, float right, float bottom, size_t max_depth, size_t reserve_size) : _left(left), _right(right)
 {
     VAssert(left <= right);
@@ -295,3 +308,57 @@ void QuadTreeRectangleP::GetStats(std::vector<size_t> &payload_histo, std::vecto
         level_histo.insert(level_histo.end(), l.begin(), l.end());
     }
 }
+
+bool QuadTreeRectangleP::Write(std::ostream &os) const
+{
+    uint32_t nbins = _qtrs.size();
+
+    os.write(fileMagic, sizeof(fileMagic));
+    os.write((const char *)&fileVersion, sizeof(fileVersion));
+    os.write((const char *)&byteOrderMark, sizeof(byteOrderMark));
+    os.write((const char *)&_left, sizeof(_left));
+    os.write((const char *)&_right, sizeof(_right));
+    os.write((const char *)&nbins, sizeof(nbins));
+
+    for (size_t i = 0; i < _qtrs.size() && os; i++) { _qtrs[i]->Write(os); }
+    return ((bool)os);
+}
+
+bool QuadTreeRectangleP::Read(std::istream &is)
+{
+    char     magic[sizeof(fileMagic)];
+    uint32_t version, bom, nbins;
+    float    left, right;
+
+    is.read(magic, sizeof(magic));
+    is.read((char *)&version, sizeof(version));
+    is.read((char *)&bom, sizeof(bom));
+    if (!is || !std::equal(magic, magic + sizeof(magic), fileMagic) || version != fileVersion || bom != byteOrderMark) return (false);
+
+    is.read((char *)&left, sizeof(left));
+    is.read((char *)&right, sizeof(right));
+    is.read((char *)&nbins, sizeof(nbins));
+    if (!is || nbins == 0 || !(left <= right)) return (false);
+
+    // Find the length of the stream once, rather than for every node
+    //
+    uint64_t nbytes = QuadTreeRectangle<float, pType>::BytesRemaining(is);
+
+    vector<QuadTreeRectangle<float, pType> *> qtrs;
+    for (uint32_t i = 0; i < nbins; i++) {
+        QuadTreeRectangle<float, pType> *qtr = new QuadTreeRectangle<float, pType>();
+        qtrs.push_back(qtr);
+        if (!qtr->Read(is, nbytes)) {
+            for (size_t j = 0; j < qtrs.size(); j++) delete qtrs[j];
+            return (false);
+        }
+    }
+
+    for (size_t i = 0; i < _qtrs.size(); i++) {
+        if (_qtrs[i]) delete _qtrs[i];
+    }
+    _qtrs = qtrs;
+    _left = left;
+    _right = right;
+    return (true);
+}
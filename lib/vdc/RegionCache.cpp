@@ -0,0 +1,192 @@
+#include <functional>
+#include "vapor/VAssert.h"
+#include <vapor/RegionCache.h>
+
+using namespace VAPoR;
+
+namespace {
+
+inline void hash_combine(size_t &seed, size_t v) { seed ^= v + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2); }
+
+};    // namespace
+
+size_t RegionCache::KeyHash::operator()(const Key &k) const
+{
+    size_t seed = std::hash<std::string>()(k.varname);
+    hash_combine(seed, std::hash<size_t>()(k.ts));
+    hash_combine(seed, std::hash<int>()(k.level));
+    hash_combine(seed, std::hash<int>()(k.lod));
+    for (int i = 0; i < k.bmin.size(); i++) {
+        hash_combine(seed, std::hash<size_t>()(k.bmin[i]));
+        hash_combine(seed, std::hash<size_t>()(k.bmax[i]));
+    }
+    return (seed);
+}
+
+RegionCache::RegionCache() {}
+
+RegionCache::~RegionCache() {}
+
+void *RegionCache::Find(const Key &key, bool lock, bool *prefetched)
+{
+    if (prefetched) *prefetched = false;
+
+    auto mitr = _byKey.find(key);
+    if (mitr == _byKey.end()) return (NULL);
+
+    region_itr_t itr = mitr->second;
+
+    if (prefetched) {
+        *prefetched = itr->prefetched;
+        itr->prefetched = false;
+    }
+
+    if (itr->lock_counter > 0) {
+        if (lock) itr->lock_counter++;
+    } else if (lock) {
+        itr->lock_counter = 1;
+        _locked.splice(_locked.end(), _lru, itr);
+    } else {
+        // Move region to the most recently used end of the list
+        //
+        _lru.splice(_lru.end(), _lru, itr);
+    }
+
+    return (itr->blks);
+}
+
+void RegionCache::Insert(const Key &key, void *blks, bool lock, bool prefetched)
+{
+    VAssert(blks);
+    VAssert(_byKey.find(key) == _byKey.end());
+    VAssert(_byBlks.find(blks) == _byBlks.end());
+
+    region_t region;
+    region.key = key;
+    region.lock_counter = lock ? 1 : 0;
+    region.prefetched = prefetched;
+    region.blks = blks;
+
+    std::list<region_t> &l = lock ? _locked : _lru;
+    region_itr_t         itr = l.insert(l.end(), region);
+
+    _byKey[key] = itr;
+    _byBlks[blks] = itr;
+    _byVar[key.varname].insert(blks);
+    _byTimeStep[key.ts].insert(blks);
+}
+
+void *RegionCache::Remove(const Key &key, bool force)
+{
+    auto mitr = _byKey.find(key);
+    if (mitr == _byKey.end()) return (NULL);
+
+    region_itr_t itr = mitr->second;
+    if (itr->lock_counter > 0 && !force) return (NULL);
+
+    void *blks = itr->blks;
+    _erase(itr);
+    return (blks);
+}
+
+bool RegionCache::Unlock(const void *blks)
+{
+    auto mitr = _byBlks.find(blks);
+    if (mitr == _byBlks.end()) return (false);
+
+    region_itr_t itr = mitr->second;
+    if (itr->lock_counter < 1) return (false);
+
+    itr->lock_counter--;
+
+    // Last lock released. Region becomes eligible for eviction as the
+    // most recently used region.
+    //
+    if (itr->lock_counter == 0) { _lru.splice(_lru.end(), _locked, itr); }
+
+    return (true);
+}
+
+void *RegionCache::EvictLRU()
+{
+    if (_lru.empty()) return (NULL);
+
+    void *blks = _lru.front().blks;
+    _erase(_lru.begin());
+    return (blks);
+}
+
+void *RegionCache::EvictLRU(const std::function<bool(const Key &)> &evictable)
+{
+    for (auto itr = _lru.begin(); itr != _lru.end(); ++itr) {
+        if (!evictable(itr->key)) continue;
+
+        void *blks = itr->blks;
+        _erase(itr);
+        return (blks);
+    }
+    return (NULL);
+}
+
+void RegionCache::RemoveVar(const std::string &varname, std::vector<void *> &blks)
+{
+    auto mitr = _byVar.find(varname);
+    if (mitr == _byVar.end()) return;
+
+    _removeBlks(std::vector<void *>(mitr->second.begin(), mitr->second.end()), blks);
+}
+
+void RegionCache::RemoveTimeStep(size_t ts, std::vector<void *> &blks)
+{
+    auto mitr = _byTimeStep.find(ts);
+    if (mitr == _byTimeStep.end()) return;
+
+    _removeBlks(std::vector<void *>(mitr->second.begin(), mitr->second.end()), blks);
+}
+
+void RegionCache::Clear(std::vector<void *> &blks)
+{
+    for (const auto &r : _lru) blks.push_back(r.blks);
+    for (const auto &r : _locked) blks.push_back(r.blks);
+
+    _lru.clear();
+    _locked.clear();
+    _byKey.clear();
+    _byBlks.clear();
+    _byVar.clear();
+    _byTimeStep.clear();
+}
+
+void RegionCache::_removeBlks(const std::vector<void *> &victims, std::vector<void *> &blks)
+{
+    for (auto b : victims) {
+        auto mitr = _byBlks.find(b);
+        VAssert(mitr != _byBlks.end());
+        _erase(mitr->second);
+        blks.push_back(b);
+    }
+}
+
+void RegionCache::_erase(region_itr_t itr)
+{
+    const Key &key = itr->key;
+    void *     blks = itr->blks;
+
+    auto vitr = _byVar.find(key.varname);
+    VAssert(vitr != _byVar.end());
+    vitr->second.erase(blks);
+    if (vitr->second.empty()) _byVar.erase(vitr);
+
+    auto titr = _byTimeStep.find(key.ts);
+    VAssert(titr != _byTimeStep.end());
+    titr->second.erase(blks);
+    if (titr->second.empty()) _byTimeStep.erase(titr);
+
+    _byBlks.erase(blks);
+    _byKey.erase(key);
+
+    if (itr->lock_counter > 0)
+        _locked.erase(itr);
+    else
+        _lru.erase(itr);
+}
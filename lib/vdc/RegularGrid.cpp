@@ -12,7 +12,9 @@
     #include <limits>
 #endif
 
+#include <algorithm>
 #include <vapor/utils.h>
+#include <vapor/OpenMPSupport.h>
 #include "vapor/RegularGrid.h"
 
 using namespace std;
@@ -87,6 +89,11 @@ float RegularGrid::GetValueNearestNeighbor(const CoordType &coords) const
 
     if (!InsideGrid(cCoords)) return (GetMissingValue());
 
+    return (_getValueNearestNeighbor(cCoords));
+}
+
+float RegularGrid::_getValueNearestNeighbor(const CoordType &cCoords) const
+{
     size_t i = 0;
     size_t j = 0;
     size_t k = 0;
@@ -122,7 +129,7 @@ float RegularGrid::GetValueNearestNeighbor(const CoordType &coords) const
     if (GetNumDimensions() == 3 && kwgt > 0.5) k++;
 
 
-    return (AccessIJK(i, j, k));
+    return (AccessIJKFast(i, j, k));
 }
 
 float RegularGrid::GetValueLinear(const CoordType &coords) const
@@ -133,6 +140,11 @@ float RegularGrid::GetValueLinear(const CoordType &coords) const
     float mv = GetMissingValue();
     if (!InsideGrid(cCoords)) return (mv);
 
+    return (_getValueLinear(cCoords));
+}
+
+float RegularGrid::_getValueLinear(const CoordType &cCoords) const
+{
     size_t i = 0;
     size_t j = 0;
     size_t k = 0;
@@ -154,7 +166,35 @@ float RegularGrid::GetValueLinear(const CoordType &coords) const
     if (_delta[1] != 0.0) { ywgt = 1.0 - (((cCoords[1] - _minu[1]) - (j * _delta[1])) / _delta[1]); }
     if (_delta[2] != 0.0) { zwgt = 1.0 - (((cCoords[2] - _minu[2]) - (k * _delta[2])) / _delta[2]); }
 
-    return (TrilinearInterpolate(i, j, k, xwgt, ywgt, zwgt));
+    return (TrilinearInterpolateFast(i, j, k, xwgt, ywgt, zwgt));
+}
+
+void RegularGrid::GetValues(const double *xyz, size_t n, float *values) const
+{
+    // Coordinates on periodic boundaries need clamping, which is left to
+    // the general method
+    //
+    const vector<bool> &periodic = GetPeriodic();
+    if (!GetBlks().size() || std::find(periodic.begin(), periodic.end(), true) != periodic.end()) {
+        Grid::GetValues(xyz, n, values);
+        return;
+    }
+
+    const float mv = GetMissingValue();
+    const bool  linear = GetInterpolationOrder() != 0;
+    const bool  is3D = GetGeometryDim() == 3;
+
+#pragma omp parallel for schedule(dynamic, 1024) if (n > 1024)
+    for (long p = 0; p < (long)n; p++) {
+        CoordType coords = {xyz[3 * p], xyz[3 * p + 1], is3D ? xyz[3 * p + 2] : 0.0};
+
+        if (!_insideGrid(coords))
+            values[p] = mv;
+        else if (linear)
+            values[p] = _getValueLinear(coords);
+        else
+            values[p] = _getValueNearestNeighbor(coords);
+    }
 }
 
 void RegularGrid::GetUserExtentsHelper(CoordType &minu, CoordType &maxu) const
@@ -227,6 +267,11 @@ bool RegularGrid::InsideGrid(const CoordType &coords) const
     CoordType cCoords;
     ClampCoord(coords, cCoords);
 
+    return (_insideGrid(cCoords));
+}
+
+bool RegularGrid::_insideGrid(const CoordType &cCoords) const
+{
     VAssert(GetGeometryDim() <= 3);
     for (int i = 0; i < GetGeometryDim(); i++) {
         if (cCoords[i] < _minu[i]) return (false);
@@ -3,7 +3,9 @@
 #include "vapor/VAssert.h"
 #include <cmath>
 #include <cfloat>
+#include <algorithm>
 #include <vapor/utils.h>
+#include <vapor/OpenMPSupport.h>
 #include <vapor/StretchedGrid.h>
 #include <vapor/KDTreeRG.h>
 #include <vapor/vizutil.h>
@@ -242,6 +244,11 @@ float StretchedGrid::GetValueNearestNeighbor(const CoordType &coords) const
     CoordType cCoords;
     ClampCoord(coords, cCoords);
 
+    return (_getValueNearestNeighbor(cCoords));
+}
+
+float StretchedGrid::_getValueNearestNeighbor(const CoordType &cCoords) const
+{
     double wgts[] = {0.0, 0.0, 0.0};
     size_t i, j, k;
     double x = cCoords[0];
@@ -255,7 +262,7 @@ float StretchedGrid::GetValueNearestNeighbor(const CoordType &coords) const
 
     if (!inside) return (GetMissingValue());
 
-    return (AccessIJK(i, j, k));
+    return (AccessIJKFast(i, j, k));
 }
 
 float StretchedGrid::GetValueLinear(const CoordType &coords) const
@@ -265,6 +272,11 @@ float StretchedGrid::GetValueLinear(const CoordType &coords) const
     CoordType cCoords;
     ClampCoord(coords, cCoords);
 
+    return (_getValueLinear(cCoords));
+}
+
+float StretchedGrid::_getValueLinear(const CoordType &cCoords) const
+{
     // handlese case where grid is 2D. I.e. if 2d then zwgt[0] == 1 &&
     // zwgt[1] = 0.0
     //
@@ -279,7 +291,28 @@ float StretchedGrid::GetValueLinear(const CoordType &coords) const
     float mv = GetMissingValue();
     if (!inside) return (mv);
 
-    return (TrilinearInterpolate(i, j, k, wgts[0], wgts[1], wgts[2]));
+    return (TrilinearInterpolateFast(i, j, k, wgts[0], wgts[1], wgts[2]));
+}
+
+void StretchedGrid::GetValues(const double *xyz, size_t n, float *values) const
+{
+    // Coordinates on periodic boundaries need clamping, which is left to
+    // the general method
+    //
+    const vector<bool> &periodic = GetPeriodic();
+    if (!GetBlks().size() || std::find(periodic.begin(), periodic.end(), true) != periodic.end()) {
+        Grid::GetValues(xyz, n, values);
+        return;
+    }
+
+    const bool linear = GetInterpolationOrder() != 0;
+
+#pragma omp parallel for schedule(dynamic, 1024) if (n > 1024)
+    for (long p = 0; p < (long)n; p++) {
+        CoordType coords = {xyz[3 * p], xyz[3 * p + 1], xyz[3 * p + 2]};
+
+        values[p] = linear ? _getValueLinear(coords) : _getValueNearestNeighbor(coords);
+    }
 }
 
 void StretchedGrid::GetUserExtentsHelper(CoordType &minext, CoordType &maxext) const
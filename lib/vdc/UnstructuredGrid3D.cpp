@@ -1,5 +1,7 @@
 #include <iostream>
 #include <vector>
+#include <algorithm>
+#include <limits>
 #include "vapor/VAssert.h"
 #include <cmath>
 #include <time.h>
@@ -15,6 +17,7 @@
 #include <vapor/utils.h>
 #include <vapor/vizutil.h>
 #include <vapor/UnstructuredGrid3D.h>
+#include <vapor/OpenMPSupport.h>
 
 using namespace std;
 using namespace VAPoR;
@@ -23,30 +26,40 @@ UnstructuredGrid3D::UnstructuredGrid3D(const DimsType &vertexDims, const DimsTyp
                                        const int *faceOnVertex, const int *faceOnFace,
                                        Location location,    // node,face, edge
                                        size_t maxVertexPerFace, size_t maxFacePerVertex, long nodeOffset, long cellOffset, const UnstructuredGridCoordless &xug, const UnstructuredGridCoordless &yug,
-                                       const UnstructuredGridCoordless &zug)
+                                       const UnstructuredGridCoordless &zug, std::shared_ptr<const CellBVH> bvh)
 : UnstructuredGrid(vertexDims, faceDims, edgeDims, bs, blks, 3, vertexOnFace, faceOnVertex, faceOnFace, location, maxVertexPerFace, maxFacePerVertex, nodeOffset, cellOffset), _xug(xug), _yug(yug),
-  _zug(zug)
+  _zug(zug), _bvh(bvh)
 {
     VAssert(xug.GetNumDimensions() == 1);
     VAssert(yug.GetNumDimensions() == 1);
     VAssert(zug.GetNumDimensions() == 1);
 
     VAssert(location == NODE);
+
+    // Cells with fewer than four nodes (e.g. particles) have no volume,
+    // so there is nothing to search
+    //
+    if (!_bvh && _maxVertexPerFace >= 4) { _bvh = _makeCellBVH(); }
 }
 
 UnstructuredGrid3D::UnstructuredGrid3D(const std::vector<size_t> &vertexDims, const std::vector<size_t> &faceDims, const std::vector<size_t> &edgeDims, const std::vector<size_t> &bs,
                                        const std::vector<float *> &blks, const int *vertexOnFace, const int *faceOnVertex, const int *faceOnFace,
                                        Location location,    // node,face, edge
                                        size_t maxVertexPerFace, size_t maxFacePerVertex, long nodeOffset, long cellOffset, const UnstructuredGridCoordless &xug, const UnstructuredGridCoordless &yug,
-                                       const UnstructuredGridCoordless &zug)
+                                       const UnstructuredGridCoordless &zug, std::shared_ptr<const CellBVH> bvh)
 : UnstructuredGrid(vertexDims, faceDims, edgeDims, bs, blks, 3, vertexOnFace, faceOnVertex, faceOnFace, location, maxVertexPerFace, maxFacePerVertex, nodeOffset, cellOffset), _xug(xug), _yug(yug),
-  _zug(zug)
+  _zug(zug), _bvh(bvh)
 {
     VAssert(xug.GetNumDimensions() == 1);
     VAssert(yug.GetNumDimensions() == 1);
     VAssert(zug.GetNumDimensions() == 1);
 
     VAssert(location == NODE);
+
+    // Cells with fewer than four nodes (e.g. particles) have no volume,
+    // so there is nothing to search
+    //
+    if (!_bvh && _maxVertexPerFace >= 4) { _bvh = _makeCellBVH(); }
 }
 
 
@@ -131,43 +144,215 @@ void UnstructuredGrid3D::GetUserCoordinates(const DimsType &indices, CoordType &
 
 bool UnstructuredGrid3D::GetIndicesCell(const CoordType &coords, DimsType &indices) const
 {
-    vector<size_t> nodes2D;
-    vector<double> lambda;
-    float          zwgt[2];
+    CoordType cCoords;
+    ClampCoord(coords, cCoords);
+
+    double         lambda[8];
+    int            nlambda;
+    size_t         cell;
+    vector<size_t> nodes;
 
-    return (_insideGrid(coords, indices, nodes2D, lambda, zwgt));
+    bool status = _insideGrid(cCoords, cell, nodes, lambda, nlambda);
+    if (status) indices[0] = cell;
+
+    return (status);
 }
 
 
 bool UnstructuredGrid3D::InsideGrid(const CoordType &coords) const
 {
-    DimsType            indices;
-    std::vector<size_t> nodes2D;
-    vector<double>      lambda;
-    float               zwgt[2];
+    CoordType cCoords;
+    ClampCoord(coords, cCoords);
+
+    double         lambda[8];
+    int            nlambda;
+    size_t         cell;
+    vector<size_t> nodes;
 
-    return (_insideGrid(coords, indices, nodes2D, lambda, zwgt));
+    return (_insideGrid(cCoords, cell, nodes, lambda, nlambda));
 }
 
 
-bool UnstructuredGrid3D::_insideGrid(const CoordType &coords, DimsType &cindices, std::vector<size_t> &nodes2D, std::vector<double> &lambda, float zwgt[2]) const
+// Search for the cell containing a point. If the point is inside return
+// true, and provide the nodes of the cell and their interpolation weights
+//
+bool UnstructuredGrid3D::_insideGrid(const CoordType &coords, size_t &cell, std::vector<size_t> &nodes, double *lambda, int &nlambda) const
 {
-    VAssert(!"Not implemented");
-    return false;
+    if (!_bvh) return (false);
+
+    return (_bvh->Find(coords, [&](size_t c) {
+        if (!_insideCell(c, coords, nodes, lambda, nlambda)) return (false);
+        cell = c;
+        return (true);
+    }));
+}
+
+
+bool UnstructuredGrid3D::_insideCell(size_t cell, const CoordType &coords, std::vector<size_t> &nodes, double *lambda, int &nlambda) const
+{
+    nodes.clear();
+    nlambda = 0;
+
+    double verts[8 * 3];
+
+    const int *ptr = _vertexOnFace + (cell * _maxVertexPerFace);
+    long       offset = GetNodeOffset();
+
+    for (int i = 0; i < _maxVertexPerFace; i++, ptr++) {
+        if (*ptr == GetMissingID()) break;
+
+        long vertex = *ptr + offset;
+        if (vertex < 0) break;
+
+        // Only tetrahedra and hexahedra are supported
+        //
+        if (nlambda == 8) return (false);
+
+        verts[nlambda * 3 + 0] = _xug.AccessIJK(vertex, 0, 0);
+        verts[nlambda * 3 + 1] = _yug.AccessIJK(vertex, 0, 0);
+        verts[nlambda * 3 + 2] = _zug.AccessIJK(vertex, 0, 0);
+        nodes.push_back(vertex);
+        nlambda++;
+    }
+
+    if (nlambda != 4 && nlambda != 8) return (false);
+
+    // Cheap rejection before solving for the interpolation weights
+    //
+    for (int d = 0; d < 3; d++) {
+        double min = verts[d];
+        double max = verts[d];
+        for (int i = 1; i < nlambda; i++) {
+            min = std::min(min, verts[i * 3 + d]);
+            max = std::max(max, verts[i * 3 + d]);
+        }
+        if (coords[d] < min || coords[d] > max) return (false);
+    }
+
+    if (nlambda == 4) return (BarycentricCoordsTet(verts, coords.data(), lambda));
+
+    return (TrilinearCoordsHex(verts, coords.data(), lambda));
 }
 
 
 float UnstructuredGrid3D::GetValueNearestNeighbor(const CoordType &coords) const
 {
-    VAssert(!"Not implemented");
-    return NAN;
+    // Clamp coordinates on periodic boundaries to reside within the
+    // grid extents
+    //
+    CoordType cCoords;
+    ClampCoord(coords, cCoords);
+
+    double         lambda[8];
+    int            nlambda;
+    size_t         cell;
+    vector<size_t> nodes;
+
+    bool inside = _insideGrid(cCoords, cell, nodes, lambda, nlambda);
+
+    if (!inside) { return (GetMissingValue()); }
+    VAssert(nodes.size() == nlambda);
+
+    int maxindx = 0;
+    for (int i = 1; i < nlambda; i++) {
+        if (lambda[i] > lambda[maxindx]) maxindx = i;
+    }
+
+    return (AccessIJK(nodes[maxindx], 0, 0));
 }
 
 
 float UnstructuredGrid3D::GetValueLinear(const CoordType &coords) const
 {
-    VAssert(!"Not implemented");
-    return NAN;
+    // Clamp coordinates on periodic boundaries to reside within the
+    // grid extents
+    //
+    CoordType cCoords;
+    ClampCoord(coords, cCoords);
+
+    double         lambda[8];
+    int            nlambda;
+    size_t         cell;
+    vector<size_t> nodes;
+
+    bool inside = _insideGrid(cCoords, cell, nodes, lambda, nlambda);
+
+    if (!inside) { return (GetMissingValue()); }
+    VAssert(nodes.size() == nlambda);
+
+    double value = 0;
+    float  mv = GetMissingValue();
+    for (int i = 0; i < nodes.size(); i++) {
+        float v = AccessIJK(nodes[i], 0, 0);
+        if (v == mv) {
+            if (lambda[i] != 0.0)
+                return (mv);
+            else
+                v = 0.0;
+        }
+
+        value += v * lambda[i];
+    }
+
+    return ((float)value);
+}
+
+
+std::shared_ptr<CellBVH> UnstructuredGrid3D::_makeCellBVH() const
+{
+    // Gather the node coordinates once, rather than once per cell
+    // sharing the node
+    //
+    size_t        nnodes = _xug.GetDimensions()[0];
+    vector<float> x(nnodes), y(nnodes), z(nnodes);
+
+#pragma omp parallel for
+    for (long i = 0; i < (long)nnodes; i++) {
+        x[i] = _xug.AccessIJK(i, 0, 0);
+        y[i] = _yug.AccessIJK(i, 0, 0);
+        z[i] = _zug.AccessIJK(i, 0, 0);
+    }
+
+    // Bounding box of each cell. Cells of unsupported types are left
+    // empty, so that they are never searched
+    //
+    size_t        ncells = GetCellDimensions()[0];
+    vector<float> boxes(6 * ncells);
+    long          offset = GetNodeOffset();
+
+#pragma omp parallel for
+    for (long c = 0; c < (long)ncells; c++) {
+        float *box = &boxes[6 * c];
+        box[0] = box[1] = box[2] = std::numeric_limits<float>::max();
+        box[3] = box[4] = box[5] = std::numeric_limits<float>::lowest();
+
+        const int *ptr = _vertexOnFace + (c * _maxVertexPerFace);
+        int        n = 0;
+        for (int i = 0; i < _maxVertexPerFace; i++, ptr++) {
+            if (*ptr == GetMissingID()) break;
+
+            long vertex = *ptr + offset;
+            if (vertex < 0 || vertex >= (long)nnodes) break;
+
+            box[0] = std::min(box[0], x[vertex]);
+            box[1] = std::min(box[1], y[vertex]);
+            box[2] = std::min(box[2], z[vertex]);
+            box[3] = std::max(box[3], x[vertex]);
+            box[4] = std::max(box[4], y[vertex]);
+            box[5] = std::max(box[5], z[vertex]);
+            n++;
+        }
+
+        if (n != 4 && n != 8) {
+            box[0] = std::numeric_limits<float>::max();
+            box[3] = std::numeric_limits<float>::lowest();
+        }
+    }
+
+    std::shared_ptr<CellBVH> bvh = std::make_shared<CellBVH>();
+    bvh->Build(boxes.data(), ncells);
+
+    return (bvh);
 }
 
 
@@ -123,7 +123,7 @@ bool isblocked(vector<size_t> bs)
 
 };    // namespace
 
-VDCNetCDF::VDCNetCDF(int nthreads, size_t master_threshold, size_t variable_threshold) : VDC()
+VDCNetCDF::VDCNetCDF(int nthreads, size_t master_threshold, size_t variable_threshold) : VDC(), _readPool(nthreads, 16)
 {
     _nthreads = nthreads;
     _master_threshold = master_threshold;
@@ -375,13 +375,15 @@ WASP *VDCNetCDF::_OpenVariableRead(size_t ts, string varname, int clevel, int lo
     if (path.compare(_master_path) == 0) {
         wasp = _master;
     } else {
-        wasp = new WASP(_nthreads);
-        rc = wasp->Open(path, NC_NOWRITE);
-        if (rc < 0) return (NULL);
+        wasp = _readPool.Checkout(path);
+        if (!wasp) return (NULL);
     }
 
     rc = wasp->OpenVarRead(varname, clevel, lod);
-    if (rc < 0) return (NULL);
+    if (rc < 0) {
+        if (wasp != _master) _readPool.Return(wasp);
+        return (NULL);
+    }
 
     return (wasp);
 }
@@ -469,6 +471,10 @@ int VDCNetCDF::OpenVariableWrite(size_t ts, string varname, int lod)
 
     WASP *wasp = NULL;
 
+    // Handles open for reading would not see what is written
+    //
+    _readPool.Purge(path);
+
     if (path.compare(_master_path) == 0) {
         wasp = _master;
     } else if (_master->ValidFile(path)) {
@@ -536,14 +542,14 @@ int VDCNetCDF::closeVariable(int fd)
     WASP *wasp = o->GetWaspData();
 
     if (wasp) { wasp->CloseVar(); }
-    if (wasp && wasp != _master) {
+    if (wasp && wasp != _master && !_readPool.Return(wasp)) {
         wasp->Close();
         delete wasp;
     }
 
     WASP *wasp_mask = o->GetWaspMask();
     if (wasp_mask) { wasp_mask->CloseVar(); }
-    if (wasp_mask && wasp_mask != _master) {
+    if (wasp_mask && wasp_mask != _master && !_readPool.Return(wasp_mask)) {
         wasp_mask->Close();
         delete wasp_mask;
     }
@@ -554,6 +560,108 @@ int VDCNetCDF::closeVariable(int fd)
     return (0);
 }
 
+VDCNetCDF::WASPPool::~WASPPool()
+{
+    _evict(0);
+
+    // Handles still checked out belong to variables that were never
+    // closed.
+    //
+    for (auto &itr : _busy) {
+        itr.first->Close();
+        delete itr.first;
+    }
+}
+
+WASP *VDCNetCDF::WASPPool::Checkout(const string &path)
+{
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        for (auto itr = _idle.begin(); itr != _idle.end(); ++itr) {
+            if (itr->first != path) continue;
+
+            WASP *wasp = itr->second;
+            _idle.erase(itr);
+            _busy[wasp] = path;
+            return (wasp);
+        }
+    }
+
+    // Opening a file is slow, so don't hold the lock while doing so
+    //
+    WASP *wasp = new WASP(&_taskPool);
+    int   rc = wasp->Open(path, NC_NOWRITE);
+    if (rc < 0) {
+        delete wasp;
+        return (NULL);
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _busy[wasp] = path;
+    return (wasp);
+}
+
+bool VDCNetCDF::WASPPool::Return(WASP *wasp)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    auto itr = _busy.find(wasp);
+    if (itr == _busy.end()) return (false);
+
+    // The file changed while the handle was checked out, so the handle
+    // can't be reused
+    //
+    if (_purged.erase(wasp)) {
+        _busy.erase(itr);
+        wasp->Close();
+        delete wasp;
+        return (true);
+    }
+
+    _idle.push_front(std::make_pair(itr->second, wasp));
+    _busy.erase(itr);
+    _evict(_maxIdle);
+    return (true);
+}
+
+void VDCNetCDF::WASPPool::Purge(const string &path)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    for (auto itr = _idle.begin(); itr != _idle.end();) {
+        if (itr->first == path) {
+            itr->second->Close();
+            delete itr->second;
+            itr = _idle.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+
+    for (auto &itr : _busy) {
+        if (itr.second == path) _purged.insert(itr.first);
+    }
+}
+
+void VDCNetCDF::WASPPool::SetMaxIdle(size_t n)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _maxIdle = n;
+    _evict(_maxIdle);
+}
+
+// Close least recently used idle handles until no more than n remain.
+// Caller must hold _mutex, except from the destructor.
+//
+void VDCNetCDF::WASPPool::_evict(size_t n)
+{
+    while (_idle.size() > n) {
+        _idle.back().second->Close();
+        delete _idle.back().second;
+        _idle.pop_back();
+    }
+}
+
 unsigned char *VDCNetCDF::_read_mask_var(WASP *wasp, string varname, string varname_mask, vector<size_t> start, vector<size_t> count)
 {
     // data variable may be time varying, while mask variable is not.
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <limits>
@@ -8,6 +9,10 @@ namespace {
 
 double dot2d(const double a[], const double b[]) { return ((a[0] * b[0]) + (a[1] * b[1])); }
 
+// Scalar triple product, a . (b x c)
+//
+double triple(const double a[], const double b[], const double c[]) { return (a[0] * (b[1] * c[2] - b[2] * c[1]) + a[1] * (b[2] * c[0] - b[0] * c[2]) + a[2] * (b[0] * c[1] - b[1] * c[0])); }
+
 };    // namespace
 
 void VAPoR::HexahedronToTets(const int hexahedron[8], int tets[5 * 4])
@@ -195,6 +200,98 @@ bool VAPoR::BarycentricCoordsTri(const double verts[], const double pt[], double
     return (lambda[0] >= 0.0 && lambda[1] >= 0.0 && lambda[2] >= 0.0);
 }
 
+bool VAPoR::BarycentricCoordsTet(const double verts[], const double pt[], double lambda[])
+{
+    // Vectors from the first vertex to the remaining vertices and to the
+    // point
+    //
+    double v0[] = {verts[3] - verts[0], verts[4] - verts[1], verts[5] - verts[2]};
+    double v1[] = {verts[6] - verts[0], verts[7] - verts[1], verts[8] - verts[2]};
+    double v2[] = {verts[9] - verts[0], verts[10] - verts[1], verts[11] - verts[2]};
+    double vp[] = {pt[0] - verts[0], pt[1] - verts[1], pt[2] - verts[2]};
+
+    double det = triple(v0, v1, v2);
+    if (det == 0.0) return (false);
+
+    lambda[1] = triple(vp, v1, v2) / det;
+    lambda[2] = triple(v0, vp, v2) / det;
+    lambda[3] = triple(v0, v1, vp) / det;
+    lambda[0] = 1.0 - lambda[1] - lambda[2] - lambda[3];
+
+    const double epsilon = std::numeric_limits<double>::epsilon();
+    for (int i = 0; i < 4; i++) {
+        if ((lambda[i] < 0.0) && ((lambda[i] + epsilon) >= 0.0)) lambda[i] = 0.0;
+    }
+
+    return (lambda[0] >= 0.0 && lambda[1] >= 0.0 && lambda[2] >= 0.0 && lambda[3] >= 0.0);
+}
+
+bool VAPoR::TrilinearCoordsHex(const double verts[], const double pt[], double lambda[])
+{
+    const int    maxIter = 20;
+    const double tolerance = 1e-10;
+    const double epsilon = 1e-6;
+
+    // Parametric coordinates, starting from the center of the cell
+    //
+    double u[] = {0.5, 0.5, 0.5};
+
+    bool converged = false;
+    for (int iter = 0; iter < maxIter && !converged; iter++) {
+        // Residual of the trilinear mapping, and its Jacobian. Vertex
+        // i is at parametric coordinates (i & 1, (i >> 1) & 1, (i >> 2) & 1)
+        //
+        double r[] = {-pt[0], -pt[1], -pt[2]};
+        double du[3] = {0.0, 0.0, 0.0};
+        double dv[3] = {0.0, 0.0, 0.0};
+        double dw[3] = {0.0, 0.0, 0.0};
+        for (int i = 0; i < 8; i++) {
+            double a = (i & 1) ? u[0] : 1.0 - u[0];
+            double b = (i & 2) ? u[1] : 1.0 - u[1];
+            double c = (i & 4) ? u[2] : 1.0 - u[2];
+            double sa = (i & 1) ? 1.0 : -1.0;
+            double sb = (i & 2) ? 1.0 : -1.0;
+            double sc = (i & 4) ? 1.0 : -1.0;
+
+            for (int d = 0; d < 3; d++) {
+                double x = verts[i * 3 + d];
+                r[d] += a * b * c * x;
+                du[d] += sa * b * c * x;
+                dv[d] += a * sb * c * x;
+                dw[d] += a * b * sc * x;
+            }
+        }
+
+        // Solve J * delta = r with Cramer's rule
+        //
+        double det = triple(du, dv, dw);
+        if (det == 0.0) return (false);
+
+        double delta[] = {triple(r, dv, dw) / det, triple(du, r, dw) / det, triple(du, dv, r) / det};
+
+        u[0] -= delta[0];
+        u[1] -= delta[1];
+        u[2] -= delta[2];
+
+        converged = std::fabs(delta[0]) < tolerance && std::fabs(delta[1]) < tolerance && std::fabs(delta[2]) < tolerance;
+    }
+    if (!converged) return (false);
+
+    for (int d = 0; d < 3; d++) {
+        if (u[d] < -epsilon || u[d] > 1.0 + epsilon) return (false);
+        u[d] = std::min(std::max(u[d], 0.0), 1.0);
+    }
+
+    for (int i = 0; i < 8; i++) {
+        double a = (i & 1) ? u[0] : 1.0 - u[0];
+        double b = (i & 2) ? u[1] : 1.0 - u[1];
+        double c = (i & 4) ? u[2] : 1.0 - u[2];
+        lambda[i] = a * b * c;
+    }
+
+    return (true);
+}
+
 bool VAPoR::WachspressCoords2D(const double verts[], const double pt[], int n, double lambda[])
 {
     if (n == 0) return (false);
@@ -25,6 +25,7 @@ void Compressor::_Compressor(vector<size_t> dims)
     _L = NULL;
     _LLen = 0;
     _keepapp = true;
+    _partialsort = true;
     _clamp_min_flag = false;
     _clamp_max_flag = false;
     _epsilon_flag = false;
@@ -110,21 +111,105 @@ Compressor::~Compressor()
 }
 
 //
-// Comparision functions for the C++ Std Lib sort function
+// Comparision functions for the C++ Std Lib sort function. Coefficients
+// of equal magnitude are ordered by address so that the set of
+// coefficients selected for a given length is unique, regardless of the
+// selection algorithm used.
 //
-inline bool my_compare_f(const void *x1, const void *x2) { return (fabsf(*(float *)x1) > fabsf(*(float *)x2)); }
+inline bool my_compare_f(const void *x1, const void *x2)
+{
+    float a1 = fabsf(*(float *)x1), a2 = fabsf(*(float *)x2);
+    return (a1 > a2 || (a1 == a2 && x1 < x2));
+}
+
+inline bool my_compare_d(const void *x1, const void *x2)
+{
+    double a1 = fabs(*(double *)x1), a2 = fabs(*(double *)x2);
+    return (a1 > a2 || (a1 == a2 && x1 < x2));
+}
+
+inline bool my_compare_i(const void *x1, const void *x2)
+{
+    int a1 = abs(*(int *)x1), a2 = abs(*(int *)x2);
+    return (a1 > a2 || (a1 == a2 && x1 < x2));
+}
+
+inline bool my_compare_l(const void *x1, const void *x2)
+{
+    long a1 = labs(*(long *)x1), a2 = labs(*(long *)x2);
+    return (a1 > a2 || (a1 == a2 && x1 < x2));
+}
+
+namespace {
+
+//
+// Order the coefficient pointers in indexvec so that the first lens[0]
+// elements reference the lens[0] largest coefficients, the next lens[1]
+// elements reference the next lens[1] largest, and so on. Within each
+// collection the pointers are sorted by address. On entry indexvec must
+// reference contiguous coefficients in address order.
+//
+// If partialsort is true the collections are found by selection
+// (nth_element), and the per-collection address order is restored with
+// a single pass over the coefficients, rather than by sorting all of
+// indexvec by magnitude and then each collection by address. Both
+// methods produce the same collections.
+//
+template<class T>
+void select_coeffs(vector<void *> &indexvec, const vector<size_t> &lens, bool partialsort, bool my_compare(const void *, const void *))
+{
+    vector<void *>::iterator first = indexvec.begin();
+
+    size_t tlen = 0;
+    for (int j = 0; j < lens.size(); j++) tlen += lens[j];
+    VAssert(tlen <= indexvec.size());
 
-inline bool my_compare_d(const void *x1, const void *x2) { return (fabs(*(double *)x1) > fabs(*(double *)x2)); }
+    if (!partialsort) {
+        sort(indexvec.begin(), indexvec.end(), my_compare);
 
-inline bool my_compare_i(const void *x1, const void *x2) { return (abs(*(int *)x1) > abs(*(int *)x2)); }
+        for (int j = 0; j < lens.size(); j++) {
+            sort(first, first + lens[j]);    // sort coefficient's indecies
+            first += lens[j];
+        }
+        return;
+    }
 
-inline bool my_compare_l(const void *x1, const void *x2) { return (labs(*(long *)x1) > labs(*(long *)x2)); }
+    if (!tlen) return;
+
+    T *base = (T *)indexvec[0];
+
+    // Move the tlen largest to the front, then successively split
+    // the front into nested prefixes, largest collection index first.
+    //
+    if (tlen < indexvec.size()) nth_element(first, first + tlen, indexvec.end(), my_compare);
+    size_t end = tlen;
+    for (int j = (int)lens.size() - 1; j > 0; j--) {
+        size_t start = end - lens[j];
+        if (start > 0) nth_element(first, first + start, first + end, my_compare);
+        end = start;
+    }
+
+    // Label each selected coefficient with its collection, then
+    // rebuild the collections in address order.
+    //
+    vector<int>    label(indexvec.size(), -1);
+    vector<size_t> offset(lens.size());
+    for (size_t j = 0, idx = 0; j < lens.size(); j++) {
+        offset[j] = idx;
+        for (size_t i = 0; i < lens[j]; i++, idx++) label[(T *)indexvec[idx] - base] = j;
+    }
+    for (size_t i = 0; i < label.size(); i++) {
+        if (label[i] >= 0) indexvec[offset[label[i]]++] = base + i;
+    }
+}
+
+};    // namespace
 
 namespace {
 
 template<class T>
 int compress_template(Compressor *cmp, const T *src_arr, T *dst_arr, size_t dst_arr_len, T *C, size_t clen, size_t *L, SignificanceMap *sigmap, const vector<size_t> &dims, size_t nlevels,
-                      vector<void *> indexvec, bool my_compare(const void *, const void *))
+                      vector<void *> &indexvec, bool partialsort, bool my_compare(const void *, const void *))
 {
     if (!C) {
         Compressor::SetErrMsg("Invalid state");
@@ -187,14 +272,12 @@ int compress_template(Compressor *cmp, const T *src_arr, T *dst_arr, size_t dst_
 
     indexvec.clear();
     for (size_t i = numkeep; i < clen; i++) indexvec.push_back(&C[i]);
-    sort(indexvec.begin(), indexvec.end(), my_compare);
+    select_coeffs<T>(indexvec, vector<size_t>(1, dst_arr_len), partialsort, my_compare);
 
     // Copy coefficients that are larger than the threshold to
     // the destination array. Record their location in the significance
     // map.
     //
-
-    sort(indexvec.begin(), indexvec.begin() + dst_arr_len);
     for (size_t idx = numkeep, i = 0; idx < clen && i < dst_arr_len; idx++) {
         const T *cptr = (T *)indexvec[i];
         dst_arr[i++] = *cptr;
@@ -206,22 +289,22 @@ int compress_template(Compressor *cmp, const T *src_arr, T *dst_arr, size_t dst_
 
 int Compressor::Compress(const float *src_arr, float *dst_arr, size_t dst_arr_len, SignificanceMap *sigmap)
 {
-    return compress_template(this, src_arr, dst_arr, dst_arr_len, (float *)_C, _CLen, _L, sigmap, _dims, _nlevels, _indexvec, my_compare_f);
+    return compress_template(this, src_arr, dst_arr, dst_arr_len, (float *)_C, _CLen, _L, sigmap, _dims, _nlevels, _indexvec, _partialsort, my_compare_f);
 }
 
 int Compressor::Compress(const double *src_arr, double *dst_arr, size_t dst_arr_len, SignificanceMap *sigmap)
 {
-    return compress_template(this, src_arr, dst_arr, dst_arr_len, (double *)_C, _CLen, _L, sigmap, _dims, _nlevels, _indexvec, my_compare_d);
+    return compress_template(this, src_arr, dst_arr, dst_arr_len, (double *)_C, _CLen, _L, sigmap, _dims, _nlevels, _indexvec, _partialsort, my_compare_d);
 }
 
 int Compressor::Compress(const int *src_arr, int *dst_arr, size_t dst_arr_len, SignificanceMap *sigmap)
 {
-    return compress_template(this, src_arr, dst_arr, dst_arr_len, (int *)_C, _CLen, _L, sigmap, _dims, _nlevels, _indexvec, my_compare_i);
+    return compress_template(this, src_arr, dst_arr, dst_arr_len, (int *)_C, _CLen, _L, sigmap, _dims, _nlevels, _indexvec, _partialsort, my_compare_i);
 }
 
 int Compressor::Compress(const long *src_arr, long *dst_arr, size_t dst_arr_len, SignificanceMap *sigmap)
 {
-    return compress_template(this, src_arr, dst_arr, dst_arr_len, (long *)_C, _CLen, _L, sigmap, _dims, _nlevels, _indexvec, my_compare_l);
+    return compress_template(this, src_arr, dst_arr, dst_arr_len, (long *)_C, _CLen, _L, sigmap, _dims, _nlevels, _indexvec, _partialsort, my_compare_l);
 }
 
 namespace {
@@ -306,7 +389,7 @@ int Compressor::Decompress(const long *src_arr, long *dst_arr, SignificanceMap *
 namespace {
 template<class T>
 int decompose_template(Compressor *cmp, const T *src_arr, T *dst_arr, const vector<size_t> &dst_arr_lens, T *C, size_t clen, size_t *L, vector<SignificanceMap> &sigmaps, const vector<size_t> &dims,
-                       size_t nlevels, vector<void *> indexvec, bool my_compare(const void *, const void *))
+                       size_t nlevels, vector<void *> &indexvec, bool partialsort, bool my_compare(const void *, const void *))
 {
     if (!C) {
         Compressor::SetErrMsg("Invalid state");
@@ -386,12 +469,9 @@ int decompose_template(Compressor *cmp, const T *src_arr, T *dst_arr, const vect
     //
     indexvec.clear();
     for (size_t i = numkeep; i < clen; i++) indexvec.push_back(&C[i]);
-    sort(indexvec.begin(), indexvec.end(), my_compare);
+    select_coeffs<T>(indexvec, my_dst_arr_lens, partialsort, my_compare);
 
-    vector<void *>::iterator itr = indexvec.begin();
-    for (int j = 0, idx = 0; j < my_dst_arr_lens.size(); j++) {
-        sort(itr, itr + my_dst_arr_lens[j]);    // sort coefficient's indecies
-        itr += my_dst_arr_lens[j];
+    for (size_t j = 0, idx = 0; j < my_dst_arr_lens.size(); j++) {
         for (int i = 0; i < my_dst_arr_lens[j]; i++, idx++) {
             const T *cptr = (T *)indexvec[idx];
             dst_arr[i] = *cptr;
@@ -474,22 +554,22 @@ int reconstruct_template(Compressor *cmp, const T *src_arr, T *dst_arr, T *C, si
 
 int Compressor::Decompose(const float *src_arr, float *dst_arr, const vector<size_t> &dst_arr_lens, vector<SignificanceMap> &sigmaps)
 {
-    return decompose_template(this, src_arr, dst_arr, dst_arr_lens, (float *)_C, _CLen, _L, sigmaps, _dims, _nlevels, _indexvec, my_compare_f);
+    return decompose_template(this, src_arr, dst_arr, dst_arr_lens, (float *)_C, _CLen, _L, sigmaps, _dims, _nlevels, _indexvec, _partialsort, my_compare_f);
 }
 
 int Compressor::Decompose(const double *src_arr, double *dst_arr, const vector<size_t> &dst_arr_lens, vector<SignificanceMap> &sigmaps)
 {
-    return decompose_template(this, src_arr, dst_arr, dst_arr_lens, (double *)_C, _CLen, _L, sigmaps, _dims, _nlevels, _indexvec, my_compare_d);
+    return decompose_template(this, src_arr, dst_arr, dst_arr_lens, (double *)_C, _CLen, _L, sigmaps, _dims, _nlevels, _indexvec, _partialsort, my_compare_d);
 }
 
 int Compressor::Decompose(const int *src_arr, int *dst_arr, const vector<size_t> &dst_arr_lens, vector<SignificanceMap> &sigmaps)
 {
-    return decompose_template(this, src_arr, dst_arr, dst_arr_lens, (int *)_C, _CLen, _L, sigmaps, _dims, _nlevels, _indexvec, my_compare_i);
+    return decompose_template(this, src_arr, dst_arr, dst_arr_lens, (int *)_C, _CLen, _L, sigmaps, _dims, _nlevels, _indexvec, _partialsort, my_compare_i);
 }
 
 int Compressor::Decompose(const long *src_arr, long *dst_arr, const vector<size_t> &dst_arr_lens, vector<SignificanceMap> &sigmaps)
 {
-    return decompose_template(this, src_arr, dst_arr, dst_arr_lens, (long *)_C, _CLen, _L, sigmaps, _dims, _nlevels, _indexvec, my_compare_l);
+    return decompose_template(this, src_arr, dst_arr, dst_arr_lens, (long *)_C, _CLen, _L, sigmaps, _dims, _nlevels, _indexvec, _partialsort, my_compare_l);
 }
 
 int Compressor::Reconstruct(const float *src_arr, float *dst_arr, vector<SignificanceMap> &sigmaps, int l)
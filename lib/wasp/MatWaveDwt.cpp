@@ -6,6 +6,11 @@
 #include <cstdio>
 #include <vapor/MatWaveDwt.h>
 #include <vapor/WaveFiltInt.h>
+#if defined(__AVX__)
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+#endif
 #ifdef WIN32
     #include <float.h>
     #define isfinite _finite
@@ -204,6 +209,58 @@ template<class T, class U> int wextend_1D_center(const T *sigIn, size_t sigInLen
     return (0);
 }
 
+//
+// SIMD support for the convolution kernels below. Each kernel computes
+// VLEN output samples at a time, where all VLEN samples read their
+// inputs from unit-stride memory, and finishes with a scalar loop. If
+// no vector instruction set is available VLEN is 1 and only the scalar
+// loop is executed. Products and sums are evaluated in the same order
+// as the scalar code, so results do not depend on the instruction set
+// (except for any fused multiply-add contraction performed by the
+// compiler).
+//
+#if defined(__AVX__)
+    #define DWT_SIMD
+typedef __m256d simd_t;
+const size_t    VLEN = 4;
+
+inline simd_t simd_zero() { return (_mm256_setzero_pd()); }
+inline simd_t simd_set1(double a) { return (_mm256_set1_pd(a)); }
+inline simd_t simd_load(const double *p) { return (_mm256_loadu_pd(p)); }
+inline void   simd_store(double *p, simd_t a) { _mm256_storeu_pd(p, a); }
+inline simd_t simd_add(simd_t a, simd_t b) { return (_mm256_add_pd(a, b)); }
+inline simd_t simd_mul(simd_t a, simd_t b) { return (_mm256_mul_pd(a, b)); }
+
+// Store e0,o0,e1,o1,... to p[0..2*VLEN)
+//
+inline void simd_store_interleaved(double *p, simd_t e, simd_t o)
+{
+    simd_t lo = _mm256_unpacklo_pd(e, o);    // e0 o0 e2 o2
+    simd_t hi = _mm256_unpackhi_pd(e, o);    // e1 o1 e3 o3
+    _mm256_storeu_pd(p, _mm256_permute2f128_pd(lo, hi, 0x20));
+    _mm256_storeu_pd(p + 4, _mm256_permute2f128_pd(lo, hi, 0x31));
+}
+#elif defined(__SSE2__) || defined(_M_X64)
+    #define DWT_SIMD
+typedef __m128d simd_t;
+const size_t    VLEN = 2;
+
+inline simd_t simd_zero() { return (_mm_setzero_pd()); }
+inline simd_t simd_set1(double a) { return (_mm_set1_pd(a)); }
+inline simd_t simd_load(const double *p) { return (_mm_loadu_pd(p)); }
+inline void   simd_store(double *p, simd_t a) { _mm_storeu_pd(p, a); }
+inline simd_t simd_add(simd_t a, simd_t b) { return (_mm_add_pd(a, b)); }
+inline simd_t simd_mul(simd_t a, simd_t b) { return (_mm_mul_pd(a, b)); }
+
+inline void simd_store_interleaved(double *p, simd_t e, simd_t o)
+{
+    _mm_storeu_pd(p, _mm_unpacklo_pd(e, o));
+    _mm_storeu_pd(p + 2, _mm_unpackhi_pd(e, o));
+}
+#else
+const size_t VLEN = 1;
+#endif
+
 //
 // Perform single-level, 1D forward wavelet transform
 // (convolution + downsampling)
@@ -217,39 +274,101 @@ template<class T, class U> int wextend_1D_center(const T *sigIn, size_t sigInLen
 // for the oddhigh parameter.
 //
 // sigIn must contain sigInLen + filterLen + 1 samples if oddlow or oddhigh
-// is true, otherwise sigInLen + filterLen samples are required
+// is true, otherwise sigInLen + filterLen samples are required.
+// sigInExtLen is the number of samples actually available in sigIn.
+//
+// work must provide space for sigInExtLen + 1 samples. It is used to
+// split sigIn into its even and odd indexed samples so that the
+// downsampled convolution reads unit-stride data.
 //
 // See G. Strang and T. Nguyen, "Wavelets and Filter Banks", chap 8, finite
 // length filters
 //
-void forward_xform(const double *sigIn, size_t sigInLen, const double *low_filter, const double *high_filter, int filterLen, double *cA, double *cD, bool oddlow, bool oddhigh)
+void forward_xform(const double *sigIn, size_t sigInLen, size_t sigInExtLen, const double *low_filter, const double *high_filter, int filterLen, double *cA, double *cD, bool oddlow, bool oddhigh,
+                   double *work)
 {
     //	VAssert(sigInLen > filterLen);
 
     size_t xlstart = oddlow ? 1 : 0;
-    size_t xl;
     size_t xhstart = oddhigh ? 1 : 0;
-    size_t xh;
+    size_t nout = (sigInLen + 1) >> 1;
+    size_t j = 0;
 
-    for (size_t yi = 0; yi < sigInLen; yi += 2) {
-        cA[yi >> 1] = cD[yi >> 1] = 0.0;
+#ifdef DWT_SIMD
+    // Sample sigIn[2*j + p] is even[j + p/2] if p is even, and
+    // odd[j + p/2] otherwise
+    //
+    double *even = work;
+    double *odd = work + ((sigInExtLen + 1) >> 1);
+    for (size_t i = 0; i < sigInExtLen; i += 2) even[i >> 1] = sigIn[i];
+    for (size_t i = 1; i < sigInExtLen; i += 2) odd[i >> 1] = sigIn[i];
+
+    for (; j + VLEN <= nout; j += VLEN) {
+        simd_t accA = simd_zero();
+        simd_t accD = simd_zero();
+
+        for (int i = 0; i < filterLen; i++) {
+            int           k = filterLen - 1 - i;
+            size_t        pl = xlstart + i;
+            size_t        ph = xhstart + i;
+            const double *xl = ((pl & 1) ? odd : even) + j + (pl >> 1);
+            const double *xh = ((ph & 1) ? odd : even) + j + (ph >> 1);
+
+            accA = simd_add(accA, simd_mul(simd_set1(low_filter[k]), simd_load(xl)));
+            accD = simd_add(accD, simd_mul(simd_set1(high_filter[k]), simd_load(xh)));
+        }
+        simd_store(&cA[j], accA);
+        simd_store(&cD[j], accD);
+    }
+#endif
+
+    for (; j < nout; j++) {
+        double a = 0.0;
+        double d = 0.0;
 
-        xl = xlstart;
-        xh = xhstart;
+        size_t xl = xlstart + (j << 1);
+        size_t xh = xhstart + (j << 1);
 
         for (int k = filterLen - 1; k >= 0; k--) {
-            cA[yi >> 1] += low_filter[k] * sigIn[xl];
-            cD[yi >> 1] += high_filter[k] * sigIn[xh];
+            a += low_filter[k] * sigIn[xl];
+            d += high_filter[k] * sigIn[xh];
             xl++;
             xh++;
         }
-        xlstart += 2;
-        xhstart += 2;
+        cA[j] = a;
+        cD[j] = d;
     }
 
     return;
 }
 
+//
+// Compute sum(f[k] * x[xi]) for k = k0, k0-2, ..., >= 0 and xi = x0,
+// x0+1, ... for VLEN consecutive values of x0. The k0 and x0 pair
+// depends only on the parity of the output sample, so even and odd
+// indexed output samples are computed by separate calls.
+//
+#ifdef DWT_SIMD
+inline simd_t simd_upsample_conv(simd_t acc, const double *x, const double *f, int k0)
+{
+    for (int k = k0; k >= 0; k -= 2) {
+        acc = simd_add(acc, simd_mul(simd_set1(f[k]), simd_load(x)));
+        x++;
+    }
+    return (acc);
+}
+
+inline simd_t simd_upsample_conv2(simd_t acc, const double *a, const double *d, const double *fa, const double *fd, int k0)
+{
+    for (int k = k0; k >= 0; k -= 2) {
+        acc = simd_add(acc, simd_add(simd_mul(simd_set1(fa[k]), simd_load(a)), simd_mul(simd_set1(fd[k]), simd_load(d))));
+        a++;
+        d++;
+    }
+    return (acc);
+}
+#endif
+
 void inverse_xform_even(const double *cA, const double *cD, size_t sigOutLen, const double *low_filter, const double *high_filter, int filterLen, double *sigOut, bool matlab)
 {
     size_t xi;    // input and out signal indecies
@@ -257,8 +376,35 @@ void inverse_xform_even(const double *cA, const double *cD, size_t sigOutLen, co
 
     VAssert((filterLen % 2) == 0);
 
-    for (size_t yi = 0; yi < sigOutLen; yi++) {
-        sigOut[yi] = 0.0;
+    size_t yi = 0;
+
+#ifdef DWT_SIMD
+    // Input offset and first filter index for even (e) and odd (o)
+    // indexed output samples
+    //
+    size_t xe, xo;
+    int    ke, ko;
+    if (matlab || (filterLen >> 1) % 2) {    // odd length half filter
+        xe = 0;
+        ke = filterLen - 2;
+        xo = 0;
+        ko = filterLen - 1;
+    } else {
+        xe = 0;
+        ke = filterLen - 1;
+        xo = 1;
+        ko = filterLen - 2;
+    }
+
+    for (size_t m = 0; 2 * (m + VLEN) <= sigOutLen; m += VLEN, yi += 2 * VLEN) {
+        simd_t e = simd_upsample_conv2(simd_zero(), cA + m + xe, cD + m + xe, low_filter, high_filter, ke);
+        simd_t o = simd_upsample_conv2(simd_zero(), cA + m + xo, cD + m + xo, low_filter, high_filter, ko);
+        simd_store_interleaved(&sigOut[yi], e, o);
+    }
+#endif
+
+    for (; yi < sigOutLen; yi++) {
+        double y = 0.0;
 
         if (matlab || (filterLen >> 1) % 2) {    // odd length half filter
             xi = yi >> 1;
@@ -277,9 +423,10 @@ void inverse_xform_even(const double *cA, const double *cD, size_t sigOutLen, co
         }
 
         for (; k >= 0; k -= 2) {
-            sigOut[yi] += (low_filter[k] * cA[xi]) + (high_filter[k] * cD[xi]);
+            y += (low_filter[k] * cA[xi]) + (high_filter[k] * cD[xi]);
             xi++;
         }
+        sigOut[yi] = y;
     }
 
     return;
@@ -300,8 +447,22 @@ void inverse_xform_odd(const double *cA, const double *cD, size_t sigOutLen, con
 
     VAssert((filterLen % 2) == 1);
 
-    for (size_t yi = 0; yi < sigOutLen; yi++) {
-        sigOut[yi] = 0.0;
+    size_t yi = 0;
+
+#ifdef DWT_SIMD
+    for (size_t m = 0; 2 * (m + VLEN) <= sigOutLen; m += VLEN, yi += 2 * VLEN) {
+        simd_t e = simd_upsample_conv(simd_zero(), cA + m, low_filter, filterLen - 1);
+        e = simd_upsample_conv(e, cD + m, high_filter, filterLen - 2);
+
+        simd_t o = simd_upsample_conv(simd_zero(), cA + m + 1, low_filter, filterLen - 2);
+        o = simd_upsample_conv(o, cD + m, high_filter, filterLen - 1);
+
+        simd_store_interleaved(&sigOut[yi], e, o);
+    }
+#endif
+
+    for (; yi < sigOutLen; yi++) {
+        double y = 0.0;
 
         xi = (yi + 1) >> 1;
         if (yi % 2) {
@@ -310,7 +471,7 @@ void inverse_xform_odd(const double *cA, const double *cD, size_t sigOutLen, con
             k = filterLen - 1;
         }
         for (; k >= 0; k -= 2) {
-            sigOut[yi] += (low_filter[k] * cA[xi]);
+            y += (low_filter[k] * cA[xi]);
             xi++;
         }
 
@@ -321,9 +482,10 @@ void inverse_xform_odd(const double *cA, const double *cD, size_t sigOutLen, con
             k = filterLen - 2;
         }
         for (; k >= 0; k -= 2) {
-            sigOut[yi] += (high_filter[k] * cD[xi]);
+            y += (high_filter[k] * cD[xi]);
             xi++;
         }
+        sigOut[yi] = y;
     }
 
     return;
@@ -352,20 +514,21 @@ void inverse_xform(const double *cA, const double *cD, size_t sigOutLen, const d
 
 template<class T, class U> void transpose(const T *a, U *b, size_t p1, size_t p2, size_t m1, size_t m2, size_t s1, size_t s2)
 {
-    size_t       I1, I2;
-    size_t       i1, i2;
-    size_t       q, r;
-    double       c0;
     const size_t block = BlockSize;
-    for (I2 = p2; I2 < p2 + m2; I2 += block)
-        for (I1 = p1; I1 < p1 + m1; I1 += block)
-            for (i2 = I2; i2 < Minimum(I2 + block, p2 + m2); i2++)
-                for (i1 = I1; i1 < Minimum(I1 + block, p1 + m1); i1++) {
-                    q = i2 * s1 + i1;
-                    r = i1 * s2 + i2;
-                    c0 = a[q];
-                    b[r] = c0;
-                }
+    for (size_t I2 = p2; I2 < p2 + m2; I2 += block) {
+        size_t e2 = Minimum(I2 + block, p2 + m2);
+        for (size_t I1 = p1; I1 < p1 + m1; I1 += block) {
+            size_t e1 = Minimum(I1 + block, p1 + m1);
+
+            // Read rows of the tile with unit stride, write columns
+            //
+            for (size_t i2 = I2; i2 < e2; i2++) {
+                const T *arow = a + i2 * s1;
+                U *      bcol = b + i2;
+                for (size_t i1 = I1; i1 < e1; i1++) { bcol[i1 * s2] = (U)arow[i1]; }
+            }
+        }
+    }
 }
 
 // specialization for Real -> Complex
@@ -443,10 +606,11 @@ int dwt_template(MatWaveDwt *dwt, const T *sigIn, size_t sigInLen, const WaveFil
     }
     size_t sigExtendedLen = sigInLen + (2 * extendLen);
 
-    V *buf = (V *)sbuf.Alloc(sizeof(dummy) * (sigExtendedLen + sigConvolvedLen));
+    V *buf = (V *)sbuf.Alloc(sizeof(dummy) * ((2 * sigExtendedLen) + sigConvolvedLen + 1));
 
     V *sigExtended = buf;
     V *sigConvolved = sigExtended + sigExtendedLen;
+    V *work = sigConvolved + sigConvolvedLen;
 
     // Signal boundary extension
     //
@@ -469,7 +633,7 @@ int dwt_template(MatWaveDwt *dwt, const T *sigIn, size_t sigInLen, const WaveFil
         double *      cAdbl = (double *)sigConvolved;
         double *      cDdbl = (double *)sigConvolved + L[0];
 
-        forward_xform(s, L[0] + L[1], wf->GetLowDecomFilCoef(), wf->GetHighDecomFilCoef(), filterLen, cAdbl, cDdbl, oddlow, oddhigh);
+        forward_xform(s, L[0] + L[1], sigExtendedLen, wf->GetLowDecomFilCoef(), wf->GetHighDecomFilCoef(), filterLen, cAdbl, cDdbl, oddlow, oddhigh, (double *)work);
     } else {
         const WaveFiltInt *wfi = dynamic_cast<const WaveFiltInt *>(wf);
         VAssert(wfi != NULL);
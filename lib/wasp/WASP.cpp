@@ -7,6 +7,9 @@
 #include "vapor/MatWaveBase.h"
 #include "vapor/Compressor.h"
 #include "vapor/WASP.h"
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
 
 using namespace VAPoR;
 using namespace Wasp;
@@ -190,45 +193,65 @@ bool vectorinc::next(vector<size_t> &start, size_t &offset)
 }
 #endif
 
-// Execution thread state for data reads and writes
+// Description of the blocks of a hyperslab that is read from or written
+// to disk by a single GetVara() or PutVara() call. Shared by all of the
+// tasks that process the hyperslab's blocks.
 //
-class thread_state {
+class block_io {
 public:
-    int                  _id;
-    EasyThreads *        _et;    // one per thread
-    int                  _nthreads;
-    string               _varname;
-    vector<NetCDFCpp *>  _ncdfcptrs;    // one for each file
-    vector<size_t>       _start;
-    vector<size_t>       _count;
-    vector<size_t>       _bs;
-    vector<size_t>       _udims;
-    vector<size_t>       _ncoeffs;
-    vector<size_t>       _encoded_dims;
-    vector<Compressor *> _compressors;    // one per thread
-    void *               _data;           // global (shared by all threads)
-    int                  _data_type;      // typeof(*_data)
-    unsigned char *      _mask;           // global (shared by all threads)
-    void *               _block;          // private (not shared)
-    void *               _coeffs;         // private (not shared)
-    int                  _block_type;     // typeof(*_block) and typeof(*_coeffs)
-    int                  _xtype;          // external storage NetCDF storage
-    unsigned char *      _maps;           // private (not shared)
-    int                  _level;
-    bool                 _unblock_flag;    // unblock the data after reconstruction?
-    static int           _status;          // error indicator
-
-    thread_state(int id, EasyThreads *et, int nthreads, string &varname, const vector<NetCDFCpp *> &ncdfcptrs, const vector<size_t> &start, const vector<size_t> &count, const vector<size_t> &bs,
-                 const vector<size_t> &udims, const vector<size_t> &ncoeffs, const vector<size_t> &encoded_dims, const vector<Compressor *> &compressors, void *data, int data_type,
-                 unsigned char *mask, void *block, void *coeffs, int block_type, int xtype, unsigned char *maps, int level, bool unblock_flag)
-    : _id(id), _et(et), _nthreads(nthreads), _varname(varname), _ncdfcptrs(ncdfcptrs), _start(start), _count(count), _bs(bs), _udims(udims), _ncoeffs(ncoeffs), _encoded_dims(encoded_dims),
-      _compressors(compressors), _data(data), _data_type(data_type), _mask(mask), _block(block), _coeffs(coeffs), _block_type(block_type), _xtype(xtype), _maps(maps), _level(level),
-      _unblock_flag(unblock_flag)
+    string              _varname;
+    vector<NetCDFCpp *> _ncdfcptrs;    // one for each file
+    vector<size_t>      _start;
+    vector<size_t>      _count;
+    vector<size_t>      _bs;
+    vector<size_t>      _ncoeffs;
+    vector<size_t>      _encoded_dims;
+    int                 _xtype;    // external storage NetCDF storage
+    int                 _level;
+    std::mutex          _ioMutex;    // NetCDF library is not thread safe
+    std::atomic<int>    _status;     // error indicator
+
+    block_io(const string &varname, const vector<NetCDFCpp *> &ncdfcptrs, const vector<size_t> &start, const vector<size_t> &count, const vector<size_t> &bs, const vector<size_t> &ncoeffs,
+             const vector<size_t> &encoded_dims, int xtype, int level)
+    : _varname(varname), _ncdfcptrs(ncdfcptrs), _start(start), _count(count), _bs(bs), _ncoeffs(ncoeffs), _encoded_dims(encoded_dims), _xtype(xtype), _level(level), _status(0)
     {
-        _status = 0;
     }
 };
-int thread_state::_status = 0;
+
+// A fixed number of buffers ("slots") that hold blocks between the time
+// they are read from disk and the time they are decoded. Acquire()
+// blocks until a slot is free.
+//
+class slot_pool {
+public:
+    slot_pool(int nslots)
+    {
+        for (int i = nslots - 1; i >= 0; i--) _free.push_back(i);
+    }
+
+    int Acquire()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cv.wait(lock, [this] { return (!_free.empty()); });
+        int slot = _free.back();
+        _free.pop_back();
+        return (slot);
+    }
+
+    void Release(int slot)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _free.push_back(slot);
+        }
+        _cv.notify_one();
+    }
+
+private:
+    std::mutex              _mutex;
+    std::condition_variable _cv;
+    vector<int>             _free;
+};
 
 // Convert voxel coordinates, 'vcoords', to block coordinates, 'bcoords',
 // assuming a block size of 'bs'. 'residual' is any offset within
@@ -968,432 +991,119 @@ int FetchBlockCompressed(string varname, vector<NetCDFCpp *> ncdfcptrs, vector<s
     return (0);
 }
 
-template<class T> void *RunWriteThreadTemplate(thread_state &s, T dummy)
+// Extract the i'th block of a hyperslab from 'data' and write it to disk
+// (no compression)
+//
+// io : hyperslab description
+// vec : block iterator for hyperslab
+// data : hyperslab
+// block : storage for one block
+//
+template<class T> int WriteBlock(block_io &io, const vectorinc &vec, size_t i, const T *data, T *block)
 {
-    vectorinc vec(s._start, s._count, s._udims, s._bs);
+    // Get starting coordinates of i'th block
+    //
+    size_t         offset;
+    vector<size_t> start;
+    vec.ith(i, start, offset);
 
-    s._status = 0;
+    // Transform coordinates from global to the region-of-interest
+    //
+    vector<size_t> roi_start = vector_sub(start, io._start);
 
     //
-    // Process blocks of data assigned to this thread
+    // Extract the block with coordinates 'start' from the
+    // array, 'data'.
     //
-    int n = vec.num();
-    for (int i = s._id; i < n; i += s._nthreads) {
-        // Get starting coordinates of i'th block
-        //
-        size_t         offset;
-        vector<size_t> start;
-        vec.ith(i, start, offset);
+    T min, max;
+    Block(data, NULL, io._count, roi_start, block, io._bs, "symh", min, max);
 
-        // Transform coordinates from global to the region-of-interest
-        //
-        vector<size_t> roi_start = vector_sub(start, s._start);
-
-        //
-        // Extract the block with coordinates 'start' from the
-        // array, 'data'.
-        //
-        T min, max;
-        Block((T *)s._data, NULL, s._count, roi_start, (T *)s._block, s._bs, "symh", min, max);
-
-        // Convert from voxel to block coordinates
-        //
-        vector<size_t> bcoords;
-        size_t         residual;
-        to_block_coords(start, s._bs, bcoords, residual);
-        VAssert(residual == 0);
-
-        // Write the transformed block to disk. Need a mutex because
-        // NetCDF library is not thread safe
-        //
-        //
-        s._et->MutexLock();
-        int rc = StoreBlock(s._varname, s._ncdfcptrs[0], bcoords, s._encoded_dims[0], (T *)s._block);
-        if (rc < 0) { s._status = -1; }
-        s._et->MutexUnlock();
-        if (s._status < 0) break;
-    }
-    return (0);
-}
-
-void *RunWriteThread(void *arg)
-{
-    thread_state &s = *(thread_state *)arg;
+    // Convert from voxel to block coordinates
+    //
+    vector<size_t> bcoords;
+    size_t         residual;
+    to_block_coords(start, io._bs, bcoords, residual);
+    VAssert(residual == 0);
 
-    switch (s._data_type) {
-    case NC_FLOAT: {
-        float dummy = 0.0;
-        return (RunWriteThreadTemplate(s, dummy));
-    }
-    case NC_DOUBLE: {
-        double dummy = 0.0;
-        return (RunWriteThreadTemplate(s, dummy));
-    }
-    case NC_INT: {
-        int dummy = 0.0;
-        return (RunWriteThreadTemplate(s, dummy));
-    }
-    case NC_SHORT: {
-        int16_t dummy = 0.0;
-        return (RunWriteThreadTemplate(s, dummy));
-    }
-    default: VAssert(0); return (NULL);
-    }
+    // Write the block to disk. Need a mutex because
+    // NetCDF library is not thread safe
+    //
+    std::lock_guard<std::mutex> lock(io._ioMutex);
+    return (StoreBlock(io._varname, io._ncdfcptrs[0], bcoords, io._encoded_dims[0], block));
 }
 
-// Thread execution help function for data writes
+// Extract the i'th block of a hyperslab from 'data', wavelet transform
+// it, and write the coefficients to disk
 //
-
-template<class T, class U> void *RunWriteThreadCompressedTemplate(thread_state &s, T dummy1, U dummy2)
+// cmp : Compressor for wavelet transform, private to the calling thread
+// block, coeffs, maps : storage for one block, private to the calling
+// thread
+//
+template<class T, class U> int WriteBlockCompressed(block_io &io, const vectorinc &vec, size_t i, const T *data, const unsigned char *mask, Compressor *cmp, U *block, U *coeffs, unsigned char *maps)
 {
-    vectorinc vec(s._start, s._count, s._udims, s._bs);
+    // Get starting coordinates of i'th block
+    //
+    size_t         offset;
+    vector<size_t> start;
+    vec.ith(i, start, offset);
 
-    s._status = 0;
+    // Transform coordinates from global to the region-of-interest
+    //
+    vector<size_t> roi_start = vector_sub(start, io._start);
 
     //
-    // Process blocks of data assigned to this thread
+    // Extract the block with coordinates 'start' from the
+    // array, 'data'.
     //
-    int n = vec.num();
-    for (int i = s._id; i < n; i += s._nthreads) {
-        // Get starting coordinates of i'th block
-        //
-        size_t         offset;
-        vector<size_t> start;
-        vec.ith(i, start, offset);
-
-        // Transform coordinates from global to the region-of-interest
-        //
-        vector<size_t> roi_start = vector_sub(start, s._start);
-
-        //
-        // Extract the block with coordinates 'start' from the
-        // array, 'data'.
-        //
-        U datarange[2];
-        Block((T *)s._data, s._mask, s._count, roi_start, (U *)s._block, s._bs, s._compressors[s._id]->dwtmode(), datarange[0], datarange[1]);
+    U datarange[2];
+    Block(data, mask, io._count, roi_start, block, io._bs, cmp->dwtmode(), datarange[0], datarange[1]);
 
-        //
-        // Wavelet transform the current block
-        //
-        int rc = DecomposeBlock(s._compressors[s._id], (const U *)s._block, vproduct(s._bs), (U *)s._coeffs, s._maps, s._xtype, s._ncoeffs, s._encoded_dims);
-        if (rc < 0) {
-            s._status = -1;
-            break;
-        }
-
-        // Convert from voxel to block coordinates
-        //
-        vector<size_t> bcoords;
-        size_t         residual;
-        to_block_coords(start, s._bs, bcoords, residual);
-        VAssert(residual == 0);
-
-        // Write the transformed block to disk. Need a mutex because
-        // NetCDF library is not thread safe
-        //
-        //
-        s._et->MutexLock();
-        rc = StoreBlockCompressed(s._varname, s._ncdfcptrs, bcoords, s._ncoeffs, s._encoded_dims, (U *)s._coeffs, datarange, s._maps, s._xtype);
-        if (rc < 0) { s._status = -1; }
-        s._et->MutexUnlock();
-        if (s._status < 0) break;
-    }
-    return (0);
-}
-
-void *RunWriteThreadCompressed(void *arg)
-{
-    thread_state &s = *(thread_state *)arg;
-
-    VAssert(s._block_type == NC_INT64 || s._block_type == NC_DOUBLE);
-
-    // Establish types for template functions. Data types aren't preserved
-    // when passed in thread_state, which must be cast to void to support
-    // pthread API :-(
     //
-    switch (s._data_type) {
-    case NC_FLOAT: {
-        float dummy1 = 0.0;
-        if (s._block_type == NC_INT64) {
-            long dummy2 = 0;
-            return (RunWriteThreadCompressedTemplate(s, dummy1, dummy2));
-        } else {
-            double dummy2 = 0;
-            return (RunWriteThreadCompressedTemplate(s, dummy1, dummy2));
-        }
-    } break;
-    case NC_DOUBLE: {
-        double dummy1 = 0.0;
-        if (s._block_type == NC_INT64) {
-            long dummy2 = 0;
-            return (RunWriteThreadCompressedTemplate(s, dummy1, dummy2));
-        } else {
-            double dummy2 = 0;
-            return (RunWriteThreadCompressedTemplate(s, dummy1, dummy2));
-        }
-    } break;
-    case NC_INT:
-    case NC_UINT: {
-        int dummy1 = 0.0;
-        if (s._block_type == NC_INT64) {
-            long dummy2 = 0;
-            return (RunWriteThreadCompressedTemplate(s, dummy1, dummy2));
-        } else {
-            double dummy2 = 0;
-            return (RunWriteThreadCompressedTemplate(s, dummy1, dummy2));
-        }
-    } break;
-    case NC_SHORT:
-    case NC_USHORT: {
-        int16_t dummy1 = 0.0;
-        if (s._block_type == NC_INT64) {
-            long dummy2 = 0;
-            return (RunWriteThreadCompressedTemplate(s, dummy1, dummy2));
-        } else {
-            double dummy2 = 0;
-            return (RunWriteThreadCompressedTemplate(s, dummy1, dummy2));
-        }
-    }
-    case NC_BYTE:
-    case NC_UBYTE: {
-        int8_t dummy1 = 0;
-        if (s._block_type == NC_INT64) {
-            long dummy2 = 0;
-            return (RunWriteThreadCompressedTemplate(s, dummy1, dummy2));
-        } else {
-            double dummy2 = 0;
-            return (RunWriteThreadCompressedTemplate(s, dummy1, dummy2));
-        }
-    } break;
-    default:
-        cerr << "Data type " << s._data_type << endl;
-        VAssert(0 && s._data_type);
-        return (NULL);
-    }
-}
-
-// Thread execution helper function for data writes
-//
-template<class T> void *RunReadThreadTemplate(thread_state &s, T dummy)
-{
-    bool unblock_flag = s._unblock_flag;    // Need to unblock data?
-    T *  data = (T *)s._data;
-
-    // Align start and count coordinates to block boundaries
+    // Wavelet transform the current block
     //
-    vector<size_t> aligned_start;
-    vector<size_t> aligned_count;
-    block_align(s._start, s._count, s._bs, aligned_start, aligned_count);
-
-    vectorinc vec(aligned_start, aligned_count, s._udims, s._bs);
-
-    s._status = 0;
-
-    int n = vec.num();
-    for (int i = s._id; i < n; i += s._nthreads) {
-        size_t         offset;
-        vector<size_t> start;
-
-        vec.ith(i, start, offset);
-
-        vector<size_t> bcoords;
-        size_t         residual;
-        to_block_coords(start, s._bs, bcoords, residual);
-        VAssert(residual == 0);
-
-        // Transform coordinates from global to the region-of-interest
-        //
-        vector<size_t> roi_start = vector_sub(start, aligned_start);
-        vector<size_t> roi_origin = vector_sub(s._start, aligned_start);
-
-        T *blockptr = (T *)s._block;
-
-        // Read wavelet coefficients from disk. Need a mutex because
-        // NetCDF API is not thread safe
-        //
-        s._et->MutexLock();
-        int rc = FetchBlock(s._varname, s._ncdfcptrs[0], bcoords, s._encoded_dims[0], blockptr);
-        if (rc < 0) s._status = -1;
-        s._et->MutexUnlock();
-        if (s._status < 0) break;
-
-        if (unblock_flag) {
-            // Unblock the current block into the destination array
-            //
-            UnBlock(blockptr, s._bs, data, s._count, roi_origin, roi_start);
-        } else {
-            // Don't unblock. Just copy
-            //
-            size_t offset = vproduct(s._bs) * i;
-            for (size_t j = 0; j < vproduct(s._bs); j++) { data[offset + j] = blockptr[j]; }
-        }
-    }
-    return (NULL);
-}
+    int rc = DecomposeBlock(cmp, (const U *)block, vproduct(io._bs), coeffs, maps, io._xtype, io._ncoeffs, io._encoded_dims);
+    if (rc < 0) return (-1);
 
-void *RunReadThread(void *arg)
-{
-    thread_state &s = *(thread_state *)arg;
+    // Convert from voxel to block coordinates
+    //
+    vector<size_t> bcoords;
+    size_t         residual;
+    to_block_coords(start, io._bs, bcoords, residual);
+    VAssert(residual == 0);
 
-    switch (s._data_type) {
-    case NC_FLOAT: {
-        float dummy = 0.0;
-        return (RunReadThreadTemplate(s, dummy));
-    }
-    case NC_DOUBLE: {
-        double dummy = 0.0;
-        return (RunReadThreadTemplate(s, dummy));
-    }
-    case NC_INT: {
-        int dummy = 0.0;
-        return (RunReadThreadTemplate(s, dummy));
-    }
-    case NC_SHORT: {
-        int16_t dummy = 0.0;
-        return (RunReadThreadTemplate(s, dummy));
-    }
-    default: VAssert(0); return (NULL);
-    }
+    // Write the transformed block to disk. Need a mutex because
+    // NetCDF library is not thread safe
+    //
+    std::lock_guard<std::mutex> lock(io._ioMutex);
+    return (StoreBlockCompressed(io._varname, io._ncdfcptrs, bcoords, io._ncoeffs, io._encoded_dims, coeffs, datarange, maps, io._xtype));
 }
 
-// Thread execution helper function for data writes
+// Copy the i'th block of a block-aligned hyperslab into the destination
+// array, 'data', either unblocking it or, if 'unblock_flag' is false,
+// copying it verbatim to its position in the block-ordered output.
 //
-
-template<class T, class U> void *RunReadThreadCompressedTemplate(thread_state &s, T dummy1, U dummy2)
+// roi_origin : offset of requested hyperslab within the aligned hyperslab
+// roi_start : offset of block within the aligned hyperslab
+//
+template<class T, class U> void StoreReadBlock(const block_io &io, size_t i, const vector<size_t> &roi_origin, const vector<size_t> &roi_start, bool unblock_flag, U *block, T *data)
 {
-    bool unblock_flag = s._unblock_flag;    // Need to unblock data?
-    T *  data = (T *)s._data;
-
-    // Align start and count coordinates to block boundaries
-    //
-    vector<size_t> aligned_start;
-    vector<size_t> aligned_count;
-    block_align(s._start, s._count, s._bs, aligned_start, aligned_count);
-
-    vectorinc vec(aligned_start, aligned_count, s._udims, s._bs);
-
-    s._status = 0;
-
-    int n = vec.num();
-    for (int i = s._id; i < n; i += s._nthreads) {
-        size_t         offset;
-        vector<size_t> start;
-
-        vec.ith(i, start, offset);
-
-        vector<size_t> bcoords;
-        size_t         residual;
-        to_block_coords(start, s._bs, bcoords, residual);
-        VAssert(residual == 0);
-
-        // Read wavelet coefficients from disk. Need a mutex because
-        // NetCDF API is not thread safe
+    if (unblock_flag) {
+        // Unblock the current block into the destination array
         //
-        U datarange[2];
-        s._et->MutexLock();
-        int rc = FetchBlockCompressed(s._varname, s._ncdfcptrs, bcoords, s._ncoeffs, s._encoded_dims, (U *)s._coeffs, datarange, s._maps, s._xtype);
-        if (rc < 0) s._status = -1;
-        s._et->MutexUnlock();
-        if (s._status < 0) break;
-
-        // Transform coordinates from global to the region-of-interest
-        //
-        vector<size_t> roi_start = vector_sub(start, aligned_start);
-        vector<size_t> roi_origin = vector_sub(s._start, aligned_start);
-
-        U *blockptr = (U *)s._block;
-
-        // Transform from wavelet to physical space
+        UnBlock(block, io._bs, data, io._count, roi_origin, roi_start);
+    } else {
+        // Don't unblock. Just copy.
         //
-        rc = ReconstructBlock(s._compressors[s._id], (U *)s._coeffs, datarange, s._maps, s._xtype, s._ncoeffs, s._encoded_dims, blockptr, vproduct(s._bs), s._level);
-        if (rc < 0) {
-            s._status = -1;
-            break;
-        }
-
-        if (unblock_flag) {
-            // Unblock the current block into the destination array
-            //
-            UnBlock(blockptr, s._bs, data, s._count, roi_origin, roi_start);
-        } else {
-            // Don't unblock. Just copy.
-            //
-            size_t offset = vproduct(s._bs) * i;
-            for (size_t j = 0; j < vproduct(s._bs); j++) { data[offset + j] = (T)blockptr[j]; }
-        }
+        size_t n = vproduct(io._bs);
+        size_t offset = n * i;
+        for (size_t j = 0; j < n; j++) { data[offset + j] = (T)block[j]; }
     }
-    return (NULL);
 }
-
-void *RunReadThreadCompressed(void *arg)
-{
-    thread_state &s = *(thread_state *)arg;
-
-    VAssert(s._block_type == NC_INT64 || s._block_type == NC_DOUBLE);
-
-    // Establish types for template functions. Data types aren't preserved
-    // when passed in thread_state, which must be cast to void to support
-    // pthread API :-(
-    //
-    switch (s._data_type) {
-    case NC_FLOAT: {
-        float dummy1 = 0.0;
-        if (s._block_type == NC_INT64) {
-            long dummy2 = 0;
-            return (RunReadThreadCompressedTemplate(s, dummy1, dummy2));
-        } else {
-            double dummy2 = 0;
-            return (RunReadThreadCompressedTemplate(s, dummy1, dummy2));
-        }
-    }
-    case NC_DOUBLE: {
-        double dummy1 = 0.0;
-        if (s._block_type == NC_INT64) {
-            long dummy2 = 0;
-            return (RunReadThreadCompressedTemplate(s, dummy1, dummy2));
-        } else {
-            double dummy2 = 0;
-            return (RunReadThreadCompressedTemplate(s, dummy1, dummy2));
-        }
-    }
-    case NC_INT: {
-        int dummy1 = 0;
-        if (s._block_type == NC_INT64) {
-            long dummy2 = 0;
-            return (RunReadThreadCompressedTemplate(s, dummy1, dummy2));
-        } else {
-            double dummy2 = 0;
-            return (RunReadThreadCompressedTemplate(s, dummy1, dummy2));
-        }
-    }
-    case NC_SHORT: {
-        int16_t dummy1 = 0;
-        if (s._block_type == NC_INT64) {
-            long dummy2 = 0;
-            return (RunReadThreadCompressedTemplate(s, dummy1, dummy2));
-        } else {
-            double dummy2 = 0;
-            return (RunReadThreadCompressedTemplate(s, dummy1, dummy2));
-        }
-    }
-    case NC_BYTE:
-    case NC_UBYTE: {
-        int8_t dummy1 = 0;
-        if (s._block_type == NC_INT64) {
-            long dummy2 = 0;
-            return (RunReadThreadCompressedTemplate(s, dummy1, dummy2));
-        } else {
-            double dummy2 = 0;
-            return (RunReadThreadCompressedTemplate(s, dummy1, dummy2));
-        }
-    }
-    default: VAssert(0); return (NULL);
-    }
-}
-
 };    // namespace
 
-WASP::WASP(int nthreads)
+WASP::WASP(int nthreads) : WASP(new TaskPool(nthreads)) { _ownPool = true; }
+
+WASP::WASP(TaskPool *pool)
 {
     _ncdfcs.clear();
     _ncdfcptrs.clear();
@@ -1414,20 +1124,14 @@ WASP::WASP(int nthreads)
     _open_write = false;
     _open_varname.clear();
 
-    _et = NULL;
-
-    // Set up execution threads for parallel execution
-    //
-    if (nthreads < 1) nthreads = EasyThreads::NProc();
-    if (nthreads < 1) nthreads = 1;
+    _pool = pool;
+    _ownPool = false;
 
-    _et = new EasyThreads(nthreads);
-
-    _nthreads = _et->GetNumThreads() > 0 ? _et->GetNumThreads() : 1;
+    _nthreads = _pool->GetNumThreads();
 
     // One Compressor instance for each thread
     //
-    _open_compressors.resize(nthreads, NULL);
+    _open_compressors.resize(_nthreads, NULL);
 }
 
 WASP::~WASP()
@@ -1435,7 +1139,7 @@ WASP::~WASP()
     for (int i = 0; i < _open_compressors.size(); i++) {
         if (_open_compressors[i]) delete _open_compressors[i];
     }
-    if (_et) delete _et;
+    if (_pool && _ownPool) delete _pool;
 }
 
 int WASP::Create(string path, int cmode, size_t initialsz, size_t &bufrsizehintp, int numfiles)
@@ -2310,44 +2014,31 @@ template<class T, class U> int WASP::_PutVara(vector<size_t> start, vector<size_
         maps = (unsigned char *)_sigbuf.Alloc(maps_size * _nthreads * NetCDFCpp::SizeOf(_open_varxtype));
     }
 
-    // Ugh. Can't preserve type in thread_state, which has to be passed
-    // as a void * to thread library
-    //
-    int data_type = _NetCDFType(*data);
-    int block_type = _NetCDFType(*block);
+    block_io  io(_open_varname, _ncdfcptrs, start, count, _open_bs, ncoeffs, encoded_dims, _open_varxtype, 0);
+    vectorinc vec(start, count, _open_udims, _open_bs);
 
     //
-    // Set up thread state for parallel (threaded) execution
+    // Process blocks in parallel. Each worker has its own Compressor and
+    // block buffers.
     //
-    vector<void *> argvec;
-    for (int i = 0; i < _nthreads; i++) {
-        argvec.push_back((void *)new thread_state(i, _et, _nthreads, _open_varname, _ncdfcptrs, start, count, _open_bs, _open_udims, ncoeffs, encoded_dims, _open_compressors, (void *)data, data_type,
-                                                  (unsigned char *)mask, block + i * block_size, coeffs + i * coeffs_size, block_type, _open_varxtype,
-                                                  maps + i * maps_size * NetCDFCpp::SizeOf(_open_varxtype), 0, true));
-    }
+    if (_open_wname.empty()) {
+        _pool->ParFor(vec.num(), [&](int w, size_t i) {
+            if (io._status < 0) return;
 
-    if (_nthreads == 1) {
-        if (_open_wname.empty()) {
-            RunWriteThread(argvec[0]);
-        } else {
-            RunWriteThreadCompressed(argvec[0]);
-        }
+            T *blkptr = (T *)(block + w * block_size);
+            if (WriteBlock(io, vec, i, data, blkptr) < 0) io._status = -1;
+        });
     } else {
-        int rc;
-        if (_open_wname.empty()) {
-            rc = _et->ParRun(RunWriteThread, argvec);
-        } else {
-            rc = _et->ParRun(RunWriteThreadCompressed, argvec);
-        }
+        size_t maps_bytes = maps_size * NetCDFCpp::SizeOf(_open_varxtype);
 
-        if (rc < 0) {
-            SetErrMsg("Error spawning threads");
-            return (-1);
-        }
+        _pool->ParFor(vec.num(), [&](int w, size_t i) {
+            if (io._status < 0) return;
+
+            if (WriteBlockCompressed(io, vec, i, data, mask, _open_compressors[w], block + w * block_size, coeffs + w * coeffs_size, maps + w * maps_bytes) < 0) { io._status = -1; }
+        });
     }
-    for (int i = 0; i < argvec.size(); i++) delete (thread_state *)argvec[i];
 
-    return (thread_state::_status);
+    return (io._status);
 }
 
 template<class T> int WASP::_PutVara(vector<size_t> start, vector<size_t> count, const T *data, const unsigned char *mask)
@@ -2502,16 +2193,25 @@ template<class T, class U> int WASP::_GetVara(vector<size_t> start, vector<size_
         return (-1);
     }
 
+    // Blocks are read from disk by the calling thread into one of
+    // 'nslots' buffers, and decoded by the task pool as soon as they
+    // have been read. Thus reading of block i+1 overlaps with decoding of
+    // block i. Each worker has its own Compressor and reconstruction
+    // buffer.
+    //
+    int nslots = 2 * _nthreads;
+
     size_t block_size = vproduct(bs_at_level);
 
-    // Need temporary space for storing reconstructed data
+    // Need temporary space for storing reconstructed (compressed case) or
+    // read (uncompressed case) data
     //
     U *block = NULL;
-    block = (U *)_blockbuf.Alloc(block_size * _nthreads * sizeof(U));
+    block = (U *)_blockbuf.Alloc(block_size * max(_nthreads, nslots) * sizeof(U));
 
     size_t         coeffs_size = 0;
     U *            coeffs = NULL;
-    size_t         maps_size = 0;
+    size_t         maps_bytes = 0;
     unsigned char *maps = NULL;
     if (!_open_wname.empty()) {
         // Handle case where not all coefficients are wanted
@@ -2522,53 +2222,97 @@ template<class T, class U> int WASP::_GetVara(vector<size_t> start, vector<size_
         }
 
         coeffs_size = vsum(ncoeffs);
-        coeffs = (U *)_coeffbuf.Alloc(coeffs_size * _nthreads * sizeof(U));
+        coeffs = (U *)_coeffbuf.Alloc(coeffs_size * nslots * sizeof(U));
 
-        maps_size = vsum(encoded_dims) - vsum(ncoeffs);
+        size_t maps_size = vsum(encoded_dims) - vsum(ncoeffs);
         maps_size -= BLK_HDR_SZ;
-        maps = (unsigned char *)_sigbuf.Alloc(maps_size * _nthreads * NetCDFCpp::SizeOf(_open_varxtype));
+        maps_bytes = maps_size * NetCDFCpp::SizeOf(_open_varxtype);
+        maps = (unsigned char *)_sigbuf.Alloc(maps_bytes * nslots);
     }
+    vector<U> dataranges(2 * nslots);
 
-    // Ugh. Can't preserve type in thread_state, which has to be passed
-    // as a void * to thread library
+    // Align start and count coordinates to block boundaries
     //
-    int data_type = _NetCDFType(*data);
-    int block_type = _NetCDFType(*block);
+    vector<size_t> aligned_start;
+    vector<size_t> aligned_count;
+    block_align(start, count, bs_at_level, aligned_start, aligned_count);
 
+    vectorinc vec(aligned_start, aligned_count, dims_at_level, bs_at_level);
+    size_t    n = vec.num();
+
+    // Transform coordinates from global to the region-of-interest
     //
-    // Set up thread state for parallel (threaded) execution
-    //
-    vector<void *> argvec;
-    for (int i = 0; i < _nthreads; i++) {
-        U *blkptr = block + i * block_size;
+    vector<size_t> roi_origin = vector_sub(start, aligned_start);
 
-        argvec.push_back((void *)new thread_state(i, _et, _nthreads, _open_varname, _ncdfcptrs, start, count, bs_at_level, dims_at_level, ncoeffs, encoded_dims, _open_compressors, data, data_type,
-                                                  NULL, blkptr, coeffs + i * coeffs_size, block_type, _open_varxtype, maps + i * maps_size * NetCDFCpp::SizeOf(_open_varxtype), _open_level,
-                                                  unblock_flag));
-    }
+    block_io io(_open_varname, _ncdfcptrs, start, count, bs_at_level, ncoeffs, encoded_dims, _open_varxtype, _open_level);
 
-    if (_nthreads == 1) {
-        if (_open_wname.empty()) {
-            RunReadThread(argvec[0]);
-        } else {
-            RunReadThreadCompressed(argvec[0]);
-        }
+    slot_pool              slots(nslots);
+    vector<int>            slot_of(n);       // slot holding i'th block
+    vector<vector<size_t>> roi_starts(n);    // ROI coordinates of i'th block
+
+    if (_open_wname.empty()) {
+        _pool->Begin([&](int w, size_t i) {
+            int slot = slot_of[i];
+            if (io._status >= 0) {
+                T *blkptr = (T *)(block + slot * block_size);
+                StoreReadBlock(io, i, roi_origin, roi_starts[i], unblock_flag, blkptr, data);
+            }
+            slots.Release(slot);
+        });
     } else {
+        _pool->Begin([&](int w, size_t i) {
+            int slot = slot_of[i];
+            if (io._status >= 0) {
+                U *blkptr = block + w * block_size;
+
+                // Transform from wavelet to physical space
+                //
+                int rc = ReconstructBlock(_open_compressors[w], coeffs + slot * coeffs_size, &dataranges[2 * slot], maps + slot * maps_bytes, io._xtype, io._ncoeffs, io._encoded_dims, blkptr,
+                                          block_size, io._level);
+                if (rc < 0) {
+                    io._status = -1;
+                } else {
+                    StoreReadBlock(io, i, roi_origin, roi_starts[i], unblock_flag, blkptr, data);
+                }
+            }
+            slots.Release(slot);
+        });
+    }
+
+    for (size_t i = 0; i < n && io._status >= 0; i++) {
+        size_t         offset;
+        vector<size_t> start;
+        vec.ith(i, start, offset);
+
+        vector<size_t> bcoords;
+        size_t         residual;
+        to_block_coords(start, bs_at_level, bcoords, residual);
+        VAssert(residual == 0);
+
+        roi_starts[i] = vector_sub(start, aligned_start);
+
+        // Read the block from disk into a free slot. Only this thread
+        // performs NetCDF I/O, so no mutex is needed.
+        //
+        int slot = slots.Acquire();
         int rc;
         if (_open_wname.empty()) {
-            rc = _et->ParRun(RunReadThread, argvec);
+            rc = FetchBlock(_open_varname, _ncdfcptrs[0], bcoords, encoded_dims[0], (T *)(block + slot * block_size));
         } else {
-            rc = _et->ParRun(RunReadThreadCompressed, argvec);
+            rc = FetchBlockCompressed(_open_varname, _ncdfcptrs, bcoords, ncoeffs, encoded_dims, coeffs + slot * coeffs_size, &dataranges[2 * slot], maps + slot * maps_bytes, _open_varxtype);
         }
         if (rc < 0) {
-            SetErrMsg("Error spawning threads");
-            return (-1);
+            io._status = -1;
+            slots.Release(slot);
+            break;
         }
-    }
 
-    for (int i = 0; i < argvec.size(); i++) delete (thread_state *)argvec[i];
+        slot_of[i] = slot;
+        _pool->Push(i);
+    }
+    _pool->Wait();
 
-    return (thread_state::_status);
+    return (io._status);
 }
 
 template<class T> int WASP::_GetVara(vector<size_t> start, vector<size_t> count, bool unblock_flag, T *data)
@@ -0,0 +1,140 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <random>
+#include <array>
+#include <algorithm>
+
+#include "vapor/RegularGrid.h"
+#include "vapor/GridStatistics.h"
+#include "vapor/OpenMPSupport.h"
+
+// Allocate a bunch of raw pointers.
+// The caller will need to delete[] them.
+//
+auto AllocateBlocks(std::array<size_t, 3> bs, std::array<size_t, 3> dims) -> std::vector<float*>
+{
+    size_t block_size = 1;
+    size_t nblocks = 1;
+
+    for (size_t i = 0; i < bs.size(); i++) {
+        block_size *= bs[i];
+        nblocks *= ((dims[i] - 1) / bs[i]) + 1;
+    }
+
+    auto blks = std::vector<float*>(nblocks, nullptr);
+    for (size_t i = 0; i < nblocks; i++)
+      blks[i] = new float[block_size];
+
+    return (blks);
+}
+
+// The statistics as computed by the Statistics dialog of VAPOR release
+// 3.6: gather the valid values, sort them for the median, and make a
+// second pass for the standard deviation
+//
+void Statistics_36(VAPoR::Grid* g, const VAPoR::CoordType& minu, const VAPoR::CoordType& maxu, double stats[5], size_t& count)
+{
+    float missingValue = g->GetMissingValue();
+    std::vector<float> buffer;
+    double sum = 0.0;
+    for (auto itr = g->cbegin(minu, maxu); itr != g->cend(); ++itr) {
+        if (*itr != missingValue) {
+            buffer.push_back(*itr);
+            sum += *itr;
+        }
+    }
+    count = buffer.size();
+    if (!count) return;
+
+    double mean = sum / count;
+    double m2 = 0.0;
+    for (auto v : buffer) m2 += (v - mean) * (v - mean);
+
+    std::sort(buffer.begin(), buffer.end());
+    stats[0] = buffer.front();
+    stats[1] = buffer.back();
+    stats[2] = mean;
+    stats[3] = buffer[(count - 1) / 2];
+    stats[4] = std::sqrt(m2 / count);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 2) {
+    std::cout << "Help:  This program compares the statistics (min, max, mean, median, stddev)\n"
+                 "       computed with a serial sort, and with a single parallel (OpenMP)\n"
+                 "       pass, over a subregion of a regular grid of size (Dim x Dim x Dim).\n"
+                 "Note:  the environment variable OMP_NUM_THREADS controls the number of threads.\n"
+                 "Usage: ./GridStatistics Dim\n";
+    return 1;
+  }
+  const size_t dim = std::stol(argv[1]);
+  const auto dims = std::array<size_t, 3>{dim, dim, dim};
+  size_t num_threads = 1;
+
+#pragma omp parallel
+  {
+    if (omp_get_thread_num() == 0)
+      num_threads = omp_get_num_threads();
+  }
+  std::printf("Testing a grid of size (%ld, %ld, %ld), using %ld threads...\n",
+              dim, dim, dim, num_threads);
+
+  // Create a grid to test
+  const auto blk_size = std::array<size_t, 3>{64, 64, 64};
+  auto blks = AllocateBlocks(blk_size, dims);
+  auto* grid = new VAPoR::RegularGrid(dims, blk_size, blks, {0.0, 0.0, 0.0}, {100.0, 100.0, 100.0});
+  grid->SetMissingValue(-999.0);
+  grid->SetHasMissingValues(true);
+
+  // Fill in skewed random values, a few of them missing
+  std::mt19937 gen(0);
+  std::exponential_distribution<float> dist(1.0);
+  std::uniform_real_distribution<float> coin(0.0, 1.0);
+  for (auto itr = grid->begin(); itr != grid->end(); ++itr)
+    *itr = coin(gen) < 0.05 ? -999.0 : 1000.0 + dist(gen);
+
+  const VAPoR::CoordType minu = {10.0, 20.0, 5.0};
+  const VAPoR::CoordType maxu = {90.0, 70.0, 95.0};
+
+  // Time a serial run
+  double stats_36[5] = {0.0, 0.0, 0.0, 0.0, 0.0};
+  size_t count_36 = 0;
+  const auto serial_start = std::chrono::steady_clock::now();
+  Statistics_36(grid, minu, maxu, stats_36, count_36);
+  const auto serial_end = std::chrono::steady_clock::now();
+  const auto serial_time = std::chrono::duration_cast<std::chrono::milliseconds>(serial_end - serial_start).count();
+  std::cout << "Statistics in serial time (milliseconds): " << serial_time << std::endl;
+
+  // Time a parallel run
+  VAPoR::GridStatistics gs;
+  const auto omp_start = std::chrono::steady_clock::now();
+  gs.Add(grid, minu, maxu);
+  const auto omp_end = std::chrono::steady_clock::now();
+  const auto omp_time = std::chrono::duration_cast<std::chrono::milliseconds>(omp_end - omp_start).count();
+  std::cout << "GridStatistics in OpenMP time (milliseconds): " << omp_time << std::endl;
+
+  const double stats_omp[5] = {gs.GetMin(), gs.GetMax(), gs.GetMean(), gs.GetQuantile(0.5), gs.GetStddev()};
+  const double tolerance[5] = {0.0, 0.0, 1e-9 * std::fabs(stats_36[2]), gs.GetBinWidth(), 1e-9 * stats_36[4]};
+  const char* names[5] = {"Min", "Max", "Mean", "Median", "StdDev"};
+  bool ok = gs.GetCount() == count_36;
+  std::printf("Count: %ld %ld\n", count_36, gs.GetCount());
+  for (int i = 0; i < 5; i++) {
+    std::printf("%s: %.9g %.9g\n", names[i], stats_36[i], stats_omp[i]);
+    if (std::fabs(stats_36[i] - stats_omp[i]) > tolerance[i]) ok = false;
+  }
+  std::cout << (ok ? "PASS" : "FAIL") << std::endl;
+
+  // Clean up
+  delete grid;
+  grid = nullptr;
+  for (size_t i = 0; i < blks.size(); i++) {
+    delete[](blks[i]);
+    blks[i] = nullptr;
+  }
+
+  return (ok ? 0 : 1);
+}
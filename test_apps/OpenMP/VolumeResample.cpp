@@ -0,0 +1,185 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <array>
+#include <algorithm>
+
+#include "vapor/RegularGrid.h"
+#include "vapor/CurvilinearGrid.h"
+#include "vapor/OpenMPSupport.h"
+
+// Allocate a bunch of raw pointers.
+// The caller will need to delete[] them.
+//
+auto AllocateBlocks(std::array<size_t, 3> bs, std::array<size_t, 3> dims) -> std::vector<float*>
+{
+    size_t block_size = 1;
+    size_t nblocks = 1;
+
+    for (size_t i = 0; i < bs.size(); i++) {
+        block_size *= bs[i];
+        nblocks *= ((dims[i] - 1) / bs[i]) + 1;
+    }
+
+    auto blks = std::vector<float*>(nblocks, nullptr);
+    for (size_t i = 0; i < nblocks; i++)
+      blks[i] = new float[block_size];
+
+    return (blks);
+}
+
+void FreeBlocks(std::vector<float*>& blks)
+{
+    for (size_t i = 0; i < blks.size(); i++) {
+        delete[](blks[i]);
+        blks[i] = nullptr;
+    }
+}
+
+// Resample the grid onto a regular lattice spanning its extents, one
+// voxel at a time, as VolumeResampled::LoadData did in VAPOR release 3.6
+//
+void Resample_36(const VAPoR::Grid* grid, size_t w, size_t h, size_t d, float* data)
+{
+    VAPoR::CoordType min, max;
+    grid->GetUserExtents(min, max);
+
+    for (size_t z = 0; z < d; z++) {
+        const float zSamplePos = (z + 0.5f) / (float)d * (max[2] - min[2]) + min[2];
+        for (size_t y = 0; y < h; y++) {
+            const float ySamplePos = (y + 0.5f) / (float)h * (max[1] - min[1]) + min[1];
+            for (size_t x = 0; x < w; x++) {
+                const float xSamplePos = (x + 0.5f) / (float)w * (max[0] - min[0]) + min[0];
+                data[z * w * h + y * w + x] = grid->GetValue(xSamplePos, ySamplePos, zSamplePos);
+            }
+        }
+    }
+}
+
+// Resample as VolumeResampled::LoadData does now: z slices in parallel,
+// each sampled with a single batched call
+//
+void Resample(const VAPoR::Grid* grid, size_t w, size_t h, size_t d, float* data)
+{
+    VAPoR::CoordType min, max;
+    grid->GetUserExtents(min, max);
+
+    std::vector<float> xs(w), ys(h);
+    for (size_t x = 0; x < w; x++) xs[x] = (x + 0.5f) / (float)w * (max[0] - min[0]) + min[0];
+    for (size_t y = 0; y < h; y++) ys[y] = (y + 0.5f) / (float)h * (max[1] - min[1]) + min[1];
+
+#pragma omp parallel
+    {
+        std::vector<double> xyz(w * h * 3);
+
+#pragma omp for schedule(dynamic)
+        for (long z = 0; z < (long)d; z++) {
+            const float zSamplePos = (z + 0.5f) / (float)d * (max[2] - min[2]) + min[2];
+            for (size_t i = 0; i < w * h; i++) {
+                xyz[3 * i] = xs[i % w];
+                xyz[3 * i + 1] = ys[i / w];
+                xyz[3 * i + 2] = zSamplePos;
+            }
+            grid->GetValues(xyz.data(), w * h, data + z * w * h);
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 2) {
+    std::cout << "Help:  This program compares resampling a terrain following curvilinear\n"
+                 "       grid of size (Dim x Dim x Dim) onto a regular grid, one voxel at\n"
+                 "       a time, and one z slice at a time in parallel (OpenMP).\n"
+                 "Note:  the environment variable OMP_NUM_THREADS controls the number of threads.\n"
+                 "Usage: ./VolumeResample Dim\n";
+    return 1;
+  }
+  const size_t dim = std::stol(argv[1]);
+  const auto dims = std::array<size_t, 3>{dim, dim, dim};
+  const auto dims2d = std::array<size_t, 3>{dim, dim, 1};
+  size_t num_threads = 1;
+
+#pragma omp parallel
+  {
+    if (omp_get_thread_num() == 0)
+      num_threads = omp_get_num_threads();
+  }
+  std::printf("Testing a grid of size (%ld, %ld, %ld), using %ld threads...\n",
+              dim, dim, dim, num_threads);
+
+  // Sheared and warped horizontal coordinates, and terrain following
+  // vertical coordinates, as in a WRF grid
+  //
+  const auto blk_size = std::array<size_t, 3>{64, 64, 64};
+  const auto blk_size2d = std::array<size_t, 3>{64, 64, 1};
+  auto xblks = AllocateBlocks(blk_size2d, dims2d);
+  auto yblks = AllocateBlocks(blk_size2d, dims2d);
+  auto zblks = AllocateBlocks(blk_size, dims);
+  auto blks = AllocateBlocks(blk_size, dims);
+  VAPoR::RegularGrid xrg(dims2d, blk_size2d, xblks, {0.0, 0.0, 0.0}, {1.0, 1.0, 0.0});
+  VAPoR::RegularGrid yrg(dims2d, blk_size2d, yblks, {0.0, 0.0, 0.0}, {1.0, 1.0, 0.0});
+  VAPoR::RegularGrid zrg(dims, blk_size, zblks, {0.0, 0.0, 0.0}, {1.0, 1.0, 1.0});
+
+  const double h = 100.0 / (dim - 1);
+  for (size_t j = 0; j < dim; j++) {
+    for (size_t i = 0; i < dim; i++) {
+      xrg.SetValueIJK(i, j, 0, i * h + 0.2 * j * h + 3.0 * std::sin(j * h * 0.05));
+      yrg.SetValueIJK(i, j, 0, j * h + 2.0 * std::sin(i * h * 0.07));
+      const double terrain = 10.0 + 5.0 * std::sin(i * h * 0.1) * std::cos(j * h * 0.1);
+      for (size_t k = 0; k < dim; k++) zrg.SetValueIJK(i, j, k, terrain + k * (100.0 - terrain) / (dim - 1));
+    }
+  }
+  auto* grid = new VAPoR::CurvilinearGrid(dims, blk_size, blks, xrg, yrg, zrg, nullptr);
+  grid->SetMissingValue(-999.0);
+  grid->SetHasMissingValues(true);
+  for (size_t k = 0; k < dim; k++)
+    for (size_t j = 0; j < dim; j++)
+      for (size_t i = 0; i < dim; i++)
+        grid->SetValueIJK(i, j, k, std::sin(i * 0.1) + std::cos(j * 0.13) + k * 0.01);
+
+  const size_t n = dim * dim * dim;
+  std::vector<float> data_36(n), data_omp(n);
+
+  // Time a serial run
+  const auto serial_start = std::chrono::steady_clock::now();
+  Resample_36(grid, dim, dim, dim, data_36.data());
+  const auto serial_end = std::chrono::steady_clock::now();
+  const auto serial_time = std::chrono::duration_cast<std::chrono::milliseconds>(serial_end - serial_start).count();
+  std::cout << "Resampling in serial time (milliseconds): " << serial_time << std::endl;
+
+  // Time a parallel run
+  const auto omp_start = std::chrono::steady_clock::now();
+  Resample(grid, dim, dim, dim, data_omp.data());
+  const auto omp_end = std::chrono::steady_clock::now();
+  const auto omp_time = std::chrono::duration_cast<std::chrono::milliseconds>(omp_end - omp_start).count();
+  std::cout << "Resampling in OpenMP time (milliseconds): " << omp_time << std::endl;
+
+  // Points near the edges of cells may be interpolated within either
+  // cell, which agree to rounding error
+  //
+  size_t missing = 0, differ = 0;
+  float maxdiff = 0.0;
+  for (size_t i = 0; i < n; i++) {
+    if (data_36[i] == -999.0) missing++;
+    if (data_36[i] == data_omp[i]) continue;
+    differ++;
+    if (data_36[i] == -999.0 || data_omp[i] == -999.0) maxdiff = INFINITY;
+    else maxdiff = std::max(maxdiff, std::fabs(data_36[i] - data_omp[i]));
+  }
+  std::printf("Samples: %ld, missing: %ld, differing: %ld, max difference: %g\n", n, missing, differ, maxdiff);
+  const bool ok = maxdiff < 1e-4;
+  std::cout << (ok ? "PASS" : "FAIL") << std::endl;
+
+  // Clean up
+  delete grid;
+  grid = nullptr;
+  FreeBlocks(xblks);
+  FreeBlocks(yblks);
+  FreeBlocks(zblks);
+  FreeBlocks(blks);
+
+  return (ok ? 0 : 1);
+}
@@ -0,0 +1,162 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include "vapor/VAssert.h"
+
+#include <vapor/MyBase.h>
+#include <vapor/ParamsMgr.h>
+#include <vapor/AnimationParams.h>
+#include <vapor/OptionParser.h>
+#include <vapor/FileUtils.h>
+
+using namespace Wasp;
+using namespace VAPoR;
+
+struct {
+    int                     nsteps;
+    OptionParser::Boolean_T help;
+    OptionParser::Boolean_T debug;
+} opt;
+
+OptionParser::OptDescRec_T set_opts[] = {{"nsteps", 1, "120", "Number of changes to make. More than the undo stack holds trims the stack"},
+                                         {"help", 0, "", "Print this message and exit"},
+                                         {"debug", 0, "", "Debug mode"},
+                                         {NULL}};
+
+OptionParser::Option_T get_options[] = {{"nsteps", Wasp::CvtToInt, &opt.nsteps, sizeof(opt.nsteps)},
+                                        {"help", Wasp::CvtToBoolean, &opt.help, sizeof(opt.help)},
+                                        {"debug", Wasp::CvtToBoolean, &opt.debug, sizeof(opt.debug)},
+                                        {NULL}};
+
+const char *ProgName;
+
+// Undo and Redo replace the params objects, so they must be looked up
+// again after each
+//
+AnimationParams *get_aparams(ParamsMgr *pm) { return ((AnimationParams *)pm->GetParams(AnimationParams::GetClassType())); }
+
+size_t get_ts(ParamsMgr *pm) { return (get_aparams(pm)->GetCurrentTimestep()); }
+
+// Make more changes than the undo stack holds, then undo all of them.
+// Undoing the oldest retained step returns to the state when the stack
+// was last cleared. Redo must then restore every step
+//
+int test_trimmed_stack(ParamsMgr *pm)
+{
+    cout << "Trimmed stack" << endl;
+
+    int    nwrong = 0;
+    size_t nsteps = opt.nsteps;
+
+    get_aparams(pm)->SetCurrentTimestep(0);
+    pm->UndoRedoClear();
+
+    for (size_t i = 1; i <= nsteps; i++) get_aparams(pm)->SetCurrentTimestep(i);
+
+    size_t nundo = pm->UndoSize();
+    if (nundo == 0 || nundo > nsteps) nwrong++;
+
+    for (size_t i = 1; i < nundo; i++) {
+        if (!pm->Undo()) nwrong++;
+        if (get_ts(pm) != nsteps - i) nwrong++;
+    }
+
+    if (!pm->Undo()) nwrong++;
+    if (get_ts(pm) != 0) nwrong++;
+    if (pm->Undo()) nwrong++;
+    if (pm->UndoSize() != 0 || pm->RedoSize() != nundo) nwrong++;
+
+    for (size_t i = 0; i < nundo; i++) {
+        if (!pm->Redo()) nwrong++;
+    }
+    if (get_ts(pm) != nsteps) nwrong++;
+    if (pm->Redo()) nwrong++;
+
+    // Undo and redo within the retained steps
+    //
+    if (!pm->Undo() || get_ts(pm) != nsteps - 1) nwrong++;
+    if (!pm->Redo() || get_ts(pm) != nsteps) nwrong++;
+
+    cout << "\tNum wrong : " << nwrong << endl;
+    return (nwrong);
+}
+
+// After UndoRedoClear() nothing can be undone, and new changes undo back
+// to the state at the time of the clear
+//
+int test_clear(ParamsMgr *pm)
+{
+    cout << "Clear" << endl;
+
+    int nwrong = 0;
+
+    get_aparams(pm)->SetCurrentTimestep(10);
+    get_aparams(pm)->SetCurrentTimestep(11);
+    pm->Undo();
+
+    pm->UndoRedoClear();
+    if (pm->UndoSize() != 0 || pm->RedoSize() != 0) nwrong++;
+    if (pm->Undo() || pm->Redo()) nwrong++;
+    if (get_ts(pm) != 10) nwrong++;
+
+    get_aparams(pm)->SetCurrentTimestep(20);
+    get_aparams(pm)->SetStartTimestep(2);
+    get_aparams(pm)->SetCurrentTimestep(21);
+    if (pm->UndoSize() != 3) nwrong++;
+
+    if (!pm->Undo() || get_ts(pm) != 20) nwrong++;
+    if (!pm->Undo() || get_ts(pm) != 20 || get_aparams(pm)->GetStartTimestep() == 2) nwrong++;
+    if (!pm->Undo() || get_ts(pm) != 10) nwrong++;
+    if (pm->Undo()) nwrong++;
+
+    if (!pm->Redo() || get_ts(pm) != 20) nwrong++;
+    if (!pm->Redo() || get_aparams(pm)->GetStartTimestep() != 2) nwrong++;
+
+    // A new change discards the redo steps
+    //
+    get_aparams(pm)->SetCurrentTimestep(30);
+    if (pm->RedoSize() != 0 || pm->Redo()) nwrong++;
+    if (!pm->Undo() || get_ts(pm) != 20) nwrong++;
+
+    cout << "\tNum wrong : " << nwrong << endl;
+    return (nwrong);
+}
+
+int main(int argc, char **argv)
+{
+    OptionParser op;
+
+    ProgName = FileUtils::LegacyBasename(argv[0]);
+
+    MyBase::SetErrMsgFilePtr(stderr);
+
+    if (op.AppendOptions(set_opts) < 0) {
+        cerr << ProgName << " : " << op.GetErrMsg();
+        exit(1);
+    }
+
+    if (op.ParseOptions(&argc, argv, get_options) < 0) {
+        cerr << ProgName << " : " << op.GetErrMsg();
+        exit(1);
+    }
+
+    if (opt.help) {
+        cerr << "Usage: " << ProgName << endl;
+        op.PrintOptionHelp(stderr);
+        exit(0);
+    }
+
+    if (opt.debug) { MyBase::SetDiagMsgFilePtr(stderr); }
+
+    ParamsMgr *pm = new ParamsMgr();
+    pm->SetSaveStateEnabled(true);
+
+    int nwrong = 0;
+    nwrong += test_trimmed_stack(pm);
+    nwrong += test_clear(pm);
+
+    delete pm;
+
+    return (nwrong ? 1 : 0);
+}
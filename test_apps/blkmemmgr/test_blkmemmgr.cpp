@@ -0,0 +1,182 @@
+#include <iostream>
+#include <string>
+#include <cstring>
+#include "vapor/VAssert.h"
+
+#include <vapor/FileUtils.h>
+#include <vapor/OptionParser.h>
+#include <vapor/BlkMemMgr.h>
+
+using namespace std;
+
+using namespace Wasp;
+using namespace VAPoR;
+
+struct {
+    int                     blksize;
+    OptionParser::Boolean_T help;
+} opt;
+
+OptionParser::OptDescRec_T set_opts[] = {{"blksize", 1, "64", "Size of a memory block in bytes"}, {"help", 0, "", "Print this message and exit"}, {NULL}};
+
+OptionParser::Option_T get_options[] = {{"blksize", Wasp::CvtToInt, &opt.blksize, sizeof(opt.blksize)}, {"help", Wasp::CvtToBoolean, &opt.help, sizeof(opt.help)}, {NULL}};
+
+const char *ProgName;
+
+size_t num_wrong = 0;
+
+void check(bool ok, const string &what)
+{
+    if (ok) return;
+    cout << "	FAILED : " << what << endl;
+    num_wrong++;
+}
+
+void check_stats(const string &test, size_t total, size_t free, size_t largest, size_t nruns, size_t nallocs)
+{
+    BlkMemMgr::Stats s = BlkMemMgr::GetStats();
+    check(s.total_blks == total, test + " total_blks");
+    check(s.free_blks == free, test + " free_blks");
+    check(s.largest_free_run == largest, test + " largest_free_run");
+    check(s.num_free_runs == nruns, test + " num_free_runs");
+    check(s.num_allocs == nallocs, test + " num_allocs");
+}
+
+// The first allocation sizes the pool's first arena to the request, so
+// allocating and freeing all of a pool of n blocks leaves a single free
+// run of n blocks
+//
+unsigned char *fill_pool(BlkMemMgr &mgr, size_t n)
+{
+    unsigned char *p = (unsigned char *)mgr.Alloc(n);
+    check(p != NULL, "allocate pool");
+    if (p) mgr.FreeMem(p);
+    return (p);
+}
+
+// A request must be satisfied by a free run of exactly its size, even
+// though the run's size class also holds smaller runs
+//
+void test_exact_fit()
+{
+    const size_t bs = opt.blksize;
+    BlkMemMgr::RequestMemSize(bs, 100);
+    BlkMemMgr mgr;
+
+    unsigned char *p = (unsigned char *)mgr.Alloc(97);
+    check(p != NULL, "exact fit Alloc(97) from a pool of 100 blocks");
+    check_stats("exact fit", 97, 0, 0, 0, 1);
+    if (!p) return;
+
+    mgr.FreeMem(p);
+    check_stats("exact fit freed", 97, 97, 97, 1, 0);
+
+    unsigned char *q = (unsigned char *)mgr.Alloc(97);
+    check(q == p, "exact fit reuses the freed run");
+    if (q) mgr.FreeMem(q);
+
+    cout << "	Exact fit done" << endl;
+}
+
+// Requests smaller than a free run are taken from its start, and the
+// remainder stays free
+//
+void test_split()
+{
+    const size_t bs = opt.blksize;
+    BlkMemMgr::RequestMemSize(bs, 100);
+    BlkMemMgr mgr;
+
+    unsigned char *base = fill_pool(mgr, 100);
+    if (!base) return;
+
+    unsigned char *a = (unsigned char *)mgr.Alloc(30, true);
+    check(a == base, "split takes the start of the run");
+    check_stats("split", 100, 70, 70, 1, 1);
+
+    bool zero = true;
+    for (size_t i = 0; a && i < 30 * bs; i++) zero = zero && a[i] == 0;
+    check(zero, "fill clears the allocation");
+
+    unsigned char *b = (unsigned char *)mgr.Alloc(20);
+    check(b == base + 30 * bs, "split remainder is allocated next");
+    check_stats("split twice", 100, 50, 50, 1, 2);
+
+    check(mgr.Alloc(51) == NULL, "request larger than the pool fails");
+
+    mgr.FreeMem(a);
+    mgr.FreeMem(b);
+    check_stats("split freed", 100, 100, 100, 1, 0);
+
+    cout << "	Split done" << endl;
+}
+
+// Freed runs are merged with free neighbors on both sides
+//
+void test_coalesce()
+{
+    const size_t bs = opt.blksize;
+    BlkMemMgr::RequestMemSize(bs, 100);
+    BlkMemMgr mgr;
+
+    unsigned char *base = fill_pool(mgr, 100);
+    if (!base) return;
+
+    void *a = mgr.Alloc(10);
+    void *b = mgr.Alloc(10);
+    void *c = mgr.Alloc(10);
+    void *d = mgr.Alloc(70);
+    check(a == base && b == base + 10 * bs && c == base + 20 * bs && d == base + 30 * bs, "coalesce allocations are contiguous");
+    check_stats("coalesce full", 100, 0, 0, 0, 4);
+
+    mgr.FreeMem(a);
+    mgr.FreeMem(c);
+    check_stats("coalesce two holes", 100, 20, 10, 2, 2);
+    check(BlkMemMgr::GetStats().Fragmentation() == 0.5, "coalesce fragmentation");
+
+    // b joins a on its left and c on its right
+    //
+    mgr.FreeMem(b);
+    check_stats("coalesce both sides", 100, 30, 30, 1, 1);
+    check(BlkMemMgr::GetStats().Fragmentation() == 0.0, "coalesce no fragmentation");
+
+    mgr.FreeMem(d);
+    check_stats("coalesce all", 100, 100, 100, 1, 0);
+
+    check(mgr.Alloc(100) == base, "coalesced pool satisfies a full request");
+
+    cout << "	Coalesce done" << endl;
+}
+
+int main(int argc, char **argv)
+{
+    OptionParser op;
+
+    ProgName = FileUtils::LegacyBasename(argv[0]);
+
+    MyBase::SetErrMsgFilePtr(stderr);
+
+    if (op.AppendOptions(set_opts) < 0) {
+        cerr << ProgName << " : " << op.GetErrMsg();
+        exit(1);
+    }
+
+    if (op.ParseOptions(&argc, argv, get_options) < 0) {
+        cerr << ProgName << " : " << op.GetErrMsg();
+        exit(1);
+    }
+
+    if (opt.help) {
+        cerr << "Usage: " << ProgName << " [options] " << endl;
+        op.PrintOptionHelp(stderr);
+        exit(0);
+    }
+
+    test_exact_fit();
+    test_split();
+    test_coalesce();
+
+    cout << "	Num wrong : " << num_wrong << endl;
+
+    return (num_wrong ? 1 : 0);
+}
@@ -0,0 +1,207 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include "vapor/VAssert.h"
+
+#include <vapor/FileUtils.h>
+#include <vapor/OptionParser.h>
+#include <vapor/Compressor.h>
+#include <vapor/SignificanceMap.h>
+
+using namespace std;
+
+using namespace Wasp;
+using namespace VAPoR;
+
+struct {
+    int                     bs;
+    int                     nblocks;
+    string                  wname;
+    std::vector<int>        cratios;
+    OptionParser::Boolean_T help;
+} opt;
+
+OptionParser::OptDescRec_T set_opts[] = {{"bs", 1, "64", "Block dimension. Blocks are bs x bs x bs"},
+                                         {"nblocks", 1, "16", "Number of blocks to compress"},
+                                         {"wname", 1, "bior4.4", "Wavelet family"},
+                                         {"cratios", 1, "500:100:10:1", "Colon delimited list of compression ratios"},
+                                         {"help", 0, "", "Print this message and exit"},
+                                         {NULL}};
+
+OptionParser::Option_T get_options[] = {{"bs", Wasp::CvtToInt, &opt.bs, sizeof(opt.bs)},
+                                        {"nblocks", Wasp::CvtToInt, &opt.nblocks, sizeof(opt.nblocks)},
+                                        {"wname", Wasp::CvtToCPPStr, &opt.wname, sizeof(opt.wname)},
+                                        {"cratios", Wasp::CvtToIntVec, &opt.cratios, sizeof(opt.cratios)},
+                                        {"help", Wasp::CvtToBoolean, &opt.help, sizeof(opt.help)},
+                                        {NULL}};
+
+const char *ProgName;
+
+typedef std::chrono::steady_clock clk;
+
+double elapsed_ms(clk::time_point t0) { return (std::chrono::duration<double, std::milli>(clk::now() - t0).count()); }
+
+// Fill a block with a smooth field plus noise. Every fourth block is
+// piecewise constant, which produces many wavelet coefficients of equal
+// magnitude and exercises tie breaking.
+//
+void make_block(size_t b, size_t bs, vector<float> &block)
+{
+    srand48(b);
+    for (size_t z = 0; z < bs; z++) {
+        for (size_t y = 0; y < bs; y++) {
+            for (size_t x = 0; x < bs; x++) {
+                float v;
+                if (b % 4 == 3) {
+                    v = (float)((x / 8 + y / 16 + z / 4) % 3);
+                } else {
+                    double fx = (double)x / bs, fy = (double)y / bs, fz = (double)z / bs;
+                    v = sin(6.0 * fx + b) * cos(4.0 * fy) + 0.5 * sin(10.0 * fz * fx) + 0.05 * (drand48() - 0.5);
+                }
+                block[z * bs * bs + y * bs + x] = v;
+            }
+        }
+    }
+}
+
+// Compute the number of coefficients in each collection the same way
+// WASP does for a list of compression ratios.
+//
+vector<size_t> ncoeffs_from_cratios(const Compressor &cmp, const vector<int> &cratios)
+{
+    vector<size_t> ncoeffs;
+    size_t         ntotal = cmp.GetNumWaveCoeffs();
+    long           naccum = 0;
+    for (int i = 0; i < cratios.size(); i++) {
+        long n = ntotal / cratios[i];
+        if (n < (long)cmp.GetMinCompression()) n = cmp.GetMinCompression();
+        n -= naccum;
+        if (n < 1) n = 1;
+        naccum += n;
+        ncoeffs.push_back(n);
+    }
+    return (ncoeffs);
+}
+
+bool same_maps(vector<SignificanceMap> &a, vector<SignificanceMap> &b)
+{
+    if (a.size() != b.size()) return (false);
+    for (int i = 0; i < a.size(); i++) {
+        const unsigned char *ma, *mb;
+        size_t               la, lb;
+        a[i].GetMap(&ma, &la);
+        b[i].GetMap(&mb, &lb);
+        if (la != lb || memcmp(ma, mb, la) != 0) return (false);
+    }
+    return (true);
+}
+
+int test_compressor()
+{
+    size_t bs = opt.bs;
+    size_t nblocks = opt.nblocks;
+    VAssert(bs >= 1 && nblocks >= 1);
+
+    vector<size_t> dims(3, bs);
+    Compressor     cmp(dims, opt.wname);
+    if (Compressor::GetErrCode() != 0) return (-1);
+
+    vector<size_t> ncoeffs = ncoeffs_from_cratios(cmp, opt.cratios);
+    size_t         tlen = 0;
+    for (int i = 0; i < ncoeffs.size(); i++) tlen += ncoeffs[i];
+
+    vector<vector<float>> blocks(nblocks, vector<float>(bs * bs * bs));
+    for (size_t b = 0; b < nblocks; b++) make_block(b, bs, blocks[b]);
+
+    vector<float>           coeffs_sort(tlen), coeffs_select(tlen);
+    vector<SignificanceMap> maps_sort(ncoeffs.size()), maps_select(ncoeffs.size());
+
+    double sort_ms = 0.0;
+    double select_ms = 0.0;
+    size_t num_wrong = 0;
+    for (size_t b = 0; b < nblocks; b++) {
+        cmp.PartialSortOnOff() = false;
+        auto t0 = clk::now();
+        int  rc = cmp.Decompose(blocks[b].data(), coeffs_sort.data(), ncoeffs, maps_sort);
+        sort_ms += elapsed_ms(t0);
+        if (rc < 0) return (-1);
+
+        cmp.PartialSortOnOff() = true;
+        t0 = clk::now();
+        rc = cmp.Decompose(blocks[b].data(), coeffs_select.data(), ncoeffs, maps_select);
+        select_ms += elapsed_ms(t0);
+        if (rc < 0) return (-1);
+
+        if (!same_maps(maps_sort, maps_select) || coeffs_sort != coeffs_select) num_wrong++;
+    }
+
+    double mb = (double)nblocks * bs * bs * bs * sizeof(float) / (1024.0 * 1024.0);
+    cout << "	Decompose " << nblocks << " " << bs << "^3 blocks, " << ncoeffs.size() << " collections" << endl;
+    cout << "	Full sort (ms) : " << sort_ms << " (" << mb / (sort_ms / 1000.0) << " MB/s)" << endl;
+    cout << "	Selection (ms) : " << select_ms << " (" << mb / (select_ms / 1000.0) << " MB/s)" << endl;
+
+    // Single collection path used by Compress()
+    //
+    size_t          n = ncoeffs[0];
+    vector<float>   dst_sort(n), dst_select(n);
+    SignificanceMap map_sort, map_select;
+    sort_ms = select_ms = 0.0;
+    for (size_t b = 0; b < nblocks; b++) {
+        cmp.PartialSortOnOff() = false;
+        auto t0 = clk::now();
+        int  rc = cmp.Compress(blocks[b].data(), dst_sort.data(), n, &map_sort);
+        sort_ms += elapsed_ms(t0);
+        if (rc < 0) return (-1);
+
+        cmp.PartialSortOnOff() = true;
+        t0 = clk::now();
+        rc = cmp.Compress(blocks[b].data(), dst_select.data(), n, &map_select);
+        select_ms += elapsed_ms(t0);
+        if (rc < 0) return (-1);
+
+        vector<SignificanceMap> a(1, map_sort), s(1, map_select);
+        if (!same_maps(a, s) || dst_sort != dst_select) num_wrong++;
+    }
+    cout << "	Compress " << nblocks << " blocks to " << n << " coefficients" << endl;
+    cout << "	Full sort (ms) : " << sort_ms << endl;
+    cout << "	Selection (ms) : " << select_ms << endl;
+
+    cout << "	Num wrong : " << num_wrong << endl;
+    return (num_wrong ? -1 : 0);
+}
+
+int main(int argc, char **argv)
+{
+    OptionParser op;
+
+    ProgName = FileUtils::LegacyBasename(argv[0]);
+
+    MyBase::SetErrMsgFilePtr(stderr);
+
+    if (op.AppendOptions(set_opts) < 0) {
+        cerr << ProgName << " : " << op.GetErrMsg();
+        exit(1);
+    }
+
+    if (op.ParseOptions(&argc, argv, get_options) < 0) {
+        cerr << ProgName << " : " << op.GetErrMsg();
+        exit(1);
+    }
+
+    if (opt.help) {
+        cerr << "Usage: " << ProgName << " [options] " << endl;
+        op.PrintOptionHelp(stderr);
+        exit(0);
+    }
+
+    if (test_compressor() < 0) {
+        cerr << ProgName << " : " << MyBase::GetErrMsg() << endl;
+        exit(1);
+    }
+
+    return 0;
+}
@@ -4,6 +4,8 @@
 #include <vector>
 #include <sstream>
 #include <cstdio>
+#include <thread>
+#include <chrono>
 #include "vapor/VAssert.h"
 
 #include <vapor/CFuncs.h>
@@ -24,6 +26,7 @@ struct {
     int                     level;
     int                     lod;
     int                     nthreads;
+    int                     nreaders;
     string                  varname;
     string                  savefilebase;
     string                  ftype;
@@ -31,6 +34,7 @@ struct {
     std::vector<double>     maxu;
     OptionParser::Boolean_T dump;
     OptionParser::Boolean_T tgetvalue;
+    OptionParser::Boolean_T prefetch;
     OptionParser::Boolean_T nogeoxform;
     OptionParser::Boolean_T novertxform;
     OptionParser::Boolean_T verbose;
@@ -48,6 +52,9 @@ OptionParser::OptDescRec_T set_opts[] = {{"nts", 1, "1", "Number of timesteps to
                                          {"nthreads", 1, "0",
                                           "Specify number of execution threads "
                                           "0 => use number of cores"},
+                                         {"nreaders", 1, "0",
+                                          "Also read the variable from this many threads at once "
+                                          "and check that each region is read only once"},
                                          {"varname", 1, "", "Name of variable"},
                                          {"savefilebase", 1, "", "Base path name to output file"},
                                          {"ftype", 1, "vdc", "data set type (vdc|wrf|cf|mpas)"},
@@ -59,6 +66,7 @@ OptionParser::OptDescRec_T set_opts[] = {{"nts", 1, "1", "Number of timesteps to
                                           "specifying domain max extents in user coordinates (X1:Y1:Z1)"},
                                          {"verbose", 0, "", "Verobse output"},
                                          {"tgetvalue", 0, "", "Apply Grid:;GetValue test"},
+                                         {"prefetch", 0, "", "Test prefetching of the following time step"},
                                          {"dump", 0, "", "Dump variable coordinates and data"},
                                          {"nogeoxform", 0, "", "Do not apply geographic transform (projection to PCS"},
                                          {"novertxform", 0, "", "Do not apply to convert pressure, etc. to meters"},
@@ -74,6 +82,7 @@ OptionParser::Option_T get_options[] = {{"nts", Wasp::CvtToInt, &opt.nts, sizeof
                                         {"level", Wasp::CvtToInt, &opt.level, sizeof(opt.level)},
                                         {"lod", Wasp::CvtToInt, &opt.lod, sizeof(opt.lod)},
                                         {"nthreads", Wasp::CvtToInt, &opt.nthreads, sizeof(opt.nthreads)},
+                                        {"nreaders", Wasp::CvtToInt, &opt.nreaders, sizeof(opt.nreaders)},
                                         {"varname", Wasp::CvtToCPPStr, &opt.varname, sizeof(opt.varname)},
                                         {"savefilebase", Wasp::CvtToCPPStr, &opt.savefilebase, sizeof(opt.savefilebase)},
                                         {"ftype", Wasp::CvtToCPPStr, &opt.ftype, sizeof(opt.ftype)},
@@ -82,6 +91,7 @@ OptionParser::Option_T get_options[] = {{"nts", Wasp::CvtToInt, &opt.nts, sizeof
                                         {"verbose", Wasp::CvtToBoolean, &opt.verbose, sizeof(opt.verbose)},
                                         {"dump", Wasp::CvtToBoolean, &opt.dump, sizeof(opt.dump)},
                                         {"tgetvalue", Wasp::CvtToBoolean, &opt.tgetvalue, sizeof(opt.tgetvalue)},
+                                        {"prefetch", Wasp::CvtToBoolean, &opt.prefetch, sizeof(opt.prefetch)},
                                         {"nogeoxform", Wasp::CvtToBoolean, &opt.nogeoxform, sizeof(opt.nogeoxform)},
                                         {"novertxform", Wasp::CvtToBoolean, &opt.novertxform, sizeof(opt.novertxform)},
                                         {"help", Wasp::CvtToBoolean, &opt.help, sizeof(opt.help)},
@@ -248,6 +258,160 @@ void dump(const Grid *g)
     }
 }
 
+void get_values(const Grid *g, vector<float> &values)
+{
+    values.clear();
+    Grid::ConstIterator itr;
+    Grid::ConstIterator enditr = g->cend();
+    for (itr = g->cbegin(); itr != enditr; ++itr) { values.push_back(*itr); }
+}
+
+// Read the same region from several threads at once. Every thread must
+// get the same values as a single reader, and the concurrent reads must
+// not go to disk more often than the single reader did
+//
+int test_concurrent_reads(DataMgr &datamgr, string vname, int ts, VAPoR::CoordType minu, VAPoR::CoordType maxu, int nreaders)
+{
+    cout << "Concurrent Read Test ----->" << endl;
+
+    int nwrong = 0;
+
+    datamgr.Clear();
+    datamgr.ResetPrefetchStats();
+
+    Grid *g = datamgr.GetVariable(ts, vname, opt.level, opt.lod, minu, maxu, false);
+    if (!g) return (1);
+
+    vector<float> refValues;
+    get_values(g, refValues);
+    delete g;
+
+    size_t nread = datamgr.GetPrefetchStats().misses;
+
+    datamgr.Clear();
+    datamgr.ResetPrefetchStats();
+
+    vector<vector<float>> values(nreaders);
+    vector<bool>          ok(nreaders, false);
+    vector<std::thread>   threads;
+    for (int i = 0; i < nreaders; i++) {
+        threads.push_back(std::thread([&, i]() {
+            Grid *g = datamgr.GetVariable(ts, vname, opt.level, opt.lod, minu, maxu, false);
+            if (!g) return;
+            get_values(g, values[i]);
+            ok[i] = true;
+            delete g;
+        }));
+    }
+    for (auto &t : threads) t.join();
+
+    for (int i = 0; i < nreaders; i++) {
+        if (!ok[i] || values[i] != refValues) {
+            cerr << "Reader " << i << " got wrong values" << endl;
+            nwrong++;
+        }
+    }
+
+    size_t nconcurrent = datamgr.GetPrefetchStats().misses;
+    if (nconcurrent != nread) {
+        cerr << nreaders << " readers read " << nconcurrent << " regions, expected " << nread << endl;
+        nwrong++;
+    }
+
+    cout << "\tNum wrong : " << nwrong << endl;
+    cout << endl;
+    return (nwrong);
+}
+
+bool same_stats(const DataMgr::PrefetchStats &a, const DataMgr::PrefetchStats &b) { return (a.reads == b.reads && a.dropped == b.dropped && a.hits == b.hits && a.misses == b.misses); }
+
+// Prefetch time step ts + 1 and check that reading it is then satisfied
+// entirely from the cache, that reading time step ts is not, and that no
+// prefetch reads happen once CancelPrefetch() or Clear() has returned
+//
+int test_prefetch(DataMgr &datamgr, string vname, int ts, VAPoR::CoordType minu, VAPoR::CoordType maxu)
+{
+    if (!datamgr.IsTimeVarying(vname) || ts + 1 >= datamgr.GetNumTimeSteps(vname)) return (0);
+
+    cout << "Prefetch Test ----->" << endl;
+
+    int nwrong = 0;
+
+    vector<string> varnames = {vname};
+
+    // Number of regions needed to construct the grid for ts + 1
+    //
+    datamgr.Clear();
+    datamgr.ResetPrefetchStats();
+    Grid *g = datamgr.GetVariable(ts + 1, vname, opt.level, opt.lod, minu, maxu, false);
+    if (!g) return (1);
+    delete g;
+    size_t nregions = datamgr.GetPrefetchStats().misses;
+
+    // Hits
+    //
+    datamgr.Clear();
+    datamgr.ResetPrefetchStats();
+    datamgr.PrefetchTimeSteps(ts, 1, varnames, opt.level, opt.lod, minu, maxu);
+
+    DataMgr::PrefetchStats stats = datamgr.GetPrefetchStats();
+    for (int i = 0; i < 6000 && stats.reads + stats.dropped < nregions; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        stats = datamgr.GetPrefetchStats();
+    }
+    if (stats.reads != nregions) {
+        cerr << "Prefetched " << stats.reads << " regions, expected " << nregions << " (" << stats.dropped << " dropped)" << endl;
+        nwrong++;
+    }
+
+    g = datamgr.GetVariable(ts + 1, vname, opt.level, opt.lod, minu, maxu, false);
+    if (!g) return (1);
+    delete g;
+    stats = datamgr.GetPrefetchStats();
+    if (stats.hits != nregions || stats.misses != 0) {
+        cerr << "Prefetched time step: " << stats.hits << " hits, " << stats.misses << " misses, expected " << nregions << " hits" << endl;
+        nwrong++;
+    }
+
+    // Misses
+    //
+    datamgr.ResetPrefetchStats();
+    g = datamgr.GetVariable(ts, vname, opt.level, opt.lod, minu, maxu, false);
+    if (!g) return (1);
+    delete g;
+    stats = datamgr.GetPrefetchStats();
+    if (stats.hits != 0 || stats.misses == 0) {
+        cerr << "Time step not prefetched: " << stats.hits << " hits, " << stats.misses << " misses" << endl;
+        nwrong++;
+    }
+
+    // Cancellation, both explicit and by clearing the cache
+    //
+    size_t k = datamgr.GetNumTimeSteps(vname) - ts - 1;
+    for (int i = 0; i < 2; i++) {
+        datamgr.Clear();
+        datamgr.ResetPrefetchStats();
+        datamgr.PrefetchTimeSteps(ts, k, varnames, opt.level, opt.lod, minu, maxu);
+        if (i == 0) {
+            datamgr.CancelPrefetch();
+        } else {
+            datamgr.Clear();
+        }
+
+        DataMgr::PrefetchStats stats0 = datamgr.GetPrefetchStats();
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        stats = datamgr.GetPrefetchStats();
+        if (!same_stats(stats0, stats)) {
+            cerr << "Prefetch reads made after " << (i == 0 ? "CancelPrefetch()" : "Clear()") << endl;
+            nwrong++;
+        }
+    }
+
+    cout << "\tNum wrong : " << nwrong << endl;
+    cout << endl;
+    return (nwrong);
+}
+
 void process(FILE *fp, DataMgr &datamgr, string vname, int loop, int ts)
 {
     vector<double> timecoords;
@@ -282,6 +446,10 @@ void process(FILE *fp, DataMgr &datamgr, string vname, int loop, int ts)
         if (rc < 0) exit(1);
     }
 
+    if (opt.nreaders > 0 && test_concurrent_reads(datamgr, vname, ts, minu, maxu, opt.nreaders)) { exit(1); }
+
+    if (opt.prefetch && test_prefetch(datamgr, vname, ts, minu, maxu)) { exit(1); }
+
     Grid *g;
     g = datamgr.GetVariable(ts, vname, opt.level, opt.lod, minu, maxu, false);
 
@@ -541,6 +541,47 @@ void test_getvalue(StructuredGrid *sg)
     cout << endl;
 }
 
+void test_getvalues(StructuredGrid *sg)
+{
+    cout << "GetValues Test ----->" << endl;
+
+    sg->SetInterpolationOrder(1);
+
+    // Sample an n x n slice through the middle of the grid, once point by
+    // point and once with a single batched call
+    //
+    const size_t   n = 1024;
+    vector<double> minu, maxu;
+    sg->GetUserExtents(minu, maxu);
+
+    vector<double> xyz;
+    xyz.reserve(n * n * 3);
+    for (size_t j = 0; j < n; j++) {
+        for (size_t i = 0; i < n; i++) {
+            xyz.push_back(minu[0] + (maxu[0] - minu[0]) * (i + 0.5) / n);
+            xyz.push_back(minu[1] + (maxu[1] - minu[1]) * (j + 0.5) / n);
+            xyz.push_back(minu.size() > 2 ? (minu[2] + maxu[2]) * 0.5 : 0.0);
+        }
+    }
+
+    vector<float> v1(n * n), v2(n * n);
+
+    double t0 = Wasp::GetTime();
+    for (size_t i = 0; i < n * n; i++) { v1[i] = sg->GetValue(&xyz[i * 3]); }
+    double t1 = Wasp::GetTime();
+    sg->GetValues(xyz.data(), n * n, v2.data());
+    double t2 = Wasp::GetTime();
+
+    cout << "GetValue time : " << t1 - t0 << endl;
+    cout << "GetValues time : " << t2 - t1 << endl;
+    if (v1 == v2) {
+        cout << "GetValue GetValues match" << endl;
+    } else {
+        cout << "FAIL : GetValue GetValues mismatch" << endl;
+    }
+    cout << endl;
+}
+
 void test_roi_iterator()
 {
     cout << "ROI Test ----->" << endl;
@@ -667,6 +708,8 @@ int main(int argc, char **argv)
 
     test_getvalue(sg);
 
+    test_getvalues(sg);
+
     delete sg;
 
     for (int i = 0; i < Heap.size(); i++) { delete[] Heap[i]; }
@@ -1,10 +1,13 @@
 #include <iostream>
+#include <sstream>
+#include <cstring>
 #include "vapor/VAssert.h"
 
 #include <vapor/FileUtils.h>
 #include <vapor/CFuncs.h>
 #include <vapor/OptionParser.h>
 #include <vapor/QuadTreeRectangle.hpp>
+#include <vapor/QuadTreeRectangleP.h>
 #include "../smokeTests/gridTools.h"
 
 using namespace std;
@@ -97,6 +100,92 @@ void test_mesh()
     print_histo(qtr);
 }
 
+// A tree restored with Read() from the output of Write() must locate
+// the same cells as the original
+//
+void test_write_read()
+{
+    size_t n = opt.n;
+    VAssert(n >= 2);
+
+    cout << "	Write/Read" << endl;
+
+    QuadTreeRectangleP qtr(0.0, 0.0, 1.0, 1.0);
+
+    float delta = 1.0 / (float)(n - 1);
+
+    vector<QuadTreeRectangle<float, pType>::rectangle_t> rectangles;
+    vector<pType>                                        payloads;
+    for (size_t j = 0; j < n - 1; j++) {
+        for (size_t i = 0; i < n - 1; i++) {
+            rectangles.push_back(QuadTreeRectangle<float, pType>::rectangle_t(i * delta, j * delta, i * delta + delta, j * delta + delta));
+            payloads.push_back(pType{(uint32_t)i, (uint32_t)j});
+        }
+    }
+    qtr.Insert(rectangles, payloads);
+
+    stringstream ss(ios::in | ios::out | ios::binary);
+    size_t       num_wrong = 0;
+    if (!qtr.Write(ss)) num_wrong++;
+
+    QuadTreeRectangleP restored;
+    if (!restored.Read(ss)) num_wrong++;
+
+    for (size_t j = 0; j < n - 1; j++) {
+        for (size_t i = 0; i < n - 1; i++) {
+            float x = (float)i * delta + (delta * 0.5);
+            float y = (float)j * delta + (delta * 0.5);
+
+            vector<DimsType> p0, p1;
+            qtr.GetPayloadContained(x, y, p0);
+            restored.GetPayloadContained(x, y, p1);
+            if (p0 != p1) num_wrong++;
+        }
+    }
+
+    cout << "	Num wrong : " << num_wrong << endl;
+}
+
+// Read() must reject truncated trees, and trees whose payload counts
+// exceed the length of the stream, without changing the current tree
+//
+void test_read_corrupt()
+{
+    cout << "	Read corrupt" << endl;
+
+    QuadTreeRectangle<float, int> qtr;
+    qtr.Insert(0.0, 0.0, 1.0, 1.0, 100);
+    qtr.Insert(0.0, 0.0, 0.2, 0.2, 101);
+
+    ostringstream os;
+    qtr.Write(os);
+    string buf = os.str();
+
+    QuadTreeRectangle<float, int> other;
+    other.Insert(0.5, 0.5, 0.6, 0.6, 200);
+
+    size_t num_wrong = 0;
+
+    istringstream truncated(buf.substr(0, buf.size() - 1));
+    if (other.Read(truncated)) num_wrong++;
+
+    // Payload count of the root node follows the 3 element header and the
+    // node's level, leaf flag, child index, and bounds
+    //
+    uint64_t npayloads = 1000000000000;
+    size_t   offset = 3 * sizeof(uint64_t) + sizeof(int32_t) + sizeof(uint8_t) + sizeof(uint64_t) + 4 * sizeof(float);
+    string   corrupt = buf;
+    memcpy(&corrupt[offset], &npayloads, sizeof(npayloads));
+    istringstream huge(corrupt);
+    if (other.Read(huge)) num_wrong++;
+
+    vector<int> payloads;
+    other.GetPayloadContained(0.55, 0.55, payloads);
+    if (payloads.size() != 1 || payloads[0] != 200) num_wrong++;
+
+    cout << "	Num wrong : " << num_wrong << endl;
+}
+
 int main(int argc, char **argv)
 {
     OptionParser op;
@@ -146,5 +235,9 @@ int main(int argc, char **argv)
 
     test_mesh();
 
+    test_write_read();
+
+    test_read_corrupt();
+
     return 0;
 }
@@ -0,0 +1,162 @@
+#include <iostream>
+#include <chrono>
+#include <list>
+#include <vector>
+#include <string>
+#include "vapor/VAssert.h"
+
+#include <vapor/FileUtils.h>
+#include <vapor/OptionParser.h>
+#include <vapor/RegionCache.h>
+
+using namespace std;
+
+using namespace Wasp;
+using namespace VAPoR;
+
+struct {
+    int                     n;
+    int                     nvars;
+    int                     nlinear;
+    OptionParser::Boolean_T help;
+} opt;
+
+OptionParser::OptDescRec_T set_opts[] = {{"n", 1, "100000", "Number of regions to insert in the cache"},
+                                         {"nvars", 1, "20", "Number of distinct variables"},
+                                         {"nlinear", 1, "1000", "Number of lookups timed against a linear list scan"},
+                                         {"help", 0, "", "Print this message and exit"},
+                                         {NULL}};
+
+OptionParser::Option_T get_options[] = {{"n", Wasp::CvtToInt, &opt.n, sizeof(opt.n)},
+                                        {"nvars", Wasp::CvtToInt, &opt.nvars, sizeof(opt.nvars)},
+                                        {"nlinear", Wasp::CvtToInt, &opt.nlinear, sizeof(opt.nlinear)},
+                                        {"help", Wasp::CvtToBoolean, &opt.help, sizeof(opt.help)},
+                                        {NULL}};
+
+const char *ProgName;
+
+typedef std::chrono::steady_clock clk;
+
+double elapsed_ms(clk::time_point t0) { return (std::chrono::duration<double, std::milli>(clk::now() - t0).count()); }
+
+// Generate n distinct region keys spread across variables, time steps
+// and block extents.
+//
+vector<RegionCache::Key> make_keys(size_t n, size_t nvars)
+{
+    vector<RegionCache::Key> keys;
+    keys.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        size_t   var = i % nvars;
+        size_t   ts = (i / nvars) / 8;
+        size_t   b = (i / nvars) % 8;
+        DimsType bmin = {b, 0, 0};
+        DimsType bmax = {b + 1, 3, 3};
+        keys.push_back(RegionCache::Key(ts, "var" + std::to_string(var), -1, -1, bmin, bmax));
+    }
+    return (keys);
+}
+
+void test_cache()
+{
+    size_t n = opt.n;
+    size_t nvars = opt.nvars;
+    VAssert(n >= 1 && nvars >= 1);
+
+    vector<RegionCache::Key> keys = make_keys(n, nvars);
+
+    // The cache does not dereference region pointers, so fake, unique
+    // addresses suffice.
+    //
+    vector<char>   storage(n);
+    vector<void *> blks(n);
+    for (size_t i = 0; i < n; i++) blks[i] = &storage[i];
+
+    RegionCache cache;
+
+    auto t0 = clk::now();
+    for (size_t i = 0; i < n; i++) cache.Insert(keys[i], blks[i], false);
+    cout << "	Insert " << n << " regions (ms) : " << elapsed_ms(t0) << endl;
+
+    size_t num_wrong = 0;
+    t0 = clk::now();
+    for (size_t i = 0; i < n; i++) {
+        if (cache.Find(keys[(i * 7919) % n], false) != blks[(i * 7919) % n]) num_wrong++;
+    }
+    cout << "	Find " << n << " regions (ms) : " << elapsed_ms(t0) << endl;
+
+    t0 = clk::now();
+    for (size_t i = 0; i < n; i++) {
+        void *b = cache.Find(keys[i], true);
+        if (!cache.Unlock(b)) num_wrong++;
+    }
+    cout << "	Lock/unlock " << n << " regions (ms) : " << elapsed_ms(t0) << endl;
+
+    // Lock every other region and evict everything that is evictable
+    //
+    for (size_t i = 0; i < n; i += 2) cache.Find(keys[i], true);
+    size_t nevicted = 0;
+    t0 = clk::now();
+    while (cache.EvictLRU()) nevicted++;
+    cout << "	Evict " << nevicted << " unlocked regions (ms) : " << elapsed_ms(t0) << endl;
+    if (nevicted != n / 2 || cache.NumLocked() != (n + 1) / 2) num_wrong++;
+
+    vector<void *> freed;
+    t0 = clk::now();
+    for (size_t v = 0; v < nvars; v++) cache.RemoveVar("var" + std::to_string(v), freed);
+    cout << "	Remove " << freed.size() << " locked regions by variable (ms) : " << elapsed_ms(t0) << endl;
+    if (cache.Size() != 0) num_wrong++;
+
+    // Baseline: the linear std::list scan the cache replaces
+    //
+    list<pair<RegionCache::Key, void *>> regionsList;
+    for (size_t i = 0; i < n; i++) regionsList.push_back(make_pair(keys[i], blks[i]));
+
+    size_t nlinear = opt.nlinear;
+    t0 = clk::now();
+    for (size_t i = 0; i < nlinear; i++) {
+        const RegionCache::Key &key = keys[(i * 7919) % n];
+        for (auto itr = regionsList.begin(); itr != regionsList.end(); ++itr) {
+            if (itr->first == key) {
+                auto tmp = *itr;
+                regionsList.erase(itr);
+                regionsList.push_back(tmp);
+                break;
+            }
+        }
+    }
+    double linear_ms = elapsed_ms(t0);
+    cout << "	Linear scan find " << nlinear << " regions (ms) : " << linear_ms << endl;
+    if (nlinear) cout << "	Linear scan extrapolated to " << n << " regions (ms) : " << linear_ms * n / nlinear << endl;
+
+    cout << "	Num wrong : " << num_wrong << endl;
+}
+
+int main(int argc, char **argv)
+{
+    OptionParser op;
+
+    ProgName = FileUtils::LegacyBasename(argv[0]);
+
+    MyBase::SetErrMsgFilePtr(stderr);
+
+    if (op.AppendOptions(set_opts) < 0) {
+        cerr << ProgName << " : " << op.GetErrMsg();
+        exit(1);
+    }
+
+    if (op.ParseOptions(&argc, argv, get_options) < 0) {
+        cerr << ProgName << " : " << op.GetErrMsg();
+        exit(1);
+    }
+
+    if (opt.help) {
+        cerr << "Usage: " << ProgName << " [options] " << endl;
+        op.PrintOptionHelp(stderr);
+        exit(0);
+    }
+
+    test_cache();
+
+    return 0;
+}
@@ -0,0 +1,173 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include "vapor/VAssert.h"
+
+#include <vapor/CFuncs.h>
+#include <vapor/OptionParser.h>
+#include <vapor/FileUtils.h>
+#include <vapor/TMSUtils.h>
+#include <vapor/GeoImageTMS.h>
+
+using namespace std;
+using namespace Wasp;
+using namespace VAPoR;
+
+struct {
+    string                  dir;
+    int                     lods;
+    int                     tilesize;
+    int                     frames;
+    double                  span;
+    int                     cachesize;
+    std::vector<size_t>     imagesize;
+    OptionParser::Boolean_T help;
+} opt;
+
+OptionParser::OptDescRec_T set_opts[] = {{"dir", 1, "tmspan",
+                                          "TMS directory to pan across. If it does not contain a TMS "
+                                          "a synthetic one is generated there"},
+                                         {"lods", 1, "6", "Number of levels of detail of a generated TMS"},
+                                         {"tilesize", 1, "128", "Width and height in pixels of the tiles of a generated TMS"},
+                                         {"frames", 1, "200", "Number of frames in the pan"},
+                                         {"span", 1, "45", "Width in degrees of longitude of each frame"},
+                                         {"cachesize", 1, "256", "Tile cache size in MBs"},
+                                         {"imagesize", 1, "2048:2048", "Colon delimited maximum width and height of a frame"},
+                                         {"help", 0, "", "Print this message and exit"},
+                                         {NULL}};
+
+OptionParser::Option_T get_options[] = {{"dir", Wasp::CvtToCPPStr, &opt.dir, sizeof(opt.dir)},
+                                        {"lods", Wasp::CvtToInt, &opt.lods, sizeof(opt.lods)},
+                                        {"tilesize", Wasp::CvtToInt, &opt.tilesize, sizeof(opt.tilesize)},
+                                        {"frames", Wasp::CvtToInt, &opt.frames, sizeof(opt.frames)},
+                                        {"span", Wasp::CvtToDouble, &opt.span, sizeof(opt.span)},
+                                        {"cachesize", Wasp::CvtToInt, &opt.cachesize, sizeof(opt.cachesize)},
+                                        {"imagesize", Wasp::CvtToSize_tVec, &opt.imagesize, sizeof(opt.imagesize)},
+                                        {"help", Wasp::CvtToBoolean, &opt.help, sizeof(opt.help)},
+                                        {NULL}};
+
+const char *ProgName;
+
+// Write a TMS pyramid of RGBA tiles. The color of each tile encodes its
+// location
+//
+int make_tms(string dir, int lods, size_t n)
+{
+    vector<unsigned char> row(n * 4);
+
+    for (int lod = 0; lod < lods; lod++) {
+        size_t ntiles = 1 << lod;
+        for (size_t x = 0; x < ntiles; x++) {
+            string xdir = FileUtils::JoinPaths({dir, std::to_string(lod), std::to_string(x)});
+            if (FileUtils::MakeDir(xdir) < 0) {
+                MyBase::SetErrMsg("Failed to create directory %s", xdir.c_str());
+                return (-1);
+            }
+
+            for (size_t y = 0; y < ntiles; y++) {
+                string path = FileUtils::JoinPaths({xdir, std::to_string(y) + ".tif"});
+                TIFF * tif = TIFFOpen(path.c_str(), "w");
+                if (!tif) {
+                    MyBase::SetErrMsg("Failed to create tile %s", path.c_str());
+                    return (-1);
+                }
+
+                uint16 extra = EXTRASAMPLE_ASSOCALPHA;
+                TIFFSetField(tif, TIFFTAG_IMAGEWIDTH, (uint32)n);
+                TIFFSetField(tif, TIFFTAG_IMAGELENGTH, (uint32)n);
+                TIFFSetField(tif, TIFFTAG_SAMPLESPERPIXEL, 4);
+                TIFFSetField(tif, TIFFTAG_EXTRASAMPLES, 1, &extra);
+                TIFFSetField(tif, TIFFTAG_BITSPERSAMPLE, 8);
+                TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_RGB);
+                TIFFSetField(tif, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+                TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, (uint32)n);
+
+                for (size_t j = 0; j < n; j++) {
+                    for (size_t i = 0; i < n; i++) {
+                        row[4 * i + 0] = (unsigned char)(255 * x / ntiles);
+                        row[4 * i + 1] = (unsigned char)(255 * y / ntiles);
+                        row[4 * i + 2] = (unsigned char)((i ^ j) & 0xff);
+                        row[4 * i + 3] = 255;
+                    }
+                    if (TIFFWriteScanline(tif, row.data(), (uint32)j) < 0) {
+                        TIFFClose(tif);
+                        MyBase::SetErrMsg("Failed to write tile %s", path.c_str());
+                        return (-1);
+                    }
+                }
+                TIFFClose(tif);
+            }
+        }
+    }
+    return (0);
+}
+
+int main(int argc, char **argv)
+{
+    OptionParser op;
+
+    ProgName = FileUtils::LegacyBasename(argv[0]);
+
+    MyBase::SetErrMsgFilePtr(stderr);
+
+    if (op.AppendOptions(set_opts) < 0) {
+        cerr << ProgName << " : " << op.GetErrMsg();
+        exit(1);
+    }
+
+    if (op.ParseOptions(&argc, argv, get_options) < 0) {
+        cerr << ProgName << " : " << op.GetErrMsg();
+        exit(1);
+    }
+
+    if (opt.help) {
+        cerr << "Usage: " << ProgName << " [options]" << endl;
+        op.PrintOptionHelp(stderr);
+        exit(0);
+    }
+
+    VAssert(opt.imagesize.size() == 2);
+
+    if (TMSUtils::GetNumTMSLODs(opt.dir) < 1) {
+        double t0 = Wasp::GetTime();
+        if (make_tms(opt.dir, opt.lods, opt.tilesize) < 0) return (1);
+        cout << "Generated TMS in " << opt.dir << " : " << Wasp::GetTime() - t0 << endl;
+    }
+
+    GeoImageTMS tms;
+    if (tms.Initialize(opt.dir, vector<double>()) < 0) return (1);
+
+    int lod = TMSUtils::GetNumTMSLODs(opt.dir) - 1;
+    tms.SetLOD(lod);
+    tms.SetTileCacheSize((size_t)opt.cachesize * 1024 * 1024);
+
+    // Pan eastward once around the globe, along the equator
+    //
+    double tmax = 0.0, ttotal = 0.0;
+    for (int f = 0; f < opt.frames; f++) {
+        double lon = -180.0 + 360.0 * f / opt.frames;
+        double extents[] = {lon, -opt.span / 4.0, lon + opt.span, opt.span / 4.0};
+
+        double         pcsExtentsImg[4], geoCornersImg[8];
+        string         proj4StringImg;
+        size_t         width, height;
+        double         t0 = Wasp::GetTime();
+        unsigned char *image = tms.GetImage(0, extents, "+proj=latlong +ellps=WGS84", opt.imagesize[0], opt.imagesize[1], pcsExtentsImg, geoCornersImg, proj4StringImg, width, height);
+        double         t = Wasp::GetTime() - t0;
+
+        if (!image) {
+            cout << "FAIL" << endl;
+            return (1);
+        }
+        ttotal += t;
+        tmax = std::max(tmax, t);
+    }
+
+    cout << "LOD : " << lod << endl;
+    cout << "Frames : " << opt.frames << endl;
+    cout << "Mean frame time : " << ttotal / opt.frames << endl;
+    cout << "Max frame time : " << tmax << endl;
+
+    return (0);
+}
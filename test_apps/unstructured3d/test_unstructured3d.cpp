@@ -0,0 +1,183 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <cmath>
+#include "vapor/VAssert.h"
+
+#include <vapor/CFuncs.h>
+#include <vapor/OptionParser.h>
+#include <vapor/FileUtils.h>
+#include <vapor/vizutil.h>
+#include <vapor/UnstructuredGrid3D.h>
+
+using namespace std;
+using namespace Wasp;
+using namespace VAPoR;
+
+struct {
+    std::vector<size_t>     dims;
+    int                     npoints;
+    string                  type;
+    int                     order;
+    OptionParser::Boolean_T help;
+} opt;
+
+OptionParser::OptDescRec_T set_opts[] = {{"dims", 1, "64:64:64",
+                                          "Colon delimited 3-element vector "
+                                          "specifying the mesh node dimensions"},
+                                         {"npoints", 1, "1000000", "Number of random points to sample"},
+                                         {"type", 1, "tet", "Cell type. One of (tet, hex)"},
+                                         {"order", 1, "1", "Interpolation order. One of (0, 1)"},
+                                         {"help", 0, "", "Print this message and exit"},
+                                         {NULL}};
+
+OptionParser::Option_T get_options[] = {{"dims", Wasp::CvtToSize_tVec, &opt.dims, sizeof(opt.dims)},
+                                        {"npoints", Wasp::CvtToInt, &opt.npoints, sizeof(opt.npoints)},
+                                        {"type", Wasp::CvtToCPPStr, &opt.type, sizeof(opt.type)},
+                                        {"order", Wasp::CvtToInt, &opt.order, sizeof(opt.order)},
+                                        {"help", Wasp::CvtToBoolean, &opt.help, sizeof(opt.help)},
+                                        {NULL}};
+
+const char *ProgName;
+
+// Non-uniformly spaced node coordinates along one axis of the unit
+// interval
+//
+vector<float> make_axis(size_t n)
+{
+    vector<float> coords;
+    for (size_t i = 0; i < n; i++) {
+        double t = (double)i / (double)(n - 1);
+        coords.push_back(t * t * (3.0 - 2.0 * t) * 0.5 + t * 0.5);
+    }
+    return (coords);
+}
+
+// The sampled function. Linear, so that it is reproduced exactly by both
+// Barycentric and trilinear interpolation
+//
+double f(double x, double y, double z) { return (x + 2.0 * y + 3.0 * z); }
+
+int main(int argc, char **argv)
+{
+    OptionParser op;
+
+    ProgName = FileUtils::LegacyBasename(argv[0]);
+
+    MyBase::SetErrMsgFilePtr(stderr);
+
+    if (op.AppendOptions(set_opts) < 0) {
+        cerr << ProgName << " : " << op.GetErrMsg();
+        exit(1);
+    }
+
+    if (op.ParseOptions(&argc, argv, get_options) < 0) {
+        cerr << ProgName << " : " << op.GetErrMsg();
+        exit(1);
+    }
+
+    if (opt.help) {
+        cerr << "Usage: " << ProgName << " [options]" << endl;
+        op.PrintOptionHelp(stderr);
+        exit(0);
+    }
+
+    VAssert(opt.dims.size() == 3);
+    size_t nx = opt.dims[0], ny = opt.dims[1], nz = opt.dims[2];
+    VAssert(nx >= 2 && ny >= 2 && nz >= 2);
+
+    bool tets = opt.type != "hex";
+
+    // Mesh nodes, and the data values at the nodes
+    //
+    vector<float> xaxis = make_axis(nx), yaxis = make_axis(ny), zaxis = make_axis(nz);
+    size_t        nnodes = nx * ny * nz;
+    vector<float> x(nnodes), y(nnodes), z(nnodes), data(nnodes);
+    for (size_t k = 0; k < nz; k++) {
+        for (size_t j = 0; j < ny; j++) {
+            for (size_t i = 0; i < nx; i++) {
+                size_t n = k * nx * ny + j * nx + i;
+                x[n] = xaxis[i];
+                y[n] = yaxis[j];
+                z[n] = zaxis[k];
+                data[n] = f(x[n], y[n], z[n]);
+            }
+        }
+    }
+
+    // Cells. Each hexahedron of the lattice is either kept, or split into
+    // five tetrahedra
+    //
+    size_t      nodesPerCell = tets ? 4 : 8;
+    vector<int> conn;
+    for (size_t k = 0; k < nz - 1; k++) {
+        for (size_t j = 0; j < ny - 1; j++) {
+            for (size_t i = 0; i < nx - 1; i++) {
+                int n0 = k * nx * ny + j * nx + i;
+                int hex[] = {n0, n0 + 1, (int)(n0 + nx), (int)(n0 + nx + 1), (int)(n0 + nx * ny), (int)(n0 + nx * ny + 1), (int)(n0 + nx * ny + nx), (int)(n0 + nx * ny + nx + 1)};
+                if (tets) {
+                    int tet[5 * 4];
+                    HexahedronToTets(hex, tet);
+                    conn.insert(conn.end(), tet, tet + 5 * 4);
+                } else {
+                    conn.insert(conn.end(), hex, hex + 8);
+                }
+            }
+        }
+    }
+    size_t ncells = conn.size() / nodesPerCell;
+
+    cout << "Nodes : " << nnodes << endl;
+    cout << "Cells : " << ncells << endl;
+
+    DimsType vertexDims = {nnodes, 1, 1};
+    DimsType faceDims = {ncells, 1, 1};
+    DimsType edgeDims = {1, 1, 1};
+    DimsType bs = {nnodes, 1, 1};
+
+    UnstructuredGridCoordless xug(vertexDims, faceDims, edgeDims, bs, {x.data()}, 3, conn.data(), NULL, NULL, UnstructuredGrid::NODE, nodesPerCell, 0, 0, 0);
+    UnstructuredGridCoordless yug(vertexDims, faceDims, edgeDims, bs, {y.data()}, 3, conn.data(), NULL, NULL, UnstructuredGrid::NODE, nodesPerCell, 0, 0, 0);
+    UnstructuredGridCoordless zug(vertexDims, faceDims, edgeDims, bs, {z.data()}, 3, conn.data(), NULL, NULL, UnstructuredGrid::NODE, nodesPerCell, 0, 0, 0);
+
+    double             t0 = Wasp::GetTime();
+    UnstructuredGrid3D ug(vertexDims, faceDims, edgeDims, bs, {data.data()}, conn.data(), NULL, NULL, UnstructuredGrid::NODE, nodesPerCell, 0, 0, 0, xug, yug, zug, nullptr);
+    cout << "BVH build time : " << Wasp::GetTime() - t0 << endl;
+    cout << *ug.GetCellBVH();
+
+    ug.SetInterpolationOrder(opt.order);
+
+    // Random points, all inside the mesh
+    //
+    std::mt19937                           gen(0);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    vector<double>                         points(3 * opt.npoints);
+    for (size_t i = 0; i < points.size(); i++) points[i] = dist(gen);
+
+    vector<float> values(opt.npoints);
+    t0 = Wasp::GetTime();
+    for (size_t i = 0; i < opt.npoints; i++) { values[i] = ug.GetValue(&points[3 * i]); }
+    double t = Wasp::GetTime() - t0;
+
+    cout << "Query time : " << t << endl;
+    cout << "Queries per second : " << opt.npoints / t << endl;
+
+    size_t missed = 0;
+    double maxErr = 0.0;
+    for (size_t i = 0; i < opt.npoints; i++) {
+        if (values[i] == ug.GetMissingValue()) {
+            missed++;
+            continue;
+        }
+        if (opt.order == 1) maxErr = std::max(maxErr, std::fabs(values[i] - f(points[3 * i], points[3 * i + 1], points[3 * i + 2])));
+    }
+    cout << "Points not found : " << missed << endl;
+    if (opt.order == 1) cout << "Lmax error : " << maxErr << endl;
+
+    if (missed) {
+        cout << "FAIL" << endl;
+        return (1);
+    }
+
+    return (0);
+}
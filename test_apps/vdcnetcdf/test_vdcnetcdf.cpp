@@ -0,0 +1,166 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include "vapor/VAssert.h"
+
+#include <vapor/FileUtils.h>
+#include <vapor/OptionParser.h>
+#include <vapor/VDCNetCDF.h>
+
+using namespace std;
+
+using namespace Wasp;
+using namespace VAPoR;
+
+//
+// Exercise the pool of read handles kept by VDCNetCDF. Creates a VDC,
+// with a variable stored outside of the master file, and checks that
+// reads see data written while a read handle on the variable's file
+// was checked out of the pool.
+//
+struct {
+    int                     nx;
+    int                     nthreads;
+    OptionParser::Boolean_T help;
+} opt;
+
+OptionParser::OptDescRec_T set_opts[] = {{"nx", 1, "16", "Length of each dimension of the test variable"},
+                                         {"nthreads", 1, "0", "Number of threads. 0 => use number of cores"},
+                                         {"help", 0, "", "Print this message and exit"},
+                                         {NULL}};
+
+OptionParser::Option_T get_options[] = {{"nx", Wasp::CvtToInt, &opt.nx, sizeof(opt.nx)},
+                                        {"nthreads", Wasp::CvtToInt, &opt.nthreads, sizeof(opt.nthreads)},
+                                        {"help", Wasp::CvtToBoolean, &opt.help, sizeof(opt.help)},
+                                        {NULL}};
+
+const char *ProgName;
+
+const string varname = "var1";
+
+int create(string master)
+{
+    // A master threshold of zero keeps every variable out of the
+    // master file, so reads go through the handle pool
+    //
+    VDCNetCDF vdc(opt.nthreads, 0);
+
+    int rc = vdc.Initialize(master, vector<string>(), VDC::W, vector<size_t>(3, 8), 1024 * 1024);
+    if (rc < 0) return (-1);
+
+    vector<string> dimnames = {"Nx", "Ny", "Nz"};
+
+    rc = vdc.SetCompressionBlock("", vector<size_t>(1, 1));
+    if (rc < 0) return (-1);
+
+    for (int i = 0; i < dimnames.size(); i++) {
+        rc = vdc.DefineDimension(dimnames[i], opt.nx, i);
+        if (rc < 0) return (-1);
+    }
+
+    rc = vdc.DefineDataVar(varname, dimnames, dimnames, "", DC::XType::FLOAT, false);
+    if (rc < 0) return (-1);
+
+    return (vdc.EndDefine());
+}
+
+// Read the variable and count the elements that differ from value
+//
+int check(VDCNetCDF &vdc, float value, int &nwrong)
+{
+    vector<float> data(opt.nx * opt.nx * opt.nx, 0.0);
+
+    int rc = vdc.GetVar(0, varname, -1, -1, data.data());
+    if (rc < 0) return (-1);
+
+    for (int i = 0; i < data.size(); i++) {
+        if (data[i] != value) nwrong++;
+    }
+    return (0);
+}
+
+int put(VDCNetCDF &vdc, float value)
+{
+    vector<float> data(opt.nx * opt.nx * opt.nx, value);
+
+    return (vdc.PutVar(0, varname, -1, data.data()));
+}
+
+int test_purge(string master, int &nwrong)
+{
+    VDCNetCDF vdc(opt.nthreads);
+
+    int rc = vdc.Initialize(master, vector<string>(), VDC::A, vector<size_t>(), 0);
+    if (rc < 0) return (-1);
+
+    rc = put(vdc, 1.0);
+    if (rc < 0) return (-1);
+
+    // Leaves an idle handle on the variable's file in the pool
+    //
+    rc = check(vdc, 1.0, nwrong);
+    if (rc < 0) return (-1);
+
+    // Check a handle out of the pool, then write while it is still
+    // checked out. The write purges the file, so the handle must be
+    // dropped, not made idle, when it is returned.
+    //
+    int fd = vdc.OpenVariableRead(0, varname, -1, -1);
+    if (fd < 0) return (-1);
+
+    rc = put(vdc, 2.0);
+    if (rc < 0) return (-1);
+
+    rc = vdc.CloseVariable(fd);
+    if (rc < 0) return (-1);
+
+    rc = check(vdc, 2.0, nwrong);
+    if (rc < 0) return (-1);
+
+    // And with the pool disabled
+    //
+    vdc.SetMaxIdleFiles(0);
+
+    rc = put(vdc, 3.0);
+    if (rc < 0) return (-1);
+
+    return (check(vdc, 3.0, nwrong));
+}
+
+int main(int argc, char **argv)
+{
+    OptionParser op;
+
+    ProgName = FileUtils::LegacyBasename(argv[0]);
+
+    MyBase::SetErrMsgFilePtr(stderr);
+
+    if (op.AppendOptions(set_opts) < 0) {
+        cerr << ProgName << " : " << op.GetErrMsg();
+        exit(1);
+    }
+
+    if (op.ParseOptions(&argc, argv, get_options) < 0) {
+        cerr << ProgName << " : " << op.GetErrMsg();
+        exit(1);
+    }
+
+    if (opt.help || argc != 2) {
+        cerr << "Usage: " << ProgName << " [options] vdcmaster" << endl;
+        op.PrintOptionHelp(stderr);
+        exit(opt.help ? 0 : 1);
+    }
+
+    VAssert(opt.nx >= 1);
+
+    string master = argv[1];
+
+    if (create(master) < 0) exit(1);
+
+    int nwrong = 0;
+    if (test_purge(master, nwrong) < 0) exit(1);
+
+    cout << "\tNum wrong : " << nwrong << endl;
+
+    return (nwrong ? 1 : 0);
+}
@@ -0,0 +1,125 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include "vapor/VAssert.h"
+
+#include <vapor/FileUtils.h>
+#include <vapor/OptionParser.h>
+#include <vapor/WASP.h>
+
+using namespace std;
+
+using namespace Wasp;
+using namespace VAPoR;
+
+//
+// Measure WASP decode throughput. Reads a variable from a file created
+// with waspcreate and raw2wasp, once for each requested thread count.
+//
+struct {
+    string                  varname;
+    int                     lod;
+    int                     level;
+    std::vector<int>        nthreads;
+    int                     nreps;
+    OptionParser::Boolean_T help;
+} opt;
+
+OptionParser::OptDescRec_T set_opts[] = {{"varname", 1, "var1", "Name of variable"},
+                                         {"lod", 1, "-1", "Compression level. -1 => all levels defined by the file"},
+                                         {"level", 1, "-1", "Multiresolution refinement level. -1 => native resolution"},
+                                         {"nthreads", 1, "1:0", "Colon delimited list of thread counts to time. 0 => use number of cores"},
+                                         {"nreps", 1, "3", "Number of times the variable is read for each thread count"},
+                                         {"help", 0, "", "Print this message and exit"},
+                                         {NULL}};
+
+OptionParser::Option_T get_options[] = {{"varname", Wasp::CvtToCPPStr, &opt.varname, sizeof(opt.varname)},
+                                        {"lod", Wasp::CvtToInt, &opt.lod, sizeof(opt.lod)},
+                                        {"level", Wasp::CvtToInt, &opt.level, sizeof(opt.level)},
+                                        {"nthreads", Wasp::CvtToIntVec, &opt.nthreads, sizeof(opt.nthreads)},
+                                        {"nreps", Wasp::CvtToInt, &opt.nreps, sizeof(opt.nreps)},
+                                        {"help", Wasp::CvtToBoolean, &opt.help, sizeof(opt.help)},
+                                        {NULL}};
+
+const char *ProgName;
+
+typedef std::chrono::steady_clock clk;
+
+double elapsed_ms(clk::time_point t0) { return (std::chrono::duration<double, std::milli>(clk::now() - t0).count()); }
+
+int test_decode(string path, int nthreads)
+{
+    WASP wasp(nthreads);
+
+    int rc = wasp.Open(path, NC_NOWRITE);
+    if (rc < 0) return (-1);
+
+    vector<size_t> dims, bs;
+    rc = wasp.InqVarDimlens(opt.varname, opt.level, dims, bs);
+    if (rc < 0) return (-1);
+
+    size_t nelements = 1;
+    for (int i = 0; i < dims.size(); i++) nelements *= dims[i];
+
+    vector<float>  data(nelements);
+    vector<size_t> start(dims.size(), 0);
+
+    double best_ms = 0.0;
+    for (int rep = 0; rep < opt.nreps; rep++) {
+        auto t0 = clk::now();
+
+        rc = wasp.OpenVarRead(opt.varname, opt.level, opt.lod);
+        if (rc < 0) return (-1);
+
+        rc = wasp.GetVara(start, dims, data.data());
+        if (rc < 0) return (-1);
+
+        rc = wasp.CloseVar();
+        if (rc < 0) return (-1);
+
+        double ms = elapsed_ms(t0);
+        if (rep == 0 || ms < best_ms) best_ms = ms;
+    }
+
+    rc = wasp.Close();
+    if (rc < 0) return (-1);
+
+    double mb = (double)nelements * sizeof(float) / (1024.0 * 1024.0);
+    cout << "	" << opt.varname << " nthreads " << nthreads << " : " << best_ms << " ms (" << mb / (best_ms / 1000.0) << " MB/s decoded)" << endl;
+
+    return (0);
+}
+
+int main(int argc, char **argv)
+{
+    OptionParser op;
+
+    ProgName = FileUtils::LegacyBasename(argv[0]);
+
+    MyBase::SetErrMsgFilePtr(stderr);
+
+    if (op.AppendOptions(set_opts) < 0) {
+        cerr << ProgName << " : " << op.GetErrMsg();
+        exit(1);
+    }
+
+    if (op.ParseOptions(&argc, argv, get_options) < 0) {
+        cerr << ProgName << " : " << op.GetErrMsg();
+        exit(1);
+    }
+
+    if (opt.help || argc != 2) {
+        cerr << "Usage: " << ProgName << " [options] waspfile" << endl;
+        op.PrintOptionHelp(stderr);
+        exit(opt.help ? 0 : 1);
+    }
+
+    VAssert(opt.nreps >= 1);
+
+    for (int i = 0; i < opt.nthreads.size(); i++) {
+        if (test_decode(argv[1], opt.nthreads[i]) < 0) exit(1);
+    }
+
+    return 0;
+}
@@ -4,11 +4,14 @@
 #include <vector>
 #include <sstream>
 #include <cstdio>
+#include <functional>
 #include "vapor/VAssert.h"
 
 #include <vapor/CFuncs.h>
+#include <vapor/FileUtils.h>
 #include <vapor/OptionParser.h>
 #include <vapor/XmlNode.h>
+#include <vapor/XmlNodeDelta.h>
 
 using namespace Wasp;
 using namespace VAPoR;
@@ -31,13 +34,269 @@ OptionParser::Option_T get_options[] = {{"ifile", Wasp::CvtToCPPStr, &opt.ifile,
 
 const char *ProgName;
 
+XmlNode *make_tree()
+{
+    XmlNode *root = new XmlNode("root");
+    root->SetElementLong("long_data", 1);
+
+    XmlNode *child1 = root->NewChild("child1");
+    child1->SetElementDouble("double_data", 2.0);
+
+    XmlNode *child2 = root->NewChild("child2");
+    child2->SetElementString("string_data", "my string");
+
+    XmlNode *child3 = child2->NewChild("child3");
+    child3->SetElementLong("long_data", 3);
+
+    return (root);
+}
+
+// Modify a tree with \p modify and check that an XmlNodeDelta recorded
+// with Update() brings a copy of the original up to date, and then
+// reverts and re-applies the modification
+//
+int test_delta(string name, std::function<void(XmlNode *)> modify)
+{
+    int nwrong = 0;
+
+    XmlNode *tree = make_tree();
+    XmlNode  before(*tree);
+    XmlNode  copy(*tree);
+
+    XmlNodeDelta::SyncMap synced;
+    XmlNodeDelta          delta0;
+    if (delta0.Update(&copy, tree, synced) || !delta0.Empty()) nwrong++;
+
+    modify(tree);
+
+    XmlNodeDelta delta;
+    if (!delta.Update(&copy, tree, synced) || delta.Empty()) nwrong++;
+    if (copy != *tree) nwrong++;
+
+    delta.Revert(&copy);
+    if (copy != before) nwrong++;
+
+    delta.Apply(&copy);
+    if (copy != *tree) nwrong++;
+
+    // Nothing changed since the last update
+    //
+    XmlNodeDelta delta1;
+    if (delta1.Update(&copy, tree, synced) || !delta1.Empty()) nwrong++;
+
+    delete tree;
+
+    cout << "\t" << name << " num wrong : " << nwrong << endl;
+    return (nwrong);
+}
+
+int test_deltas()
+{
+    cout << "XmlNodeDelta" << endl;
+
+    int nwrong = 0;
+
+    nwrong += test_delta("Set element", [](XmlNode *root) { root->GetChild("child2")->GetChild("child3")->SetElementLong("long_data", 99); });
+
+    nwrong += test_delta("Add element", [](XmlNode *root) { root->GetChild("child1")->SetElementString("new_data", "new"); });
+
+    nwrong += test_delta("Add child", [](XmlNode *root) {
+        XmlNode *child = root->GetChild("child2")->NewChild("child4");
+        child->SetElementLong("long_data", 4);
+        child->NewChild("child5");
+    });
+
+    nwrong += test_delta("Remove child", [](XmlNode *root) { root->DeleteChild("child2"); });
+
+    nwrong += test_delta("Reorder children", [](XmlNode *root) {
+        XmlNode child1(*root->GetChild("child1"));
+        root->DeleteChild("child1");
+        root->AddChild(child1);
+    });
+
+    nwrong += test_delta("Replace and modify children", [](XmlNode *root) {
+        root->DeleteChild("child1");
+        root->NewChild("child1")->SetElementLong("long_data", 5);
+        root->GetChild("child2")->DeleteChild("child3");
+        root->SetElementLong("long_data", 6);
+    });
+
+    return (nwrong);
+}
+
+// Return the generations of a node and of each of its ancestors
+//
+vector<unsigned long> get_generations(const XmlNode *node)
+{
+    vector<unsigned long> generations;
+    for (; node; node = node->GetParent()) generations.push_back(node->GetGeneration());
+    return (generations);
+}
+
+bool advanced(const vector<unsigned long> &before, const vector<unsigned long> &after)
+{
+    if (before.size() != after.size()) return (false);
+    for (size_t i = 0; i < before.size(); i++) {
+        if (after[i] <= before[i]) return (false);
+    }
+    return (true);
+}
+
+// Apply \p modify to the node "b" of the tree root/a/b/c, and check that
+// the generations of b, a and root all advance
+//
+int test_generation(string name, std::function<void(XmlNode *)> modify)
+{
+    XmlNode  root("root");
+    XmlNode *a = root.NewChild("a");
+    XmlNode *b = a->NewChild("b");
+    XmlNode *c = b->NewChild("c");
+    b->SetElementLong("long_data", 1);
+    c->SetElementLong("long_data", 2);
+    root.NewChild("a2");
+
+    vector<unsigned long> before = get_generations(b);
+    modify(b);
+    vector<unsigned long> after = get_generations(b);
+
+    int nwrong = advanced(before, after) ? 0 : 1;
+    if (nwrong) cout << "\t" << name << " did not advance generation" << endl;
+    return (nwrong);
+}
+
+int test_generations()
+{
+    cout << "Generation" << endl;
+
+    int nwrong = 0;
+
+    nwrong += test_generation("SetTag", [](XmlNode *b) { b->SetTag("bb"); });
+    nwrong += test_generation("SetElementLong", [](XmlNode *b) { b->SetElementLong("long_data", 3); });
+    nwrong += test_generation("SetElementLong path", [](XmlNode *b) { b->SetElementLong(vector<string>{"c", "long_data"}, 3); });
+    nwrong += test_generation("SetElementDouble", [](XmlNode *b) { b->SetElementDouble("double_data", 3.0); });
+    nwrong += test_generation("SetElementDouble path", [](XmlNode *b) { b->SetElementDouble(vector<string>{"c", "double_data"}, 3.0); });
+    nwrong += test_generation("SetElementString", [](XmlNode *b) { b->SetElementString("string_data", "s"); });
+    nwrong += test_generation("SetElementStringVec", [](XmlNode *b) { b->SetElementStringVec("string_data", vector<string>{"s", "t"}); });
+    nwrong += test_generation("SetElementStringVec path", [](XmlNode *b) { b->SetElementStringVec(vector<string>{"d", "string_data"}, vector<string>{"s"}); });
+    nwrong += test_generation("NewChild", [](XmlNode *b) { b->NewChild("d"); });
+    nwrong += test_generation("AddChild", [](XmlNode *b) { b->AddChild(XmlNode("d")); });
+    nwrong += test_generation("DeleteChild index", [](XmlNode *b) { b->DeleteChild((size_t)0); });
+    nwrong += test_generation("DeleteChild tag", [](XmlNode *b) { b->DeleteChild("c"); });
+    nwrong += test_generation("DeleteAll", [](XmlNode *b) { b->DeleteAll(); });
+    nwrong += test_generation("SetParent from", [](XmlNode *b) { b->GetChild("c")->SetParent(b->GetRoot()->GetChild("a2")); });
+    nwrong += test_generation("SetParent to", [](XmlNode *b) { b->GetRoot()->GetChild("a2")->SetParent(b); });
+
+    // The moved node, and its new ancestors, change too
+    //
+    XmlNode  root("root");
+    XmlNode *c = root.NewChild("b")->NewChild("c");
+    XmlNode *a2 = root.NewChild("a2");
+    vector<unsigned long> before = get_generations(a2);
+    before.insert(before.begin(), c->GetGeneration());
+    c->SetParent(a2);
+    if (!advanced(before, get_generations(c))) {
+        cout << "\tSetParent did not advance generation of moved node" << endl;
+        nwrong++;
+    }
+
+    // Assignment detaches the node from its parent, so only the node
+    // itself can be checked
+    //
+    XmlNode       node("node");
+    unsigned long generation = node.GetGeneration();
+    node = XmlNode("other");
+    if (node.GetGeneration() <= generation) {
+        cout << "\toperator= did not advance generation" << endl;
+        nwrong++;
+    }
+
+    return (nwrong);
+}
+
+// Elements must be kept sorted by tag however they are inserted, and
+// lookups by tag and by key must agree
+//
+int test_element_map()
+{
+    cout << "XmlElementMap" << endl;
+
+    int nwrong = 0;
+
+    XmlElementMap<long> m;
+    m["delta"] = 4;
+    m[XmlKey("alpha")] = 1;
+    m["charlie"] = 3;
+    m[XmlKey("echo")] = 5;
+    m["bravo"] = 2;
+    m[XmlKey("charlie")] = 33;
+
+    vector<string> tags;
+    vector<long>   values;
+    for (const auto &e : m) {
+        tags.push_back(e.first.str());
+        values.push_back(e.second);
+    }
+    if (tags != vector<string>{"alpha", "bravo", "charlie", "delta", "echo"}) nwrong++;
+    if (values != vector<long>{1, 2, 33, 4, 5}) nwrong++;
+
+    for (const auto &tag : tags) {
+        if (m.find(tag) == m.end() || m.find(tag) != m.find(XmlKey(tag))) nwrong++;
+    }
+    if (m.find("foxtrot") != m.end() || m.find(XmlKey("foxtrot")) != m.end()) nwrong++;
+    if (m.count(XmlKey("aardvark")) || m.count("zulu")) nwrong++;
+
+    m.erase(XmlKey("bravo"));
+    m.erase("echo");
+    if (m.size() != 3 || m.count("bravo") || m.count(XmlKey("echo"))) nwrong++;
+    if (m.find(XmlKey("delta"))->second != 4) nwrong++;
+
+    cout << "\tNum wrong : " << nwrong << endl;
+    return (nwrong);
+}
+
+// A tree written with operator<< and read back with XmlParser must be
+// equal to the original
+//
+int test_serialization()
+{
+    cout << "Serialization" << endl;
+
+    int nwrong = 0;
+
+    XmlNode *tree = make_tree();
+    tree->SetElementLong("zeta", vector<long>{3, 2, 1});
+    tree->SetElementLong("alpha", 7);
+    tree->SetElementDouble("mu", vector<double>{0.5, 1.5});
+    tree->GetChild("child1")->SetElementString("beta", "b");
+    tree->GetChild("child1")->SetElementString("alpha", "a");
+
+    ostringstream os;
+    os << *tree;
+
+    XmlNode       restored;
+    XmlParser     parser;
+    istringstream is(os.str());
+    if (parser.LoadFromFile(&restored, is) < 0) nwrong++;
+    if (restored != *tree) nwrong++;
+
+    // Reading resolves tags to the same keys as setting them
+    //
+    if (restored.GetElementLong("alpha") != vector<long>{7}) nwrong++;
+    if (restored.GetChild("child1")->GetElementString("alpha") != "a") nwrong++;
+
+    delete tree;
+
+    cout << "\tNum wrong : " << nwrong << endl;
+    return (nwrong);
+}
+
 int main(int argc, char **argv)
 {
     OptionParser op;
     double       timer = 0.0;
     string       s;
 
-    ProgName = Basename(argv[0]);
+    ProgName = FileUtils::LegacyBasename(argv[0]);
 
     MyBase::SetErrMsgFilePtr(stderr);
 
@@ -65,6 +324,12 @@ int main(int argc, char **argv)
         exit(1);
     }
 
+    int nwrong = test_deltas();
+    nwrong += test_generations();
+    nwrong += test_element_map();
+    nwrong += test_serialization();
+    cout << "\tNum wrong : " << nwrong << endl;
+
     XmlNode *parent = new XmlNode("parent");
     parent->SetElementLong("long_data1", 1);
     parent->SetElementLong("long_data2", 2);